@@ -34,6 +34,7 @@
 #include "itkWeakPointer.h"
 #include "itkRealTimeStamp.h"
 #include "itkObjectFactory.h"
+#include "itkImageBufferAllocator.h"
 
 namespace itk
 {
@@ -379,6 +380,21 @@ public:
     return m_DataReleased;
   }
 
+  /** Set/Get the policy with which the bulk data is allocated from now on,
+   * see ImportImageContainer::SetAllocationPolicy(). Data objects which do
+   * not allocate their bulk data through ImageBufferAllocator ignore it, and
+   * return ImageBufferAllocatorEnums::Policy::GlobalDefault. */
+  /** @ITKStartGrouping */
+  virtual void
+  SetBulkDataAllocationPolicy(ImageBufferAllocatorEnums::Policy itkNotUsed(policy))
+  {}
+  virtual ImageBufferAllocatorEnums::Policy
+  GetBulkDataAllocationPolicy() const
+  {
+    return ImageBufferAllocatorEnums::Policy::GlobalDefault;
+  }
+  /** @ITKEndGrouping */
+
   /** Provides opportunity for the data object to insure internal
    * consistency before access. Also causes owning source/filter (if
    * any) to update itself. The Update() method is composed of
@@ -285,6 +285,24 @@ public:
   void
   SetPixelContainer(PixelContainer * container);
 
+  /** Set/Get the allocation policy of the pixel container, which is kept
+   * when the container is replaced by Initialize(). */
+  /** @ITKStartGrouping */
+  void
+  SetBulkDataAllocationPolicy(ImageBufferAllocatorEnums::Policy policy) override
+  {
+    if (m_Buffer)
+    {
+      m_Buffer->SetAllocationPolicy(policy);
+    }
+  }
+  ImageBufferAllocatorEnums::Policy
+  GetBulkDataAllocationPolicy() const override
+  {
+    return m_Buffer ? m_Buffer->GetAllocationPolicy() : ImageBufferAllocatorEnums::Policy::GlobalDefault;
+  }
+  /** @ITKEndGrouping */
+
   /** Graft the data and information from one image to another. This
    * is a convenience method to setup a second image with all the meta
    * information of another image and use the same pixel
@@ -0,0 +1,168 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocator_h
+#define itkImageBufferAllocator_h
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+#include "itkMacro.h" // for ITKCommon_EXPORT
+#include "itkSingletonMacro.h"
+
+namespace itk
+{
+/** \class ImageBufferAllocatorEnums
+ *
+ * \brief enums for ImageBufferAllocator
+ *
+ * \ingroup ITKCommon
+ */
+class ImageBufferAllocatorEnums
+{
+public:
+  /**
+   * \ingroup ITKCommon
+   * Strategies used to obtain the memory of an image buffer.
+   *
+   * GlobalDefault: use the process-wide default, see
+   * ImageBufferAllocator::SetGlobalDefaultPolicy().
+   * Standard: plain `new[]`/`delete[]`, the historical ITK behavior.
+   * Aligned: buffers start on an ImageBufferAllocator::Alignment byte boundary.
+   * HugePage: aligned buffers which, where the platform supports it, are
+   * backed by transparent huge pages.
+   * Pooled: aligned buffers that are returned to a size-bucketed pool when
+   * released, and handed out again to the next request of the same size.
+   */
+  enum class Policy : uint8_t
+  {
+    GlobalDefault = 0,
+    Standard,
+    Aligned,
+    HugePage,
+    Pooled
+  };
+};
+// Define how to print enumeration
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const ImageBufferAllocatorEnums::Policy value);
+
+/** \class ImageBufferAllocator
+ * \brief Process-wide raw memory provider for image buffers.
+ *
+ * ImageBufferAllocator hands out the raw memory used by ImportImageContainer
+ * (and therefore by every itk::Image) when its allocation policy is not
+ * ImageBufferAllocatorEnums::Policy::Standard. It provides SIMD friendly
+ * alignment, transparent huge page backing on Linux, and a recycling pool that
+ * lets pipelines which repeatedly allocate equally sized intermediate images
+ * reuse memory that is already mapped, instead of faulting in fresh pages.
+ *
+ * The global default policy is initialized from the environment variable
+ * ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_ALLOCATION_POLICY (one of "STANDARD",
+ * "ALIGNED", "HUGEPAGE" or "POOLED") and falls back to Standard. It can be
+ * overridden per container with ImportImageContainer::SetAllocationPolicy().
+ *
+ * All member functions are thread safe.
+ *
+ * \ingroup ITKCommon
+ */
+struct ImageBufferAllocatorGlobals;
+
+class ITKCommon_EXPORT ImageBufferAllocator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocator);
+  // default constructor required for wrapping to succeed
+  ImageBufferAllocator() = default;
+  virtual ~ImageBufferAllocator() = default;
+
+  using PolicyEnum = ImageBufferAllocatorEnums::Policy;
+
+  /** Alignment, in bytes, of every buffer returned for the Aligned, HugePage
+   * and Pooled policies. Large enough for AVX-512 loads and a cache line. */
+  static constexpr size_t Alignment = 64;
+
+  /** Counters describing the allocator activity since the last call to
+   * ResetStatistics(). Byte counts are in bytes as actually reserved, after
+   * rounding up to the allocation granularity. */
+  struct Statistics
+  {
+    /** Number of Pooled allocations served from the pool. */
+    uint64_t PoolHits{ 0 };
+    /** Number of Pooled allocations which needed fresh memory. */
+    uint64_t PoolMisses{ 0 };
+    /** Bytes currently held, unused, by the pool. */
+    size_t PooledBytes{ 0 };
+    /** Bytes currently handed out for the Aligned, HugePage and Pooled policies. */
+    size_t AllocatedBytes{ 0 };
+  };
+
+  /** Set/Get the policy used by containers whose policy is GlobalDefault.
+   * Setting GlobalDefault is interpreted as Standard. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalDefaultPolicy(PolicyEnum policy);
+  static PolicyEnum
+  GetGlobalDefaultPolicy();
+  /** @ITKEndGrouping */
+
+  /** Resolve GlobalDefault to the current global default policy. Any other
+   * value is returned unchanged. */
+  static PolicyEnum
+  ResolvePolicy(PolicyEnum policy);
+
+  /** Allocate at least numberOfBytes of raw, uninitialized memory with the
+   * given policy. Returns nullptr on failure. The Standard policy is served
+   * by `::operator new[]`. */
+  static void *
+  Allocate(size_t numberOfBytes, PolicyEnum policy);
+
+  /** Release memory obtained from Allocate(). numberOfBytes and policy must
+   * be the values passed to Allocate(). */
+  static void
+  Deallocate(void * pointer, size_t numberOfBytes, PolicyEnum policy);
+
+  /** Set/Get the upper bound on the number of unused bytes kept by the pool.
+   * Buffers released while the pool is full are returned to the system.
+   * Lowering the bound releases pooled memory immediately. */
+  /** @ITKStartGrouping */
+  static void
+  SetMaximumPooledBytes(size_t numberOfBytes);
+  static size_t
+  GetMaximumPooledBytes();
+  /** @ITKEndGrouping */
+
+  /** Return all unused pooled buffers to the system. */
+  static void
+  ReleasePooledMemory();
+
+  /** Get a snapshot of the allocator counters. */
+  static Statistics
+  GetStatistics();
+
+  /** Reset the hit and miss counters. Byte counts are not affected. */
+  static void
+  ResetStatistics();
+
+private:
+  itkGetGlobalDeclarationMacro(ImageBufferAllocatorGlobals, PimplGlobals);
+  static ImageBufferAllocatorGlobals * m_PimplGlobals;
+};
+} // namespace itk
+
+#endif
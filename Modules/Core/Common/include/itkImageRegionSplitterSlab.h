@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegionSplitterSlab_h
+#define itkImageRegionSplitterSlab_h
+
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkNumericTraits.h"
+
+namespace itk
+{
+
+/** \class ImageRegionSplitterSlab
+ * \brief Divide an image region into many small slabs of contiguous scan lines
+ *
+ * ImageRegionSplitterSlab divides a region into slabs of at most SlabSize
+ * pixels. A slab consists of whole scan lines (whole slices of the fastest
+ * dimensions) and extends along a single, slower dimension, so that the
+ * pixels of a slab are contiguous in a buffer of the same shape as the region.
+ * With the default SlabSize, the pixels of a slab of a float image fit in the
+ * L2 cache of most processors.
+ *
+ * The number of slabs only depends on the region and SlabSize, and is
+ * typically much larger than the number of threads. This makes the splitter
+ * suitable for dynamic scheduling, see
+ * MultiThreaderBase::SetRegionScheduling(), where idle threads keep taking
+ * the next slab until all slabs are processed.
+ *
+ * When fewer pieces are requested than there are slabs, the region is split
+ * like ImageRegionSplitterSlowDimension does.
+ *
+ * \sa ImageRegionSplitterSlowDimension
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup DataProcessing
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageRegionSplitterSlab : public ImageRegionSplitterSlowDimension
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageRegionSplitterSlab);
+
+  /** Standard class type aliases. */
+  using Self = ImageRegionSplitterSlab;
+  using Superclass = ImageRegionSplitterSlowDimension;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageRegionSplitterSlab);
+
+  /** Default number of pixels of a slab. */
+  static constexpr SizeValueType DefaultSlabSize = 32768;
+
+  /** Set/Get the maximum number of pixels of a slab. Defaults to DefaultSlabSize. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(SlabSize, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(SlabSize, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Number of slabs of the region. Unlike GetNumberOfSplits(), it is not
+   * limited to the range of unsigned int. */
+  [[nodiscard]] SizeValueType
+  GetNumberOfSlabs(const ImageIORegion & region) const;
+
+  /** Set the region to its slab of index i, with i smaller than
+   * GetNumberOfSlabs(region). */
+  void
+  GetSlab(SizeValueType i, ImageIORegion & region) const;
+
+protected:
+  ImageRegionSplitterSlab();
+
+  unsigned int
+  GetNumberOfSplitsInternal(unsigned int         dim,
+                            const IndexValueType regionIndex[],
+                            const SizeValueType  regionSize[],
+                            unsigned int         requestedNumber) const override;
+
+  unsigned int
+  GetSplitInternal(unsigned int   dim,
+                   unsigned int   i,
+                   unsigned int   numberOfPieces,
+                   IndexValueType regionIndex[],
+                   SizeValueType  regionSize[]) const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** How a region is divided into slabs. */
+  struct SlabLayout
+  {
+    /** Dimension along which the slabs extend. */
+    unsigned int SlabAxis;
+    /** Number of index values along SlabAxis per slab, except for the last slab of a row of slabs. */
+    SizeValueType ValuesPerSlab;
+    /** Number of slabs along SlabAxis. */
+    SizeValueType SlabsPerAxis;
+    SizeValueType NumberOfSlabs;
+  };
+
+  SlabLayout
+  ComputeSlabLayout(unsigned int dim, const SizeValueType regionSize[]) const;
+
+  static void
+  ComputeSlab(const SlabLayout & layout,
+              SizeValueType      i,
+              unsigned int       dim,
+              IndexValueType     regionIndex[],
+              SizeValueType      regionSize[]);
+
+  SizeValueType m_SlabSize{ DefaultSlabSize };
+};
+} // end namespace itk
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkImageBufferAllocator.h"
 #include <utility>
 
 namespace itk
@@ -31,6 +32,12 @@ namespace itk
  * conforms to the ImageContainerInterface. This is a full-fledged Object,
  * so there is modification time, debug, and reference count information.
  *
+ * Memory allocated by the container itself is obtained according to its
+ * AllocationPolicy. By default the policy follows
+ * ImageBufferAllocator::GetGlobalDefaultPolicy(), which in turn defaults to
+ * plain `new[]`. Aligned, huge page backed, and pooled allocation can be
+ * selected globally or for an individual container.
+ *
  * \tparam TElementIdentifier An INTEGRAL type for use in indexing the
  * imported buffer.
  *
@@ -79,6 +86,22 @@ public:
   void
   SetImportPointer(TElement * ptr, TElementIdentifier num, bool LetContainerManageMemory = false);
 
+  /** Set the pointer from which the image data is imported, where the
+   * memory is owned by another object, for instance a memory mapped file.
+   * The container holds a reference to memoryOwner for as long as it uses
+   * the memory, so that the memory stays valid, and never frees the memory
+   * itself. */
+  void
+  SetImportPointerWithOwner(TElement * ptr, TElementIdentifier num, const LightObject * memoryOwner);
+
+  /** Get the object owning the imported memory, as passed to
+   * SetImportPointerWithOwner(), or nullptr. */
+  const LightObject *
+  GetImportPointerOwner() const
+  {
+    return m_ImportPointerOwner.GetPointer();
+  }
+
   /** Index operator. This version can be an lvalue. */
   TElement &
   operator[](const ElementIdentifier id)
@@ -160,6 +183,17 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
   /** @ITKEndGrouping */
+
+  using AllocationPolicyEnum = ImageBufferAllocatorEnums::Policy;
+
+  /** Set/Get the policy used for memory allocated by this container from now
+   * on. The buffer currently held keeps the policy it was allocated with.
+   * Defaults to AllocationPolicyEnum::GlobalDefault.
+   * \sa ImageBufferAllocator */
+  /** @ITKStartGrouping */
+  itkSetEnumMacro(AllocationPolicy, AllocationPolicyEnum);
+  itkGetConstMacro(AllocationPolicy, AllocationPolicyEnum);
+  /** @ITKEndGrouping */
 protected:
   ImportImageContainer() = default;
   ~ImportImageContainer() override;
@@ -171,12 +205,20 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
   /**
-   * Allocates elements of the array.  If UseValueInitialization is true, then
-   * POD types will be zero-initialized.
+   * Allocates elements of the array with `new[]`.  If UseValueInitialization
+   * is true, then POD types will be zero-initialized.
    */
   virtual TElement *
   AllocateElements(ElementIdentifier size, bool UseValueInitialization = false) const;
 
+  /**
+   * Allocates elements of the array with the given resolved policy, which the
+   * caller records to release the memory. The Standard policy calls the
+   * AllocateElements overload above, so that its overrides are used.
+   */
+  TElement *
+  AllocateElements(ElementIdentifier size, bool UseValueInitialization, AllocationPolicyEnum policy) const;
+
   virtual void
   DeallocateManagedMemory();
 
@@ -211,6 +253,15 @@ private:
   TElementIdentifier m_Size{};
   TElementIdentifier m_Capacity{};
   bool               m_ContainerManageMemory{ true };
+
+  AllocationPolicyEnum m_AllocationPolicy{ AllocationPolicyEnum::GlobalDefault };
+
+  /** Policy with which the managed m_ImportPointer was allocated. Memory
+   * passed in by SetImportPointer() is always released with `delete[]`. */
+  AllocationPolicyEnum m_BufferAllocationPolicy{ AllocationPolicyEnum::Standard };
+
+  /** Object owning m_ImportPointer, when set by SetImportPointerWithOwner(). */
+  LightObject::ConstPointer m_ImportPointerOwner{};
 };
 } // end namespace itk
 
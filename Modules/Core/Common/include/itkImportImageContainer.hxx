@@ -29,6 +29,8 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <limits>
+#include <memory> // For uninitialized_default_construct_n and destroy_n.
 
 namespace itk
 {
@@ -53,13 +55,15 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   {
     if (size > m_Capacity)
     {
-      TElement * temp = this->AllocateElements(size, UseValueInitialization);
+      const AllocationPolicyEnum policy = ImageBufferAllocator::ResolvePolicy(m_AllocationPolicy);
+      TElement *                 temp = this->AllocateElements(size, UseValueInitialization, policy);
       // only copy the portion of the data used in the old buffer
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_BufferAllocationPolicy = policy;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -73,7 +77,9 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   }
   else
   {
-    m_ImportPointer = this->AllocateElements(size, UseValueInitialization);
+    const AllocationPolicyEnum policy = ImageBufferAllocator::ResolvePolicy(m_AllocationPolicy);
+    m_ImportPointer = this->AllocateElements(size, UseValueInitialization, policy);
+    m_BufferAllocationPolicy = policy;
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -93,13 +99,15 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
   {
     if (m_Size < m_Capacity)
     {
-      const TElementIdentifier size = m_Size;
-      TElement *               temp = this->AllocateElements(size, false);
+      const TElementIdentifier   size = m_Size;
+      const AllocationPolicyEnum policy = ImageBufferAllocator::ResolvePolicy(m_AllocationPolicy);
+      TElement *                 temp = this->AllocateElements(size, false, policy);
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_BufferAllocationPolicy = policy;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -150,13 +158,28 @@ ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *
   this->Modified();
 }
 
+template <typename TElementIdentifier, typename TElement>
+void
+ImportImageContainer<TElementIdentifier, TElement>::SetImportPointerWithOwner(TElement *          ptr,
+                                                                              TElementIdentifier  num,
+                                                                              const LightObject * memoryOwner)
+{
+  DeallocateManagedMemory();
+  m_ImportPointer = ptr;
+  m_ImportPointerOwner = memoryOwner;
+  m_ContainerManageMemory = false;
+  m_Capacity = num;
+  m_Size = num;
+
+  this->Modified();
+}
+
 template <typename TElementIdentifier, typename TElement>
 TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
                                                                      bool              UseValueInitialization) const
 {
   TElement * data = nullptr;
-
   try
   {
     if (UseValueInitialization)
@@ -181,6 +204,51 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
   return data;
 }
 
+template <typename TElementIdentifier, typename TElement>
+TElement *
+ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier    size,
+                                                                     bool                 UseValueInitialization,
+                                                                     AllocationPolicyEnum policy) const
+{
+  if (policy == AllocationPolicyEnum::Standard)
+  {
+    return this->AllocateElements(size, UseValueInitialization);
+  }
+
+  TElement * data = nullptr;
+  if (static_cast<size_t>(size) <= std::numeric_limits<size_t>::max() / sizeof(TElement))
+  {
+    const size_t numberOfBytes = static_cast<size_t>(size) * sizeof(TElement);
+    data = static_cast<TElement *>(ImageBufferAllocator::Allocate(numberOfBytes, policy));
+    if (data)
+    {
+      try
+      {
+        if (UseValueInitialization)
+        {
+          std::uninitialized_value_construct_n(data, size);
+        }
+        else
+        {
+          std::uninitialized_default_construct_n(data, size);
+        }
+      }
+      catch (...)
+      {
+        ImageBufferAllocator::Deallocate(data, numberOfBytes, policy);
+        data = nullptr;
+      }
+    }
+  }
+  if (!data)
+  {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+  return data;
+}
+
 template <typename TElementIdentifier, typename TElement>
 void
 ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
@@ -188,9 +256,20 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_BufferAllocationPolicy == AllocationPolicyEnum::Standard)
+    {
+      delete[] m_ImportPointer;
+    }
+    else if (m_ImportPointer)
+    {
+      std::destroy_n(m_ImportPointer, m_Capacity);
+      ImageBufferAllocator::Deallocate(
+        m_ImportPointer, static_cast<size_t>(m_Capacity) * sizeof(TElement), m_BufferAllocationPolicy);
+    }
   }
   m_ImportPointer = nullptr;
+  m_ImportPointerOwner = nullptr;
+  m_BufferAllocationPolicy = AllocationPolicyEnum::Standard;
   m_Capacity = 0;
   m_Size = 0;
 }
@@ -205,6 +284,9 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  os << indent << "AllocationPolicy: " << m_AllocationPolicy << std::endl;
+  os << indent << "BufferAllocationPolicy: " << m_BufferAllocationPolicy << std::endl;
+  os << indent << "ImportPointerOwner: " << m_ImportPointerOwner.GetPointer() << std::endl;
 }
 } // end namespace itk
 
@@ -80,12 +80,29 @@ public:
     STD_EXCEPTION,
     UNKNOWN
   };
+
+  /**
+   * \ingroup ITKCommon
+   * How the templated ParallelizeImageRegion member functions distribute a region over the work units.
+   *
+   * Static: the region is split into at most one piece per work unit, by the global default splitter.
+   * Dynamic: the region is split into many small slabs, by ImageRegionSplitterSlab, and the work units keep taking
+   * the next slab until all slabs are processed. This balances the load when the cost per pixel varies across the
+   * region, for instance for masked or thresholded regions.
+   */
+  enum class RegionScheduling : uint8_t
+  {
+    Static,
+    Dynamic
+  };
 };
 // Define how to print enumeration
 extern ITKCommon_EXPORT std::ostream &
                         operator<<(std::ostream & out, const MultiThreaderBaseEnums::Threader value);
 extern ITKCommon_EXPORT std::ostream &
                         operator<<(std::ostream & out, const MultiThreaderBaseEnums::ThreadExitCode value);
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const MultiThreaderBaseEnums::RegionScheduling value);
 
 /** \class MultiThreaderBase
  * \brief A class for performing multithreaded execution
@@ -142,6 +159,22 @@ public:
   SetUpdateProgress(bool updates);
   itkGetConstMacro(UpdateProgress, bool);
 
+  using RegionSchedulingEnum = MultiThreaderBaseEnums::RegionScheduling;
+
+  /** Set/Get how the templated ParallelizeImageRegion member functions schedule the pieces of a region.
+   * Initialized to GetGlobalDefaultRegionScheduling() at construction. */
+  /** @ITKStartGrouping */
+  itkSetEnumMacro(RegionScheduling, RegionSchedulingEnum);
+  itkGetConstMacro(RegionScheduling, RegionSchedulingEnum);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the maximum number of pixels of the slabs processed by dynamic scheduling.
+   * Defaults to ImageRegionSplitterSlab::DefaultSlabSize. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(SlabSize, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(SlabSize, SizeValueType);
+  /** @ITKEndGrouping */
+
   /** Set/Get the maximum number of threads to use when multithreading.  It
    * will be clamped to the range [ 1, ITK_MAX_THREADS ] because several arrays
    * are already statically allocated using the ITK_MAX_THREADS number.
@@ -225,6 +258,19 @@ public:
   static ThreadIdType
   GetGlobalDefaultNumberOfThreads();
   /** @ITKEndGrouping */
+
+  /** Set/Get the value which is used to initialize the RegionScheduling in the constructor.
+   *
+   * The default is picked up from the ITK_GLOBAL_DEFAULT_REGION_SCHEDULING
+   * environment variable ("STATIC" or "DYNAMIC"), and is Static otherwise.
+   * If SetGlobalDefaultRegionScheduling is ever called, its value is
+   * respected over the environment variable. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalDefaultRegionScheduling(RegionSchedulingEnum regionScheduling);
+  static RegionSchedulingEnum
+  GetGlobalDefaultRegionScheduling();
+  /** @ITKEndGrouping */
 #if !defined(ITK_LEGACY_REMOVE)
   /** Get/Set the number of threads to use.
    * DEPRECATED! Use WorkUnits and MaximumNumberOfThreads instead. */
@@ -341,27 +387,61 @@ ITK_GCC_PRAGMA_DIAG_POP()
                    ArrayThreadingFunctorType aFunc,
                    ProcessObject *           filter);
 
+  using ChunkCostFunctorType = std::function<double(const IndexValueType index[], const SizeValueType size[])>;
+
   /** Break up region into smaller chunks, and call the user-specified function or function object `funcP` for each
    * chunk, having the region of the chunk as argument. The type of such a chuck region is `ImageRegion<VDimension>`.
    * Each such `funcP(region)` call must be thread-safe.
+   * The chunks are scheduled according to GetRegionScheduling().
    * If filter argument is not nullptr, this function will update its progress
    * as each work unit is completed. Delegates work to non-templated version. */
   template <unsigned int VDimension, typename TFunction>
   ITK_TEMPLATE_EXPORT void
   ParallelizeImageRegion(const ImageRegion<VDimension> & requestedRegion, TFunction funcP, ProcessObject * filter)
   {
-    this->ParallelizeImageRegion(
+    const auto chunkFunctor = [&funcP](const IndexValueType index[], const SizeValueType size[]) {
+      funcP(MakeImageRegion<VDimension>(index, size));
+    };
+
+    if (m_RegionScheduling == RegionSchedulingEnum::Dynamic)
+    {
+      this->ParallelizeImageRegionDynamically(VDimension,
+                                              requestedRegion.GetIndex().m_InternalArray,
+                                              requestedRegion.GetSize().m_InternalArray,
+                                              chunkFunctor,
+                                              nullptr,
+                                              filter);
+    }
+    else
+    {
+      this->ParallelizeImageRegion(VDimension,
+                                   requestedRegion.GetIndex().m_InternalArray,
+                                   requestedRegion.GetSize().m_InternalArray,
+                                   chunkFunctor,
+                                   filter);
+    }
+  }
+
+  /** Similar to ParallelizeImageRegion, but with a hint of the cost of each chunk: `costP(region)` estimates the
+   * relative cost of `funcP(region)`, for instance by the number of pixels of the chunk inside a mask. The region is
+   * always scheduled dynamically, and the chunks are processed in order of decreasing estimated cost, so that the
+   * most expensive chunks are not left for the end. costP is called once for each chunk, before any call to funcP. */
+  template <unsigned int VDimension, typename TFunction, typename TCostFunction>
+  ITK_TEMPLATE_EXPORT void
+  ParallelizeImageRegion(const ImageRegion<VDimension> & requestedRegion,
+                         TFunction                       funcP,
+                         TCostFunction                   costP,
+                         ProcessObject *                 filter)
+  {
+    this->ParallelizeImageRegionDynamically(
       VDimension,
       requestedRegion.GetIndex().m_InternalArray,
       requestedRegion.GetSize().m_InternalArray,
       [&funcP](const IndexValueType index[], const SizeValueType size[]) {
-        ImageRegion<VDimension> region;
-        for (unsigned int d = 0; d < VDimension; ++d)
-        {
-          region.SetIndex(d, index[d]);
-          region.SetSize(d, size[d]);
-        }
-        funcP(region);
+        funcP(MakeImageRegion<VDimension>(index, size));
+      },
+      [&costP](const IndexValueType index[], const SizeValueType size[]) {
+        return static_cast<double>(costP(MakeImageRegion<VDimension>(index, size)));
       },
       filter);
   }
@@ -398,26 +478,33 @@ ITK_GCC_PRAGMA_DIAG_POP()
         }
       }
 
-      this->ParallelizeImageRegion(
-        SplitDimension,
-        splitIndex.m_InternalArray,
-        splitSize.m_InternalArray,
-        [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[], const SizeValueType size[]) {
-          ImageRegion<VDimension> restrictedRequestedRegion;
-          restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
-          restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
-          for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
+      const auto chunkFunctor = [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[],
+                                                                                 const SizeValueType  size[]) {
+        ImageRegion<VDimension> restrictedRequestedRegion;
+        restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
+        restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
+        for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
+        {
+          if (dimension != restrictedDirection)
           {
-            if (dimension != restrictedDirection)
-            {
-              restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
-              restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
-              ++splitDimension;
-            }
+            restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
+            restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
+            ++splitDimension;
           }
-          funcP(restrictedRequestedRegion);
-        },
-        filter);
+        }
+        funcP(restrictedRequestedRegion);
+      };
+
+      if (m_RegionScheduling == RegionSchedulingEnum::Dynamic)
+      {
+        this->ParallelizeImageRegionDynamically(
+          SplitDimension, splitIndex.m_InternalArray, splitSize.m_InternalArray, chunkFunctor, nullptr, filter);
+      }
+      else
+      {
+        this->ParallelizeImageRegion(
+          SplitDimension, splitIndex.m_InternalArray, splitSize.m_InternalArray, chunkFunctor, filter);
+      }
     }
   }
 
@@ -430,6 +517,18 @@ ITK_GCC_PRAGMA_DIAG_POP()
                          ThreadingFunctorType funcP,
                          ProcessObject *      filter);
 
+  /** Break up region into many small slabs, by ImageRegionSplitterSlab, and call the function with the slabs as
+   * parameters. The work units keep taking the next slab until all slabs are processed, which balances the load when
+   * the cost of the slabs varies. If costP is not empty, the slabs are taken in order of decreasing costP.
+   * Implemented on top of ParallelizeArray, so it is supported by all multi-threaders. */
+  void
+  ParallelizeImageRegionDynamically(unsigned int         dimension,
+                                    const IndexValueType index[],
+                                    const SizeValueType  size[],
+                                    ThreadingFunctorType funcP,
+                                    ChunkCostFunctorType costP,
+                                    ProcessObject *      filter);
+
 protected:
   MultiThreaderBase();
   ~MultiThreaderBase() override;
@@ -459,6 +558,19 @@ protected:
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
   ParallelizeImageRegionHelper(void * arg);
 
+  template <unsigned int VDimension>
+  static ImageRegion<VDimension>
+  MakeImageRegion(const IndexValueType index[], const SizeValueType size[])
+  {
+    ImageRegion<VDimension> region;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      region.SetIndex(d, index[d]);
+      region.SetSize(d, size[d]);
+    }
+    return region;
+  }
+
   /** The number of work units to create. */
   ThreadIdType m_NumberOfWorkUnits{};
 
@@ -498,6 +610,9 @@ private:
 
   std::atomic<bool> m_UpdateProgress{ true };
 
+  RegionSchedulingEnum m_RegionScheduling{ RegionSchedulingEnum::Static };
+  SizeValueType        m_SlabSize{};
+
   static MultiThreaderBaseGlobals * m_PimplGlobals;
   /** Friends of Multithreader.
    * ProcessObject is a friend so that it can call PrintSelf() on its
@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineMemoryPlanner_h
+#define itkPipelineMemoryPlanner_h
+
+#include "itkProcessObject.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class PipelineMemoryPlanner
+ * \brief Updates a pipeline while keeping only the intermediate data that
+ *        is still needed.
+ *
+ * By default, every filter of a pipeline keeps its output after the
+ * downstream filters have consumed it, so that the peak memory of a long
+ * pipeline is the sum of all its intermediate images. ReleaseDataFlag
+ * avoids this, but has to be set by hand on every intermediate output, and
+ * releases the data after its first consumer, even when other filters still
+ * need it.
+ *
+ * Update() analyzes the pipeline upstream of the target filter before
+ * updating it. For every intermediate data object, it finds the filters of
+ * the pipeline which consume it, and releases its bulk data as soon as the
+ * last of them has finished executing. Data objects without source, the
+ * outputs of the target, and the data objects added with
+ * AddPreservedDataObject() are never released. Preserve the intermediate
+ * data which is used after the update, e.g. by filters which do not
+ * contribute to the target: released data is not invalid, but its source
+ * executes again when it is requested.
+ *
+ * When ReuseBuffers is on (the default), the outputs of the filters of the
+ * pipeline are allocated with the ImageBufferAllocatorEnums::Policy::Pooled
+ * policy during the update, unless they have an explicit allocation policy
+ * (see DataObject::SetBulkDataAllocationPolicy()). A released intermediate
+ * buffer then returns to the pool of ImageBufferAllocator, and is handed
+ * out again to the next filter which allocates an output of the same size,
+ * instead of new memory being mapped. The global default policy, and the
+ * images which are not part of the pipeline, are not affected. The pooled
+ * memory is kept for the next update, see
+ * ImageBufferAllocator::ReleasePooledMemory().
+ *
+ * As with ReleaseDataFlag, the filters producing released data execute
+ * again on the next update, even when they are not modified.
+ *
+ * \code
+ * auto planner = itk::PipelineMemoryPlanner::New();
+ * planner->SetTarget(writer);
+ * planner->Update();
+ * \endcode
+ *
+ * \sa DataObject::SetReleaseDataFlag ImageBufferAllocator
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineMemoryPlanner : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PipelineMemoryPlanner);
+
+  /** Standard class type aliases. */
+  using Self = PipelineMemoryPlanner;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PipelineMemoryPlanner);
+
+  /** Set/Get the last filter of the pipeline, the one which is updated. */
+  /** @ITKStartGrouping */
+  itkSetObjectMacro(Target, ProcessObject);
+  itkGetModifiableObjectMacro(Target, ProcessObject);
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether the image buffers allocated during the update are
+   * recycled through the pool of ImageBufferAllocator. Defaults to true. */
+  /** @ITKStartGrouping */
+  itkSetMacro(ReuseBuffers, bool);
+  itkGetConstMacro(ReuseBuffers, bool);
+  itkBooleanMacro(ReuseBuffers);
+  /** @ITKEndGrouping */
+
+  /** Add a data object of the pipeline which must not be released by
+   * Update(), or clear the list of such data objects. */
+  /** @ITKStartGrouping */
+  void
+  AddPreservedDataObject(const DataObject * dataObject);
+  void
+  ClearPreservedDataObjects();
+  /** @ITKEndGrouping */
+
+  /** Update the target, releasing every intermediate data object after its
+   * last consumer. Throws an ExceptionObject if no target is set, and
+   * forwards the exceptions of the pipeline. */
+  void
+  Update();
+
+  /** Number of data objects released by the last call to Update(). */
+  itkGetConstMacro(NumberOfReleasedDataObjects, SizeValueType);
+
+protected:
+  PipelineMemoryPlanner() = default;
+  ~PipelineMemoryPlanner() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  bool
+  IsPreserved(const DataObject * dataObject) const;
+
+  ProcessObject::Pointer m_Target{};
+
+  std::vector<DataObject::ConstPointer> m_PreservedDataObjects{};
+
+  bool m_ReuseBuffers{ true };
+
+  SizeValueType m_NumberOfReleasedDataObjects{ 0 };
+};
+} // end namespace itk
+
+#endif
@@ -271,6 +271,24 @@ public:
   void
   SetPixelContainer(PixelContainer * container);
 
+  /** Set/Get the allocation policy of the pixel container, which is kept
+   * when the container is replaced by Initialize(). */
+  /** @ITKStartGrouping */
+  void
+  SetBulkDataAllocationPolicy(ImageBufferAllocatorEnums::Policy policy) override
+  {
+    if (m_Buffer)
+    {
+      m_Buffer->SetAllocationPolicy(policy);
+    }
+  }
+  ImageBufferAllocatorEnums::Policy
+  GetBulkDataAllocationPolicy() const override
+  {
+    return m_Buffer ? m_Buffer->GetAllocationPolicy() : ImageBufferAllocatorEnums::Policy::GlobalDefault;
+  }
+  /** @ITKEndGrouping */
+
   /** Return the Pixel Accessor object */
   AccessorType
   GetPixelAccessor()
@@ -62,8 +62,12 @@ VectorImage<TPixel, VImageDimension>::Initialize()
 
   // Replace the handle to the buffer. This is the safest thing to do,
   // since the same container can be shared by multiple images (e.g.
-  // Grafted outputs and in place filters).
+  // Grafted outputs and in place filters). The allocation policy of the
+  // image is kept for its next buffer.
+  const auto allocationPolicy =
+    m_Buffer ? m_Buffer->GetAllocationPolicy() : PixelContainer::AllocationPolicyEnum::GlobalDefault;
   m_Buffer = PixelContainer::New();
+  m_Buffer->SetAllocationPolicy(allocationPolicy);
 }
 
 template <typename TPixel, unsigned int VImageDimension>
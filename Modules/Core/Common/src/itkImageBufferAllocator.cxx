@@ -0,0 +1,380 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+#include "itkSingleton.h"
+
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm> // For max.
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <malloc.h>
+#else
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+
+namespace
+{
+// Pooled buffers are bucketed by their size rounded up to a whole page, so
+// that images of equal size always share a bucket.
+constexpr size_t PoolGranularity = 4096;
+
+// Transparent huge pages are only used for buffers at least this large, and
+// such buffers are aligned and sized to a whole number of huge pages.
+constexpr size_t HugePageSize = size_t{ 2 } * 1024 * 1024;
+
+constexpr size_t DefaultMaximumPooledBytes = size_t{ 1 } << 30;
+
+size_t
+RoundUp(size_t numberOfBytes, size_t granularity)
+{
+  return ((numberOfBytes + granularity - 1) / granularity) * granularity;
+}
+
+void *
+AlignedAllocate(size_t numberOfBytes, size_t alignment)
+{
+#if defined(_WIN32)
+  return _aligned_malloc(numberOfBytes, alignment);
+#else
+  void * pointer = nullptr;
+  if (posix_memalign(&pointer, alignment, numberOfBytes) != 0)
+  {
+    return nullptr;
+  }
+  return pointer;
+#endif
+}
+
+void
+AlignedFree(void * pointer)
+{
+#if defined(_WIN32)
+  _aligned_free(pointer);
+#else
+  free(pointer);
+#endif
+}
+
+size_t
+HugePageAllocationSize(size_t numberOfBytes)
+{
+  return numberOfBytes >= HugePageSize ? RoundUp(numberOfBytes, HugePageSize)
+                                       : RoundUp(numberOfBytes, ImageBufferAllocator::Alignment);
+}
+
+void *
+HugePageAllocate(size_t allocationSize)
+{
+  if (allocationSize < HugePageSize)
+  {
+    return AlignedAllocate(allocationSize, ImageBufferAllocator::Alignment);
+  }
+  void * pointer = AlignedAllocate(allocationSize, HugePageSize);
+#if defined(MADV_HUGEPAGE)
+  if (pointer != nullptr)
+  {
+    // Only advisory: failure simply leaves the buffer on regular pages.
+    madvise(pointer, allocationSize, MADV_HUGEPAGE);
+  }
+#endif
+  return pointer;
+}
+
+ImageBufferAllocatorEnums::Policy
+PolicyFromString(std::string policyString)
+{
+  policyString = itksys::SystemTools::UpperCase(policyString);
+  if (policyString == "ALIGNED")
+  {
+    return ImageBufferAllocatorEnums::Policy::Aligned;
+  }
+  if (policyString == "HUGEPAGE")
+  {
+    return ImageBufferAllocatorEnums::Policy::HugePage;
+  }
+  if (policyString == "POOLED")
+  {
+    return ImageBufferAllocatorEnums::Policy::Pooled;
+  }
+  return ImageBufferAllocatorEnums::Policy::Standard;
+}
+} // namespace
+
+struct ImageBufferAllocatorGlobals
+{
+  ImageBufferAllocatorGlobals()
+  {
+    std::string envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_ALLOCATION_POLICY", envVar))
+    {
+      m_GlobalDefaultPolicy = PolicyFromString(envVar);
+    }
+  }
+
+  ~ImageBufferAllocatorGlobals()
+  {
+    for (auto & bucket : m_Pool)
+    {
+      for (void * pointer : bucket.second)
+      {
+        AlignedFree(pointer);
+      }
+    }
+  }
+
+  std::mutex                                      m_Mutex;
+  ImageBufferAllocatorEnums::Policy               m_GlobalDefaultPolicy{ ImageBufferAllocatorEnums::Policy::Standard };
+  size_t                                          m_MaximumPooledBytes{ DefaultMaximumPooledBytes };
+  std::unordered_map<size_t, std::vector<void *>> m_Pool;
+  ImageBufferAllocator::Statistics                m_Statistics;
+
+  // m_Mutex must be held.
+  void
+  TrimPool()
+  {
+    for (auto it = m_Pool.begin(); it != m_Pool.end() && m_Statistics.PooledBytes > m_MaximumPooledBytes;)
+    {
+      auto & buffers = it->second;
+      while (!buffers.empty() && m_Statistics.PooledBytes > m_MaximumPooledBytes)
+      {
+        AlignedFree(buffers.back());
+        buffers.pop_back();
+        m_Statistics.PooledBytes -= it->first;
+      }
+      it = buffers.empty() ? m_Pool.erase(it) : std::next(it);
+    }
+  }
+};
+
+itkGetGlobalSimpleMacro(ImageBufferAllocator, ImageBufferAllocatorGlobals, PimplGlobals);
+
+ImageBufferAllocatorGlobals * ImageBufferAllocator::m_PimplGlobals;
+
+void
+ImageBufferAllocator::SetGlobalDefaultPolicy(PolicyEnum policy)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_GlobalDefaultPolicy = (policy == PolicyEnum::GlobalDefault) ? PolicyEnum::Standard : policy;
+}
+
+auto
+ImageBufferAllocator::GetGlobalDefaultPolicy() -> PolicyEnum
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_GlobalDefaultPolicy;
+}
+
+auto
+ImageBufferAllocator::ResolvePolicy(PolicyEnum policy) -> PolicyEnum
+{
+  return (policy == PolicyEnum::GlobalDefault) ? GetGlobalDefaultPolicy() : policy;
+}
+
+void *
+ImageBufferAllocator::Allocate(size_t numberOfBytes, PolicyEnum policy)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  // Like operator new[], hand out a unique pointer for empty buffers.
+  numberOfBytes = std::max<size_t>(numberOfBytes, 1);
+  switch (ResolvePolicy(policy))
+  {
+    case PolicyEnum::Aligned:
+    {
+      const size_t allocationSize = RoundUp(numberOfBytes, Alignment);
+      void *       pointer = AlignedAllocate(allocationSize, Alignment);
+      if (pointer != nullptr)
+      {
+        const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+        m_PimplGlobals->m_Statistics.AllocatedBytes += allocationSize;
+      }
+      return pointer;
+    }
+    case PolicyEnum::HugePage:
+    {
+      const size_t allocationSize = HugePageAllocationSize(numberOfBytes);
+      void *       pointer = HugePageAllocate(allocationSize);
+      if (pointer != nullptr)
+      {
+        const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+        m_PimplGlobals->m_Statistics.AllocatedBytes += allocationSize;
+      }
+      return pointer;
+    }
+    case PolicyEnum::Pooled:
+    {
+      const size_t allocationSize = RoundUp(numberOfBytes, PoolGranularity);
+      {
+        const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+        auto &                            statistics = m_PimplGlobals->m_Statistics;
+        const auto                        bucket = m_PimplGlobals->m_Pool.find(allocationSize);
+        if (bucket != m_PimplGlobals->m_Pool.end() && !bucket->second.empty())
+        {
+          void * pointer = bucket->second.back();
+          bucket->second.pop_back();
+          ++statistics.PoolHits;
+          statistics.PooledBytes -= allocationSize;
+          statistics.AllocatedBytes += allocationSize;
+          return pointer;
+        }
+        ++statistics.PoolMisses;
+      }
+      void * pointer = HugePageAllocate(allocationSize);
+      if (pointer != nullptr)
+      {
+        const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+        m_PimplGlobals->m_Statistics.AllocatedBytes += allocationSize;
+      }
+      return pointer;
+    }
+    default:
+      return ::operator new(numberOfBytes, std::nothrow);
+  }
+}
+
+void
+ImageBufferAllocator::Deallocate(void * pointer, size_t numberOfBytes, PolicyEnum policy)
+{
+  if (pointer == nullptr)
+  {
+    return;
+  }
+  itkInitGlobalsMacro(PimplGlobals);
+  numberOfBytes = std::max<size_t>(numberOfBytes, 1);
+  policy = (m_PimplGlobals == nullptr && policy == PolicyEnum::GlobalDefault) ? PolicyEnum::Standard
+                                                                                : ResolvePolicy(policy);
+  if (policy == PolicyEnum::Standard)
+  {
+    ::operator delete(pointer);
+    return;
+  }
+  if (m_PimplGlobals == nullptr)
+  {
+    // Buffers released during static destruction, after the globals are gone.
+    AlignedFree(pointer);
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  auto &                            statistics = m_PimplGlobals->m_Statistics;
+  switch (policy)
+  {
+    case PolicyEnum::Aligned:
+      statistics.AllocatedBytes -= RoundUp(numberOfBytes, Alignment);
+      break;
+    case PolicyEnum::HugePage:
+      statistics.AllocatedBytes -= HugePageAllocationSize(numberOfBytes);
+      break;
+    default:
+    {
+      const size_t allocationSize = RoundUp(numberOfBytes, PoolGranularity);
+      statistics.AllocatedBytes -= allocationSize;
+      if (statistics.PooledBytes + allocationSize <= m_PimplGlobals->m_MaximumPooledBytes)
+      {
+        m_PimplGlobals->m_Pool[allocationSize].push_back(pointer);
+        statistics.PooledBytes += allocationSize;
+        return;
+      }
+      break;
+    }
+  }
+  AlignedFree(pointer);
+}
+
+void
+ImageBufferAllocator::SetMaximumPooledBytes(size_t numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_MaximumPooledBytes = numberOfBytes;
+  m_PimplGlobals->TrimPool();
+}
+
+size_t
+ImageBufferAllocator::GetMaximumPooledBytes()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_MaximumPooledBytes;
+}
+
+void
+ImageBufferAllocator::ReleasePooledMemory()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  const size_t                      maximumPooledBytes = m_PimplGlobals->m_MaximumPooledBytes;
+  m_PimplGlobals->m_MaximumPooledBytes = 0;
+  m_PimplGlobals->TrimPool();
+  m_PimplGlobals->m_MaximumPooledBytes = maximumPooledBytes;
+}
+
+auto
+ImageBufferAllocator::GetStatistics() -> Statistics
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_Statistics;
+}
+
+void
+ImageBufferAllocator::ResetStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_Statistics.PoolHits = 0;
+  m_PimplGlobals->m_Statistics.PoolMisses = 0;
+}
+
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const ImageBufferAllocatorEnums::Policy value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case ImageBufferAllocatorEnums::Policy::GlobalDefault:
+        return "itk::ImageBufferAllocatorEnums::Policy::GlobalDefault";
+      case ImageBufferAllocatorEnums::Policy::Standard:
+        return "itk::ImageBufferAllocatorEnums::Policy::Standard";
+      case ImageBufferAllocatorEnums::Policy::Aligned:
+        return "itk::ImageBufferAllocatorEnums::Policy::Aligned";
+      case ImageBufferAllocatorEnums::Policy::HugePage:
+        return "itk::ImageBufferAllocatorEnums::Policy::HugePage";
+      case ImageBufferAllocatorEnums::Policy::Pooled:
+        return "itk::ImageBufferAllocatorEnums::Policy::Pooled";
+      default:
+        return "INVALID VALUE FOR itk::ImageBufferAllocatorEnums::Policy";
+    }
+  }();
+}
+
+} // namespace itk
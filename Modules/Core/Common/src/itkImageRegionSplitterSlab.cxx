@@ -0,0 +1,144 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageRegionSplitterSlab.h"
+
+#include <algorithm> // For clamp and min.
+
+
+namespace itk
+{
+
+ImageRegionSplitterSlab::ImageRegionSplitterSlab() = default;
+
+void
+ImageRegionSplitterSlab::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "SlabSize: " << m_SlabSize << std::endl;
+}
+
+auto
+ImageRegionSplitterSlab::ComputeSlabLayout(unsigned int dim, const SizeValueType regionSize[]) const -> SlabLayout
+{
+  // The slabs extend along the fastest dimension that does not fit in a slab as a whole, or along the slowest
+  // dimension when the whole region fits in a single slab.
+  unsigned int  slabAxis = 0;
+  SizeValueType pixelsPerIndexValue = 1;
+  while (slabAxis + 1 < dim && pixelsPerIndexValue * regionSize[slabAxis] <= m_SlabSize)
+  {
+    pixelsPerIndexValue *= regionSize[slabAxis];
+    ++slabAxis;
+  }
+
+  const SizeValueType range = regionSize[slabAxis];
+  if (range == 0 || pixelsPerIndexValue == 0)
+  {
+    // An empty region is a single, empty slab.
+    return { slabAxis, range, 1, 1 };
+  }
+
+  // Spread the index values evenly over the slabs.
+  const SizeValueType maximumValuesPerSlab = std::clamp<SizeValueType>(m_SlabSize / pixelsPerIndexValue, 1, range);
+  SizeValueType       slabsPerAxis = (range + maximumValuesPerSlab - 1) / maximumValuesPerSlab;
+  const SizeValueType valuesPerSlab = (range + slabsPerAxis - 1) / slabsPerAxis;
+  slabsPerAxis = (range + valuesPerSlab - 1) / valuesPerSlab;
+
+  SizeValueType numberOfSlabs = slabsPerAxis;
+  for (unsigned int d = slabAxis + 1; d < dim; ++d)
+  {
+    numberOfSlabs *= regionSize[d];
+  }
+  return { slabAxis, valuesPerSlab, slabsPerAxis, numberOfSlabs };
+}
+
+unsigned int
+ImageRegionSplitterSlab::GetNumberOfSplitsInternal(unsigned int         dim,
+                                                   const IndexValueType regionIndex[],
+                                                   const SizeValueType  regionSize[],
+                                                   unsigned int         requestedNumber) const
+{
+  const SizeValueType numberOfSlabs = this->ComputeSlabLayout(dim, regionSize).NumberOfSlabs;
+  if (numberOfSlabs <= requestedNumber)
+  {
+    return static_cast<unsigned int>(numberOfSlabs);
+  }
+  // Fewer pieces than slabs, which the superclass splits into at most requestedNumber < numberOfSlabs pieces.
+  return Superclass::GetNumberOfSplitsInternal(dim, regionIndex, regionSize, requestedNumber);
+}
+
+unsigned int
+ImageRegionSplitterSlab::GetSplitInternal(unsigned int   dim,
+                                          unsigned int   i,
+                                          unsigned int   numberOfPieces,
+                                          IndexValueType regionIndex[],
+                                          SizeValueType  regionSize[]) const
+{
+  const SlabLayout layout = this->ComputeSlabLayout(dim, regionSize);
+  if (layout.NumberOfSlabs > numberOfPieces)
+  {
+    return Superclass::GetSplitInternal(dim, i, numberOfPieces, regionIndex, regionSize);
+  }
+
+  if (i < layout.NumberOfSlabs)
+  {
+    ComputeSlab(layout, i, dim, regionIndex, regionSize);
+  }
+  return static_cast<unsigned int>(layout.NumberOfSlabs);
+}
+
+SizeValueType
+ImageRegionSplitterSlab::GetNumberOfSlabs(const ImageIORegion & region) const
+{
+  return this->ComputeSlabLayout(region.GetImageDimension(), &region.GetSize()[0]).NumberOfSlabs;
+}
+
+void
+ImageRegionSplitterSlab::GetSlab(SizeValueType i, ImageIORegion & region) const
+{
+  const unsigned int dim = region.GetImageDimension();
+  const SlabLayout   layout = this->ComputeSlabLayout(dim, &region.GetSize()[0]);
+  if (i < layout.NumberOfSlabs)
+  {
+    ComputeSlab(layout, i, dim, &region.GetModifiableIndex()[0], &region.GetModifiableSize()[0]);
+  }
+}
+
+void
+ImageRegionSplitterSlab::ComputeSlab(const SlabLayout & layout,
+                                     SizeValueType      i,
+                                     unsigned int       dim,
+                                     IndexValueType     regionIndex[],
+                                     SizeValueType      regionSize[])
+{
+  // Slabs are numbered along the slab axis first, then along the slower dimensions.
+  const SizeValueType slabAlongAxis = i % layout.SlabsPerAxis;
+  const SizeValueType firstValue = slabAlongAxis * layout.ValuesPerSlab;
+  regionIndex[layout.SlabAxis] += static_cast<IndexValueType>(firstValue);
+  regionSize[layout.SlabAxis] = std::min(layout.ValuesPerSlab, regionSize[layout.SlabAxis] - firstValue);
+
+  SizeValueType slice = i / layout.SlabsPerAxis;
+  for (unsigned int d = layout.SlabAxis + 1; d < dim; ++d)
+  {
+    regionIndex[d] += static_cast<IndexValueType>(slice % regionSize[d]);
+    slice /= regionSize[d];
+    regionSize[d] = 1;
+  }
+}
+
+} // namespace itk
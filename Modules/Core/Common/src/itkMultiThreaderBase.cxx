@@ -56,6 +56,10 @@
 #endif
 
 #include "itkTotalProgressReporter.h"
+#include "itkImageRegionSplitterSlab.h"
+
+#include <numeric>
+#include <vector>
 
 namespace itk
 {
@@ -90,6 +94,14 @@ struct MultiThreaderBaseGlobals
   //  m_GlobalMaximumNumberOfThreads and larger or equal to 1 once it has been
   //  initialized in the constructor of the first MultiThreaderBase instantiation.
   ThreadIdType m_GlobalDefaultNumberOfThreads{ 0 };
+
+  // Like GlobalDefaultThreaderTypeIsInitialized, ensures that the
+  // ITK_GLOBAL_DEFAULT_REGION_SCHEDULING environmental variable is only
+  // used as a fall back option.
+  bool                                    GlobalDefaultRegionSchedulingIsInitialized{ false };
+  MultiThreaderBase::RegionSchedulingEnum m_GlobalDefaultRegionScheduling{
+    MultiThreaderBase::RegionSchedulingEnum::Static
+  };
 };
 
 itkGetGlobalSimpleMacro(MultiThreaderBase, MultiThreaderBaseGlobals, PimplGlobals);
@@ -192,6 +204,44 @@ MultiThreaderBase::GetGlobalDefaultThreader()
   return MultiThreaderBase::GetGlobalDefaultThreaderPrivate();
 }
 
+void
+MultiThreaderBase::SetGlobalDefaultRegionScheduling(RegionSchedulingEnum regionScheduling)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->globalDefaultInitializerMutex);
+
+  m_PimplGlobals->m_GlobalDefaultRegionScheduling = regionScheduling;
+  m_PimplGlobals->GlobalDefaultRegionSchedulingIsInitialized = true;
+}
+
+MultiThreaderBase::RegionSchedulingEnum
+MultiThreaderBase::GetGlobalDefaultRegionScheduling()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->globalDefaultInitializerMutex);
+
+  if (!m_PimplGlobals->GlobalDefaultRegionSchedulingIsInitialized)
+  {
+    std::string envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_REGION_SCHEDULING", envVar))
+    {
+      envVar = itksys::SystemTools::UpperCase(envVar);
+      if (envVar == "DYNAMIC")
+      {
+        m_PimplGlobals->m_GlobalDefaultRegionScheduling = RegionSchedulingEnum::Dynamic;
+      }
+      else if (envVar == "STATIC")
+      {
+        m_PimplGlobals->m_GlobalDefaultRegionScheduling = RegionSchedulingEnum::Static;
+      }
+    }
+    m_PimplGlobals->GlobalDefaultRegionSchedulingIsInitialized = true;
+  }
+  return m_PimplGlobals->m_GlobalDefaultRegionScheduling;
+}
+
 MultiThreaderBase::ThreaderEnum
 MultiThreaderBase::ThreaderTypeFromString(std::string threaderString)
 {
@@ -422,6 +472,8 @@ MultiThreaderBase::New()
 
 MultiThreaderBase::MultiThreaderBase()
   : m_MaximumNumberOfThreads(MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
+  , m_RegionScheduling(MultiThreaderBase::GetGlobalDefaultRegionScheduling())
+  , m_SlabSize(ImageRegionSplitterSlab::DefaultSlabSize)
 {
   m_NumberOfWorkUnits = m_MaximumNumberOfThreads;
 }
@@ -576,6 +628,86 @@ MultiThreaderBase::ParallelizeImageRegionHelper(void * arg)
   return ITK_THREAD_RETURN_DEFAULT_VALUE;
 }
 
+void
+MultiThreaderBase::ParallelizeImageRegionDynamically(unsigned int         dimension,
+                                                     const IndexValueType index[],
+                                                     const SizeValueType  size[],
+                                                     ThreadingFunctorType funcP,
+                                                     ChunkCostFunctorType costP,
+                                                     ProcessObject *      filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  // Upon destruction, progress will be set to 1.0
+  const ProgressReporter progress(filter, 0, 1);
+
+  ImageIORegion region(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    region.SetIndex(d, index[d]);
+    region.SetSize(d, size[d]);
+  }
+
+  const auto splitter = ImageRegionSplitterSlab::New();
+  splitter->SetSlabSize(m_SlabSize);
+  const SizeValueType numberOfSlabs = splitter->GetNumberOfSlabs(region);
+  const auto numberOfWorkUnits = static_cast<ThreadIdType>(std::min<SizeValueType>(m_NumberOfWorkUnits, numberOfSlabs));
+
+  if (numberOfWorkUnits <= 1)
+  {
+    // Processing the slabs one after the other would only add overhead.
+    funcP(index, size);
+    return;
+  }
+
+  // Order in which the slabs are taken: by decreasing cost when a hint is given, otherwise in memory order.
+  std::vector<SizeValueType> order(numberOfSlabs);
+  std::iota(order.begin(), order.end(), SizeValueType{ 0 });
+  if (costP)
+  {
+    std::vector<double> costs(numberOfSlabs);
+    for (SizeValueType i = 0; i < numberOfSlabs; ++i)
+    {
+      ImageIORegion slab = region;
+      splitter->GetSlab(i, slab);
+      costs[i] = costP(&slab.GetIndex()[0], &slab.GetSize()[0]);
+    }
+    std::stable_sort(
+      order.begin(), order.end(), [&costs](SizeValueType a, SizeValueType b) { return costs[a] > costs[b]; });
+  }
+
+  // The work units take the next slab from a shared counter until all slabs are processed, so that a work unit which
+  // finishes early keeps helping with the remaining slabs instead of waiting for the slowest one.
+  std::atomic<SizeValueType> nextSlab{ 0 };
+  const SizeValueType        numberOfPixels = region.GetNumberOfPixels();
+
+  this->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [&](SizeValueType) {
+      TotalProgressReporter reporter(filter, numberOfPixels);
+      for (SizeValueType i = nextSlab++; i < numberOfSlabs; i = nextSlab++)
+      {
+        ImageIORegion slab = region;
+        splitter->GetSlab(order[i], slab);
+        try
+        {
+          funcP(&slab.GetIndex()[0], &slab.GetSize()[0]);
+        }
+        catch (...)
+        {
+          // Let the other work units stop after their current slab.
+          nextSlab = numberOfSlabs;
+          throw;
+        }
+        reporter.Completed(slab.GetNumberOfPixels());
+      }
+    },
+    nullptr);
+}
+
 // Print method for the multithreader
 void
 MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
@@ -587,6 +719,8 @@ MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Global Maximum Number Of Threads: " << m_PimplGlobals->m_GlobalMaximumNumberOfThreads << std::endl;
   os << indent << "Global Default Number Of Threads: " << m_PimplGlobals->m_GlobalDefaultNumberOfThreads << std::endl;
   os << indent << "Global Default Threader Type: " << m_PimplGlobals->m_GlobalDefaultThreader << std::endl;
+  os << indent << "RegionScheduling: " << m_RegionScheduling << std::endl;
+  os << indent << "SlabSize: " << m_SlabSize << std::endl;
   os << indent << "SingleMethod: " << m_SingleMethod << std::endl;
   os << indent << "SingleData: " << m_SingleData << std::endl;
 }
@@ -641,4 +775,20 @@ operator<<(std::ostream & out, const MultiThreaderBaseEnums::ThreadExitCode valu
     }
   }();
 }
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const MultiThreaderBaseEnums::RegionScheduling value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case MultiThreaderBaseEnums::RegionScheduling::Static:
+        return "itk::MultiThreaderBaseEnums::RegionScheduling::Static";
+      case MultiThreaderBaseEnums::RegionScheduling::Dynamic:
+        return "itk::MultiThreaderBaseEnums::RegionScheduling::Dynamic";
+      default:
+        return "INVALID VALUE FOR itk::MultiThreaderBaseEnums::RegionScheduling";
+    }
+  }();
+}
 } // namespace itk
@@ -0,0 +1,236 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineMemoryPlanner.h"
+#include "itkImageBufferAllocator.h"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace itk
+{
+namespace
+{
+// Consumers, within the pipeline, of a data object.
+struct DataObjectRecord
+{
+  // Distinct filters having the data object as input.
+  std::vector<ProcessObject *> Consumers{};
+
+  // Consumers which have finished executing. A streamed consumer may execute more than once.
+  std::unordered_set<ProcessObject *> FinishedConsumers{};
+};
+
+// The inputs of a filter, without holding references to them.
+std::vector<DataObject *>
+GetInputsOf(ProcessObject * filter)
+{
+  std::vector<DataObject *>                   inputs;
+  const ProcessObject::DataObjectPointerArray pointers = filter->GetInputs();
+  for (const auto & pointer : pointers)
+  {
+    if (pointer)
+    {
+      inputs.push_back(pointer.GetPointer());
+    }
+  }
+  return inputs;
+}
+
+// Removes the observers added to the consumers, and restores the allocation
+// policies of the outputs, when the update ends, whether it succeeds or throws.
+class UpdateScope
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(UpdateScope);
+
+  UpdateScope() = default;
+
+  ~UpdateScope()
+  {
+    for (const auto & observer : m_Observers)
+    {
+      observer.first->RemoveObserver(observer.second);
+    }
+    for (const auto & output : m_PooledOutputs)
+    {
+      output->SetBulkDataAllocationPolicy(ImageBufferAllocatorEnums::Policy::GlobalDefault);
+    }
+  }
+
+  void
+  AddObserver(ProcessObject * filter, std::function<void(const EventObject &)> function)
+  {
+    m_Observers.emplace_back(filter, filter->AddObserver(EndEvent(), std::move(function)));
+  }
+
+  // Allocates the outputs of the filter from the pool, unless they have an explicit policy.
+  void
+  PoolOutputsOf(ProcessObject * filter)
+  {
+    const ProcessObject::DataObjectPointerArray outputs = filter->GetOutputs();
+    for (const auto & output : outputs)
+    {
+      if (output && output->GetBulkDataAllocationPolicy() == ImageBufferAllocatorEnums::Policy::GlobalDefault)
+      {
+        output->SetBulkDataAllocationPolicy(ImageBufferAllocatorEnums::Policy::Pooled);
+        if (output->GetBulkDataAllocationPolicy() == ImageBufferAllocatorEnums::Policy::Pooled)
+        {
+          m_PooledOutputs.push_back(output);
+        }
+      }
+    }
+  }
+
+private:
+  std::vector<std::pair<ProcessObject *, unsigned long>> m_Observers{};
+  std::vector<DataObject::Pointer>                       m_PooledOutputs{};
+};
+} // namespace
+
+
+void
+PipelineMemoryPlanner::AddPreservedDataObject(const DataObject * dataObject)
+{
+  if (dataObject != nullptr && !this->IsPreserved(dataObject))
+  {
+    m_PreservedDataObjects.emplace_back(dataObject);
+    this->Modified();
+  }
+}
+
+
+void
+PipelineMemoryPlanner::ClearPreservedDataObjects()
+{
+  if (!m_PreservedDataObjects.empty())
+  {
+    m_PreservedDataObjects.clear();
+    this->Modified();
+  }
+}
+
+
+bool
+PipelineMemoryPlanner::IsPreserved(const DataObject * dataObject) const
+{
+  return std::any_of(m_PreservedDataObjects.cbegin(),
+                     m_PreservedDataObjects.cend(),
+                     [dataObject](const DataObject::ConstPointer & preserved) { return preserved == dataObject; });
+}
+
+
+void
+PipelineMemoryPlanner::Update()
+{
+  if (m_Target == nullptr)
+  {
+    itkExceptionMacro("Target is not set.");
+  }
+  m_NumberOfReleasedDataObjects = 0;
+
+  // Find the filters upstream of the target, and the consumers of their outputs.
+  std::unordered_map<DataObject *, DataObjectRecord> records;
+  std::vector<ProcessObject *>                       filters{ m_Target.GetPointer() };
+  std::unordered_set<ProcessObject *>                visited{ m_Target.GetPointer() };
+  std::vector<ProcessObject *>                       pending{ m_Target.GetPointer() };
+  while (!pending.empty())
+  {
+    ProcessObject * const filter = pending.back();
+    pending.pop_back();
+
+    for (DataObject * const input : GetInputsOf(filter))
+    {
+      DataObjectRecord & record = records[input];
+      // Every filter is visited once, so that its own entries are the last ones.
+      if (record.Consumers.empty() || record.Consumers.back() != filter)
+      {
+        record.Consumers.push_back(filter);
+      }
+
+      ProcessObject * const source = input->GetSource().GetPointer();
+      if (source != nullptr && visited.insert(source).second)
+      {
+        filters.push_back(source);
+        pending.push_back(source);
+      }
+    }
+  }
+
+  // Plan the release of the intermediate data objects, after their last consumer.
+  using ReleaseListType = std::vector<std::pair<DataObject *, DataObjectRecord *>>;
+  std::unordered_map<ProcessObject *, ReleaseListType> releasesByConsumer;
+  SizeValueType                                        numberOfPlannedReleases = 0;
+  for (auto & [dataObject, record] : records)
+  {
+    const ProcessObject * const source = dataObject->GetSource().GetPointer();
+    if (source == nullptr || source == m_Target || this->IsPreserved(dataObject))
+    {
+      continue;
+    }
+
+    for (ProcessObject * const consumer : record.Consumers)
+    {
+      releasesByConsumer[consumer].emplace_back(dataObject, &record);
+    }
+    ++numberOfPlannedReleases;
+  }
+  itkDebugMacro("Planned the release of " << numberOfPlannedReleases << " of " << records.size() << " data objects.");
+
+  UpdateScope scope;
+  if (m_ReuseBuffers)
+  {
+    for (ProcessObject * const filter : filters)
+    {
+      scope.PoolOutputsOf(filter);
+    }
+  }
+  for (auto & consumerReleases : releasesByConsumer)
+  {
+    ProcessObject * const   consumer = consumerReleases.first;
+    const ReleaseListType & releases = consumerReleases.second;
+    scope.AddObserver(consumer, [this, consumer, &releases](const EventObject &) {
+      for (const auto & [dataObject, record] : releases)
+      {
+        if (record->FinishedConsumers.insert(consumer).second &&
+            record->FinishedConsumers.size() == record->Consumers.size())
+        {
+          dataObject->ReleaseData();
+          ++m_NumberOfReleasedDataObjects;
+        }
+      }
+    });
+  }
+
+  m_Target->Update();
+}
+
+
+void
+PipelineMemoryPlanner::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Target);
+  itkPrintSelfBooleanMacro(ReuseBuffers);
+  os << indent << "PreservedDataObjects: " << m_PreservedDataObjects.size() << std::endl;
+  os << indent << "NumberOfReleasedDataObjects: " << m_NumberOfReleasedDataObjects << std::endl;
+}
+} // end namespace itk
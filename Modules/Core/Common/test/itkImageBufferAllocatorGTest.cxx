@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageBufferAllocator.h"
+#include "itkImage.h"
+#include "itkRGBPixel.h"
+#include "itkGTest.h"
+
+#include <cstdint>
+
+
+namespace
+{
+using PolicyEnum = itk::ImageBufferAllocatorEnums::Policy;
+
+bool
+IsAligned(const void * pointer)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % itk::ImageBufferAllocator::Alignment == 0;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const PolicyEnum policy, const itk::SizeValueType sizeValue, const bool initializePixels = false)
+{
+  auto image = TImage::New();
+  image->GetPixelContainer()->SetAllocationPolicy(policy);
+  image->SetRegions(TImage::SizeType::Filled(sizeValue));
+  image->Allocate(initializePixels);
+  return image;
+}
+} // namespace
+
+
+TEST(ImageBufferAllocator, GlobalDefaultPolicyIsStandardUnlessSet)
+{
+  const PolicyEnum original = itk::ImageBufferAllocator::GetGlobalDefaultPolicy();
+
+  itk::ImageBufferAllocator::SetGlobalDefaultPolicy(PolicyEnum::GlobalDefault);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultPolicy(), PolicyEnum::Standard);
+
+  itk::ImageBufferAllocator::SetGlobalDefaultPolicy(PolicyEnum::Aligned);
+  EXPECT_EQ(itk::ImageBufferAllocator::ResolvePolicy(PolicyEnum::GlobalDefault), PolicyEnum::Aligned);
+  EXPECT_EQ(itk::ImageBufferAllocator::ResolvePolicy(PolicyEnum::Pooled), PolicyEnum::Pooled);
+
+  itk::ImageBufferAllocator::SetGlobalDefaultPolicy(original);
+}
+
+
+TEST(ImageBufferAllocator, BuffersAreAligned)
+{
+  for (const auto policy : { PolicyEnum::Aligned, PolicyEnum::HugePage, PolicyEnum::Pooled })
+  {
+    for (const size_t numberOfBytes : { size_t{ 0 }, size_t{ 1 }, size_t{ 1000 }, size_t{ 3 } << 20 })
+    {
+      void * const pointer = itk::ImageBufferAllocator::Allocate(numberOfBytes, policy);
+      ASSERT_NE(pointer, nullptr);
+      EXPECT_TRUE(IsAligned(pointer)) << policy;
+      itk::ImageBufferAllocator::Deallocate(pointer, numberOfBytes, policy);
+    }
+  }
+}
+
+
+TEST(ImageBufferAllocator, PoolRecyclesBuffersOfEqualSize)
+{
+  itk::ImageBufferAllocator::ReleasePooledMemory();
+  itk::ImageBufferAllocator::ResetStatistics();
+
+  using ImageType = itk::Image<float, 3>;
+  const void * firstBuffer{};
+  {
+    const auto image = MakeImage<ImageType>(PolicyEnum::Pooled, 32);
+    firstBuffer = image->GetBufferPointer();
+    EXPECT_TRUE(IsAligned(firstBuffer));
+  }
+
+  auto statistics = itk::ImageBufferAllocator::GetStatistics();
+  EXPECT_EQ(statistics.PoolHits, 0u);
+  EXPECT_EQ(statistics.PoolMisses, 1u);
+  EXPECT_GE(statistics.PooledBytes, 32u * 32u * 32u * sizeof(float));
+
+  {
+    // Same number of bytes, different pixel type: served from the pool.
+    const auto image = MakeImage<itk::Image<int32_t, 3>>(PolicyEnum::Pooled, 32, true);
+    EXPECT_EQ(static_cast<const void *>(image->GetBufferPointer()), firstBuffer);
+    EXPECT_EQ(image->GetPixel({}), 0);
+
+    statistics = itk::ImageBufferAllocator::GetStatistics();
+    EXPECT_EQ(statistics.PoolHits, 1u);
+    EXPECT_EQ(statistics.PooledBytes, 0u);
+    EXPECT_GE(statistics.AllocatedBytes, 32u * 32u * 32u * sizeof(int32_t));
+  }
+
+  itk::ImageBufferAllocator::ReleasePooledMemory();
+  EXPECT_EQ(itk::ImageBufferAllocator::GetStatistics().PooledBytes, 0u);
+}
+
+
+TEST(ImageBufferAllocator, PoolRespectsMaximumPooledBytes)
+{
+  const size_t originalMaximum = itk::ImageBufferAllocator::GetMaximumPooledBytes();
+  itk::ImageBufferAllocator::ReleasePooledMemory();
+  itk::ImageBufferAllocator::SetMaximumPooledBytes(4096);
+
+  void * const small = itk::ImageBufferAllocator::Allocate(100, PolicyEnum::Pooled);
+  void * const large = itk::ImageBufferAllocator::Allocate(10000, PolicyEnum::Pooled);
+  itk::ImageBufferAllocator::Deallocate(small, 100, PolicyEnum::Pooled);
+  itk::ImageBufferAllocator::Deallocate(large, 10000, PolicyEnum::Pooled);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetStatistics().PooledBytes, 4096u);
+
+  itk::ImageBufferAllocator::SetMaximumPooledBytes(0);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetStatistics().PooledBytes, 0u);
+
+  itk::ImageBufferAllocator::SetMaximumPooledBytes(originalMaximum);
+}
+
+
+TEST(ImageBufferAllocator, ImageKeepsAllocationPolicyAcrossInitialize)
+{
+  using ImageType = itk::Image<itk::RGBPixel<uint8_t>, 2>;
+  const auto image = MakeImage<ImageType>(PolicyEnum::Aligned, 7, true);
+  EXPECT_TRUE(IsAligned(image->GetBufferPointer()));
+  EXPECT_EQ(image->GetPixel({ { 6, 6 } }), ImageType::PixelType{});
+
+  image->Initialize();
+  EXPECT_EQ(image->GetPixelContainer()->GetAllocationPolicy(), PolicyEnum::Aligned);
+}
+
+
+TEST(ImageBufferAllocator, ContainerReserveAndSqueezeKeepContents)
+{
+  using ContainerType = itk::ImportImageContainer<itk::SizeValueType, double>;
+  for (const auto policy : { PolicyEnum::Standard, PolicyEnum::Aligned, PolicyEnum::HugePage, PolicyEnum::Pooled })
+  {
+    const auto container = ContainerType::New();
+    container->SetAllocationPolicy(policy);
+    container->Reserve(10, true);
+    (*container)[9] = 9.0;
+    container->Reserve(20);
+    EXPECT_EQ((*container)[9], 9.0);
+    container->Reserve(5);
+    container->Squeeze();
+    EXPECT_EQ(container->Capacity(), 5u);
+    container->Initialize();
+    EXPECT_EQ(container->GetImportPointer(), nullptr);
+
+    // Memory passed in by the user is released with delete[], regardless of the policy.
+    container->SetImportPointer(new double[3], 3, true);
+  }
+}
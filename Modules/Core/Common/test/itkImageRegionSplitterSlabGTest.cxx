@@ -0,0 +1,151 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageRegionSplitterSlab.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkGTest.h"
+
+
+namespace
+{
+// Splits the region into the given number of pieces, and checks that the pieces tile the region.
+template <unsigned int VDimension>
+void
+ExpectPiecesTileRegion(const itk::ImageRegionSplitterSlab & splitter,
+                       const itk::ImageRegion<VDimension> & region,
+                       const unsigned int                   numberOfPieces,
+                       const itk::SizeValueType             maximumPixelsPerPiece)
+{
+  const auto count = itk::Image<unsigned char, VDimension>::New();
+  count->SetRegions(region);
+  count->AllocateInitialized();
+
+  for (unsigned int i = 0; i < numberOfPieces; ++i)
+  {
+    itk::ImageRegion<VDimension> piece = region;
+    EXPECT_EQ(splitter.GetSplit(i, numberOfPieces, piece), numberOfPieces);
+    EXPECT_TRUE(region.IsInside(piece));
+    EXPECT_GT(piece.GetNumberOfPixels(), 0u);
+    EXPECT_LE(piece.GetNumberOfPixels(), maximumPixelsPerPiece);
+    for (itk::ImageRegionIterator<itk::Image<unsigned char, VDimension>> it(count, piece); !it.IsAtEnd(); ++it)
+    {
+      ++it.Value();
+    }
+  }
+
+  for (itk::ImageRegionConstIterator<itk::Image<unsigned char, VDimension>> it(count, region); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), 1) << it.GetIndex();
+  }
+}
+} // namespace
+
+
+TEST(ImageRegionSplitterSlab, SlabsTileRegion)
+{
+  const auto splitter = itk::ImageRegionSplitterSlab::New();
+  EXPECT_EQ(splitter->GetSlabSize(), itk::ImageRegionSplitterSlab::DefaultSlabSize);
+
+  const itk::ImageRegion<3> region{ { { -3, 5, 2 } }, { { 37, 11, 7 } } };
+
+  // Slabs of whole rows, several rows per slab.
+  splitter->SetSlabSize(100);
+  const unsigned int numberOfSlabs = splitter->GetNumberOfSplits(region, 100000);
+  EXPECT_EQ(numberOfSlabs, 6u * 7u);
+  ExpectPiecesTileRegion(*splitter, region, numberOfSlabs, 100);
+
+  // Slabs smaller than a row.
+  splitter->SetSlabSize(10);
+  EXPECT_EQ(splitter->GetNumberOfSplits(region, 100000), 4u * 11u * 7u);
+  ExpectPiecesTileRegion(*splitter, region, 4u * 11u * 7u, 10);
+
+  // Slabs of whole slices.
+  splitter->SetSlabSize(37 * 11 * 2);
+  EXPECT_EQ(splitter->GetNumberOfSplits(region, 100000), 4u);
+  ExpectPiecesTileRegion(*splitter, region, 4u, 37 * 11 * 2);
+
+  // The whole region fits in a single slab.
+  splitter->SetSlabSize(itk::ImageRegionSplitterSlab::DefaultSlabSize);
+  EXPECT_EQ(splitter->GetNumberOfSplits(region, 100000), 1u);
+  ExpectPiecesTileRegion(*splitter, region, 1u, region.GetNumberOfPixels());
+}
+
+
+TEST(ImageRegionSplitterSlab, FewerPiecesThanSlabs)
+{
+  const auto splitter = itk::ImageRegionSplitterSlab::New();
+  splitter->SetSlabSize(64);
+
+  const itk::ImageRegion<2> region{ { { 0, 0 } }, { { 64, 64 } } };
+  EXPECT_EQ(splitter->GetNumberOfSplits(region, 1000), 64u);
+
+  // Like ImageRegionSplitterSlowDimension when fewer pieces are requested than there are slabs.
+  const auto slowDimensionSplitter = itk::ImageRegionSplitterSlowDimension::New();
+  const unsigned int numberOfPieces = splitter->GetNumberOfSplits(region, 5);
+  EXPECT_EQ(numberOfPieces, slowDimensionSplitter->GetNumberOfSplits(region, 5));
+  for (unsigned int i = 0; i < numberOfPieces; ++i)
+  {
+    itk::ImageRegion<2> piece = region;
+    itk::ImageRegion<2> expectedPiece = region;
+    splitter->GetSplit(i, numberOfPieces, piece);
+    slowDimensionSplitter->GetSplit(i, numberOfPieces, expectedPiece);
+    EXPECT_EQ(piece, expectedPiece);
+  }
+}
+
+
+TEST(ImageRegionSplitterSlab, SlabsBeyondUnsignedIntRange)
+{
+  const auto splitter = itk::ImageRegionSplitterSlab::New();
+  splitter->SetSlabSize(10);
+
+  // GetSlab() matches GetSplit() when all the slabs are requested.
+  const itk::ImageRegion<3> region{ { { -3, 5, 2 } }, { { 37, 11, 7 } } };
+  itk::ImageIORegion        ioRegion(3);
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    ioRegion.SetIndex(d, region.GetIndex(d));
+    ioRegion.SetSize(d, region.GetSize(d));
+  }
+  const itk::SizeValueType numberOfSlabs = splitter->GetNumberOfSlabs(ioRegion);
+  EXPECT_EQ(numberOfSlabs, 4u * 11u * 7u);
+  for (itk::SizeValueType i = 0; i < numberOfSlabs; ++i)
+  {
+    itk::ImageIORegion slab = ioRegion;
+    itk::ImageIORegion expectedSlab = ioRegion;
+    splitter->GetSlab(i, slab);
+    splitter->GetSplit(static_cast<unsigned int>(i), static_cast<unsigned int>(numberOfSlabs), expectedSlab);
+    EXPECT_EQ(slab, expectedSlab);
+  }
+
+  // A region with more slabs than an unsigned int can count.
+  splitter->SetSlabSize(1);
+  itk::ImageIORegion hugeRegion(2);
+  hugeRegion.SetSize(0, 1u << 20);
+  hugeRegion.SetSize(1, 1u << 20);
+  const itk::SizeValueType numberOfHugeSlabs = itk::SizeValueType{ 1 } << 40;
+  ASSERT_EQ(splitter->GetNumberOfSlabs(hugeRegion), numberOfHugeSlabs);
+  itk::ImageIORegion lastSlab = hugeRegion;
+  splitter->GetSlab(numberOfHugeSlabs - 1, lastSlab);
+  EXPECT_EQ(lastSlab.GetIndex(0), (1 << 20) - 1);
+  EXPECT_EQ(lastSlab.GetIndex(1), (1 << 20) - 1);
+  EXPECT_EQ(lastSlab.GetSize(0), 1u);
+  EXPECT_EQ(lastSlab.GetSize(1), 1u);
+}
@@ -0,0 +1,205 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkMultiThreaderBase.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterSlab.h"
+#include "itkPlatformMultiThreader.h"
+#include "itkSingleMultiThreader.h"
+#include "itkGTest.h"
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+#  include "itkPoolMultiThreader.h"
+#endif
+#if defined(ITK_USE_TBB)
+#  include "itkTBBMultiThreader.h"
+#endif
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace
+{
+using RegionSchedulingEnum = itk::MultiThreaderBase::RegionSchedulingEnum;
+using ImageType = itk::Image<int, 3>;
+
+std::vector<itk::MultiThreaderBase::Pointer>
+MakeMultiThreaders()
+{
+  std::vector<itk::MultiThreaderBase::Pointer> threaders{ itk::PlatformMultiThreader::New().GetPointer(),
+                                                          itk::SingleMultiThreader::New().GetPointer() };
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+  threaders.push_back(itk::PoolMultiThreader::New().GetPointer());
+#endif
+#if defined(ITK_USE_TBB)
+  threaders.push_back(itk::TBBMultiThreader::New().GetPointer());
+#endif
+  for (const auto & threader : threaders)
+  {
+    threader->SetNumberOfWorkUnits(4);
+    threader->SetSlabSize(50);
+  }
+  return threaders;
+}
+
+// Counts how often each pixel of the region is visited.
+ImageType::Pointer
+MakeCountImage(const ImageType::RegionType & region)
+{
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->AllocateInitialized();
+  return image;
+}
+
+void
+ExpectEachPixelVisitedOnce(const ImageType & count)
+{
+  for (itk::ImageRegionConstIterator<ImageType> it(&count, count.GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), 1) << it.GetIndex();
+  }
+}
+} // namespace
+
+
+TEST(MultiThreaderBase, RegionSchedulingDefaultsToGlobalDefault)
+{
+  const RegionSchedulingEnum original = itk::MultiThreaderBase::GetGlobalDefaultRegionScheduling();
+
+  itk::MultiThreaderBase::SetGlobalDefaultRegionScheduling(RegionSchedulingEnum::Dynamic);
+  EXPECT_EQ(itk::MultiThreaderBase::New()->GetRegionScheduling(), RegionSchedulingEnum::Dynamic);
+  itk::MultiThreaderBase::SetGlobalDefaultRegionScheduling(RegionSchedulingEnum::Static);
+  EXPECT_EQ(itk::MultiThreaderBase::New()->GetRegionScheduling(), RegionSchedulingEnum::Static);
+  EXPECT_EQ(itk::MultiThreaderBase::New()->GetSlabSize(), itk::ImageRegionSplitterSlab::DefaultSlabSize);
+
+  itk::MultiThreaderBase::SetGlobalDefaultRegionScheduling(original);
+}
+
+
+TEST(MultiThreaderBase, DynamicSchedulingVisitsEachPixelOnce)
+{
+  const ImageType::RegionType region{ { { 2, -1, 0 } }, { { 13, 9, 5 } } };
+
+  for (const auto & threader : MakeMultiThreaders())
+  {
+    for (const auto scheduling : { RegionSchedulingEnum::Static, RegionSchedulingEnum::Dynamic })
+    {
+      threader->SetRegionScheduling(scheduling);
+      const auto count = MakeCountImage(region);
+      std::mutex mutex;
+      threader->ParallelizeImageRegion<3>(
+        region,
+        [&count, &mutex](const ImageType::RegionType & chunk) {
+          const std::lock_guard<std::mutex> lock(mutex);
+          for (itk::ImageRegionIterator<ImageType> it(count, chunk); !it.IsAtEnd(); ++it)
+          {
+            ++it.Value();
+          }
+        },
+        nullptr);
+      ExpectEachPixelVisitedOnce(*count);
+
+      // The same for a region of which one direction is not split.
+      const auto restrictedCount = MakeCountImage(region);
+      threader->ParallelizeImageRegionRestrictDirection<3>(
+        1,
+        region,
+        [&restrictedCount, &mutex, &region](const ImageType::RegionType & chunk) {
+          EXPECT_EQ(chunk.GetIndex(1), region.GetIndex(1));
+          EXPECT_EQ(chunk.GetSize(1), region.GetSize(1));
+          const std::lock_guard<std::mutex> lock(mutex);
+          for (itk::ImageRegionIterator<ImageType> it(restrictedCount, chunk); !it.IsAtEnd(); ++it)
+          {
+            ++it.Value();
+          }
+        },
+        nullptr);
+      ExpectEachPixelVisitedOnce(*restrictedCount);
+    }
+  }
+}
+
+
+TEST(MultiThreaderBase, CostHintOrdersChunksByDecreasingCost)
+{
+  const ImageType::RegionType region{ {}, { { 10, 10, 10 } } };
+
+  for (const auto & threader : MakeMultiThreaders())
+  {
+    threader->SetNumberOfWorkUnits(2);
+    const auto       count = MakeCountImage(region);
+    std::mutex       mutex;
+    std::vector<int> processedSlices;
+    std::atomic<int> numberOfCostCalls{ 0 };
+    threader->ParallelizeImageRegion<3>(
+      region,
+      [&count, &mutex, &processedSlices](const ImageType::RegionType & chunk) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        processedSlices.push_back(static_cast<int>(chunk.GetIndex(2)));
+        for (itk::ImageRegionIterator<ImageType> it(count, chunk); !it.IsAtEnd(); ++it)
+        {
+          ++it.Value();
+        }
+      },
+      [&numberOfCostCalls](const ImageType::RegionType & chunk) {
+        ++numberOfCostCalls;
+        return static_cast<double>(chunk.GetIndex(2));
+      },
+      nullptr);
+    ExpectEachPixelVisitedOnce(*count);
+    if (threader->GetNumberOfWorkUnits() > 1)
+    {
+      EXPECT_EQ(numberOfCostCalls, static_cast<int>(processedSlices.size()));
+
+      // The chunks of the most expensive slice are taken first by the two work units, so the first chunk reported
+      // belongs to that slice, whichever work unit reports first.
+      ASSERT_FALSE(processedSlices.empty());
+      EXPECT_EQ(processedSlices.front(), 9);
+    }
+    else
+    {
+      // A single work unit processes the region as a whole.
+      EXPECT_EQ(processedSlices.size(), 1u);
+    }
+  }
+}
+
+
+TEST(MultiThreaderBase, DynamicSchedulingPropagatesExceptions)
+{
+  const ImageType::RegionType region{ {}, { { 10, 10, 10 } } };
+
+  for (const auto & threader : MakeMultiThreaders())
+  {
+    threader->SetRegionScheduling(RegionSchedulingEnum::Dynamic);
+    EXPECT_THROW(threader->ParallelizeImageRegion<3>(
+                   region,
+                   [](const ImageType::RegionType & chunk) {
+                     if (chunk.IsInside(ImageType::IndexType{ { 0, 0, 5 } }))
+                     {
+                       itkGenericExceptionMacro("Failure in chunk " << chunk);
+                     }
+                   },
+                   nullptr),
+                 itk::ExceptionObject);
+  }
+}
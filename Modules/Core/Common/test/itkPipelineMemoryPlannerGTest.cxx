@@ -0,0 +1,247 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPipelineMemoryPlanner.h"
+#include "itkImage.h"
+#include "itkImageBufferAllocator.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageToImageFilter.h"
+#include "itkGTest.h"
+
+#include <vector>
+
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+
+// Sums its inputs plus one, into a newly allocated output.
+class SumPlusOneFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SumPlusOneFilter);
+
+  using Self = SumPlusOneFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(SumPlusOneFilter);
+
+  unsigned int NumberOfExecutions{ 0 };
+
+protected:
+  SumPlusOneFilter() = default;
+
+  void
+  GenerateData() override
+  {
+    ++NumberOfExecutions;
+    this->AllocateOutputs();
+    ImageType * const output = this->GetOutput();
+    output->FillBuffer(1.0f);
+    for (itk::ProcessObject::DataObjectPointerArraySizeType i = 0; i < this->GetNumberOfIndexedInputs(); ++i)
+    {
+      itk::ImageRegionConstIterator<ImageType> inputIt(this->GetInput(i), output->GetRequestedRegion());
+      for (itk::ImageRegionIterator<ImageType> outputIt(output, output->GetRequestedRegion()); !outputIt.IsAtEnd();
+           ++outputIt, ++inputIt)
+      {
+        outputIt.Value() += inputIt.Get();
+      }
+    }
+  }
+};
+
+ImageType::Pointer
+MakeImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(32));
+  image->AllocateInitialized();
+  return image;
+}
+
+SumPlusOneFilter::Pointer
+MakeFilter(const std::initializer_list<ImageType *> inputs)
+{
+  auto                                               filter = SumPlusOneFilter::New();
+  itk::ProcessObject::DataObjectPointerArraySizeType i = 0;
+  for (ImageType * const input : inputs)
+  {
+    filter->SetInput(i++, input);
+  }
+  return filter;
+}
+
+void
+ExpectOutputValue(const SumPlusOneFilter * filter, const float expected)
+{
+  const ImageType * const output = filter->GetOutput();
+  ASSERT_NE(output->GetBufferPointer(), nullptr);
+  for (itk::ImageRegionConstIterator<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), expected);
+  }
+}
+} // namespace
+
+
+TEST(PipelineMemoryPlanner, ReleasesIntermediateOutputsOfAChain)
+{
+  const auto image = MakeImage();
+  const auto filter1 = MakeFilter({ image });
+  const auto filter2 = MakeFilter({ filter1->GetOutput() });
+  const auto filter3 = MakeFilter({ filter2->GetOutput() });
+  const auto filter4 = MakeFilter({ filter3->GetOutput() });
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  EXPECT_THROW(planner->Update(), itk::ExceptionObject);
+  planner->SetTarget(filter4);
+  planner->Update();
+
+  EXPECT_EQ(planner->GetNumberOfReleasedDataObjects(), 3u);
+  EXPECT_TRUE(filter1->GetOutput()->GetDataReleased());
+  EXPECT_TRUE(filter2->GetOutput()->GetDataReleased());
+  EXPECT_TRUE(filter3->GetOutput()->GetDataReleased());
+  EXPECT_FALSE(filter4->GetOutput()->GetDataReleased());
+  EXPECT_FALSE(image->GetDataReleased());
+  ExpectOutputValue(filter4, 4.0f);
+
+  // As with ReleaseDataFlag, the target is up to date, and is not executed again.
+  planner->Update();
+  EXPECT_EQ(filter4->NumberOfExecutions, 1u);
+}
+
+
+TEST(PipelineMemoryPlanner, KeepsPreservedDataObjects)
+{
+  const auto               image = MakeImage();
+  const auto               filter1 = MakeFilter({ image });
+  const auto               filter2 = MakeFilter({ filter1->GetOutput() });
+  const ImageType::Pointer kept = filter2->GetOutput();
+  const auto               filter3 = MakeFilter({ kept });
+  const auto               filter4 = MakeFilter({ filter3->GetOutput() });
+  const auto               otherConsumer = MakeFilter({ filter3->GetOutput() });
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  planner->SetTarget(filter4);
+  planner->AddPreservedDataObject(kept);
+  planner->AddPreservedDataObject(filter3->GetOutput());
+  planner->Update();
+
+  EXPECT_EQ(planner->GetNumberOfReleasedDataObjects(), 1u);
+  EXPECT_TRUE(filter1->GetOutput()->GetDataReleased());
+  EXPECT_FALSE(kept->GetDataReleased());
+  ASSERT_NE(kept->GetBufferPointer(), nullptr);
+  EXPECT_EQ(kept->GetPixel({}), 2.0f);
+  EXPECT_FALSE(filter3->GetOutput()->GetDataReleased());
+  ExpectOutputValue(filter4, 4.0f);
+
+  // The other consumer uses the preserved data, without executing its source again.
+  otherConsumer->Update();
+  EXPECT_EQ(filter3->NumberOfExecutions, 1u);
+  ExpectOutputValue(otherConsumer, 4.0f);
+}
+
+
+TEST(PipelineMemoryPlanner, ReleasesDataWhichIsNotPreserved)
+{
+  const auto image = MakeImage();
+  const auto filter1 = MakeFilter({ image });
+  const auto filter2 = MakeFilter({ filter1->GetOutput() });
+  const auto filter3 = MakeFilter({ filter2->GetOutput() });
+  const auto otherConsumer = MakeFilter({ filter2->GetOutput() });
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  planner->SetTarget(filter3);
+  planner->AddPreservedDataObject(filter2->GetOutput());
+  planner->ClearPreservedDataObjects();
+  planner->Update();
+
+  EXPECT_EQ(planner->GetNumberOfReleasedDataObjects(), 2u);
+  EXPECT_TRUE(filter2->GetOutput()->GetDataReleased());
+
+  // As with ReleaseDataFlag, the released data is produced again when it is requested.
+  otherConsumer->Update();
+  EXPECT_EQ(filter2->NumberOfExecutions, 2u);
+  ExpectOutputValue(otherConsumer, 3.0f);
+}
+
+
+TEST(PipelineMemoryPlanner, ReleasesSharedDataAfterItsLastConsumer)
+{
+  const auto image = MakeImage();
+  const auto filter1 = MakeFilter({ image });
+  const auto branch1 = MakeFilter({ filter1->GetOutput() });
+  const auto branch2 = MakeFilter({ filter1->GetOutput(), image });
+  const auto merge = MakeFilter({ branch1->GetOutput(), branch2->GetOutput(), branch2->GetOutput() });
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  planner->SetTarget(merge);
+  planner->Update();
+
+  EXPECT_EQ(planner->GetNumberOfReleasedDataObjects(), 3u);
+  EXPECT_TRUE(filter1->GetOutput()->GetDataReleased());
+  EXPECT_TRUE(branch1->GetOutput()->GetDataReleased());
+  EXPECT_TRUE(branch2->GetOutput()->GetDataReleased());
+  // Released after the first branch, filter1 would have executed again for the second one.
+  EXPECT_EQ(filter1->NumberOfExecutions, 1u);
+  ExpectOutputValue(merge, 2.0f + 2.0f + 2.0f + 1.0f);
+}
+
+
+TEST(PipelineMemoryPlanner, RecyclesReleasedBuffers)
+{
+  using PolicyEnum = itk::ImageBufferAllocatorEnums::Policy;
+  const PolicyEnum original = itk::ImageBufferAllocator::GetGlobalDefaultPolicy();
+
+  const auto                             image = MakeImage();
+  std::vector<SumPlusOneFilter::Pointer> filters{ MakeFilter({ image }) };
+  for (unsigned int i = 1; i < 8; ++i)
+  {
+    filters.push_back(MakeFilter({ filters.back()->GetOutput() }));
+  }
+
+  itk::ImageBufferAllocator::ReleasePooledMemory();
+  itk::ImageBufferAllocator::ResetStatistics();
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  planner->SetTarget(filters.back());
+  EXPECT_TRUE(planner->GetReuseBuffers());
+  // The outputs of the pipeline are pooled, without changing the global default policy.
+  bool policiesChecked = false;
+  filters[4]->AddObserver(itk::StartEvent(), [&](const itk::EventObject &) {
+    EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultPolicy(), original);
+    EXPECT_EQ(filters[4]->GetOutput()->GetBulkDataAllocationPolicy(), PolicyEnum::Pooled);
+    policiesChecked = true;
+  });
+  planner->Update();
+  EXPECT_TRUE(policiesChecked);
+
+  // Every filter but the first two allocates its output in the buffer released by its grandparent.
+  const auto statistics = itk::ImageBufferAllocator::GetStatistics();
+  EXPECT_EQ(statistics.PoolMisses, 2u);
+  EXPECT_EQ(statistics.PoolHits, 6u);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultPolicy(), original);
+  EXPECT_EQ(filters.back()->GetOutput()->GetPixelContainer()->GetAllocationPolicy(), PolicyEnum::GlobalDefault);
+  EXPECT_EQ(filters.back()->GetOutput()->GetBulkDataAllocationPolicy(), PolicyEnum::GlobalDefault);
+  ExpectOutputValue(filters.back(), 8.0f);
+
+  itk::ImageBufferAllocator::ReleasePooledMemory();
+}
@@ -65,6 +65,7 @@ public:
   using typename Superclass::JacobianType;
   using typename Superclass::JacobianPositionType;
   using typename Superclass::InverseJacobianPositionType;
+  using typename Superclass::NonZeroJacobianIndicesType;
 
   /** Transform category type. */
   using typename Superclass::TransformCategoryEnum;
@@ -298,6 +299,22 @@ public:
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override = 0;
 
+  /** The Jacobian of a point only depends on the coefficients of its support
+   * region. */
+  bool
+  HasSparseJacobianWithRespectToParameters() const override
+  {
+    return true;
+  }
+
+  /** Compute the SpaceDimension * NumberOfWeights columns of the Jacobian
+   * which depend on the coefficients of the support region of the point.
+   * There are no columns for a point outside of the valid region. */
+  void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       point,
+                                               JacobianType &               jacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const override;
+
   void
   ComputeJacobianWithRespectToPosition(const InputPointType &, JacobianPositionType &) const override
   {
@@ -264,6 +264,54 @@ BSplineBaseTransform<TParametersValueType, VDimension, VSplineOrder>::
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineBaseTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &       point,
+  JacobianType &               jacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+{
+  ContinuousIndexType index =
+    this->m_CoefficientImages[0]
+      ->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(point);
+
+  // As in ComputeJacobianWithRespectToParameters, the Jacobian is zero outside of the valid region.
+  if (!this->InsideValidRegion(index))
+  {
+    jacobian.SetSize(SpaceDimension, 0);
+    nonZeroJacobianIndices.clear();
+    return;
+  }
+
+  WeightsType weights;
+  IndexType   supportIndex;
+  this->m_WeightsFunction->Evaluate(index, weights, supportIndex);
+
+  // Column d * NumberOfWeights + k is the derivative with respect to the coefficient k of the
+  // support region, in dimension d, which only moves the point along dimension d.
+  jacobian.SetSize(SpaceDimension, SpaceDimension * NumberOfWeights);
+  jacobian.Fill(0.0);
+  nonZeroJacobianIndices.resize(SpaceDimension * NumberOfWeights);
+
+  constexpr auto              supportSize = SizeType::Filled(SplineOrder + 1);
+  const RegionType            supportRegion(supportIndex, supportSize);
+  const ParametersValueType * basePointer = this->m_CoefficientImages[0]->GetBufferPointer();
+  const NumberOfParametersType numberOfParametersPerDimension = this->GetNumberOfParametersPerDimension();
+
+  unsigned int counter = 0;
+  for (ImageRegionIterator coeffIterator(this->m_CoefficientImages[0], supportRegion); !coeffIterator.IsAtEnd();
+       ++coeffIterator)
+  {
+    const auto parameterIndex = static_cast<NumberOfParametersType>(&(coeffIterator.Value()) - basePointer);
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      jacobian(d, d * NumberOfWeights + counter) = weights[counter];
+      nonZeroJacobianIndices[d * NumberOfWeights + counter] = parameterIndex + d * numberOfParametersPerDimension;
+    }
+    ++counter;
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 unsigned int
 BSplineBaseTransform<TParametersValueType, VDimension, VSplineOrder>::GetNumberOfAffectedWeights() const
@@ -124,6 +124,7 @@ public:
   using typename Superclass::JacobianType;
   using typename Superclass::JacobianPositionType;
   using typename Superclass::InverseJacobianPositionType;
+  using typename Superclass::NonZeroJacobianIndicesType;
 
   /** Transform category type. */
   using typename Superclass::TransformCategoryEnum;
@@ -399,6 +400,22 @@ public:
   virtual void
   FlattenTransformQueue();
 
+  /**
+   * Get a composite transform that maps points as this one does, with fewer
+   * sub transforms to evaluate: nested composite transforms are flattened, and
+   * each run of consecutive sub transforms derived from MatrixOffsetTransformBase
+   * is merged into a single AffineTransform. The other sub transforms are
+   * shared with this transform.
+   *
+   * The merged transforms are new transforms, which are not optimized, and
+   * which do not follow later changes to the transforms they were merged from:
+   * the flattened transform is meant for evaluating a transform that no longer
+   * changes, e.g. when resampling several images with the result of a
+   * registration.
+   */
+  Pointer
+  GetFlattenedTransform() const;
+
   /**
    * Compute the Jacobian with respect to the parameters for the composite
    * transform using Jacobian rule. See comments in the implementation.
@@ -419,6 +436,20 @@ public:
                                                           JacobianType &         outJacobian,
                                                           JacobianType &         cacheJacobian) const override;
 
+  /** The Jacobian is sparse when the Jacobian of a sub transform to optimize is sparse. */
+  bool
+  HasSparseJacobianWithRespectToParameters() const override;
+
+  /**
+   * Compute the non-zero columns of the Jacobian with respect to the
+   * parameters, from the sparse Jacobians of the sub transforms to optimize,
+   * using the Jacobian rule as ComputeJacobianWithRespectToParameters does.
+   */
+  void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       p,
+                                               JacobianType &               outJacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const override;
+
 protected:
   CompositeTransform() = default;
   ~CompositeTransform() override = default;
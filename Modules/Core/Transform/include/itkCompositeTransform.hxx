@@ -19,6 +19,7 @@
 #define itkCompositeTransform_hxx
 
 
+#include "itkAffineTransform.h"
 #include "itkPrintHelper.h"
 namespace itk
 {
@@ -591,6 +592,133 @@ CompositeTransform<TParametersValueType, VDimension>::ComputeJacobianWithRespect
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+bool
+CompositeTransform<TParametersValueType, VDimension>::HasSparseJacobianWithRespectToParameters() const
+{
+  if (this->GetNumberOfTransforms() == 1)
+  {
+    return this->GetNthTransformConstPointer(0)->HasSparseJacobianWithRespectToParameters();
+  }
+
+  for (SizeValueType tind = 0; tind < this->GetNumberOfTransforms(); ++tind)
+  {
+    if (this->GetNthTransformToOptimize(tind) &&
+        this->GetNthTransformConstPointer(tind)->HasSparseJacobianWithRespectToParameters())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &       p,
+  JacobianType &               outJacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+{
+  if (this->GetNumberOfTransforms() == 1)
+  {
+    const TransformType * const transform = this->GetNthTransformConstPointer(0);
+    transform->ComputeSparseJacobianWithRespectToParameters(p, outJacobian, nonZeroJacobianIndices);
+    return;
+  }
+
+  // The sparse Jacobians of the sub transforms, with the first of their columns and the offset of their parameters,
+  // and the Jacobians with respect to the position of the sub transforms. The buffers are reused from point to point,
+  // as this is called once per point.
+  struct SparseJacobianBuffers
+  {
+    std::vector<JacobianType>               SubJacobians;
+    std::vector<NonZeroJacobianIndicesType> SubIndices;
+    std::vector<unsigned int>               FirstColumns;
+    std::vector<NumberOfParametersType>     Offsets;
+    std::vector<JacobianPositionType>       PositionJacobians;
+  };
+  thread_local SparseJacobianBuffers buffers;
+
+  const SizeValueType numberOfTransforms = this->GetNumberOfTransforms();
+  if (buffers.SubJacobians.size() < numberOfTransforms)
+  {
+    buffers.SubJacobians.resize(numberOfTransforms);
+    buffers.SubIndices.resize(numberOfTransforms);
+    buffers.FirstColumns.resize(numberOfTransforms);
+    buffers.Offsets.resize(numberOfTransforms);
+    buffers.PositionJacobians.resize(numberOfTransforms);
+  }
+
+  // Same loop as ComputeJacobianWithRespectToParametersCachedTemporaries, on the non-zero columns only: the columns
+  // of each sub transform to optimize follow those of the transforms applied before it, with the indices of its
+  // parameters shifted by its offset.
+  NumberOfParametersType offset{};
+  unsigned int           numberOfColumns = 0;
+  OutputPointType        transformedPoint(p);
+  for (SizeValueType tind = numberOfTransforms; tind-- > 0;)
+  {
+    const TransformType * const transform = this->GetNthTransformConstPointer(tind);
+
+    // The columns of the previous transforms are to be left multiplied by dTk / dT{k-1}.
+    if (numberOfColumns > 0)
+    {
+      transform->ComputeJacobianWithRespectToPosition(transformedPoint, buffers.PositionJacobians[tind]);
+    }
+
+    buffers.SubIndices[tind].clear();
+    buffers.FirstColumns[tind] = numberOfColumns;
+    buffers.Offsets[tind] = offset;
+    if (this->GetNthTransformToOptimize(tind))
+    {
+      transform->ComputeSparseJacobianWithRespectToParameters(
+        transformedPoint, buffers.SubJacobians[tind], buffers.SubIndices[tind]);
+      numberOfColumns += static_cast<unsigned int>(buffers.SubIndices[tind].size());
+      offset += transform->GetNumberOfLocalParameters();
+    }
+
+    if (tind > 0)
+    {
+      transformedPoint = transform->TransformPoint(transformedPoint);
+    }
+  }
+
+  // Fill the columns of each sub transform, left multiplied by the product of the Jacobians with respect to the
+  // position of the transforms applied after it, from the first transform of the queue, which is applied last.
+  outJacobian.SetSize(VDimension, numberOfColumns);
+  nonZeroJacobianIndices.resize(numberOfColumns);
+
+  JacobianPositionType chainJacobian;
+  chainJacobian.set_identity();
+  for (SizeValueType tind = 0; tind < numberOfTransforms; ++tind)
+  {
+    const JacobianType &               subJacobian = buffers.SubJacobians[tind];
+    const NonZeroJacobianIndicesType & subIndices = buffers.SubIndices[tind];
+    const unsigned int                 firstColumn = buffers.FirstColumns[tind];
+    for (unsigned int c = 0; c < subIndices.size(); ++c)
+    {
+      for (unsigned int r = 0; r < VDimension; ++r)
+      {
+        double value = 0.0;
+        for (unsigned int k = 0; k < VDimension; ++k)
+        {
+          value += chainJacobian[r][k] * subJacobian[k][c];
+        }
+        outJacobian[r][firstColumn + c] = value;
+      }
+      nonZeroJacobianIndices[firstColumn + c] = subIndices[c] + buffers.Offsets[tind];
+    }
+
+    if (firstColumn == 0)
+    {
+      // The transforms applied before have no columns.
+      break;
+    }
+    chainJacobian = chainJacobian * buffers.PositionJacobians[tind];
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 CompositeTransform<TParametersValueType, VDimension>::GetParameters() const -> const ParametersType &
@@ -942,6 +1070,74 @@ CompositeTransform<TParametersValueType, VDimension>::FlattenTransformQueue()
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CompositeTransform<TParametersValueType, VDimension>::GetFlattenedTransform() const -> Pointer
+{
+  using MatrixOffsetTransformType = MatrixOffsetTransformBase<TParametersValueType, VDimension, VDimension>;
+  using AffineTransformType = AffineTransform<TParametersValueType, VDimension>;
+
+  // Flatten a copy of the queue, so that this transform is unchanged.
+  auto nestedTransform = Self::New();
+  for (SizeValueType n = 0; n < this->GetNumberOfTransforms(); ++n)
+  {
+    const auto * nestedCompositeTransform = dynamic_cast<const Self *>(this->m_TransformQueue[n].GetPointer());
+    if (nestedCompositeTransform)
+    {
+      const Pointer flattenedNestedTransform = nestedCompositeTransform->GetFlattenedTransform();
+      for (SizeValueType m = 0; m < flattenedNestedTransform->GetNumberOfTransforms(); ++m)
+      {
+        nestedTransform->AddTransform(flattenedNestedTransform->GetNthTransformModifiablePointer(m));
+        nestedTransform->SetNthTransformToOptimize(nestedTransform->GetNumberOfTransforms() - 1,
+                                                   flattenedNestedTransform->GetNthTransformToOptimize(m));
+      }
+    }
+    else
+    {
+      nestedTransform->AddTransform(this->m_TransformQueue[n]);
+      nestedTransform->SetNthTransformToOptimize(nestedTransform->GetNumberOfTransforms() - 1,
+                                                 this->GetNthTransformToOptimize(n));
+    }
+  }
+
+  // The transforms are applied from the back of the queue to the front, so a run
+  // T_a, ..., T_b of matrix offset transforms is merged into T_a o ... o T_b.
+  auto          flattenedTransform = Self::New();
+  SizeValueType n = 0;
+  while (n < nestedTransform->GetNumberOfTransforms())
+  {
+    SizeValueType runEnd = n;
+    while (runEnd < nestedTransform->GetNumberOfTransforms() &&
+           dynamic_cast<const MatrixOffsetTransformType *>(nestedTransform->GetNthTransformConstPointer(runEnd)))
+    {
+      ++runEnd;
+    }
+
+    if (runEnd > n + 1)
+    {
+      auto mergedTransform = AffineTransformType::New();
+      for (SizeValueType m = n; m < runEnd; ++m)
+      {
+        mergedTransform->Compose(
+          static_cast<const MatrixOffsetTransformType *>(nestedTransform->GetNthTransformConstPointer(m)), true);
+      }
+      flattenedTransform->AddTransform(mergedTransform);
+      flattenedTransform->SetNthTransformToOptimizeOff(flattenedTransform->GetNumberOfTransforms() - 1);
+      n = runEnd;
+    }
+    else
+    {
+      flattenedTransform->AddTransform(nestedTransform->GetNthTransformModifiablePointer(n));
+      flattenedTransform->SetNthTransformToOptimize(flattenedTransform->GetNumberOfTransforms() - 1,
+                                                    nestedTransform->GetNthTransformToOptimize(n));
+      ++n;
+    }
+  }
+
+  return flattenedTransform;
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 void
 CompositeTransform<TParametersValueType, VDimension>::PrintSelf(std::ostream & os, Indent indent) const
@@ -28,6 +28,9 @@
 #include "vnl/vnl_matrix_fixed.h"
 #include "itkMatrix.h"
 
+#include <numeric>
+#include <vector>
+
 namespace itk
 {
 /**
@@ -173,6 +176,9 @@ public:
 
   using typename Superclass::NumberOfParametersType;
 
+  /** Type of the indices, in the local parameters, of the columns of a sparse Jacobian. */
+  using NonZeroJacobianIndicesType = std::vector<NumberOfParametersType>;
+
   /**  Method to transform a point.
    * \warning This method must be thread-safe. See, e.g., its use
    * in ResampleImageFilter.
@@ -506,6 +512,36 @@ public:
     this->ComputeJacobianWithRespectToParameters(p, jacobian);
   }
 
+  /** Whether the Jacobian with respect to the parameters is sparse, i.e.
+   * whether at any point, most parameters do not change the transformed point,
+   * as for the parameters of transforms with a compact support, e.g.
+   * BSplineTransform. When true, ComputeSparseJacobianWithRespectToParameters
+   * computes the few columns of the Jacobian which may be non-zero, at a cost
+   * independent of the number of parameters. */
+  virtual bool
+  HasSparseJacobianWithRespectToParameters() const
+  {
+    return false;
+  }
+
+  /** Compute the columns of the Jacobian with respect to the local parameters
+   * which may be non-zero at the point, and their indices in the local
+   * parameters: column \c c of \c jacobian is column \c nonZeroJacobianIndices[c]
+   * of the full Jacobian, and the other columns of the full Jacobian are zero.
+   *
+   * The default implementation computes the full Jacobian, with all the
+   * indices. \c jacobian and \c nonZeroJacobianIndices are assumed to be
+   * thread-local variables, and are resized internally. */
+  virtual void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       p,
+                                               JacobianType &               jacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+  {
+    this->ComputeJacobianWithRespectToParameters(p, jacobian);
+    nonZeroJacobianIndices.resize(jacobian.cols());
+    std::iota(nonZeroJacobianIndices.begin(), nonZeroJacobianIndices.end(), NumberOfParametersType{ 0 });
+  }
+
 
   /** This provides the ability to get a local jacobian value
    *  in a dense/local transform, e.g. DisplacementFieldTransform. For such
@@ -21,6 +21,8 @@
 #include "itkGTest.h"
 #include "itkBSplineTransform.h"
 
+#include "itkAffineTransform.h"
+#include "itkCompositeTransform.h"
 #include "itkImageBufferRange.h"
 #include "itkImageRegionConstIterator.h"
 
@@ -84,6 +86,40 @@ bspline_eq(const itk::BSplineTransform<TParametersValueType, VDimension, VSpline
   }
 }
 
+
+// Expands the sparse Jacobian of the transform at the point, and checks that it is its full Jacobian.
+template <typename TTransform>
+void
+ExpectSparseJacobianEqualsJacobian(const TTransform & transform, const typename TTransform::InputPointType & point)
+{
+  typename TTransform::JacobianType jacobian;
+  transform.ComputeJacobianWithRespectToParameters(point, jacobian);
+
+  typename TTransform::JacobianType               sparseJacobian;
+  typename TTransform::NonZeroJacobianIndicesType nonZeroJacobianIndices;
+  transform.ComputeSparseJacobianWithRespectToParameters(point, sparseJacobian, nonZeroJacobianIndices);
+  ASSERT_EQ(sparseJacobian.rows(), jacobian.rows());
+  ASSERT_EQ(sparseJacobian.cols(), nonZeroJacobianIndices.size());
+
+  typename TTransform::JacobianType expandedJacobian(jacobian.rows(), jacobian.cols());
+  expandedJacobian.Fill(0.0);
+  for (unsigned int k = 0; k < nonZeroJacobianIndices.size(); ++k)
+  {
+    ASSERT_LT(nonZeroJacobianIndices[k], jacobian.cols());
+    for (unsigned int d = 0; d < jacobian.rows(); ++d)
+    {
+      expandedJacobian(d, nonZeroJacobianIndices[k]) += sparseJacobian(d, k);
+    }
+  }
+  for (unsigned int d = 0; d < jacobian.rows(); ++d)
+  {
+    for (unsigned int p = 0; p < jacobian.cols(); ++p)
+    {
+      EXPECT_NEAR(expandedJacobian(d, p), jacobian(d, p), 1e-12) << "point: " << point << ", parameter: " << p;
+    }
+  }
+}
+
 } // namespace
 
 TEST(ITKBSplineTransform, Construction)
@@ -201,3 +237,96 @@ TEST(ITKBSplineTransform, NumberOfWeights)
   testNumberOfWeights(*itk::BSplineTransform<float, 2>::New());
   testNumberOfWeights(*itk::BSplineTransform<float, 2, 2>::New());
 }
+
+
+TEST(ITKBSplineTransform, SparseJacobianWithRespectToParameters)
+{
+  using BSplineType = itk::BSplineTransform<double, 2, 3>;
+  using PointType = BSplineType::InputPointType;
+
+  auto bspline = BSplineType::New();
+  bspline->SetTransformDomainOrigin(itk::MakePoint(-1.0, 2.0));
+  bspline->SetTransformDomainPhysicalDimensions(itk::MakeVector(20.0, 30.0));
+  bspline->SetTransformDomainMeshSize(itk::MakeSize(5, 6));
+  BSplineType::ParametersType parameters(bspline->GetNumberOfParameters());
+  for (unsigned int p = 0; p < parameters.size(); ++p)
+  {
+    parameters[p] = 0.01 * static_cast<double>(p % 17);
+  }
+  bspline->SetParameters(parameters);
+
+  EXPECT_TRUE(bspline->HasSparseJacobianWithRespectToParameters());
+
+  BSplineType::JacobianType                sparseJacobian;
+  BSplineType::NonZeroJacobianIndicesType nonZeroJacobianIndices;
+  bspline->ComputeSparseJacobianWithRespectToParameters(
+    itk::MakePoint(4.5, 10.0), sparseJacobian, nonZeroJacobianIndices);
+  EXPECT_EQ(nonZeroJacobianIndices.size(), 2 * BSplineType::NumberOfWeights);
+
+  // Outside of the transform domain, the Jacobian is zero.
+  bspline->ComputeSparseJacobianWithRespectToParameters(
+    itk::MakePoint(-30.0, 10.0), sparseJacobian, nonZeroJacobianIndices);
+  EXPECT_TRUE(nonZeroJacobianIndices.empty());
+
+  for (const PointType & point : { itk::MakePoint(4.5, 10.0),
+                                   itk::MakePoint(-1.0, 2.0),
+                                   itk::MakePoint(18.9, 31.9),
+                                   itk::MakePoint(7.25, 2.5),
+                                   itk::MakePoint(-30.0, 10.0) })
+  {
+    ExpectSparseJacobianEqualsJacobian(*bspline, point);
+  }
+
+  // An affine transform has a dense Jacobian: all its columns are returned.
+  using AffineType = itk::AffineTransform<double, 2>;
+  auto affine = AffineType::New();
+  affine->Rotate2D(0.2);
+  affine->Translate(itk::MakeVector(1.5, -2.0));
+  EXPECT_FALSE(affine->HasSparseJacobianWithRespectToParameters());
+  ExpectSparseJacobianEqualsJacobian(*affine, itk::MakePoint(4.5, 10.0));
+
+  // The Jacobian of a composite transform, of the affine transform applied after the B-spline transform.
+  using CompositeType = itk::CompositeTransform<double, 2>;
+  auto composite = CompositeType::New();
+  composite->AddTransform(affine);
+  composite->AddTransform(bspline);
+  EXPECT_TRUE(composite->HasSparseJacobianWithRespectToParameters());
+  for (const PointType & point : { itk::MakePoint(4.5, 10.0), itk::MakePoint(7.25, 2.5), itk::MakePoint(-30.0, 10.0) })
+  {
+    ExpectSparseJacobianEqualsJacobian(*composite, point);
+  }
+
+  // Only the columns of the B-spline transform, when the affine transform is not optimized.
+  composite->SetNthTransformToOptimizeOff(0);
+  ExpectSparseJacobianEqualsJacobian(*composite, itk::MakePoint(4.5, 10.0));
+  composite->ComputeSparseJacobianWithRespectToParameters(
+    itk::MakePoint(4.5, 10.0), sparseJacobian, nonZeroJacobianIndices);
+  EXPECT_EQ(nonZeroJacobianIndices.size(), 2 * BSplineType::NumberOfWeights);
+
+  // No sparse Jacobian, when only the affine transform is optimized.
+  composite->SetNthTransformToOptimizeOn(0);
+  composite->SetNthTransformToOptimizeOff(1);
+  EXPECT_FALSE(composite->HasSparseJacobianWithRespectToParameters());
+  ExpectSparseJacobianEqualsJacobian(*composite, itk::MakePoint(4.5, 10.0));
+
+  // A longer chain, of two affine transforms applied after the B-spline transform, with either transform not
+  // optimized. The B-spline transform has no Jacobian with respect to the position, so it is applied first.
+  auto otherAffine = AffineType::New();
+  otherAffine->Scale(1.1);
+  otherAffine->Translate(itk::MakeVector(-0.5, 1.0));
+  auto chain = CompositeType::New();
+  chain->AddTransform(affine);
+  chain->AddTransform(otherAffine);
+  chain->AddTransform(bspline);
+  for (unsigned int notOptimized = 0; notOptimized <= 3; ++notOptimized)
+  {
+    for (unsigned int n = 0; n < 3; ++n)
+    {
+      chain->SetNthTransformToOptimize(n, n != notOptimized);
+    }
+    for (const PointType & point : { itk::MakePoint(4.5, 10.0), itk::MakePoint(7.25, 2.5) })
+    {
+      ExpectSparseJacobianEqualsJacobian(*chain, point);
+    }
+  }
+}
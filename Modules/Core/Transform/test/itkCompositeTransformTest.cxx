@@ -17,6 +17,7 @@
  *=========================================================================*/
 
 #include <iostream>
+#include <vector>
 
 #include "itkAffineTransform.h"
 #include "itkCompositeTransform.h"
@@ -912,6 +913,63 @@ itkCompositeTransformTest(int, char *[])
     return EXIT_FAILURE;
   }
 
+  /*
+   * Test the flattened transform, in which nested composite transforms are
+   * flattened and consecutive matrix offset transforms are merged.
+   */
+  {
+    std::cout << "Test GetFlattenedTransform." << std::endl;
+    std::vector<AffineType::Pointer> affines;
+    for (unsigned int n = 0; n < 5; ++n)
+    {
+      auto stage = AffineType::New();
+      stage->Rotate2D(0.1 + 0.2 * n);
+      stage->Scale(1.0 + 0.05 * n);
+      AffineType::OutputVectorType translation;
+      translation[0] = 1.0 + n;
+      translation[1] = -2.0 * n;
+      stage->Translate(translation);
+      affines.push_back(stage);
+    }
+    auto translationTransform = TranslationTransformType::New();
+    TranslationTransformType::ParametersType translationParameters(VDimension);
+    translationParameters.Fill(0.5);
+    translationTransform->SetParameters(translationParameters);
+
+    auto nestedTransform = CompositeType::New();
+    nestedTransform->AddTransform(affines[2]);
+    nestedTransform->AddTransform(affines[3]);
+
+    auto transform = CompositeType::New();
+    transform->AddTransform(affines[0]);
+    transform->AddTransform(affines[1]);
+    transform->AddTransform(nestedTransform);
+    transform->AddTransform(translationTransform);
+    transform->AddTransform(affines[4]);
+
+    const CompositeType::Pointer flattenedTransform = transform->GetFlattenedTransform();
+    ITK_TEST_EXPECT_EQUAL(flattenedTransform->GetNumberOfTransforms(), 3);
+    ITK_TEST_EXPECT_EQUAL(transform->GetNumberOfTransforms(), 5);
+    ITK_TEST_EXPECT_EQUAL(nestedTransform->GetNumberOfTransforms(), 2);
+    ITK_TEST_EXPECT_TRUE(!flattenedTransform->GetNthTransformToOptimize(0));
+    ITK_TEST_EXPECT_TRUE(flattenedTransform->GetNthTransformConstPointer(1) == translationTransform.GetPointer());
+    ITK_TEST_EXPECT_TRUE(flattenedTransform->GetNthTransformConstPointer(2) == affines[4].GetPointer());
+    ITK_TEST_EXPECT_TRUE(flattenedTransform->GetNthTransformToOptimize(2));
+
+    for (const double x : { -3.0, 0.0, 7.5 })
+    {
+      CompositeType::InputPointType point;
+      point[0] = x;
+      point[1] = 2.0 - 0.5 * x;
+      if (!testPoint(flattenedTransform->TransformPoint(point), transform->TransformPoint(point)))
+      {
+        std::cerr << "Flattened transform maps " << point << " to " << flattenedTransform->TransformPoint(point)
+                  << " instead of " << transform->TransformPoint(point) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
   /* Test SetParameters with wrong size array */
   std::cout << "Test SetParameters with wrong size array." << std::endl;
   parametersTruth.SetSize(1);
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCachedDisplacementFieldTransform_h
+#define itkCachedDisplacementFieldTransform_h
+
+#include "itkDisplacementFieldTransform.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+
+/** \class CachedDisplacementFieldTransform
+ * \brief Caches another transform as a displacement field sampled on a grid.
+ *
+ * Evaluating a transform made of several stages, e.g. a CompositeTransform of
+ * affine transforms and of a displacement field transform, evaluates each of
+ * the stages at each point. When the same transform is applied to several
+ * images, this transform samples it once on a grid, the grid of its
+ * displacement field, and then transforms each point with a single lookup in
+ * the displacement field.
+ *
+ * The grid is set with SetFixedParameters(), or by SetDisplacementField(),
+ * whose field is then overwritten. The cached transform is sampled again
+ * whenever it, or one of its sub transforms when it is a CompositeTransform or
+ * another MultiTransform, has been modified since it was last sampled:
+ * explicitly by UpdateDisplacementField(), which samples with several
+ * threads, or else by the first point transformed afterwards. A
+ * CompositeTransform is sampled through its flattened transform, see
+ * CompositeTransform::GetFlattenedTransform().
+ *
+ * Points outside the grid are transformed by the cached transform itself.
+ * The displacement field is interpolated, so within the grid the transform
+ * approximates the cached transform to the accuracy allowed by the spacing of
+ * the grid.
+ *
+ * This transform is meant for applying a transform, e.g. with
+ * ResampleImageFilter, not for optimizing it.
+ *
+ * \sa TransformToDisplacementFieldFilter
+ *
+ * \ingroup ITKDisplacementField
+ */
+template <typename TParametersValueType, unsigned int VDimension>
+class ITK_TEMPLATE_EXPORT CachedDisplacementFieldTransform
+  : public DisplacementFieldTransform<TParametersValueType, VDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CachedDisplacementFieldTransform);
+
+  /** Standard class type aliases. */
+  using Self = CachedDisplacementFieldTransform;
+  using Superclass = DisplacementFieldTransform<TParametersValueType, VDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(CachedDisplacementFieldTransform);
+
+  /** New macro for creation of through a Smart Pointer */
+  itkNewMacro(Self);
+
+  /** Types from superclass */
+  using typename Superclass::InputPointType;
+  using typename Superclass::OutputPointType;
+  using typename Superclass::JacobianPositionType;
+  using typename Superclass::InverseJacobianPositionType;
+  using typename Superclass::DisplacementFieldType;
+  using typename Superclass::InterpolatorType;
+  using typename Superclass::RegionType;
+
+  /** Type of the cached transform. */
+  using TransformType = Transform<TParametersValueType, VDimension, VDimension>;
+
+  /** Set/Get the cached transform. */
+  /** @ITKStartGrouping */
+  virtual void
+  SetCachedTransform(const TransformType * transform);
+  itkGetConstObjectMacro(CachedTransform, TransformType);
+  /** @ITKEndGrouping */
+
+  /** Sample the cached transform on the grid of the displacement field, with
+   * several threads, if it was modified since it was last sampled. */
+  void
+  UpdateDisplacementField();
+
+  /** Whether the cached transform, or one of its sub transforms, was modified
+   * since it was last sampled, or the displacement field was replaced. */
+  bool
+  IsCachedTransformModified() const;
+
+  /** Transform a point by the displacement field within its grid, and by the
+   * cached transform outside. The displacement field is updated first. */
+  OutputPointType
+  TransformPoint(const InputPointType & inputPoint) const override;
+
+  /** Compute the Jacobians with respect to the position, of the displacement
+   * field within its grid, and of the cached transform outside. The
+   * displacement field is updated first. */
+  /** @ITKStartGrouping */
+  void
+  ComputeJacobianWithRespectToPosition(const InputPointType & point, JacobianPositionType & jacobian) const override;
+  using Superclass::ComputeJacobianWithRespectToPosition;
+
+  void
+  ComputeInverseJacobianWithRespectToPosition(const InputPointType &        point,
+                                              InverseJacobianPositionType & jacobian) const override;
+  using Superclass::ComputeInverseJacobianWithRespectToPosition;
+  /** @ITKEndGrouping */
+
+protected:
+  CachedDisplacementFieldTransform() = default;
+  ~CachedDisplacementFieldTransform() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Clone the current transform */
+  [[nodiscard]] LightObject::Pointer
+  InternalClone() const override;
+
+private:
+  using TransformListType = std::vector<typename TransformType::ConstPointer>;
+
+  /** Sample the cached transform if it was modified, in a thread safe way,
+   * with several threads. \c lazily tells that a point is being
+   * transformed. */
+  void
+  UpdateDisplacementFieldIfModified(bool lazily) const;
+
+  /** Append the transform and, recursively, its sub transforms to the list. */
+  static void
+  AppendTransformAndSubTransforms(const TransformType * transform, TransformListType & transforms);
+
+  /** Whether the point is inside the buffer of the displacement field. */
+  bool
+  IsInsideDisplacementField(const InputPointType & inputPoint) const;
+
+  typename TransformType::ConstPointer m_CachedTransform{};
+
+  /** The latest modification time of the cached transform and of its sub
+   * transforms, and the time the displacement field was set, when the cached
+   * transform was last sampled. */
+  mutable std::atomic<ModifiedTimeType> m_SampledTransformTime{ 0 };
+  mutable std::atomic<ModifiedTimeType> m_SampledDisplacementFieldSetTime{ 0 };
+
+  /** The cached transform and its sub transforms when it was last sampled,
+   * whose modification times are checked at each transformed point. A list
+   * is added when the sub transforms change, and the previous ones are kept
+   * until the cached transform is set, as concurrent calls may still read
+   * them. */
+  mutable std::deque<TransformListType>           m_SampledTransformLists{};
+  mutable std::atomic<const TransformListType *> m_SampledTransforms{ nullptr };
+
+  /** Serializes the sampling of the cached transform by concurrent calls. */
+  mutable std::mutex m_SamplingMutex{};
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCachedDisplacementFieldTransform.hxx"
+#endif
+
+#endif // itkCachedDisplacementFieldTransform_h
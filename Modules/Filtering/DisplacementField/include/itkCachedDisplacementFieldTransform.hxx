@@ -0,0 +1,270 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCachedDisplacementFieldTransform_hxx
+#define itkCachedDisplacementFieldTransform_hxx
+
+#include "itkCompositeTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
+#include "itkPlatformMultiThreader.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::SetCachedTransform(const TransformType * transform)
+{
+  if (this->m_CachedTransform != transform)
+  {
+    this->m_CachedTransform = transform;
+    // The new transform may be older than the sampled one.
+    this->m_SampledTransforms = nullptr;
+    this->m_SampledTransformLists.clear();
+    this->m_SampledTransformTime = 0;
+    this->Modified();
+  }
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::AppendTransformAndSubTransforms(
+  const TransformType * transform,
+  TransformListType &   transforms)
+{
+  transforms.push_back(transform);
+
+  // The modification time of a multi transform does not include the one of its
+  // sub transforms.
+  using MultiTransformType = MultiTransform<TParametersValueType, VDimension, VDimension>;
+  if (const auto * multiTransform = dynamic_cast<const MultiTransformType *>(transform))
+  {
+    for (SizeValueType n = 0; n < multiTransform->GetNumberOfTransforms(); ++n)
+    {
+      AppendTransformAndSubTransforms(multiTransform->GetNthTransformConstPointer(n), transforms);
+    }
+  }
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+bool
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::IsCachedTransformModified() const
+{
+  if (this->m_CachedTransform.IsNull() || this->m_DisplacementField.IsNull())
+  {
+    return false;
+  }
+  if (this->m_DisplacementFieldSetTime != this->m_SampledDisplacementFieldSetTime)
+  {
+    return true;
+  }
+
+  // A multi transform is modified when its sub transforms are added or removed, so the transforms of the last
+  // sampling are the ones to check, without walking the cached transform again.
+  const TransformListType * const transforms = this->m_SampledTransforms;
+  if (transforms == nullptr)
+  {
+    return true;
+  }
+  const ModifiedTimeType sampledTransformTime = this->m_SampledTransformTime;
+  return std::any_of(transforms->cbegin(), transforms->cend(), [sampledTransformTime](const auto & transform) {
+    return transform->GetMTime() > sampledTransformTime;
+  });
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::UpdateDisplacementField()
+{
+  this->UpdateDisplacementFieldIfModified(false);
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::UpdateDisplacementFieldIfModified(
+  bool lazily) const
+{
+  if (!this->IsCachedTransformModified())
+  {
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lockGuard(m_SamplingMutex);
+  if (!this->IsCachedTransformModified())
+  {
+    // Sampled by another thread meanwhile.
+    return;
+  }
+
+  TransformListType transforms;
+  AppendTransformAndSubTransforms(this->m_CachedTransform, transforms);
+  ModifiedTimeType transformTime = 0;
+  for (const auto & subTransform : transforms)
+  {
+    transformTime = std::max(transformTime, subTransform->GetMTime());
+  }
+
+  // Sample a composite transform through its flattened transform.
+  using CompositeTransformType = CompositeTransform<TParametersValueType, VDimension>;
+  typename TransformType::ConstPointer transform = this->m_CachedTransform;
+  if (const auto * compositeTransform = dynamic_cast<const CompositeTransformType *>(transform.GetPointer()))
+  {
+    transform = compositeTransform->GetFlattenedTransform().GetPointer();
+  }
+
+  DisplacementFieldType * field = this->m_DisplacementField;
+  auto                    sampler = [field, &transform](const RegionType & region) {
+    for (ImageRegionIteratorWithIndex<DisplacementFieldType> it(field, region); !it.IsAtEnd(); ++it)
+    {
+      InputPointType point;
+      field->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+      it.Set(transform->TransformPoint(point) - point);
+    }
+  };
+
+  // A lazy sampling runs while transforming a point, possibly in a work unit of the thread pool, while the other
+  // work units wait for the mutex: sample on threads of its own, so as not to wait for work units of the pool.
+  const MultiThreaderBase::Pointer multiThreader =
+    lazily ? MultiThreaderBase::Pointer(PlatformMultiThreader::New()) : MultiThreaderBase::New();
+  multiThreader->template ParallelizeImageRegion<VDimension>(field->GetBufferedRegion(), sampler, nullptr);
+  field->Modified();
+
+  const TransformListType * const sampledTransforms = this->m_SampledTransforms;
+  if (sampledTransforms == nullptr || *sampledTransforms != transforms)
+  {
+    this->m_SampledTransformLists.push_back(std::move(transforms));
+    this->m_SampledTransforms = &this->m_SampledTransformLists.back();
+  }
+  this->m_SampledDisplacementFieldSetTime = this->m_DisplacementFieldSetTime;
+  this->m_SampledTransformTime = transformTime;
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+bool
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::IsInsideDisplacementField(
+  const InputPointType & inputPoint) const
+{
+  typename InterpolatorType::PointType point;
+  point.CastFrom(inputPoint);
+  return this->m_Interpolator->IsInsideBuffer(point);
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoint(
+  const InputPointType & inputPoint) const -> OutputPointType
+{
+  if (this->m_CachedTransform.IsNull() || this->m_DisplacementField.IsNull() || this->m_Interpolator.IsNull())
+  {
+    return Superclass::TransformPoint(inputPoint);
+  }
+
+  this->UpdateDisplacementFieldIfModified(true);
+
+  typename InterpolatorType::PointType point;
+  point.CastFrom(inputPoint);
+  const typename InterpolatorType::ContinuousIndexType cidx =
+    this->m_DisplacementField
+      ->template TransformPhysicalPointToContinuousIndex<typename InterpolatorType::ContinuousIndexType::ValueType>(
+        point);
+  if (!this->m_Interpolator->IsInsideBuffer(cidx))
+  {
+    return this->m_CachedTransform->TransformPoint(inputPoint);
+  }
+
+  const typename InterpolatorType::OutputType displacement = this->m_Interpolator->EvaluateAtContinuousIndex(cidx);
+  OutputPointType                             outputPoint;
+  outputPoint.CastFrom(inputPoint);
+  for (unsigned int ii = 0; ii < VDimension; ++ii)
+  {
+    outputPoint[ii] += displacement[ii];
+  }
+  return outputPoint;
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::ComputeJacobianWithRespectToPosition(
+  const InputPointType & point,
+  JacobianPositionType & jacobian) const
+{
+  if (this->m_CachedTransform.IsNotNull() && this->m_DisplacementField.IsNotNull() && this->m_Interpolator.IsNotNull())
+  {
+    this->UpdateDisplacementFieldIfModified(true);
+    if (!this->IsInsideDisplacementField(point))
+    {
+      this->m_CachedTransform->ComputeJacobianWithRespectToPosition(point, jacobian);
+      return;
+    }
+  }
+  Superclass::ComputeJacobianWithRespectToPosition(point, jacobian);
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::ComputeInverseJacobianWithRespectToPosition(
+  const InputPointType &        point,
+  InverseJacobianPositionType & jacobian) const
+{
+  if (this->m_CachedTransform.IsNotNull() && this->m_DisplacementField.IsNotNull() && this->m_Interpolator.IsNotNull())
+  {
+    this->UpdateDisplacementFieldIfModified(true);
+    if (!this->IsInsideDisplacementField(point))
+    {
+      this->m_CachedTransform->ComputeInverseJacobianWithRespectToPosition(point, jacobian);
+      return;
+    }
+  }
+  Superclass::ComputeInverseJacobianWithRespectToPosition(point, jacobian);
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+LightObject::Pointer
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+
+  //
+  // set fields not in the fixed parameters.
+  rval->SetCachedTransform(this->m_CachedTransform);
+
+  return loPtr;
+}
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CachedDisplacementFieldTransform<TParametersValueType, VDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(CachedTransform);
+  os << indent << "SampledTransformTime: " << m_SampledTransformTime << std::endl;
+  os << indent << "SampledDisplacementFieldSetTime: " << m_SampledDisplacementFieldSetTime << std::endl;
+}
+} // namespace itk
+
+#endif
@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkCachedDisplacementFieldTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTestingMacros.h"
+
+#include <atomic>
+#include <cmath>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using CompositeTransformType = itk::CompositeTransform<double, Dimension>;
+using CachedTransformType = itk::CachedDisplacementFieldTransform<double, Dimension>;
+using PointType = CachedTransformType::InputPointType;
+
+// Compare the cached transform with the composite transform at the points of
+// the grid, where the displacement field is not interpolated.
+bool
+MatchesOnGrid(const CachedTransformType * cachedTransform, const CompositeTransformType * transform)
+{
+  const auto *          field = cachedTransform->GetDisplacementField();
+  const itk::SizeValueType numberOfPixels = field->GetBufferedRegion().GetNumberOfPixels();
+  std::atomic<unsigned int> numberOfMismatches{ 0 };
+
+  // Transform the points concurrently, as ResampleImageFilter does.
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfPixels,
+    [&](itk::SizeValueType i) {
+      PointType point;
+      field->TransformIndexToPhysicalPoint(field->ComputeIndex(i), point);
+      const PointType expectedPoint = transform->TransformPoint(point);
+      const PointType cachedPoint = cachedTransform->TransformPoint(point);
+      if (expectedPoint.EuclideanDistanceTo(cachedPoint) > 1e-9)
+      {
+        ++numberOfMismatches;
+      }
+    },
+    nullptr);
+
+  if (numberOfMismatches > 0)
+  {
+    std::cerr << numberOfMismatches << " grid points are transformed differently." << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkCachedDisplacementFieldTransformTest(int, char *[])
+{
+  auto cachedTransform = CachedTransformType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(cachedTransform, CachedDisplacementFieldTransform, DisplacementFieldTransform);
+
+  // A composite transform of affine transforms and of a displacement field.
+  using AffineTransformType = itk::AffineTransform<double, Dimension>;
+  auto firstAffineTransform = AffineTransformType::New();
+  firstAffineTransform->Rotate2D(0.2);
+  auto secondAffineTransform = AffineTransformType::New();
+  secondAffineTransform->Scale(1.1);
+  auto lastAffineTransform = AffineTransformType::New();
+  lastAffineTransform->Translate(itk::MakeVector(2.0, -1.0));
+
+  using DisplacementFieldTransformType = itk::DisplacementFieldTransform<double, Dimension>;
+  using FieldType = DisplacementFieldTransformType::DisplacementFieldType;
+  auto field = FieldType::New();
+  field->SetRegions(itk::MakeSize(60, 60));
+  field->SetOrigin(itk::MakePoint(-30.0, -30.0));
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<FieldType> it(field, field->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(itk::MakeVector(std::sin(0.1 * it.GetIndex()[1]), 0.5 * std::cos(0.2 * it.GetIndex()[0])));
+  }
+  auto displacementFieldTransform = DisplacementFieldTransformType::New();
+  displacementFieldTransform->SetDisplacementField(field);
+
+  auto transform = CompositeTransformType::New();
+  transform->AddTransform(firstAffineTransform);
+  transform->AddTransform(secondAffineTransform);
+  transform->AddTransform(displacementFieldTransform);
+  transform->AddTransform(lastAffineTransform);
+
+  // The grid of the cached displacement field.
+  auto grid = FieldType::New();
+  grid->SetRegions(itk::MakeSize(25, 20));
+  grid->SetOrigin(itk::MakePoint(-12.0, -8.0));
+  grid->SetSpacing(itk::MakeVector(1.0, 0.75));
+  grid->Allocate();
+
+  cachedTransform->SetDisplacementField(grid);
+  ITK_TEST_EXPECT_TRUE(!cachedTransform->IsCachedTransformModified());
+  cachedTransform->SetCachedTransform(transform);
+  ITK_TEST_SET_GET_VALUE(transform.GetPointer(), cachedTransform->GetCachedTransform());
+  ITK_TEST_EXPECT_TRUE(cachedTransform->IsCachedTransformModified());
+
+  cachedTransform->UpdateDisplacementField();
+  ITK_TEST_EXPECT_TRUE(!cachedTransform->IsCachedTransformModified());
+  ITK_TEST_EXPECT_TRUE(MatchesOnGrid(cachedTransform, transform));
+
+  // Points outside the grid are transformed by the cached transform.
+  const auto outsidePoint = itk::MakePoint(20.0, 3.0);
+  ITK_TEST_EXPECT_TRUE(cachedTransform->TransformPoint(outsidePoint) == transform->TransformPoint(outsidePoint));
+
+  // Between the points of the grid, the displacement field is interpolated.
+  const auto insidePoint = itk::MakePoint(1.3, -2.9);
+  ITK_TEST_EXPECT_TRUE(cachedTransform->TransformPoint(insidePoint).EuclideanDistanceTo(
+                         transform->TransformPoint(insidePoint)) < 0.05);
+
+  // Modifying a sub transform invalidates the displacement field, which is
+  // sampled again by the next point transformed.
+  secondAffineTransform->Scale(0.9);
+  ITK_TEST_EXPECT_TRUE(cachedTransform->IsCachedTransformModified());
+  ITK_TEST_EXPECT_TRUE(MatchesOnGrid(cachedTransform, transform));
+  ITK_TEST_EXPECT_TRUE(!cachedTransform->IsCachedTransformModified());
+
+  field->FillBuffer(itk::MakeVector(0.25, 0.5));
+  displacementFieldTransform->Modified();
+  ITK_TEST_EXPECT_TRUE(cachedTransform->IsCachedTransformModified());
+  ITK_TEST_EXPECT_TRUE(MatchesOnGrid(cachedTransform, transform));
+
+  // A transform added to the composite transform is sampled, and so are its later modifications.
+  auto addedAffineTransform = AffineTransformType::New();
+  addedAffineTransform->Rotate2D(-0.1);
+  transform->AddTransform(addedAffineTransform);
+  ITK_TEST_EXPECT_TRUE(cachedTransform->IsCachedTransformModified());
+  ITK_TEST_EXPECT_TRUE(MatchesOnGrid(cachedTransform, transform));
+  addedAffineTransform->Translate(itk::MakeVector(0.5, 0.25));
+  ITK_TEST_EXPECT_TRUE(cachedTransform->IsCachedTransformModified());
+  ITK_TEST_EXPECT_TRUE(MatchesOnGrid(cachedTransform, transform));
+
+  // A new grid is sampled again.
+  cachedTransform->SetFixedParameters(cachedTransform->GetFixedParameters());
+  ITK_TEST_EXPECT_TRUE(cachedTransform->IsCachedTransformModified());
+  ITK_TEST_EXPECT_TRUE(MatchesOnGrid(cachedTransform, transform));
+
+  // A clone caches the same transform.
+  const CachedTransformType::Pointer clone = cachedTransform->Clone();
+  ITK_TEST_EXPECT_EQUAL(clone->GetCachedTransform(), cachedTransform->GetCachedTransform());
+  ITK_TEST_EXPECT_TRUE(MatchesOnGrid(clone, transform));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -20,12 +20,14 @@
 #define itkFastMarchingBase_h
 
 #include "itkIntTypes.h"
+#include "itkFastMarchingIndexedHeap.h"
 #include "itkFastMarchingStoppingCriterionBase.h"
 #include "itkFastMarchingTraits.h"
+#include "itkProgressReporter.h"
 #include "ITKFastMarchingExport.h"
 
-#include <queue>
-#include <functional>
+#include <map>
+#include <vector>
 
 namespace itk
 {
@@ -63,8 +65,10 @@ extern ITKFastMarching_EXPORT std::ostream &
  *
  * Updates are performed using an entropy satisfy scheme where only
  * "upwind" neighborhoods are used. This implementation of Fast Marching
- * uses a std::priority_queue to locate the next proper node to
- * update.
+ * uses an indexed min-heap, FastMarchingIndexedHeap, to locate the next
+ * proper node to update. A trial node is in the heap at most once: when its
+ * value is updated, it is moved within the heap instead of being pushed
+ * again.
  *
  * Fast Marching sweeps through N points in (N log N) steps to obtain
  * the arrival time value as the front propagates through the domain.
@@ -91,10 +95,6 @@ extern ITKFastMarching_EXPORT std::ostream &
  *    \li Superclass (itk::ImageToImageFilter or
  * itk::QuadEdgeMeshToQuadEdgeMeshFilter )
  *
- * \todo In the current implementation, std::priority_queue only allows
- * taking nodes out from the front and putting nodes in from the back.
- * Use itk::PriorityQueueContainer instead.
- *
  * \par Topology constraints:
  * Additional flexibility in this class includes the implementation of
  * topology constraints for image-based fast marching.  Further details
@@ -112,6 +112,13 @@ extern ITKFastMarching_EXPORT std::ostream &
  * marching cubes algorithm to produce a mesh whose genus is identical
  * to that of the evolved front(s).
  *
+ * Trial nodes of equal values are accepted by increasing identifier, e.g. by
+ * increasing offset in an image, whatever the order in which they were
+ * pushed. With the "Strict" and "NoHandles" options, which nodes are
+ * accepted depends on this order. Before ITK 6, ties were broken by the
+ * internal order of a std::priority_queue, so these outputs may differ from
+ * the ones of ITK 5 in a few nodes along the fronts.
+ *
  * \sa FastMarchingStoppingCriterionBase
  *
  * \ingroup ITKFastMarching
@@ -158,18 +165,6 @@ public:
   using StoppingCriterionType = FastMarchingStoppingCriterionBase<TInput, TOutput>;
   using StoppingCriterionPointer = typename StoppingCriterionType::Pointer;
 
-  /*
-  using ElementIdentifier = long;
-
-  using PriorityQueueElementType = MinPriorityQueueElementWrapper< NodeType,
-    OutputPixelType,
-    ElementIdentifier >;
-
-  using PriorityQueueType = PriorityQueueContainer< PriorityQueueElementType,
-    PriorityQueueElementType, OutputPixelType, ElementIdentifier >;
-  using PriorityQueuePointer = typename PriorityQueueType::Pointer;
-  */
-
   using TopologyCheckEnum = FastMarchingTraitsEnums::TopologyCheck;
 #if !defined(ITK_LEGACY_REMOVE)
   using TopologyCheckType = FastMarchingTraitsEnums::TopologyCheck;
@@ -255,20 +250,43 @@ protected:
 
   bool m_CollectPoints{};
 
-  // PriorityQueuePointer m_Heap;
-  using HeapContainerType = std::vector<NodePairType>;
-  using NodeComparerType = std::greater<NodePairType>;
-
-  using PriorityQueueType = std::priority_queue<NodePairType, HeapContainerType, NodeComparerType>;
+  /** The heap of the trial nodes, identified by GetNodeIdentifier() in 32
+   * bits. Before ITK 6, m_Heap was a std::priority_queue of NodePairType, in
+   * which a node was pushed again whenever its value was updated. Subclasses
+   * that pushed into it directly must call PushNodePair() instead. */
+  using PriorityQueueType = FastMarchingIndexedHeap<OutputPixelType>;
 
   PriorityQueueType m_Heap{};
 
+  /** The heap of the trial nodes of the domains of more than 2^32 nodes,
+   * used instead of m_Heap. */
+  using LargePriorityQueueType = FastMarchingIndexedHeap<OutputPixelType, IdentifierType>;
+
+  LargePriorityQueueType m_LargeHeap{};
+
   TopologyCheckEnum m_TopologyCheck{};
 
   /** \brief Get the total number of nodes in the domain */
   [[nodiscard]] virtual IdentifierType
   GetTotalNumberOfNodes() const = 0;
 
+  /** \brief Get the identifier of a node in the heap. The image and mesh
+   * filters number the nodes of their domain; this default implementation
+   * numbers them in the order they are first pushed.
+    \param[in] iNode
+    \return its identifier */
+  virtual IdentifierType
+  GetNodeIdentifier(const NodeType & iNode);
+
+  /** \brief Get the node of an identifier returned by GetNodeIdentifier() */
+  virtual NodeType
+  GetNodeFromIdentifier(IdentifierType iIdentifier) const;
+
+  /** \brief Insert a trial node with its value in the heap, or update its value
+   * if it is already in the heap */
+  void
+  PushNodePair(const NodePairType & iNodePair);
+
   /** \brief Get the output value (front value) for a given node */
   virtual const OutputPixelType
   GetOutputValue(OutputDomainType * oDomain, const NodeType & iNode) const = 0;
@@ -314,6 +332,10 @@ protected:
   void
   Initialize(OutputDomainType * oDomain);
 
+  /** \brief Empty the heap and release its memory */
+  void
+  ClearHeap();
+
   /**    */
   virtual void
   InitializeOutput(OutputDomainType * oDomain) = 0;
@@ -325,6 +347,19 @@ protected:
   /** \brief PrintSelf method  */
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Accept the trial nodes of the heap, in increasing order of their values,
+   * until it is empty or the stopping criterion is satisfied. */
+  template <typename THeap>
+  void
+  March(THeap & heap, OutputDomainType * oDomain, ProgressReporter & progress, OutputPixelType & currentValue);
+
+  bool m_UseLargeHeap{ false };
+
+  /** The nodes numbered by the default GetNodeIdentifier(). */
+  std::map<NodeType, IdentifierType> m_NodeIdentifiers{};
+  std::vector<NodeType>              m_IdentifiedNodes{};
 };
 } // namespace itk
 
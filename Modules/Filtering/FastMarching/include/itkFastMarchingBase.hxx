@@ -23,6 +23,8 @@
 #include "itkProgressReporter.h"
 #include "itkMath.h"
 
+#include <algorithm>
+
 namespace itk
 {
 // -----------------------------------------------------------------------------
@@ -41,7 +43,6 @@ FastMarchingBase<TInput, TOutput>::FastMarchingBase()
   , m_TopologyCheck(TopologyCheckEnum::Nothing)
 {
   this->ProcessObject::SetNumberOfRequiredInputs(0);
-  // m_Heap = PriorityQueueType::New();
 }
 // -----------------------------------------------------------------------------
 
@@ -88,16 +89,9 @@ FastMarchingBase<TInput, TOutput>::Initialize(OutputDomainType * oDomain)
   }
 
   // make sure the heap is empty
-  while (!m_Heap.empty())
-  {
-    m_Heap.pop();
-  }
-  /*
-  while ( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }
-  */
+  this->ClearHeap();
+  m_UseLargeHeap =
+    static_cast<SizeValueType>(this->GetTotalNumberOfNodes()) > PriorityQueueType::MaximumNumberOfIdentifiers;
 
   this->InitializeOutput(oDomain);
 
@@ -124,83 +118,143 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
 
   try
   {
-    // while( !m_Heap->Empty() )
-    while (!m_Heap.empty())
+    if (m_UseLargeHeap)
     {
-      // PriorityQueueElementType element = m_Heap->Peek();
-      // m_Heap->Pop();
-      //
-      // NodeType current_node = element.m_Element;
-      // OutputPixelType current_value = element.m_Priority;
+      this->March(m_LargeHeap, output, progress, current_value);
+    }
+    else
+    {
+      this->March(m_Heap, output, progress, current_value);
+    }
+  }
+  catch (const ProcessAborted &)
+  {
+    // User aborted filter execution Here we catch an exception thrown by the
+    // progress reporter and rethrow it with the correct line number and file
+    // name. We also invoke AbortEvent in case some observer was interested on
+    // it.
+    //
+    // RELEASE MEMORY!!!
+    this->ClearHeap();
 
+    throw ProcessAborted(__FILE__, __LINE__);
+  }
 
-      NodePairType current_node_pair = m_Heap.top();
-      m_Heap.pop();
+  m_TargetReachedValue = current_value;
 
-      const NodeType current_node = current_node_pair.GetNode();
-      current_value = this->GetOutputValue(output, current_node);
+  // let's release some useless memory...
+  this->ClearHeap();
+}
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+template <typename THeap>
+void
+FastMarchingBase<TInput, TOutput>::March(THeap &            heap,
+                                         OutputDomainType * oDomain,
+                                         ProgressReporter & progress,
+                                         OutputPixelType &  currentValue)
+{
+  while (!heap.IsEmpty())
+  {
+    const typename THeap::ElementType element = heap.GetTop();
+    heap.Pop();
+
+    const NodePairType current_node_pair(this->GetNodeFromIdentifier(element.Identifier), element.Value);
+
+    const NodeType current_node = current_node_pair.GetNode();
+    currentValue = this->GetOutputValue(oDomain, current_node);
 
-      if (Math::ExactlyEquals(current_value, current_node_pair.GetValue()))
+    if (Math::ExactlyEquals(currentValue, current_node_pair.GetValue()))
+    {
+      // is this node already alive ?
+      if (this->GetLabelValueForGivenNode(current_node) != Traits::Alive)
       {
-        // is this node already alive ?
-        if (this->GetLabelValueForGivenNode(current_node) != Traits::Alive)
+        m_StoppingCriterion->SetCurrentNodePair(current_node_pair);
+
+        if (m_StoppingCriterion->IsSatisfied())
         {
-          m_StoppingCriterion->SetCurrentNodePair(current_node_pair);
+          break;
+        }
 
-          if (m_StoppingCriterion->IsSatisfied())
+        if (this->CheckTopology(oDomain, current_node))
+        {
+          if (m_CollectPoints)
           {
-            break;
+            m_ProcessedPoints->push_back(current_node_pair);
           }
 
-          if (this->CheckTopology(output, current_node))
-          {
-            if (m_CollectPoints)
-            {
-              m_ProcessedPoints->push_back(current_node_pair);
-            }
-
-            // set this node as alive
-            this->SetLabelValueForGivenNode(current_node, Traits::Alive);
+          // set this node as alive
+          this->SetLabelValueForGivenNode(current_node, Traits::Alive);
 
-            // update its neighbors
-            this->UpdateNeighbors(output, current_node);
-          }
+          // update its neighbors
+          this->UpdateNeighbors(oDomain, current_node);
         }
-        progress.CompletedPixel();
       }
+      progress.CompletedPixel();
     }
   }
-  catch (const ProcessAborted &)
-  {
-    // User aborted filter execution Here we catch an exception thrown by the
-    // progress reporter and rethrow it with the correct line number and file
-    // name. We also invoke AbortEvent in case some observer was interested on
-    // it.
-    //
-    // RELEASE MEMORY!!!
-    while (!m_Heap.empty())
-    {
-      m_Heap.pop();
-    }
-    /*while( !m_Heap->Empty() )
-      {
-      m_Heap->Pop();
-      }*/
+}
+// -----------------------------------------------------------------------------
 
-    throw ProcessAborted(__FILE__, __LINE__);
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+IdentifierType
+FastMarchingBase<TInput, TOutput>::GetNodeIdentifier(const NodeType & iNode)
+{
+  const auto inserted = m_NodeIdentifiers.emplace(iNode, m_IdentifiedNodes.size());
+  if (inserted.second)
+  {
+    m_IdentifiedNodes.push_back(iNode);
   }
+  return inserted.first->second;
+}
+// -----------------------------------------------------------------------------
 
-  m_TargetReachedValue = current_value;
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+auto
+FastMarchingBase<TInput, TOutput>::GetNodeFromIdentifier(IdentifierType iIdentifier) const -> NodeType
+{
+  return m_IdentifiedNodes[iIdentifier];
+}
+// -----------------------------------------------------------------------------
 
-  // let's release some useless memory...
-  while (!m_Heap.empty())
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+void
+FastMarchingBase<TInput, TOutput>::PushNodePair(const NodePairType & iNodePair)
+{
+  const IdentifierType identifier = this->GetNodeIdentifier(iNodePair.GetNode());
+  if (m_UseLargeHeap)
   {
-    m_Heap.pop();
-  }
-  /*while( !m_Heap->Empty() )
+    if (identifier >= m_LargeHeap.GetNumberOfIdentifiers())
     {
-    m_Heap->Pop();
-    }*/
+      m_LargeHeap.SetNumberOfIdentifiers(std::max<SizeValueType>(identifier + 1, this->GetTotalNumberOfNodes()));
+    }
+    m_LargeHeap.Push(identifier, iNodePair.GetValue());
+    return;
+  }
+  if (identifier >= m_Heap.GetNumberOfIdentifiers())
+  {
+    // Make room for all the nodes of the domain at once.
+    m_Heap.SetNumberOfIdentifiers(std::max<SizeValueType>(identifier + 1, this->GetTotalNumberOfNodes()));
+  }
+  m_Heap.Push(static_cast<typename PriorityQueueType::IdentifierType>(identifier), iNodePair.GetValue());
+}
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+void
+FastMarchingBase<TInput, TOutput>::ClearHeap()
+{
+  m_Heap.Clear();
+  m_LargeHeap.Clear();
+  m_NodeIdentifiers.clear();
+  m_IdentifiedNodes.clear();
+  m_IdentifiedNodes.shrink_to_fit();
 }
 // -----------------------------------------------------------------------------
 
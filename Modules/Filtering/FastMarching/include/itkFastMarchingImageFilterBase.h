@@ -60,6 +60,12 @@ namespace itk
  *
  * For an alternative implementation, see itk::FastMarchingImageFilter.
  *
+ * The nodes are accepted one at a time, in a single thread. There is no
+ * multi-threaded fast sweeping or fast iterative solver mode: the stopping
+ * criteria, the topology checks, the processed points and the target reached
+ * value are all defined by the order in which the nodes are accepted, which
+ * these solvers do not provide.
+ *
  * \tparam TTraits traits
  *
  * \sa FastMarchingImageFilter
@@ -188,6 +194,13 @@ protected:
   [[nodiscard]] IdentifierType
   GetTotalNumberOfNodes() const override;
 
+  /** The offset of the node in the buffer of the output image. */
+  IdentifierType
+  GetNodeIdentifier(const NodeType & iNode) override;
+
+  NodeType
+  GetNodeFromIdentifier(IdentifierType iIdentifier) const override;
+
   void
   SetOutputValue(OutputImageType * oImage, const NodeType & iNode, const OutputPixelType & iValue) override;
 
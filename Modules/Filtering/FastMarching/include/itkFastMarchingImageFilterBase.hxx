@@ -106,6 +106,20 @@ FastMarchingImageFilterBase<TInput, TOutput>::GetTotalNumberOfNodes() const
   return this->m_BufferedRegion.GetNumberOfPixels();
 }
 
+template <typename TInput, typename TOutput>
+IdentifierType
+FastMarchingImageFilterBase<TInput, TOutput>::GetNodeIdentifier(const NodeType & iNode)
+{
+  return static_cast<IdentifierType>(m_LabelImage->ComputeOffset(iNode));
+}
+
+template <typename TInput, typename TOutput>
+auto
+FastMarchingImageFilterBase<TInput, TOutput>::GetNodeFromIdentifier(IdentifierType iIdentifier) const -> NodeType
+{
+  return m_LabelImage->ComputeIndex(static_cast<OffsetValueType>(iIdentifier));
+}
+
 template <typename TInput, typename TOutput>
 void
 FastMarchingImageFilterBase<TInput, TOutput>::SetOutputValue(OutputImageType *       oImage,
@@ -185,7 +199,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::UpdateValue(OutputImageType * oIma
     this->SetLabelValueForGivenNode(iNode, Traits::Trial);
 
     // Insert point into trial heap
-    this->m_Heap.push(NodePairType(iNode, outputPixel));
+    this->PushNodePair(NodePairType(iNode, outputPixel));
   }
 }
 
@@ -527,8 +541,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::InitializeOutput(OutputImageType *
         outputPixel = pointsIter->Value().GetValue();
         this->SetOutputValue(oImage, idx, outputPixel);
 
-        // this->m_Heap->Push( PriorityQueueElementType( idx, pointsIter->second ) );
-        this->m_Heap.push(pointsIter->Value());
+        this->PushNodePair(pointsIter->Value());
       }
       ++pointsIter;
     }
@@ -0,0 +1,303 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFastMarchingIndexedHeap_h
+#define itkFastMarchingIndexedHeap_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class FastMarchingIndexedHeap
+ * \brief Min-heap of the trial nodes of fast marching, with decrease-key.
+ *
+ * The nodes are identified by integers smaller than the number of
+ * identifiers, e.g. the offsets of the pixels of an image. Each identifier
+ * is in the heap at most once: pushing an identifier already in the heap
+ * updates its value and moves it to its new place, instead of adding a
+ * duplicate to be discarded when it is popped. Elements of equal values are
+ * popped by increasing identifier, so that the order does not depend on the
+ * order of the pushes.
+ *
+ * The identifiers are stored as TIdentifier, a 32 bit integer by default,
+ * so that an element of a float value takes 8 bytes; domains of more than
+ * 2^32 nodes need a 64 bit TIdentifier. The place of each identifier in the
+ * heap is stored in a 32 bit integer.
+ * While the heap holds few identifiers compared to the number of
+ * identifiers, e.g. a small front in a large image, the places are stored
+ * in a hash table. Once it holds more than one identifier in 256, they are
+ * stored in an array indexed by identifier, which is faster to update.
+ *
+ * \ingroup ITKFastMarching
+ */
+template <typename TValue, typename TIdentifier = std::uint32_t>
+class FastMarchingIndexedHeap
+{
+public:
+  using Self = FastMarchingIndexedHeap;
+  using ValueType = TValue;
+  using IdentifierType = TIdentifier;
+
+  /** The largest number of identifiers of the heap. */
+  static constexpr SizeValueType MaximumNumberOfIdentifiers =
+    std::numeric_limits<IdentifierType>::max() < std::numeric_limits<SizeValueType>::max()
+      ? SizeValueType{ std::numeric_limits<IdentifierType>::max() } + 1
+      : std::numeric_limits<SizeValueType>::max();
+
+  /** An identifier and its value. */
+  struct ElementType
+  {
+    ValueType      Value;
+    IdentifierType Identifier;
+  };
+
+  [[nodiscard]] bool
+  IsEmpty() const
+  {
+    return m_Elements.empty();
+  }
+
+  [[nodiscard]] SizeValueType
+  GetSize() const
+  {
+    return m_Elements.size();
+  }
+
+  /** The identifiers pushed must be smaller than the number of identifiers.
+   * Increasing it keeps the elements of the heap. */
+  /** @ITKStartGrouping */
+  void
+  SetNumberOfIdentifiers(SizeValueType numberOfIdentifiers)
+  {
+    if (numberOfIdentifiers > MaximumNumberOfIdentifiers)
+    {
+      itkGenericExceptionMacro("Too many nodes for the identifiers of the heap of the fast marching: "
+                               << numberOfIdentifiers << " > " << MaximumNumberOfIdentifiers);
+    }
+    m_NumberOfIdentifiers = numberOfIdentifiers;
+    if (m_UseDensePositions)
+    {
+      m_Positions.resize(numberOfIdentifiers, NotInHeap);
+    }
+  }
+  [[nodiscard]] SizeValueType
+  GetNumberOfIdentifiers() const
+  {
+    return m_NumberOfIdentifiers;
+  }
+  /** @ITKEndGrouping */
+
+  [[nodiscard]] bool
+  Contains(IdentifierType identifier) const
+  {
+    return this->GetPosition(identifier) != NotInHeap;
+  }
+
+  /** Insert the identifier with its value, or update its value if it is
+   * already in the heap. */
+  void
+  Push(IdentifierType identifier, const ValueType & value)
+  {
+    PositionType position = this->GetPosition(identifier);
+    if (position == NotInHeap)
+    {
+      if (m_Elements.size() >= NotInHeap)
+      {
+        itkGenericExceptionMacro("Too many elements in the heap of the fast marching.");
+      }
+      position = static_cast<PositionType>(m_Elements.size());
+      m_Elements.push_back({ value, identifier });
+      if (!m_UseDensePositions && m_Elements.size() > m_NumberOfIdentifiers / 256)
+      {
+        this->UseDensePositions();
+      }
+      this->SiftUp(position);
+    }
+    else if (value < m_Elements[position].Value)
+    {
+      m_Elements[position].Value = value;
+      this->SiftUp(position);
+    }
+    else
+    {
+      m_Elements[position].Value = value;
+      this->SiftDown(position);
+    }
+  }
+
+  /** The element of smallest value. */
+  [[nodiscard]] const ElementType &
+  GetTop() const
+  {
+    return m_Elements.front();
+  }
+
+  /** Remove the element of smallest value. */
+  void
+  Pop()
+  {
+    this->ErasePosition(m_Elements.front().Identifier);
+    if (m_Elements.size() > 1)
+    {
+      m_Elements.front() = m_Elements.back();
+      m_Elements.pop_back();
+      this->SiftDown(0);
+    }
+    else
+    {
+      m_Elements.pop_back();
+    }
+  }
+
+  /** Remove all the elements and identifiers, and release their memory. */
+  void
+  Clear()
+  {
+    std::vector<ElementType>().swap(m_Elements);
+    std::vector<PositionType>().swap(m_Positions);
+    std::unordered_map<IdentifierType, PositionType>().swap(m_SparsePositions);
+    m_NumberOfIdentifiers = 0;
+    m_UseDensePositions = false;
+  }
+
+private:
+  using PositionType = std::uint32_t;
+
+  static constexpr PositionType NotInHeap = std::numeric_limits<PositionType>::max();
+
+  /** Whether the element comes first: the smaller value, or the smaller
+   * identifier for equal values. */
+  static bool
+  Precedes(const ElementType & element, const ElementType & otherElement)
+  {
+    if (element.Value < otherElement.Value)
+    {
+      return true;
+    }
+    return !(otherElement.Value < element.Value) && element.Identifier < otherElement.Identifier;
+  }
+
+  [[nodiscard]] PositionType
+  GetPosition(IdentifierType identifier) const
+  {
+    if (m_UseDensePositions)
+    {
+      return m_Positions[identifier];
+    }
+    const auto it = m_SparsePositions.find(identifier);
+    return it == m_SparsePositions.end() ? NotInHeap : it->second;
+  }
+
+  void
+  ErasePosition(IdentifierType identifier)
+  {
+    if (m_UseDensePositions)
+    {
+      m_Positions[identifier] = NotInHeap;
+    }
+    else
+    {
+      m_SparsePositions.erase(identifier);
+    }
+  }
+
+  /** Move the places of the elements from the hash table to the array. */
+  void
+  UseDensePositions()
+  {
+    m_Positions.assign(m_NumberOfIdentifiers, NotInHeap);
+    for (const auto & identifierAndPosition : m_SparsePositions)
+    {
+      m_Positions[identifierAndPosition.first] = identifierAndPosition.second;
+    }
+    std::unordered_map<IdentifierType, PositionType>().swap(m_SparsePositions);
+    m_UseDensePositions = true;
+  }
+
+  void
+  Place(PositionType position, const ElementType & element)
+  {
+    m_Elements[position] = element;
+    if (m_UseDensePositions)
+    {
+      m_Positions[element.Identifier] = position;
+    }
+    else
+    {
+      m_SparsePositions[element.Identifier] = position;
+    }
+  }
+
+  void
+  SiftUp(PositionType position)
+  {
+    const ElementType element = m_Elements[position];
+    while (position > 0)
+    {
+      const PositionType parent = (position - 1) / 2;
+      if (!Precedes(element, m_Elements[parent]))
+      {
+        break;
+      }
+      this->Place(position, m_Elements[parent]);
+      position = parent;
+    }
+    this->Place(position, element);
+  }
+
+  void
+  SiftDown(PositionType position)
+  {
+    const ElementType   element = m_Elements[position];
+    const SizeValueType size = m_Elements.size();
+    while (true)
+    {
+      SizeValueType child = 2 * SizeValueType{ position } + 1;
+      if (child >= size)
+      {
+        break;
+      }
+      if (child + 1 < size && Precedes(m_Elements[child + 1], m_Elements[child]))
+      {
+        ++child;
+      }
+      if (!Precedes(m_Elements[child], element))
+      {
+        break;
+      }
+      this->Place(position, m_Elements[child]);
+      position = static_cast<PositionType>(child);
+    }
+    this->Place(position, element);
+  }
+
+  std::vector<ElementType>                         m_Elements{};
+  std::vector<PositionType>                        m_Positions{};
+  std::unordered_map<IdentifierType, PositionType> m_SparsePositions{};
+  SizeValueType                                    m_NumberOfIdentifiers{ 0 };
+  bool                                             m_UseDensePositions{ false };
+};
+} // end namespace itk
+
+#endif // itkFastMarchingIndexedHeap_h
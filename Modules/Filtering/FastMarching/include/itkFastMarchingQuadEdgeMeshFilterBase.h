@@ -108,6 +108,13 @@ protected:
   [[nodiscard]] IdentifierType
   GetTotalNumberOfNodes() const override;
 
+  /** The node is the identifier of a point of the mesh. */
+  IdentifierType
+  GetNodeIdentifier(const NodeType & iNode) override;
+
+  NodeType
+  GetNodeFromIdentifier(IdentifierType iIdentifier) const override;
+
   void
   SetOutputValue(OutputMeshType * oMesh, const NodeType & iNode, const OutputPixelType & iValue) override;
 
@@ -39,6 +39,21 @@ FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::GetTotalNumberOfNodes() con
   return this->GetInput()->GetNumberOfPoints();
 }
 
+template <typename TInput, typename TOutput>
+IdentifierType
+FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::GetNodeIdentifier(const NodeType & iNode)
+{
+  return static_cast<IdentifierType>(iNode);
+}
+
+template <typename TInput, typename TOutput>
+auto
+FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::GetNodeFromIdentifier(IdentifierType iIdentifier) const
+  -> NodeType
+{
+  return static_cast<NodeType>(iIdentifier);
+}
+
 template <typename TInput, typename TOutput>
 void
 FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::SetOutputValue(OutputMeshType *        oMesh,
@@ -202,7 +217,7 @@ FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::UpdateValue(OutputMeshType
 
       this->SetLabelValueForGivenNode(iNode, Traits::Trial);
 
-      this->m_Heap.push(NodePairType(iNode, outputPixel));
+      this->PushNodePair(NodePairType(iNode, outputPixel));
     }
   }
   else
@@ -668,7 +683,7 @@ FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::InitializeOutput(OutputMesh
         this->SetLabelValueForGivenNode(idx, Traits::InitialTrial);
         this->SetOutputValue(oMesh, idx, outputPixel);
 
-        this->m_Heap.push(pointsIter->Value());
+        this->PushNodePair(pointsIter->Value());
       }
 
       ++pointsIter;
@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Checks that the output of topology constrained fast marching does not depend on the order of the trial points. The
+// fronts propagate at a constant speed in a torus, from seeds placed symmetrically around it, so that many trial
+// nodes have equal values, and the fronts meet.
+
+#include "itkFastMarchingImageFilterBase.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+int
+itkFastMarchingImageTopologicalTieOrderTest(int argc, char * argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv)
+              << " topologyCheck(1: strict, 2: no handles) outputImage reverseOrderOutputImage" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 3 };
+  using ImageType = itk::Image<float, Dimension>;
+  using FastMarchingType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
+  using NodePairType = FastMarchingType::NodePairType;
+  using NodePairContainerType = FastMarchingType::NodePairContainerType;
+  using TopologyCheckEnum = FastMarchingType::TopologyCheckEnum;
+
+  const TopologyCheckEnum topologyCheck =
+    std::stoi(argv[1]) == 1 ? TopologyCheckEnum::Strict : TopologyCheckEnum::NoHandles;
+
+  // A speed of one in a torus around the z axis, of zero elsewhere.
+  const ImageType::SizeType size{ { 48, 40, 36 } };
+  auto                      speed = ImageType::New();
+  speed->SetRegions(size);
+  speed->AllocateInitialized();
+  constexpr double majorRadius{ 13.0 };
+  constexpr double minorRadius{ 6.5 };
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(speed, speed->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const double               x = index[0] - 0.5 * (size[0] - 1);
+    const double               y = index[1] - 0.5 * (size[1] - 1);
+    const double               z = index[2] - 0.5 * (size[2] - 1);
+    if (itk::Math::sqr(std::hypot(x, y) - majorRadius) + z * z < minorRadius * minorRadius)
+    {
+      it.Set(1.0f);
+    }
+  }
+
+  // Seeds on the central circle of the torus.
+  std::vector<NodePairType> seeds;
+  for (unsigned int i = 0; i < 6; ++i)
+  {
+    const double         angle = i * itk::Math::pi / 3.0;
+    ImageType::IndexType index;
+    index[0] = itk::Math::Round<itk::IndexValueType>(0.5 * (size[0] - 1) + majorRadius * std::cos(angle));
+    index[1] = itk::Math::Round<itk::IndexValueType>(0.5 * (size[1] - 1) + majorRadius * std::sin(angle));
+    index[2] = size[2] / 2;
+    seeds.emplace_back(index, 0.0f);
+  }
+
+  const auto march = [&speed, topologyCheck](const std::vector<NodePairType> & trialPoints,
+                                             const TopologyCheckEnum           check) {
+    auto criterion = itk::FastMarchingThresholdStoppingCriterion<ImageType, ImageType>::New();
+    criterion->SetThreshold(100.0);
+
+    auto trialContainer = NodePairContainerType::New();
+    for (const NodePairType & trialPoint : trialPoints)
+    {
+      trialContainer->push_back(trialPoint);
+    }
+
+    auto fastMarching = FastMarchingType::New();
+    fastMarching->SetInput(speed);
+    fastMarching->SetStoppingCriterion(criterion);
+    fastMarching->SetTrialPoints(trialContainer);
+    fastMarching->SetTopologyCheck(check);
+    fastMarching->Update();
+    return ImageType::Pointer(fastMarching->GetOutput());
+  };
+
+  ImageType::Pointer output;
+  ITK_TRY_EXPECT_NO_EXCEPTION(output = march(seeds, topologyCheck));
+  ImageType::Pointer reverseOrderOutput;
+  ITK_TRY_EXPECT_NO_EXCEPTION(reverseOrderOutput = march({ seeds.rbegin(), seeds.rend() }, topologyCheck));
+  ImageType::Pointer unconstrainedOutput;
+  ITK_TRY_EXPECT_NO_EXCEPTION(unconstrainedOutput = march(seeds, TopologyCheckEnum::Nothing));
+
+  // The outputs are compared voxel by voxel, without tolerance.
+  unsigned int numberOfDifferences = 0;
+  unsigned int numberOfConstrainedVoxels = 0;
+  for (itk::ImageRegionConstIterator<ImageType> it(output, output->GetBufferedRegion()),
+       reverseIt(reverseOrderOutput, output->GetBufferedRegion()),
+       unconstrainedIt(unconstrainedOutput, output->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it, ++reverseIt, ++unconstrainedIt)
+  {
+    if (it.Get() != reverseIt.Get())
+    {
+      ++numberOfDifferences;
+    }
+    if (it.Get() != unconstrainedIt.Get())
+    {
+      ++numberOfConstrainedVoxels;
+    }
+  }
+  std::cout << "Voxels changed by the topology check: " << numberOfConstrainedVoxels << std::endl;
+
+  // The topology check changes the output, otherwise the order of the ties would not matter.
+  ITK_TEST_EXPECT_TRUE(numberOfConstrainedVoxels > 0);
+  if (numberOfDifferences > 0)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The outputs for the trial points in reverse order differ in " << numberOfDifferences << " voxels."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(output, argv[2]));
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(reverseOrderOutput, argv[3]));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastMarchingIndexedHeap.h"
+#include "itkTestingMacros.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+int
+itkFastMarchingIndexedHeapTest(int, char *[])
+{
+  using HeapType = itk::FastMarchingIndexedHeap<float>;
+  HeapType heap;
+
+  ITK_TEST_EXPECT_TRUE(heap.IsEmpty());
+  constexpr itk::SizeValueType numberOfIdentifiers = 1000;
+  heap.SetNumberOfIdentifiers(numberOfIdentifiers);
+  ITK_TEST_EXPECT_EQUAL(heap.GetNumberOfIdentifiers(), numberOfIdentifiers);
+
+  // Push, update and pop random identifiers, and compare with the values
+  // expected for each identifier.
+  std::map<HeapType::IdentifierType, float> expectedValues;
+  std::mt19937                              randomNumberGenerator(11);
+  std::uniform_int_distribution<size_t>     identifierDistribution(0, numberOfIdentifiers - 1);
+  std::uniform_real_distribution<float>     valueDistribution(0.0f, 100.0f);
+
+  float lastPoppedValue = 0.0f;
+  for (unsigned int i = 0; i < 20000; ++i)
+  {
+    if (i % 3 == 2 && !heap.IsEmpty())
+    {
+      const HeapType::ElementType top = heap.GetTop();
+      // The top has the smallest value of the heap.
+      for (const auto & identifierAndValue : expectedValues)
+      {
+        if (identifierAndValue.second < top.Value)
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "The top value " << top.Value << " is larger than the value " << identifierAndValue.second
+                    << " of identifier " << identifierAndValue.first << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+      ITK_TEST_EXPECT_EQUAL(top.Value, expectedValues.at(top.Identifier));
+      heap.Pop();
+      expectedValues.erase(top.Identifier);
+      ITK_TEST_EXPECT_TRUE(!heap.Contains(top.Identifier));
+      lastPoppedValue = top.Value;
+    }
+    else
+    {
+      // Values larger than the last popped value, as in fast marching, either
+      // decreasing or increasing the value of the identifiers in the heap.
+      const HeapType::IdentifierType identifier = identifierDistribution(randomNumberGenerator);
+      const float                    value = lastPoppedValue + valueDistribution(randomNumberGenerator);
+      heap.Push(identifier, value);
+      expectedValues[identifier] = value;
+      ITK_TEST_EXPECT_TRUE(heap.Contains(identifier));
+    }
+    ITK_TEST_EXPECT_EQUAL(heap.GetSize(), expectedValues.size());
+  }
+
+  // The remaining elements are popped by increasing value.
+  float previousValue = 0.0f;
+  while (!heap.IsEmpty())
+  {
+    const HeapType::ElementType top = heap.GetTop();
+    ITK_TEST_EXPECT_TRUE(previousValue <= top.Value);
+    ITK_TEST_EXPECT_EQUAL(top.Value, expectedValues.at(top.Identifier));
+    previousValue = top.Value;
+    heap.Pop();
+  }
+
+  heap.Clear();
+  ITK_TEST_EXPECT_TRUE(heap.IsEmpty());
+  ITK_TEST_EXPECT_EQUAL(heap.GetNumberOfIdentifiers(), 0);
+
+  // Elements of equal values are popped by increasing identifier, whatever the
+  // order of the pushes. A small heap among many identifiers, whose places are
+  // in the hash table.
+  heap.SetNumberOfIdentifiers(100000000);
+  const std::vector<HeapType::IdentifierType> identifiers = { 0, 99999999, 2, 5, 9, 8, 1, 4, 7, 6, 3, 70000 };
+  for (const HeapType::IdentifierType identifier : identifiers)
+  {
+    heap.Push(identifier, identifier % 2 ? 1.0f : 2.0f);
+  }
+  heap.Push(70000, 1.0f);
+  ITK_TEST_EXPECT_TRUE(heap.Contains(99999999));
+  ITK_TEST_EXPECT_TRUE(!heap.Contains(10));
+  const std::vector<HeapType::IdentifierType> expectedIdentifiers = { 1, 3, 5, 7, 9, 70000, 99999999, 0, 2, 4, 6, 8 };
+  std::vector<HeapType::IdentifierType>       poppedIdentifiers;
+  while (!heap.IsEmpty())
+  {
+    poppedIdentifiers.push_back(heap.GetTop().Identifier);
+    heap.Pop();
+  }
+  ITK_TEST_EXPECT_TRUE(poppedIdentifiers == expectedIdentifiers);
+  ITK_TEST_EXPECT_TRUE(!heap.Contains(99999999));
+
+  // The identifiers are encoded in 32 bits by default. More identifiers need a
+  // 64 bit identifier type.
+  static_assert(sizeof(HeapType::ElementType) == 8, "Elements of float values take 8 bytes.");
+  ITK_TEST_EXPECT_EQUAL(HeapType::MaximumNumberOfIdentifiers, itk::SizeValueType{ 1 } << 32);
+  ITK_TRY_EXPECT_EXCEPTION(heap.SetNumberOfIdentifiers(HeapType::MaximumNumberOfIdentifiers + 1));
+
+  using LargeHeapType = itk::FastMarchingIndexedHeap<float, itk::IdentifierType>;
+  LargeHeapType                 largeHeap;
+  constexpr itk::IdentifierType largeIdentifier = itk::IdentifierType{ 1 } << 32;
+  ITK_TRY_EXPECT_NO_EXCEPTION(largeHeap.SetNumberOfIdentifiers(largeIdentifier + 1));
+  largeHeap.Push(largeIdentifier, 1.0f);
+  largeHeap.Push(0, 1.0f);
+  ITK_TEST_EXPECT_EQUAL(largeHeap.GetTop().Identifier, 0);
+  largeHeap.Pop();
+  ITK_TEST_EXPECT_EQUAL(largeHeap.GetTop().Identifier, largeIdentifier);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -18,6 +18,7 @@
 #ifndef itkBinaryGeneratorImageFilter_hxx
 #define itkBinaryGeneratorImageFilter_hxx
 
+#include "itkImageBufferRange.h"
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
 
@@ -185,6 +186,13 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  // With direct pixel access, the pixels of a line are contiguous in memory: the functor is applied in a plain
+  // loop over them, which the compiler can vectorize.
+  constexpr bool directPixelAccess = std::is_pointer_v<typename ImageBufferRange<const TInputImage1>::iterator> &&
+                                     std::is_pointer_v<typename ImageBufferRange<const TInputImage2>::iterator> &&
+                                     std::is_pointer_v<typename ImageBufferRange<TOutputImage>::iterator>;
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
   if (inputPtr1 && inputPtr2)
   {
     ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
@@ -193,18 +201,31 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
     while (!inputIt1.IsAtEnd())
     {
-      while (!inputIt1.IsAtEndOfLine())
+      if constexpr (directPixelAccess)
+      {
+        const Input1ImagePixelType * const input1Line = &inputIt1.Value();
+        const Input2ImagePixelType * const input2Line = &inputIt2.Value();
+        OutputImagePixelType * const       outputLine = &outputIt.Value();
+        for (SizeValueType i = 0; i < lineLength; ++i)
+        {
+          outputLine[i] = functor(input1Line[i], input2Line[i]);
+        }
+      }
+      else
       {
-        outputIt.Set(functor(inputIt1.Get(), inputIt2.Get()));
-        ++inputIt2;
-        ++inputIt1;
-        ++outputIt;
+        while (!inputIt1.IsAtEndOfLine())
+        {
+          outputIt.Set(functor(inputIt1.Get(), inputIt2.Get()));
+          ++inputIt2;
+          ++inputIt1;
+          ++outputIt;
+        }
       }
 
       inputIt1.NextLine();
       inputIt2.NextLine();
       outputIt.NextLine();
-      progress.Completed(outputRegionForThread.GetSize()[0]);
+      progress.Completed(lineLength);
     }
   }
   else if (inputPtr1)
@@ -216,15 +237,27 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
     while (!inputIt1.IsAtEnd())
     {
-      while (!inputIt1.IsAtEndOfLine())
+      if constexpr (directPixelAccess)
       {
-        outputIt.Set(functor(inputIt1.Get(), input2Value));
-        ++inputIt1;
-        ++outputIt;
+        const Input1ImagePixelType * const input1Line = &inputIt1.Value();
+        OutputImagePixelType * const       outputLine = &outputIt.Value();
+        for (SizeValueType i = 0; i < lineLength; ++i)
+        {
+          outputLine[i] = functor(input1Line[i], input2Value);
+        }
+      }
+      else
+      {
+        while (!inputIt1.IsAtEndOfLine())
+        {
+          outputIt.Set(functor(inputIt1.Get(), input2Value));
+          ++inputIt1;
+          ++outputIt;
+        }
       }
       inputIt1.NextLine();
       outputIt.NextLine();
-      progress.Completed(outputRegionForThread.GetSize()[0]);
+      progress.Completed(lineLength);
     }
   }
   else if (inputPtr2)
@@ -236,15 +269,27 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
     while (!inputIt2.IsAtEnd())
     {
-      while (!inputIt2.IsAtEndOfLine())
+      if constexpr (directPixelAccess)
+      {
+        const Input2ImagePixelType * const input2Line = &inputIt2.Value();
+        OutputImagePixelType * const       outputLine = &outputIt.Value();
+        for (SizeValueType i = 0; i < lineLength; ++i)
+        {
+          outputLine[i] = functor(input1Value, input2Line[i]);
+        }
+      }
+      else
       {
-        outputIt.Set(functor(input1Value, inputIt2.Get()));
-        ++inputIt2;
-        ++outputIt;
+        while (!inputIt2.IsAtEndOfLine())
+        {
+          outputIt.Set(functor(input1Value, inputIt2.Get()));
+          ++inputIt2;
+          ++outputIt;
+        }
       }
       inputIt2.NextLine();
       outputIt.NextLine();
-      progress.Completed(outputRegionForThread.GetSize()[0]);
+      progress.Completed(lineLength);
     }
   }
   else
@@ -0,0 +1,108 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkComposedFunctor_h
+#define itkComposedFunctor_h
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace itk::Functor
+{
+/**
+ * \class ComposedFunctor
+ * \brief Applies a sequence of pixel functors, as a single functor.
+ *
+ * The first functor receives the arguments of the composed functor, and may
+ * therefore take several pixels, e.g. the pixels of the two inputs of a
+ * BinaryGeneratorImageFilter. Every next functor receives the value returned
+ * by the previous one, and the value returned by the last functor is the
+ * value of the composed functor.
+ *
+ * A chain of pixel-wise filters, such as a shift and scale, followed by a
+ * clamp, a threshold and a cast, reads and writes every pixel once per
+ * filter, and allocates an image per filter. The same chain, composed at
+ * compile time and given to a UnaryGeneratorImageFilter or a
+ * BinaryGeneratorImageFilter, reads and writes every pixel once, without
+ * intermediate image. The composed functor is inlined into the loop of the
+ * filter, which the compiler vectorizes when the functors allow it.
+ *
+ * The functors may be ITK functor objects, lambdas or function pointers.
+ * Their operator() must be const, as they are shared by the threads of the
+ * filter. Compose() deduces the type of the composed functor:
+ *
+ * \code
+ * auto filter = itk::UnaryGeneratorImageFilter<FloatImageType, UCharImageType>::New();
+ * filter->SetFunctor(itk::Functor::Compose([](float p) { return 2.0f * p + 10.0f; },
+ *                                          [](float p) { return std::clamp(p, 0.0f, 255.0f); },
+ *                                          [](float p) { return static_cast<unsigned char>(p); }));
+ * \endcode
+ *
+ * \sa UnaryGeneratorImageFilter BinaryGeneratorImageFilter
+ *
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFirstFunctor, typename... TFunctors>
+class ComposedFunctor
+{
+public:
+  ComposedFunctor() = default;
+
+  explicit ComposedFunctor(TFirstFunctor firstFunctor, TFunctors... functors)
+    : m_FirstFunctor(std::move(firstFunctor))
+    , m_Functors(std::move(functors)...)
+  {}
+
+  template <typename... TArguments>
+  auto
+  operator()(const TArguments &... arguments) const
+  {
+    return this->Apply<0>(m_FirstFunctor(arguments...));
+  }
+
+private:
+  template <size_t VIndex, typename TValue>
+  auto
+  Apply(const TValue & value) const
+  {
+    if constexpr (VIndex == sizeof...(TFunctors))
+    {
+      return value;
+    }
+    else
+    {
+      return this->Apply<VIndex + 1>(std::get<VIndex>(m_Functors)(value));
+    }
+  }
+
+  TFirstFunctor            m_FirstFunctor{};
+  std::tuple<TFunctors...> m_Functors{};
+};
+
+
+/** Compose pixel functors, applied from the first to the last one.
+ * \sa ComposedFunctor */
+template <typename TFirstFunctor, typename... TFunctors>
+ComposedFunctor<TFirstFunctor, TFunctors...>
+Compose(TFirstFunctor firstFunctor, TFunctors... functors)
+{
+  return ComposedFunctor<TFirstFunctor, TFunctors...>(std::move(firstFunctor), std::move(functors)...);
+}
+} // namespace itk::Functor
+
+#endif
@@ -18,6 +18,7 @@
 #ifndef itkUnaryGeneratorImageFilter_hxx
 #define itkUnaryGeneratorImageFilter_hxx
 
+#include "itkImageBufferRange.h"
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 #include "itkTotalProgressReporter.h"
@@ -97,13 +98,30 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
 
+  // With direct pixel access, the pixels of a line are contiguous in memory: the functor is applied in a plain
+  // loop over them, which the compiler can vectorize.
+  constexpr bool directPixelAccess = std::is_pointer_v<typename ImageBufferRange<const TInputImage>::iterator> &&
+                                     std::is_pointer_v<typename ImageBufferRange<TOutputImage>::iterator>;
+
   while (!inputIt.IsAtEnd())
   {
-    while (!inputIt.IsAtEndOfLine())
+    if constexpr (directPixelAccess)
+    {
+      const InputImagePixelType * const inputLine = &inputIt.Value();
+      OutputImagePixelType * const      outputLine = &outputIt.Value();
+      for (SizeValueType i = 0; i < regionSize[0]; ++i)
+      {
+        outputLine[i] = functor(inputLine[i]);
+      }
+    }
+    else
     {
-      outputIt.Set(functor(inputIt.Get()));
-      ++inputIt;
-      ++outputIt;
+      while (!inputIt.IsAtEndOfLine())
+      {
+        outputIt.Set(functor(inputIt.Get()));
+        ++inputIt;
+        ++outputIt;
+      }
     }
     progress.Completed(regionSize[0]);
     inputIt.NextLine();
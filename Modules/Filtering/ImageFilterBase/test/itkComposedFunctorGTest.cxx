@@ -0,0 +1,173 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkComposedFunctor.h"
+#include "itkBinaryGeneratorImageFilter.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkUnaryGeneratorImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkGTest.h"
+
+#include <algorithm>
+#include <cstdint>
+
+
+namespace
+{
+using FloatImageType = itk::Image<float, 3>;
+using UCharImageType = itk::Image<uint8_t, 3>;
+
+constexpr float
+ShiftScale(const float p)
+{
+  return 2.0f * p - 20.0f;
+}
+
+constexpr float
+Clamp(const float p)
+{
+  return std::clamp(p, 0.0f, 200.0f);
+}
+
+constexpr uint8_t
+Threshold(const float p)
+{
+  return (p >= 100.0f) ? 255 : 0;
+}
+
+FloatImageType::Pointer
+MakeImage()
+{
+  auto image = FloatImageType::New();
+  image->SetRegions(itk::MakeSize(37, 5, 4));
+  image->Allocate();
+  float value = 0.0f;
+  for (auto & pixel : itk::MakeImageBufferRange(image.GetPointer()))
+  {
+    pixel = value;
+    value += 0.75f;
+  }
+  return image;
+}
+} // namespace
+
+
+TEST(ComposedFunctor, AppliesFunctorsInOrder)
+{
+  const auto composed = itk::Functor::Compose([](int a, int b) { return a - b; },
+                                              [](int p) { return 10 * p; },
+                                              [](int p) { return static_cast<double>(p) + 0.5; });
+  EXPECT_EQ(composed(3, 1), 20.5);
+
+  const auto single = itk::Functor::Compose(&Clamp);
+  EXPECT_EQ(single(-5.0f), 0.0f);
+  EXPECT_EQ(itk::Functor::Compose(&ShiftScale, &Clamp, &Threshold)(70.0f), 255);
+}
+
+
+TEST(ComposedFunctor, FusesUnaryFiltersIntoASinglePass)
+{
+  const auto image = MakeImage();
+
+  auto filter = itk::UnaryGeneratorImageFilter<FloatImageType, UCharImageType>::New();
+  filter->SetInput(image);
+  filter->SetFunctor(itk::Functor::Compose(&ShiftScale, &Clamp, &Threshold));
+
+  // A requested region which is not the whole image: its lines are not adjacent in memory.
+  const itk::ImageRegion<3> requestedRegion({ { 3, 1, 1 } }, { { 30, 3, 2 } });
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+
+  const UCharImageType * const output = filter->GetOutput();
+  for (itk::ImageRegionConstIteratorWithIndex<UCharImageType> it(output, requestedRegion); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), Threshold(Clamp(ShiftScale(image->GetPixel(it.GetIndex()))))) << it.GetIndex();
+  }
+}
+
+
+TEST(ComposedFunctor, FusesBinaryAndUnaryFilters)
+{
+  const auto image1 = MakeImage();
+  const auto image2 = MakeImage();
+
+  const auto difference = [](const float a, const float b) { return a - 0.5f * b; };
+
+  auto filter = itk::BinaryGeneratorImageFilter<FloatImageType, FloatImageType, UCharImageType>::New();
+  filter->SetInput1(image1);
+  filter->SetInput2(image2);
+  filter->SetFunctor(itk::Functor::Compose(difference, &Clamp, &Threshold));
+  filter->Update();
+
+  for (itk::ImageRegionConstIteratorWithIndex<UCharImageType> it(filter->GetOutput(),
+                                                                 filter->GetOutput()->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const float pixel = image1->GetPixel(it.GetIndex());
+    ASSERT_EQ(it.Get(), Threshold(Clamp(difference(pixel, pixel)))) << it.GetIndex();
+  }
+
+  filter->SetConstant2(40.0f);
+  filter->Update();
+
+  for (itk::ImageRegionConstIteratorWithIndex<UCharImageType> it(filter->GetOutput(),
+                                                                 filter->GetOutput()->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    ASSERT_EQ(it.Get(), Threshold(Clamp(difference(image1->GetPixel(it.GetIndex()), 40.0f)))) << it.GetIndex();
+  }
+}
+
+
+TEST(ComposedFunctor, SupportsImagesWithoutDirectPixelAccess)
+{
+  using VectorImageType = itk::VectorImage<float, 2>;
+  using PixelType = VectorImageType::PixelType;
+
+  auto image = VectorImageType::New();
+  image->SetRegions(itk::MakeSize(7, 3));
+  image->SetVectorLength(2);
+  image->Allocate();
+  PixelType pixel(2);
+  pixel[0] = 1.0f;
+  pixel[1] = 300.0f;
+  image->FillBuffer(pixel);
+
+  const auto clampComponents = [](const PixelType & p) {
+    PixelType result(p.GetSize());
+    for (unsigned int i = 0; i < p.GetSize(); ++i)
+    {
+      result[i] = Clamp(p[i]);
+    }
+    return result;
+  };
+
+  auto filter = itk::UnaryGeneratorImageFilter<VectorImageType, VectorImageType>::New();
+  filter->SetInput(image);
+  filter->SetFunctor(itk::Functor::Compose([](const PixelType & p) { return PixelType(p * 2.0f); }, clampComponents));
+  filter->Update();
+
+  const PixelType result = filter->GetOutput()->GetPixel({ { 6, 2 } });
+  EXPECT_EQ(result[0], 2.0f);
+  EXPECT_EQ(result[1], 200.0f);
+}
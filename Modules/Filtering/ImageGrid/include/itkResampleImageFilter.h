@@ -21,6 +21,7 @@
 #include "itkFixedArray.h"
 #include "itkTransform.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkImageToImageFilter.h"
 #include "itkExtrapolateImageFunction.h"
 #include "itkLinearInterpolateImageFunction.h"
@@ -28,6 +29,8 @@
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDataObjectDecorator.h"
 
+#include <type_traits> // For is_same_v and is_arithmetic_v.
+
 
 namespace itk
 {
@@ -370,6 +373,37 @@ private:
   static PixelType
   CastPixelWithBoundsChecking(const TPixel value);
 
+  /** Whether the input is an itk::Image of scalars, which LinearThreadedGenerateData may interpolate directly from
+   * its buffer. */
+  static constexpr bool IsInputSupportedByBufferInterpolation =
+    std::is_same_v<InputImageType, Image<InputPixelType, InputImageDimension>> && std::is_arithmetic_v<InputPixelType>;
+
+  /** Interpolations that LinearThreadedGenerateData may evaluate directly on the input buffer, instead of calling
+   * m_Interpolator for each pixel. */
+  enum class BufferInterpolationEnum : uint8_t
+  {
+    None,
+    Linear,
+    NearestNeighbor
+  };
+
+  /** Returns the buffer interpolation that yields the same values as m_Interpolator, or None when m_Interpolator is
+   * not exactly a LinearInterpolateImageFunction or NearestNeighborInterpolateImageFunction, or when the input is
+   * not an itk::Image of scalars. Linear interpolation is only evaluated on the buffer of images of at most three
+   * dimensions. */
+  BufferInterpolationEnum
+  GetBufferInterpolation() const;
+
+  /** Interpolates the output pixels from scanlineIndex up to (but excluding) scanlineEnd, along the current line of
+   * outIt, directly from the input buffer. inputIndexAt maps an output index value along the line to its continuous
+   * input index, which must lie in the part of the buffer where the interpolation needs no boundary handling. */
+  template <bool VNearestNeighbor, typename TInputIndexFunction>
+  void
+  InterpolateScanlineFromBuffer(ImageScanlineIterator<OutputImageType> & outIt,
+                                IndexValueType                           scanlineIndex,
+                                IndexValueType                           scanlineEnd,
+                                const TInputIndexFunction &              inputIndexAt) const;
+
   void
   InitializeTransform();
 
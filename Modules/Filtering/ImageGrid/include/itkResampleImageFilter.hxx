@@ -26,9 +26,13 @@
 #include "itkSpecialCoordinatesImage.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkImageAlgorithm.h"
+#include "itkMath.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 
-#include <algorithm>   // For max.
+#include <algorithm>   // For clamp, max and min.
+#include <cmath>       // For ceil and floor.
 #include <type_traits> // For is_same.
+#include <typeinfo>    // For typeid.
 #include "itkPrintHelper.h"
 
 namespace itk
@@ -460,6 +464,38 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
   };
 
+  // For the linear and nearest neighbor interpolators, the part of each scan line that maps to the interior of the
+  // input buffer is interpolated directly from the buffer. The interior is where the continuous index lies in
+  // [interiorLower, interiorUpper) along each dimension: for linear interpolation, where all neighbors are inside the
+  // buffer, and for nearest neighbor interpolation, where IsInsideBuffer holds.
+  const BufferInterpolationEnum bufferInterpolation = this->GetBufferInterpolation();
+  ContinuousInputIndexType      interiorLower;
+  ContinuousInputIndexType      interiorUpper;
+  {
+    const typename InputImageType::RegionType & bufferedRegion = inputPtr->GetBufferedRegion();
+    const double margin = (bufferInterpolation == BufferInterpolationEnum::NearestNeighbor) ? 0.5 : 0.0;
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      const auto lastIndexValue =
+        bufferedRegion.GetIndex(i) + static_cast<IndexValueType>(bufferedRegion.GetSize(i)) - 1;
+      interiorLower[i] = static_cast<TInterpolatorPrecisionType>(bufferedRegion.GetIndex(i) - margin);
+      interiorUpper[i] = static_cast<TInterpolatorPrecisionType>(lastIndexValue + margin);
+    }
+  }
+  const auto isInInterior = [&interiorLower, &interiorUpper](const ContinuousInputIndexType & inputIndex) {
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      // Test for negative of a positive so we can catch NaN's.
+      if (!(inputIndex[i] >= interiorLower[i] && inputIndex[i] < interiorUpper[i]))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const auto scanlineSize = static_cast<IndexValueType>(outputRegionForThread.GetSize(0));
+
   // Create an iterator that will walk the output region for this thread.
   for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
@@ -475,13 +511,9 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     index[0] += firstSizeValueOfLargestPossibleRegion;
     const auto vectorFromStartIndex = transformIndex(index) - startIndex;
 
-    IndexValueType scanlineIndex = computedIndex[0];
-
-
-    while (!outIt.IsAtEndOfLine())
-    {
-
-      // Perform linear interpolation from startIndex, along vectorFromStartIndex
+    // Perform linear interpolation from startIndex, along vectorFromStartIndex
+    const auto inputIndexAt = [&startIndex, &vectorFromStartIndex, firstIndexValueOfLargestPossibleRegion,
+                               firstSizeValueOfLargestPossibleRegion](const IndexValueType scanlineIndex) {
       const double alpha =
         (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
@@ -490,6 +522,11 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       {
         inputIndex[i] += alpha * vectorFromStartIndex[i];
       }
+      return inputIndex;
+    };
+
+    const auto evaluateAt = [this, &outIt, &inputIndexAt, &defaultValue](const IndexValueType scanlineIndex) {
+      const ContinuousInputIndexType inputIndex = inputIndexAt(scanlineIndex);
 
       // Evaluate input at right position and copy to the output
       if (m_Interpolator->IsInsideBuffer(inputIndex))
@@ -507,14 +544,224 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
           outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
         }
       }
+    };
+
+    const IndexValueType scanlineBegin = computedIndex[0];
+    const IndexValueType scanlineEnd = scanlineBegin + scanlineSize;
+
+    // The continuous index moves linearly along the scan line, so its interior part is a single run of pixels.
+    // Estimate the run analytically, then correct the estimate for rounding by testing the pixels at its ends.
+    IndexValueType interiorBegin = scanlineEnd;
+    IndexValueType interiorEnd = scanlineEnd;
+    if (bufferInterpolation != BufferInterpolationEnum::None)
+    {
+      double alphaBegin = 0.0;
+      double alphaEnd = 1.0;
+      for (unsigned int i = 0; i < InputImageDimension; ++i)
+      {
+        const double lowerAlpha = (interiorLower[i] - startIndex[i]) / vectorFromStartIndex[i];
+        const double upperAlpha = (interiorUpper[i] - startIndex[i]) / vectorFromStartIndex[i];
+        alphaBegin = std::max(alphaBegin, std::min(lowerAlpha, upperAlpha));
+        alphaEnd = std::min(alphaEnd, std::max(lowerAlpha, upperAlpha));
+      }
+      const auto toScanlineIndex = [=](const double value) {
+        // Also maps NaN to the begin of the scan line.
+        return (value > scanlineBegin) ? static_cast<IndexValueType>(std::min<double>(value, scanlineEnd))
+                                       : scanlineBegin;
+      };
+      interiorBegin = toScanlineIndex(
+        std::ceil(firstIndexValueOfLargestPossibleRegion + alphaBegin * firstSizeValueOfLargestPossibleRegion));
+      interiorEnd = std::max(
+        interiorBegin,
+        toScanlineIndex(
+          std::floor(firstIndexValueOfLargestPossibleRegion + alphaEnd * firstSizeValueOfLargestPossibleRegion) + 1));
+
+      while (interiorBegin < interiorEnd && !isInInterior(inputIndexAt(interiorBegin)))
+      {
+        ++interiorBegin;
+      }
+      while (interiorEnd > interiorBegin && !isInInterior(inputIndexAt(interiorEnd - 1)))
+      {
+        --interiorEnd;
+      }
+      if (interiorBegin < interiorEnd)
+      {
+        while (interiorBegin > scanlineBegin && isInInterior(inputIndexAt(interiorBegin - 1)))
+        {
+          --interiorBegin;
+        }
+        while (interiorEnd < scanlineEnd && isInInterior(inputIndexAt(interiorEnd)))
+        {
+          ++interiorEnd;
+        }
+      }
+    }
 
-      ++outIt;
-      ++scanlineIndex;
+    IndexValueType scanlineIndex = scanlineBegin;
+    for (; scanlineIndex < interiorBegin; ++scanlineIndex, ++outIt)
+    {
+      evaluateAt(scanlineIndex);
+    }
+    if constexpr (IsInputSupportedByBufferInterpolation)
+    {
+      if (bufferInterpolation == BufferInterpolationEnum::Linear)
+      {
+        this->template InterpolateScanlineFromBuffer<false>(outIt, scanlineIndex, interiorEnd, inputIndexAt);
+      }
+      else if (bufferInterpolation == BufferInterpolationEnum::NearestNeighbor)
+      {
+        this->template InterpolateScanlineFromBuffer<true>(outIt, scanlineIndex, interiorEnd, inputIndexAt);
+      }
+    }
+    for (scanlineIndex = interiorEnd; scanlineIndex < scanlineEnd; ++scanlineIndex, ++outIt)
+    {
+      evaluateAt(scanlineIndex);
     }
     progress.Completed(outputRegionForThread.GetSize()[0]);
   }
 }
 
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+auto
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  GetBufferInterpolation() const -> BufferInterpolationEnum
+{
+  if constexpr (IsInputSupportedByBufferInterpolation)
+  {
+    using NearestNeighborInterpolatorType =
+      NearestNeighborInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+
+    // Derived interpolators may override the evaluation, so the type must match exactly.
+    // Above three dimensions, LinearInterpolateImageFunction uses EvaluateUnoptimized, whose arithmetic differs.
+    const InterpolatorType & interpolator = *m_Interpolator;
+    if (InputImageDimension <= 3 && typeid(interpolator) == typeid(LinearInterpolatorType))
+    {
+      return BufferInterpolationEnum::Linear;
+    }
+    if (typeid(interpolator) == typeid(NearestNeighborInterpolatorType))
+    {
+      return BufferInterpolationEnum::NearestNeighbor;
+    }
+  }
+  return BufferInterpolationEnum::None;
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+template <bool VNearestNeighbor, typename TInputIndexFunction>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  InterpolateScanlineFromBuffer(ImageScanlineIterator<OutputImageType> & outIt,
+                                IndexValueType                           scanlineIndex,
+                                const IndexValueType                     scanlineEnd,
+                                const TInputIndexFunction &              inputIndexAt) const
+{
+  using RealType = typename InterpolatorType::RealType;
+
+  constexpr unsigned int numberOfNeighbors = VNearestNeighbor ? 1 : (1u << InputImageDimension);
+
+  const InputImageType * const                inputPtr = this->GetInput();
+  const InputPixelType * const                buffer = inputPtr->GetBufferPointer();
+  const OffsetValueType * const               offsetTable = inputPtr->GetOffsetTable();
+  const typename InputImageType::RegionType & bufferedRegion = inputPtr->GetBufferedRegion();
+
+  // Range of the nearest neighbor index, or of the base index of a linear interpolation. Clamping to it does not
+  // change any index inside the interior of the buffer, it only guarantees that the buffer is never read out of
+  // bounds.
+  IndexValueType firstIndexValues[InputImageDimension];
+  IndexValueType lastIndexValues[InputImageDimension];
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    firstIndexValues[i] = bufferedRegion.GetIndex(i);
+    lastIndexValues[i] = firstIndexValues[i] + static_cast<IndexValueType>(bufferedRegion.GetSize(i)) -
+                         (VNearestNeighbor ? 1 : 2);
+  }
+
+  // Offsets of the neighbors of a linear interpolation from its base index. Bit i of the neighbor number selects the
+  // next index along dimension i.
+  OffsetValueType neighborOffsets[numberOfNeighbors];
+  for (unsigned int n = 0; n < numberOfNeighbors; ++n)
+  {
+    neighborOffsets[n] = 0;
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      if (n & (1u << i))
+      {
+        neighborOffsets[n] += offsetTable[i];
+      }
+    }
+  }
+
+  // Process the pixels in blocks: first compute the buffer offsets (and interpolation distances) of all pixels of a
+  // block, which are independent of each other, then read and interpolate the neighbors.
+  constexpr IndexValueType                    blockSize = 64;
+  OffsetValueType                             offsets[blockSize];
+  [[maybe_unused]] TInterpolatorPrecisionType distances[InputImageDimension][blockSize];
+
+  while (scanlineIndex < scanlineEnd)
+  {
+    const IndexValueType numberOfPixels = std::min(blockSize, scanlineEnd - scanlineIndex);
+
+    for (IndexValueType k = 0; k < numberOfPixels; ++k)
+    {
+      const ContinuousInputIndexType inputIndex = inputIndexAt(scanlineIndex + k);
+
+      OffsetValueType offset = 0;
+      for (unsigned int i = 0; i < InputImageDimension; ++i)
+      {
+        if constexpr (VNearestNeighbor)
+        {
+          const IndexValueType nearestIndexValue =
+            std::clamp(Math::Round<IndexValueType>(inputIndex[i]), firstIndexValues[i], lastIndexValues[i]);
+          offset += (nearestIndexValue - firstIndexValues[i]) * offsetTable[i];
+        }
+        else
+        {
+          const IndexValueType baseIndexValue =
+            std::clamp(Math::Floor<IndexValueType>(inputIndex[i]), firstIndexValues[i], lastIndexValues[i]);
+          distances[i][k] = inputIndex[i] - static_cast<TInterpolatorPrecisionType>(baseIndexValue);
+          offset += (baseIndexValue - firstIndexValues[i]) * offsetTable[i];
+        }
+      }
+      offsets[k] = offset;
+    }
+
+    for (IndexValueType k = 0; k < numberOfPixels; ++k, ++outIt)
+    {
+      if constexpr (VNearestNeighbor)
+      {
+        outIt.Set(Self::CastPixelWithBoundsChecking(static_cast<InterpolatorOutputType>(buffer[offsets[k]])));
+      }
+      else
+      {
+        // Interpolate along dimension 0 first, then along dimension 1, and so on, in the same order and precision
+        // as LinearInterpolateImageFunction, so that both yield the same values.
+        const InputPixelType * const base = buffer + offsets[k];
+        RealType                     values[numberOfNeighbors];
+        for (unsigned int n = 0; n < numberOfNeighbors; ++n)
+        {
+          values[n] = static_cast<RealType>(base[neighborOffsets[n]]);
+        }
+        for (unsigned int i = 0; i < InputImageDimension; ++i)
+        {
+          for (unsigned int n = 0; n < (numberOfNeighbors >> (i + 1)); ++n)
+          {
+            values[n] =
+              static_cast<RealType>(values[2 * n] + (values[2 * n + 1] - values[2 * n]) * distances[i][k]);
+          }
+        }
+        outIt.Set(Self::CastPixelWithBoundsChecking(static_cast<InterpolatorOutputType>(values[0])));
+      }
+    }
+    scanlineIndex += numberOfPixels;
+  }
+}
+
 template <typename TInputImage,
           typename TOutputImage,
           typename TInterpolatorPrecisionType,
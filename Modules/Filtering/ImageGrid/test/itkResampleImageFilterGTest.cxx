@@ -25,6 +25,7 @@
 #include "itkImage.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 #include "itkStreamingImageFilter.h"
 
 // Google Test header file:
@@ -117,6 +118,43 @@ Expect_ResampleImageFilter_thows_on_incomplete_configuration(const TPixel inputP
   EXPECT_EQ(TestThrowErrorOnEmptyResampleSpace(inputPixel, true), inputPixel);
 }
 
+
+// Interpolator that evaluates exactly like TInterpolator, but is not one of the interpolators which
+// ResampleImageFilter evaluates directly on the input buffer.
+template <typename TInterpolator>
+class DerivedInterpolator : public TInterpolator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DerivedInterpolator);
+
+  using Self = DerivedInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+protected:
+  DerivedInterpolator() = default;
+  ~DerivedInterpolator() override = default;
+};
+
+
+// Resamples the input with a ResampleImageFilter that uses the specified interpolator and transform, and returns the
+// output, which is partially outside the input.
+template <typename TImage, typename TInterpolator, typename TTransform>
+typename TImage::Pointer
+Resample(const TImage & input, TInterpolator & interpolator, const TTransform & transform)
+{
+  const auto filter = itk::ResampleImageFilter<TImage, TImage>::New();
+  filter->SetInput(&input);
+  filter->SetInterpolator(&interpolator);
+  filter->SetTransform(&transform);
+  filter->SetSize(TImage::SizeType::Filled(40));
+  filter->SetOutputOrigin(itk::MakeFilled<typename TImage::PointType>(-5.0));
+  filter->SetDefaultPixelValue(7);
+  filter->Update();
+  return filter->GetOutput();
+}
+
 } // namespace
 
 // Compile time check of mixing transform and precision types
@@ -241,3 +279,77 @@ TEST(ResampleImageFilter, StreamingMatchesNonStreamedWithGaussianInterpolator)
   }
   EXPECT_EQ(itU.IsAtEnd(), itS.IsAtEnd());
 }
+
+
+// The linear and nearest neighbor interpolators are evaluated directly on the input buffer, in the interior of the
+// input. Check that this yields exactly the values of the interpolator itself.
+TEST(ResampleImageFilter, BufferInterpolationMatchesInterpolator)
+{
+  constexpr unsigned int Dimension{ 3 };
+  using ImageType = itk::Image<uint8_t, Dimension>;
+  using TransformType = itk::AffineTransform<double, Dimension>;
+  using LinearInterpolatorType = itk::LinearInterpolateImageFunction<ImageType>;
+  using NearestNeighborInterpolatorType = itk::NearestNeighborInterpolateImageFunction<ImageType>;
+
+  const auto input = ImageType::New();
+  input->SetRegions(ImageType::SizeType{ { 23, 19, 17 } });
+  input->Allocate();
+
+  std::default_random_engine randomEngine;
+  for (itk::ImageRegionIterator<ImageType> it(input, input->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<uint8_t>(std::uniform_int_distribution<>{ 0, 255 }(randomEngine)));
+  }
+
+  // An axis aligned transform, for which the scan lines do not move along dimensions 1 and 2, and a rotation.
+  const auto scaling = TransformType::New();
+  scaling->Scale(0.7);
+  scaling->Translate(itk::MakeFilled<TransformType::OutputVectorType>(0.25));
+
+  const auto rotation = TransformType::New();
+  rotation->Rotate3D(itk::MakeFilled<TransformType::OutputVectorType>(1.0), 0.4);
+  rotation->Scale(0.6);
+
+  for (const TransformType * const transform : { scaling.get(), rotation.get() })
+  {
+    const auto linearOutput = Resample(*input, *LinearInterpolatorType::New(), *transform);
+    const auto expectedLinearOutput = Resample(*input, *DerivedInterpolator<LinearInterpolatorType>::New(), *transform);
+    const auto nearestNeighborOutput = Resample(*input, *NearestNeighborInterpolatorType::New(), *transform);
+    const auto expectedNearestNeighborOutput =
+      Resample(*input, *DerivedInterpolator<NearestNeighborInterpolatorType>::New(), *transform);
+
+    EXPECT_EQ(*linearOutput, *expectedLinearOutput);
+    EXPECT_EQ(*nearestNeighborOutput, *expectedNearestNeighborOutput);
+  }
+}
+
+
+// LinearInterpolateImageFunction has its own arithmetic for images of more than three dimensions. Check that the
+// output of a four-dimensional resampling is still exactly that of the interpolator.
+TEST(ResampleImageFilter, BufferInterpolationMatchesInterpolatorIn4D)
+{
+  constexpr unsigned int Dimension{ 4 };
+  using ImageType = itk::Image<float, Dimension>;
+  using TransformType = itk::AffineTransform<double, Dimension>;
+  using LinearInterpolatorType = itk::LinearInterpolateImageFunction<ImageType>;
+  using NearestNeighborInterpolatorType = itk::NearestNeighborInterpolateImageFunction<ImageType>;
+
+  const auto input = ImageType::New();
+  input->SetRegions(ImageType::SizeType{ { 13, 11, 9, 7 } });
+  input->Allocate();
+
+  std::default_random_engine randomEngine;
+  for (itk::ImageRegionIterator<ImageType> it(input, input->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(std::uniform_real_distribution<float>{ -100.0f, 100.0f }(randomEngine));
+  }
+
+  const auto transform = TransformType::New();
+  transform->Scale(0.3);
+  transform->Translate(itk::MakeFilled<TransformType::OutputVectorType>(0.35));
+
+  EXPECT_EQ(*Resample(*input, *LinearInterpolatorType::New(), *transform),
+            *Resample(*input, *DerivedInterpolator<LinearInterpolatorType>::New(), *transform));
+  EXPECT_EQ(*Resample(*input, *NearestNeighborInterpolatorType::New(), *transform),
+            *Resample(*input, *DerivedInterpolator<NearestNeighborInterpolatorType>::New(), *transform));
+}
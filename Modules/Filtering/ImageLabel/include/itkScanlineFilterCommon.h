@@ -20,10 +20,13 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkConstShapedNeighborhoodIterator.h"
+#include <algorithm>
 #include <atomic>
 #include <deque>
 #include <functional>
 #include <mutex>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 namespace itk
@@ -130,7 +133,7 @@ protected:
 
   using LineMapType = std::vector<LineEncodingType>;
 
-  using UnionFindType = std::vector<InternalLabelType>;
+  using UnionFindType = std::vector<std::atomic<InternalLabelType>>;
   using ConsecutiveVectorType = std::vector<OutputPixelType>;
 
   SizeValueType
@@ -149,79 +152,152 @@ protected:
     return linearIndex;
   }
 
+  /** Label the runs of the lines consecutively in raster order, starting from
+   * 1, and make each of them its own set. */
   void
   InitUnion(InternalLabelType numberOfLabels)
   {
     m_UnionFind = UnionFindType(numberOfLabels + 1);
-
-    const auto        MapBegin = m_LineMap.begin();
-    const auto        MapEnd = m_LineMap.end();
-    InternalLabelType label = 1;
-    for (typename LineMapType::iterator LineIt = MapBegin; LineIt != MapEnd; ++LineIt)
-    {
-      for (auto cIt = LineIt->begin(); cIt != LineIt->end(); ++cIt)
-      {
-        cIt->label = label;
-        m_UnionFind[label] = label;
-        ++label;
-      }
-    }
+    m_UnionFind[0].store(0, std::memory_order_relaxed);
+
+    // The first label of each block of lines is the number of runs of the
+    // preceding blocks, plus one.
+    const std::vector<SizeValueType> firstLabels =
+      this->ComputeBlockOffsets(m_LineMap.size(), [this](SizeValueType lineIndex) -> SizeValueType {
+        return m_LineMap[lineIndex].size();
+      });
+
+    this->ParallelizeBlocks(
+      m_LineMap.size(), [this, &firstLabels](SizeValueType block, SizeValueType begin, SizeValueType end) {
+        InternalLabelType label = firstLabels[block] + 1;
+        for (SizeValueType lineIndex = begin; lineIndex < end; ++lineIndex)
+        {
+          for (auto & run : m_LineMap[lineIndex])
+          {
+            run.label = label;
+            m_UnionFind[label].store(label, std::memory_order_relaxed);
+            ++label;
+          }
+        }
+      });
   }
 
+  /** Find the representative of the set of the label, the smallest label of
+   * the set. Each label on the path to it is linked to its grandparent along
+   * the way. It may be called concurrently with itself and with
+   * LinkLabels(). */
   InternalLabelType
   LookupSet(const InternalLabelType label)
   {
     InternalLabelType l = label;
-    while (l != m_UnionFind[l])
+    InternalLabelType parent = m_UnionFind[l].load(std::memory_order_relaxed);
+    while (l != parent)
     {
-      l = m_UnionFind[l]; // transitively sets equivalence
+      const InternalLabelType grandParent = m_UnionFind[parent].load(std::memory_order_relaxed);
+      if (parent != grandParent)
+      {
+        // Any ancestor of a label is a valid parent, so concurrent stores are
+        // harmless.
+        m_UnionFind[l].store(grandParent, std::memory_order_relaxed);
+      }
+      l = parent;
+      parent = grandParent;
     }
     return l;
   }
 
+  /** Merge the sets of the two labels. The larger representative is linked to
+   * the smaller one by a compare-and-swap, which fails when another thread
+   * linked it meanwhile, so that the sets are merged without locking, while
+   * every label remains larger than its parent. */
   void
   LinkLabels(const InternalLabelType label1, const InternalLabelType label2)
   {
-    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
-    const InternalLabelType           E1 = this->LookupSet(label1);
-    const InternalLabelType           E2 = this->LookupSet(label2);
-
-    if (E1 < E2)
+    InternalLabelType E1 = label1;
+    InternalLabelType E2 = label2;
+    while (true)
     {
-      m_UnionFind[E2] = E1;
-    }
-    else
-    {
-      m_UnionFind[E1] = E2;
+      E1 = this->LookupSet(E1);
+      E2 = this->LookupSet(E2);
+      if (E1 == E2)
+      {
+        return;
+      }
+      if (E1 > E2)
+      {
+        std::swap(E1, E2);
+      }
+      InternalLabelType expected = E2;
+      if (m_UnionFind[E2].compare_exchange_strong(expected, E1, std::memory_order_relaxed))
+      {
+        return;
+      }
     }
   }
 
+  /** Number the sets consecutively, in the order of their representatives,
+   * skipping the background value, and point every label directly to the
+   * representative of its set. Returns the number of sets. */
   SizeValueType
   CreateConsecutive(OutputPixelType backgroundValue)
   {
-    const size_t N = m_UnionFind.size();
+    const SizeValueType N = m_UnionFind.size();
 
     m_Consecutive = ConsecutiveVectorType(N);
+    if (N == 0)
+    {
+      return 0;
+    }
     m_Consecutive[0] = backgroundValue;
 
-    OutputPixelType consecutiveLabel = 0;
-    SizeValueType   count = 0;
+    // The number of representatives of the labels 1 to N - 1 preceding each
+    // block.
+    const SizeValueType              numberOfLabels = N - 1;
+    const std::vector<SizeValueType> firstCounts =
+      this->ComputeBlockOffsets(numberOfLabels, [this](SizeValueType index) -> SizeValueType {
+        return m_UnionFind[index + 1].load(std::memory_order_relaxed) == index + 1;
+      });
+
+    this->ParallelizeBlocks(
+      numberOfLabels,
+      [this, &firstCounts, backgroundValue](SizeValueType block, SizeValueType begin, SizeValueType end) {
+        // The labels of the preceding representatives skipped the background
+        // value if it is one of them.
+        auto consecutiveLabel = static_cast<OutputPixelType>(firstCounts[block]);
+        if (NumericTraits<OutputPixelType>::IsNonnegative(backgroundValue) && backgroundValue < consecutiveLabel &&
+            static_cast<OutputPixelType>(static_cast<SizeValueType>(backgroundValue)) == backgroundValue)
+        {
+          ++consecutiveLabel;
+        }
+        for (SizeValueType i = begin + 1; i <= end; ++i)
+        {
+          if (m_UnionFind[i].load(std::memory_order_relaxed) == i)
+          {
+            if (consecutiveLabel == backgroundValue)
+            {
+              ++consecutiveLabel;
+            }
+            m_Consecutive[i] = consecutiveLabel;
+            ++consecutiveLabel;
+          }
+        }
+      });
 
-    for (size_t i = 1; i < N; ++i)
-    {
-      const auto label = static_cast<size_t>(m_UnionFind[i]);
-      if (label == i)
+    // Now that the representatives are numbered, flatten the sets. The
+    // representatives keep their numbers: other blocks read them meanwhile.
+    this->ParallelizeBlocks(numberOfLabels, [this](SizeValueType, SizeValueType begin, SizeValueType end) {
+      for (SizeValueType i = begin + 1; i <= end; ++i)
       {
-        if (consecutiveLabel == backgroundValue)
+        const InternalLabelType representative = this->LookupSet(i);
+        if (representative != i)
         {
-          ++consecutiveLabel;
+          m_UnionFind[i].store(representative, std::memory_order_relaxed);
+          m_Consecutive[i] = m_Consecutive[representative];
         }
-        m_Consecutive[label] = consecutiveLabel;
-        ++consecutiveLabel;
-        ++count;
       }
-    }
-    return count;
+    });
+
+    return firstCounts.back();
   }
 
   bool
@@ -434,6 +510,49 @@ protected:
     }
   }
 
+  /** Split the range [0, size) into blocks of consecutive indices, one per
+   * work unit of the enclosing filter, and call the function on the blocks
+   * concurrently, with the index of the block and its range [begin, end). */
+  template <typename TFunction>
+  void
+  ParallelizeBlocks(SizeValueType size, TFunction && function)
+  {
+    const SizeValueType numberOfBlocks = this->GetNumberOfBlocks(size);
+    m_EnclosingFilter->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [size, numberOfBlocks, &function](SizeValueType block) {
+        function(block, block * size / numberOfBlocks, (block + 1) * size / numberOfBlocks);
+      },
+      nullptr);
+  }
+
+  /** The sums of the counts of the indices preceding each block of
+   * ParallelizeBlocks(), followed by the total count. */
+  template <typename TCountFunction>
+  std::vector<SizeValueType>
+  ComputeBlockOffsets(SizeValueType size, TCountFunction && count)
+  {
+    std::vector<SizeValueType> offsets(this->GetNumberOfBlocks(size) + 1, 0);
+    this->ParallelizeBlocks(size, [&offsets, &count](SizeValueType block, SizeValueType begin, SizeValueType end) {
+      SizeValueType blockCount = 0;
+      for (SizeValueType index = begin; index < end; ++index)
+      {
+        blockCount += count(index);
+      }
+      offsets[block + 1] = blockCount;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    return offsets;
+  }
+
+  SizeValueType
+  GetNumberOfBlocks(SizeValueType size) const
+  {
+    const SizeValueType numberOfWorkUnits = m_EnclosingFilter->GetMultiThreader()->GetNumberOfWorkUnits();
+    return std::max<SizeValueType>(1, std::min(size, numberOfWorkUnits));
+  }
+
   WeakPointer<EnclosingFilter> m_EnclosingFilter;
 
   struct WorkUnitData
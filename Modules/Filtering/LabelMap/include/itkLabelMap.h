@@ -21,6 +21,8 @@
 #include "itkImageBase.h"
 #include "itkWeakPointer.h"
 #include <map>
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -44,6 +46,25 @@ namespace itk
  * L is the number of lines in the image (imageSize[1] * imageSize[2] for a 3D
  * image).
  *
+ * The label objects are found by their label in constant time when the labels
+ * are small non-negative integers, e.g. the consecutive labels of connected
+ * components, and in logarithmic time otherwise.
+ *
+ * Each label object is a separate object. By default, each one holds its own
+ * lines. PackLines() stores the lines of all the label objects in a single
+ * contiguous array instead, sorted by label, in which each label object
+ * refers to its range of lines. Reading the lines of the label objects in
+ * order then goes through memory sequentially, and the lines take a single
+ * allocation, without the spare capacity of the vectors of the label
+ * objects. This suits label maps of many small objects, e.g. cell
+ * segmentations, once they are built. A label object copies its lines out
+ * of the array before they are modified, so the label objects keep the same
+ * interface, and the filters work on packed label maps unchanged, e.g.:
+   \code
+   labelImageToShapeLabelMapFilter->Update();
+   labelImageToShapeLabelMapFilter->GetOutput()->PackLines();
+   \endcode
+ *
  * To iterate over the LabelObjects in the map, use:
    \code
    for(unsigned int i = 0; i < filter->GetOutput()->GetNumberOfLabelObjects(); ++i)
@@ -311,6 +332,14 @@ public:
   void
   Optimize();
 
+  /**
+   * Store the lines of all the label objects in a single array, in the order
+   * of their labels, which the label objects share until their lines are
+   * modified.
+   */
+  void
+  PackLines();
+
   /**
    * \class ConstIterator
    * \brief A forward iterator over the LabelObjects of a LabelMap
@@ -473,6 +502,21 @@ private:
   LabelObjectContainerType m_LabelObjectContainer{};
   LabelType                m_BackgroundValue{};
 
+  /** Lookup table of the label objects of the small non-negative integer
+   * labels, indexed by label, holding nullptr for the absent labels. */
+  std::vector<LabelObjectType *> m_LabelObjectLookupTable{};
+
+  static constexpr bool UseLabelObjectLookupTable =
+    std::is_integral_v<LabelType> && !std::is_same_v<LabelType, bool>;
+
+  /** The label object of the label, or nullptr if there is none. */
+  LabelObjectType *
+  FindLabelObject(const LabelType & label) const;
+
+  /** Update the lookup table for a label object added with the label. */
+  void
+  AddToLabelObjectLookupTable(const LabelType & label, LabelObjectType * labelObject);
+
   void
   AddPixel(const LabelObjectContainerIterator & it, const IndexType & idx, const LabelType & label);
 
@@ -80,6 +80,7 @@ LabelMap<TLabelObject>::Graft(const Self * imgData)
     m_LabelObjectContainer.clear();
     LabelObjectContainerType newLabelObjectContainer(imgData->m_LabelObjectContainer);
     std::swap(m_LabelObjectContainer, newLabelObjectContainer);
+    m_LabelObjectLookupTable = imgData->m_LabelObjectLookupTable;
   }
   m_BackgroundValue = imgData->m_BackgroundValue;
 }
@@ -115,14 +116,14 @@ LabelMap<TLabelObject>::GetLabelObject(const LabelType & label) -> LabelObjectTy
     itkExceptionMacro("Label " << static_cast<typename NumericTraits<LabelType>::PrintType>(label)
                                << " is the background label.");
   }
-  auto it = m_LabelObjectContainer.find(label);
-  if (it == m_LabelObjectContainer.end())
+  LabelObjectType * labelObject = this->FindLabelObject(label);
+  if (labelObject == nullptr)
   {
     itkExceptionMacro("No label object with label " << static_cast<typename NumericTraits<LabelType>::PrintType>(label)
                                                     << '.');
   }
 
-  return it->second;
+  return labelObject;
 }
 
 
@@ -135,14 +136,14 @@ LabelMap<TLabelObject>::GetLabelObject(const LabelType & label) const -> const L
     itkExceptionMacro("Label " << static_cast<typename NumericTraits<LabelType>::PrintType>(label)
                                << " is the background label.");
   }
-  auto it = m_LabelObjectContainer.find(label);
-  if (it == m_LabelObjectContainer.end())
+  LabelObjectType * labelObject = this->FindLabelObject(label);
+  if (labelObject == nullptr)
   {
     itkExceptionMacro("No label object with label " << static_cast<typename NumericTraits<LabelType>::PrintType>(label)
                                                     << '.');
   }
 
-  return it->second;
+  return labelObject;
 }
 
 
@@ -150,7 +151,61 @@ template <typename TLabelObject>
 bool
 LabelMap<TLabelObject>::HasLabel(const LabelType label) const
 {
-  return m_LabelObjectContainer.find(label) != m_LabelObjectContainer.end();
+  return this->FindLabelObject(label) != nullptr;
+}
+
+
+template <typename TLabelObject>
+auto
+LabelMap<TLabelObject>::FindLabelObject(const LabelType & label) const -> LabelObjectType *
+{
+  if constexpr (UseLabelObjectLookupTable)
+  {
+    const auto index = static_cast<SizeValueType>(static_cast<std::make_unsigned_t<LabelType>>(label));
+    if (index < m_LabelObjectLookupTable.size())
+    {
+      return m_LabelObjectLookupTable[index];
+    }
+  }
+  const auto it = m_LabelObjectContainer.find(label);
+  return it != m_LabelObjectContainer.end() ? it->second.GetPointer() : nullptr;
+}
+
+
+template <typename TLabelObject>
+void
+LabelMap<TLabelObject>::AddToLabelObjectLookupTable(const LabelType & label, LabelObjectType * labelObject)
+{
+  if constexpr (UseLabelObjectLookupTable)
+  {
+    using UnsignedLabelType = std::make_unsigned_t<LabelType>;
+    const auto index = static_cast<SizeValueType>(static_cast<UnsignedLabelType>(label));
+    if (index >= m_LabelObjectLookupTable.size())
+    {
+      // Grow the table geometrically, up to a size proportional to the number
+      // of label objects, so that sparse labels do not waste memory.
+      const SizeValueType limit =
+        std::min(std::max(SizeValueType{ 1024 }, 8 * static_cast<SizeValueType>(m_LabelObjectContainer.size())),
+                 static_cast<SizeValueType>(static_cast<UnsignedLabelType>(NumericTraits<LabelType>::max())));
+      if (index >= limit)
+      {
+        return;
+      }
+      const auto          oldSize = static_cast<SizeValueType>(m_LabelObjectLookupTable.size());
+      const SizeValueType newSize = std::min(limit, std::max(index + 1, 2 * oldSize));
+      m_LabelObjectLookupTable.resize(newSize, nullptr);
+
+      // Add the labels already in the map which are now covered by the table.
+      for (auto it = m_LabelObjectContainer.lower_bound(static_cast<LabelType>(oldSize));
+           it != m_LabelObjectContainer.end() &&
+           static_cast<SizeValueType>(static_cast<UnsignedLabelType>(it->first)) < newSize;
+           ++it)
+      {
+        m_LabelObjectLookupTable[static_cast<SizeValueType>(static_cast<UnsignedLabelType>(it->first))] = it->second;
+      }
+    }
+    m_LabelObjectLookupTable[index] = labelObject;
+  }
 }
 
 
@@ -241,9 +296,16 @@ LabelMap<TLabelObject>::AddPixel(const IndexType & idx, const LabelType & label)
     return;
   }
 
-  const LabelObjectContainerIterator it = m_LabelObjectContainer.find(label);
-
-  this->AddPixel(it, idx, label);
+  if (LabelObjectType * labelObject = this->FindLabelObject(label))
+  {
+    // the label already exist - add the pixel to it
+    labelObject->AddIndex(idx);
+    this->Modified();
+  }
+  else
+  {
+    this->AddPixel(m_LabelObjectContainer.end(), idx, label);
+  }
 }
 
 
@@ -328,12 +390,10 @@ LabelMap<TLabelObject>::SetLine(const IndexType & idx, const LengthType & length
     return;
   }
 
-  auto it = m_LabelObjectContainer.find(label);
-
-  if (it != m_LabelObjectContainer.end())
+  if (LabelObjectType * existingLabelObject = this->FindLabelObject(label))
   {
-    // the label already exist - add the pixel to it
-    it->second->AddLine(idx, length);
+    // the label already exist - add the line to it
+    existingLabelObject->AddLine(idx, length);
     this->Modified();
   }
   else
@@ -371,6 +431,7 @@ LabelMap<TLabelObject>::AddLabelObject(LabelObjectType * labelObject)
   itkAssertOrThrowMacro((labelObject != nullptr), "Input LabelObject can't be Null");
 
   m_LabelObjectContainer[labelObject->GetLabel()] = labelObject;
+  this->AddToLabelObjectLookupTable(labelObject->GetLabel(), labelObject);
   this->Modified();
 }
 
@@ -459,6 +520,14 @@ LabelMap<TLabelObject>::RemoveLabel(const LabelType & label)
     itkExceptionMacro("Label " << static_cast<typename NumericTraits<LabelType>::PrintType>(label)
                                << " is the background label.");
   }
+  if constexpr (UseLabelObjectLookupTable)
+  {
+    const auto index = static_cast<SizeValueType>(static_cast<std::make_unsigned_t<LabelType>>(label));
+    if (index < m_LabelObjectLookupTable.size())
+    {
+      m_LabelObjectLookupTable[index] = nullptr;
+    }
+  }
   m_LabelObjectContainer.erase(label);
   this->Modified();
 }
@@ -471,6 +540,7 @@ LabelMap<TLabelObject>::ClearLabels()
   if (!m_LabelObjectContainer.empty())
   {
     m_LabelObjectContainer.clear();
+    m_LabelObjectLookupTable.clear();
     this->Modified();
   }
 }
@@ -531,6 +601,40 @@ LabelMap<TLabelObject>::Optimize()
   this->Modified();
 }
 
+template <typename TLabelObject>
+void
+LabelMap<TLabelObject>::PackLines()
+{
+  using LineContainerType = typename LabelObjectType::LineContainerType;
+
+  SizeValueType numberOfLines = 0;
+  for (const auto & labelAndObject : m_LabelObjectContainer)
+  {
+    numberOfLines += labelAndObject.second->GetNumberOfLines();
+  }
+
+  const auto lineContainer = std::make_shared<LineContainerType>();
+  lineContainer->reserve(numberOfLines);
+  for (const auto & labelAndObject : m_LabelObjectContainer)
+  {
+    const LabelObjectType * labelObject = labelAndObject.second;
+    for (typename LabelObjectType::ConstLineIterator lit(labelObject); !lit.IsAtEnd(); ++lit)
+    {
+      lineContainer->push_back(lit.GetLine());
+    }
+  }
+
+  // The array is complete, so that the label objects can refer to it.
+  SizeValueType begin = 0;
+  for (const auto & labelAndObject : m_LabelObjectContainer)
+  {
+    const SizeValueType numberOfObjectLines = labelAndObject.second->GetNumberOfLines();
+    labelAndObject.second->SetSharedLines(lineContainer, begin, numberOfObjectLines);
+    begin += numberOfObjectLines;
+  }
+  this->Modified();
+}
+
 } // end namespace itk
 
 #endif
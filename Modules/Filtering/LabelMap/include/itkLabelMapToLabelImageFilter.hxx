@@ -21,6 +21,8 @@
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -41,14 +43,15 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapToLabelImageFilter<TInputImage, TOutputImage>::ThreadedProcessLabelObject(LabelObjectType * labelObject)
 {
-  OutputImageType *                            output = this->GetOutput();
-  const typename LabelObjectType::LabelType &  label = labelObject->GetLabel();
-  typename LabelObjectType::ConstIndexIterator it(labelObject);
+  OutputImageType *            output = this->GetOutput();
+  const auto                   label = static_cast<OutputImagePixelType>(labelObject->GetLabel());
+  OutputImagePixelType * const buffer = output->GetBufferPointer();
 
-  while (!it.IsAtEnd())
+  // Fill each line at once, the lines being contiguous in the buffer.
+  for (typename LabelObjectType::ConstLineIterator lit(labelObject); !lit.IsAtEnd(); ++lit)
   {
-    output->SetPixel(it.GetIndex(), label);
-    ++it;
+    const typename LabelObjectType::LineType & line = lit.GetLine();
+    std::fill_n(buffer + output->ComputeOffset(line.GetIndex()), line.GetLength(), label);
   }
 }
 
@@ -18,7 +18,8 @@
 #ifndef itkLabelObject_h
 #define itkLabelObject_h
 
-#include <deque>
+#include <memory>
+#include <vector>
 #include "itkLightObject.h"
 #include "itkLabelObjectLine.h"
 #include "itkWeakPointer.h"
@@ -40,6 +41,10 @@ namespace itk
  * reconstruction filters for an example. If a simple attribute is needed,
  * AttributeLabelObject can be used directly.
  *
+ * Each label object stores its own lines in a vector, in the order they were added, until Optimize() sorts and
+ * merges them. Alternatively, the lines of many label objects may be stored in a single container that they share,
+ * see LabelMap::PackLines(). A label object copies its shared lines into its own vector before they are modified.
+ *
  * All the subclasses of LabelObject have to reimplement the CopyAttributesFrom() and CopyAllFrom() method.
  * No need to reimplement CopyLinesFrom() since all derived class share the same type line data members.
  *
@@ -87,6 +92,7 @@ public:
   using LabelType = TLabel;
   using LineType = LabelObjectLine<VImageDimension>;
   using LengthType = typename LineType::LengthType;
+  using LineContainerType = std::vector<LineType>;
   using AttributeType = unsigned int;
   using SizeValueType = itk::SizeValueType;
 
@@ -198,6 +204,22 @@ public:
   void
   Optimize();
 
+  /** Use the given number of lines of a container shared with other label
+   * objects, from the given position, in place of the lines of this object.
+   * The container must not be modified while it is shared. */
+  void
+  SetSharedLines(const std::shared_ptr<const LineContainerType> & lineContainer,
+                 SizeValueType                                    begin,
+                 SizeValueType                                    numberOfLines);
+
+  /** Whether the lines are stored in a container shared with other label
+   * objects, rather than in this object. */
+  [[nodiscard]] bool
+  HasSharedLines() const
+  {
+    return m_SharedLineContainer != nullptr;
+  }
+
   /** Shift the object position */
   void
   Shift(OffsetType offset);
@@ -213,8 +235,8 @@ public:
     ConstLineIterator() = default;
 
     ConstLineIterator(const Self * lo)
-      : m_Begin(lo->m_LineContainer.begin())
-      , m_End(lo->m_LineContainer.end())
+      : m_Begin(lo->GetLinesBegin())
+      , m_End(lo->GetLinesEnd())
     {
       m_Iterator = m_Begin;
     }
@@ -270,11 +292,10 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
-    using InternalIteratorType = typename LineContainerType::const_iterator;
-    InternalIteratorType m_Iterator;
-    InternalIteratorType m_Begin;
-    InternalIteratorType m_End;
+    using InternalIteratorType = const LineType *;
+    InternalIteratorType m_Iterator{};
+    InternalIteratorType m_Begin{};
+    InternalIteratorType m_End{};
   };
 
   /**
@@ -294,8 +315,8 @@ public:
     }
 
     ConstIndexIterator(const Self * lo)
-      : m_Begin(lo->m_LineContainer.begin())
-      , m_End(lo->m_LineContainer.end())
+      : m_Begin(lo->GetLinesBegin())
+      , m_End(lo->GetLinesEnd())
     {
       GoToBegin();
     }
@@ -360,8 +381,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
-    using InternalIteratorType = typename LineContainerType::const_iterator;
+    using InternalIteratorType = const LineType *;
     void
     NextValidLine()
     {
@@ -388,10 +408,27 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
-  using LineContainerType = typename std::deque<LineType>;
+  /** The first and past-the-end lines of the object. */
+  /** @ITKStartGrouping */
+  [[nodiscard]] const LineType *
+  GetLinesBegin() const;
+  [[nodiscard]] const LineType *
+  GetLinesEnd() const;
+  /** @ITKEndGrouping */
+
+  /** Copy the shared lines in the line container of this object, before
+   * they are modified. */
+  void
+  DetachSharedLines();
 
   LineContainerType m_LineContainer{};
   LabelType         m_Label{};
+
+  /** The lines shared with other label objects, when they are not in
+   * m_LineContainer. */
+  std::shared_ptr<const LineContainerType> m_SharedLineContainer{};
+  SizeValueType                            m_SharedLinesBegin{ 0 };
+  SizeValueType                            m_NumberOfSharedLines{ 0 };
 };
 } // end namespace itk
 
@@ -82,9 +82,9 @@ template <typename TLabel, unsigned int VImageDimension>
 bool
 LabelObject<TLabel, VImageDimension>::HasIndex(const IndexType & idx) const
 {
-  auto end = m_LineContainer.end();
+  const LineType * const end = this->GetLinesEnd();
 
-  for (auto it = m_LineContainer.begin(); it != end; ++it)
+  for (const LineType * it = this->GetLinesBegin(); it != end; ++it)
   {
     if (it->HasIndex(idx))
     {
@@ -99,6 +99,8 @@ template <typename TLabel, unsigned int VImageDimension>
 bool
 LabelObject<TLabel, VImageDimension>::RemoveIndex(const IndexType & idx)
 {
+  this->DetachSharedLines();
+
   auto it = m_LineContainer.begin();
 
   while (it != m_LineContainer.end())
@@ -153,6 +155,8 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::AddIndex(const IndexType & idx)
 {
+  this->DetachSharedLines();
+
   if (!m_LineContainer.empty())
   {
     // can we use the last line to add that index ?
@@ -186,6 +190,7 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::AddLine(const LineType & line)
 {
+  this->DetachSharedLines();
   m_LineContainer.push_back(line);
 }
 
@@ -193,20 +198,21 @@ template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetNumberOfLines() const -> SizeValueType
 {
-  return static_cast<LabelObject<TLabel, VImageDimension>::SizeValueType>(m_LineContainer.size());
+  return static_cast<SizeValueType>(this->GetLinesEnd() - this->GetLinesBegin());
 }
 
 template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetLine(SizeValueType i) const -> const LineType &
 {
-  return m_LineContainer[i];
+  return this->GetLinesBegin()[i];
 }
 
 template <typename TLabel, unsigned int VImageDimension>
 auto
 LabelObject<TLabel, VImageDimension>::GetLine(SizeValueType i) -> LineType &
 {
+  this->DetachSharedLines();
   return m_LineContainer[i];
 }
 
@@ -216,7 +222,7 @@ LabelObject<TLabel, VImageDimension>::Size() const -> SizeValueType
 {
   int size = 0;
 
-  for (auto it = m_LineContainer.begin(); it != m_LineContainer.end(); ++it)
+  for (const LineType * it = this->GetLinesBegin(); it != this->GetLinesEnd(); ++it)
   {
     size += it->GetLength();
   }
@@ -227,7 +233,7 @@ template <typename TLabel, unsigned int VImageDimension>
 bool
 LabelObject<TLabel, VImageDimension>::Empty() const
 {
-  return this->m_LineContainer.empty();
+  return this->GetLinesBegin() == this->GetLinesEnd();
 }
 
 template <typename TLabel, unsigned int VImageDimension>
@@ -236,9 +242,9 @@ LabelObject<TLabel, VImageDimension>::GetIndex(SizeValueType offset) const -> In
 {
   SizeValueType o = offset;
 
-  auto it = this->m_LineContainer.begin();
+  const LineType * it = this->GetLinesBegin();
 
-  while (it != m_LineContainer.end())
+  while (it != this->GetLinesEnd())
   {
     const SizeValueType size = it->GetLength();
 
@@ -266,7 +272,8 @@ LabelObject<TLabel, VImageDimension>::CopyLinesFrom(const TSourceLabelObject * s
 {
   itkAssertOrThrowMacro((src != nullptr), "Null Pointer");
   // clear original lines and copy lines
-  m_LineContainer.clear();
+  this->Clear();
+  m_LineContainer.reserve(src->GetNumberOfLines());
   for (size_t i = 0; i < src->GetNumberOfLines(); ++i)
   {
     this->AddLine(src->GetLine(static_cast<SizeValueType>(i)));
@@ -304,11 +311,14 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::Optimize()
 {
+  this->DetachSharedLines();
+
   if (!m_LineContainer.empty())
   {
-    // first copy the lines in another container and clear the current one
-    LineContainerType lineContainer = m_LineContainer;
-    m_LineContainer.clear();
+    // first move the lines in another container and clear the current one
+    LineContainerType lineContainer;
+    lineContainer.swap(m_LineContainer);
+    m_LineContainer.reserve(lineContainer.size());
 
     // reorder the lines
     const typename Functor::LabelObjectLineComparator<LineType> comparator;
@@ -365,6 +375,8 @@ template <typename TLabel, unsigned int VImageDimension>
 void
 LabelObject<TLabel, VImageDimension>::Shift(OffsetType offset)
 {
+  this->DetachSharedLines();
+
   for (auto it = m_LineContainer.begin(); it != m_LineContainer.end(); ++it)
   {
     LineType & line = *it;
@@ -377,6 +389,59 @@ void
 LabelObject<TLabel, VImageDimension>::Clear()
 {
   m_LineContainer.clear();
+  m_SharedLineContainer = nullptr;
+  m_SharedLinesBegin = 0;
+  m_NumberOfSharedLines = 0;
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+LabelObject<TLabel, VImageDimension>::SetSharedLines(const std::shared_ptr<const LineContainerType> & lineContainer,
+                                                     SizeValueType                                    begin,
+                                                     SizeValueType                                    numberOfLines)
+{
+  itkAssertOrThrowMacro(lineContainer != nullptr && begin + numberOfLines <= lineContainer->size(),
+                        "The shared lines are not in the line container");
+  // release the lines of the object
+  LineContainerType().swap(m_LineContainer);
+  m_SharedLineContainer = lineContainer;
+  m_SharedLinesBegin = begin;
+  m_NumberOfSharedLines = numberOfLines;
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+LabelObject<TLabel, VImageDimension>::GetLinesBegin() const -> const LineType *
+{
+  if (m_SharedLineContainer != nullptr)
+  {
+    return m_SharedLineContainer->data() + m_SharedLinesBegin;
+  }
+  return m_LineContainer.data();
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+LabelObject<TLabel, VImageDimension>::GetLinesEnd() const -> const LineType *
+{
+  if (m_SharedLineContainer != nullptr)
+  {
+    return m_SharedLineContainer->data() + m_SharedLinesBegin + m_NumberOfSharedLines;
+  }
+  return m_LineContainer.data() + m_LineContainer.size();
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+LabelObject<TLabel, VImageDimension>::DetachSharedLines()
+{
+  if (m_SharedLineContainer != nullptr)
+  {
+    m_LineContainer.assign(this->GetLinesBegin(), this->GetLinesEnd());
+    m_SharedLineContainer = nullptr;
+    m_SharedLinesBegin = 0;
+    m_NumberOfSharedLines = 0;
+  }
 }
 
 template <typename TLabel, unsigned int VImageDimension>
@@ -385,6 +450,9 @@ LabelObject<TLabel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "LineContainer: " << &m_LineContainer << std::endl;
+  os << indent << "SharedLineContainer: " << m_SharedLineContainer.get() << std::endl;
+  os << indent << "SharedLinesBegin: " << m_SharedLinesBegin << std::endl;
+  os << indent << "NumberOfSharedLines: " << m_NumberOfSharedLines << std::endl;
   print_helper::PrintNumericTrait(os, indent, "Label", m_Label);
 }
 } // end namespace itk
@@ -32,6 +32,7 @@
 #include <deque>
 #include "vnl/vnl_diag_matrix.h"
 #include <map>
+#include <utility>
 
 namespace itk
 {
@@ -780,7 +781,7 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ComputeOrientedBoundingBox(LabelObject
   VNLMatrixType pixelLocations(ImageDimension, labelObject->GetNumberOfLines() * 2);
   for (unsigned int l = 0; l < numLines; ++l)
   {
-    const typename LabelObjectType::LineType line = labelObject->GetLine(l);
+    const typename LabelObjectType::LineType line = std::as_const(*labelObject).GetLine(l);
 
     // add start index of line as physical point relative to centroid
     IndexType                     idx = line.GetIndex();
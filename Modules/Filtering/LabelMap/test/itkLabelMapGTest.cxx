@@ -0,0 +1,206 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLabelMap.h"
+#include "itkLabelObject.h"
+#include "itkGTest.h"
+
+#include <map>
+#include <vector>
+
+namespace
+{
+// Check that the label map finds the same label objects as the reference.
+template <typename TLabelMap, typename TLabel>
+void
+ExpectSameLabelObjects(const TLabelMap * labelMap, const std::map<TLabel, const void *> & reference)
+{
+  ASSERT_EQ(labelMap->GetNumberOfLabelObjects(), reference.size());
+  for (const auto & entry : reference)
+  {
+    ASSERT_TRUE(labelMap->HasLabel(entry.first));
+    EXPECT_EQ(static_cast<const void *>(labelMap->GetLabelObject(entry.first)), entry.second);
+  }
+  auto it = reference.begin();
+  for (typename TLabelMap::ConstIterator lit(labelMap); !lit.IsAtEnd(); ++lit, ++it)
+  {
+    EXPECT_EQ(lit.GetLabel(), it->first);
+  }
+}
+
+// Check that the label object has the lines of the reference.
+template <typename TLabelObject>
+void
+ExpectSameLines(const TLabelObject * labelObject, const std::vector<typename TLabelObject::LineType> & reference)
+{
+  ASSERT_EQ(labelObject->GetNumberOfLines(), reference.size());
+  for (itk::SizeValueType i = 0; i < reference.size(); ++i)
+  {
+    EXPECT_EQ(labelObject->GetLine(i).GetIndex(), reference[i].GetIndex());
+    EXPECT_EQ(labelObject->GetLine(i).GetLength(), reference[i].GetLength());
+  }
+}
+} // namespace
+
+TEST(LabelMap, FindsLabelObjectsOfSmallAndSparseLabels)
+{
+  using LabelObjectType = itk::LabelObject<int, 2>;
+  using LabelMapType = itk::LabelMap<LabelObjectType>;
+
+  auto labelMap = LabelMapType::New();
+  labelMap->SetRegions(LabelMapType::RegionType{ LabelMapType::IndexType{}, LabelMapType::SizeType::Filled(100) });
+  labelMap->SetBackgroundValue(-100);
+
+  // Sparse and negative labels first, then consecutive ones.
+  std::map<int, const void *> reference;
+  for (const int label : { 1000000, -5, 70000, 3 })
+  {
+    labelMap->SetLine(itk::MakeIndex(0, 0), 1, label);
+    reference[label] = labelMap->GetLabelObject(label);
+  }
+  for (int label = 1; label <= 3000; ++label)
+  {
+    labelMap->SetLine(itk::MakeIndex(label % 100, 1), 1, label);
+    reference[label] = labelMap->GetLabelObject(label);
+  }
+  ExpectSameLabelObjects(labelMap.GetPointer(), reference);
+  EXPECT_EQ(labelMap->GetLabelObject(3)->GetNumberOfLines(), 2u);
+  EXPECT_FALSE(labelMap->HasLabel(3001));
+  EXPECT_FALSE(labelMap->HasLabel(-1));
+  EXPECT_THROW(labelMap->GetLabelObject(5000), itk::ExceptionObject);
+
+  // Removed labels are not found anymore.
+  for (int label = 2; label <= 3000; label += 7)
+  {
+    labelMap->RemoveLabel(label);
+    reference.erase(label);
+  }
+  labelMap->RemoveLabel(-5);
+  reference.erase(-5);
+  ExpectSameLabelObjects(labelMap.GetPointer(), reference);
+  EXPECT_FALSE(labelMap->HasLabel(2));
+
+  // A replaced label object is found.
+  auto labelObject = LabelObjectType::New();
+  labelObject->SetLabel(10);
+  labelMap->AddLabelObject(labelObject);
+  reference[10] = labelObject.GetPointer();
+  ExpectSameLabelObjects(labelMap.GetPointer(), reference);
+
+  // A grafted label map finds the same label objects.
+  auto graftedLabelMap = LabelMapType::New();
+  graftedLabelMap->Graft(labelMap);
+  ExpectSameLabelObjects(graftedLabelMap.GetPointer(), reference);
+
+  labelMap->ClearLabels();
+  EXPECT_EQ(labelMap->GetNumberOfLabelObjects(), 0u);
+  EXPECT_FALSE(labelMap->HasLabel(1));
+  labelMap->SetLine(itk::MakeIndex(0, 0), 4, 1);
+  EXPECT_EQ(labelMap->GetLabelObject(1)->Size(), 4u);
+  ExpectSameLabelObjects(graftedLabelMap.GetPointer(), reference);
+}
+
+TEST(LabelMap, FindsLabelObjectsOfAllLabels)
+{
+  using LabelObjectType = itk::LabelObject<unsigned char, 2>;
+  using LabelMapType = itk::LabelMap<LabelObjectType>;
+
+  auto labelMap = LabelMapType::New();
+  labelMap->SetRegions(LabelMapType::RegionType{ LabelMapType::IndexType{}, LabelMapType::SizeType::Filled(4) });
+
+  std::map<unsigned char, const void *> reference;
+  for (unsigned int label = 255; label >= 1; --label)
+  {
+    labelMap->AddPixel(itk::MakeIndex(0, 0), static_cast<unsigned char>(label));
+    reference[static_cast<unsigned char>(label)] = labelMap->GetLabelObject(static_cast<unsigned char>(label));
+  }
+  ExpectSameLabelObjects(labelMap.GetPointer(), reference);
+}
+
+TEST(LabelMap, PackLinesStoresTheLinesContiguouslyByLabel)
+{
+  using LabelObjectType = itk::LabelObject<int, 2>;
+  using LabelMapType = itk::LabelMap<LabelObjectType>;
+  using LineType = LabelObjectType::LineType;
+
+  auto labelMap = LabelMapType::New();
+  labelMap->SetRegions(LabelMapType::RegionType{ LabelMapType::IndexType{}, LabelMapType::SizeType::Filled(100) });
+  labelMap->SetBackgroundValue(-100);
+
+  // Lines of labels in no particular order, several per label object.
+  std::map<int, std::vector<LineType>> reference;
+  for (int y = 0; y < 40; ++y)
+  {
+    for (int x = 0; x < 100; x += 10)
+    {
+      const int label = (7 * x + 13 * y) % 23 - 5;
+      const LineType line(itk::MakeIndex(x, y), 1 + (x + y) % 10);
+      labelMap->SetLine(line.GetIndex(), line.GetLength(), label);
+      reference[label].push_back(line);
+    }
+  }
+  labelMap->PackLines();
+
+  const LineType * previousEnd = nullptr;
+  for (const auto & [label, lines] : reference)
+  {
+    const LabelObjectType * labelObject = labelMap->GetLabelObject(label);
+    ASSERT_TRUE(labelObject->HasSharedLines());
+    ExpectSameLines(labelObject, lines);
+    // The lines of each label object follow the ones of the previous label.
+    if (previousEnd != nullptr)
+    {
+      EXPECT_EQ(&labelObject->GetLine(0), previousEnd);
+    }
+    previousEnd = &labelObject->GetLine(0) + lines.size();
+
+    itk::SizeValueType size = 0;
+    for (const LineType & line : lines)
+    {
+      size += line.GetLength();
+    }
+    EXPECT_EQ(labelObject->Size(), size);
+    itk::SizeValueType numberOfIndices = 0;
+    for (LabelObjectType::ConstIndexIterator it(labelObject); !it.IsAtEnd(); ++it)
+    {
+      EXPECT_TRUE(labelObject->HasIndex(it.GetIndex()));
+      ++numberOfIndices;
+    }
+    EXPECT_EQ(numberOfIndices, size);
+  }
+
+  // A label object copies its lines before they are modified; the others still share theirs.
+  LabelObjectType * modifiedLabelObject = labelMap->GetLabelObject(0);
+  const LineType    addedLine(itk::MakeIndex(0, 90), 3);
+  modifiedLabelObject->AddLine(addedLine);
+  reference[0].push_back(addedLine);
+  EXPECT_FALSE(modifiedLabelObject->HasSharedLines());
+  for (const auto & [label, lines] : reference)
+  {
+    const LabelObjectType * labelObject = labelMap->GetLabelObject(label);
+    EXPECT_EQ(labelObject->HasSharedLines(), label != 0);
+    ExpectSameLines(labelObject, lines);
+  }
+
+  // A label object keeps its shared lines when the label map releases it.
+  const LabelObjectType::Pointer keptLabelObject = labelMap->GetLabelObject(1);
+  labelMap->ClearLabels();
+  ExpectSameLines(keptLabelObject.GetPointer(), reference[1]);
+  keptLabelObject->Optimize();
+  EXPECT_FALSE(keptLabelObject->HasSharedLines());
+}
@@ -20,6 +20,8 @@
 
 #include "itkImage.h"
 #include "itkLabelImageToShapeLabelMapFilter.h"
+#include "itkLabelMapToLabelImageFilter.h"
+#include "itkImageRegionIterator.h"
 #include "itkTestingMacros.h"
 
 #include <cmath>
@@ -594,3 +596,71 @@ TEST_F(ShapeLabelMapFixture, 3D_DegenerateFlatObject_NumericallyStableEllipsoidD
   EXPECT_TRUE(std::isfinite(rawDeterminant)) << "Determinant of principal moments should be finite";
   EXPECT_GE(rawDeterminant, 0.0) << "Product of non-negative principal moments should be non-negative";
 }
+
+
+TEST_F(ShapeLabelMapFixture, PackedLines)
+{
+  using Utils = FixtureUtilities<3>;
+
+  auto image = Utils::CreateImage();
+  for (itk::ImageRegionIterator<Utils::ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<Utils::PixelType>((index[0] / 4 + 7 * (index[1] / 3) + 3 * (index[2] / 5)) % 11));
+  }
+
+  using L2SType = itk::LabelImageToShapeLabelMapFilter<Utils::ImageType>;
+  auto l2s = L2SType::New();
+  l2s->SetInput(image);
+  l2s->ComputePerimeterOn();
+  l2s->ComputeOrientedBoundingBoxOn();
+  l2s->Update();
+  const Utils::ShapeLabelMapType::Pointer labelMap = l2s->GetOutput();
+
+  // The shape attributes of a packed label map are the ones of the label map it was packed from.
+  auto packedLabelMap = Utils::ShapeLabelMapType::New();
+  packedLabelMap->CopyInformation(labelMap);
+  packedLabelMap->SetRegions(labelMap->GetLargestPossibleRegion());
+  for (unsigned int i = 0; i < labelMap->GetNumberOfLabelObjects(); ++i)
+  {
+    auto labelObject = Utils::LabelObjectType::New();
+    labelObject->CopyAllFrom(labelMap->GetNthLabelObject(i));
+    packedLabelMap->AddLabelObject(labelObject);
+  }
+  packedLabelMap->PackLines();
+
+  using ShapeFilterType = itk::ShapeLabelMapFilter<Utils::ShapeLabelMapType>;
+  auto shapeFilter = ShapeFilterType::New();
+  shapeFilter->SetInput(packedLabelMap);
+  shapeFilter->SetInPlace(true);
+  shapeFilter->ComputePerimeterOn();
+  shapeFilter->ComputeOrientedBoundingBoxOn();
+  shapeFilter->Update();
+
+  ASSERT_EQ(shapeFilter->GetOutput()->GetNumberOfLabelObjects(), labelMap->GetNumberOfLabelObjects());
+  for (unsigned int i = 0; i < labelMap->GetNumberOfLabelObjects(); ++i)
+  {
+    const Utils::LabelObjectType * labelObject = labelMap->GetNthLabelObject(i);
+    const Utils::LabelObjectType * packedLabelObject = shapeFilter->GetOutput()->GetNthLabelObject(i);
+    EXPECT_TRUE(packedLabelObject->HasSharedLines());
+    EXPECT_EQ(packedLabelObject->GetLabel(), labelObject->GetLabel());
+    EXPECT_EQ(packedLabelObject->GetNumberOfPixels(), labelObject->GetNumberOfPixels());
+    EXPECT_EQ(packedLabelObject->GetBoundingBox(), labelObject->GetBoundingBox());
+    EXPECT_EQ(packedLabelObject->GetCentroid(), labelObject->GetCentroid());
+    EXPECT_EQ(packedLabelObject->GetPerimeter(), labelObject->GetPerimeter());
+    EXPECT_EQ(packedLabelObject->GetPrincipalMoments(), labelObject->GetPrincipalMoments());
+    EXPECT_EQ(packedLabelObject->GetOrientedBoundingBoxSize(), labelObject->GetOrientedBoundingBoxSize());
+  }
+
+  // A packed label map is converted back to the label image it was computed from.
+  using L2IType = itk::LabelMapToLabelImageFilter<Utils::ShapeLabelMapType, Utils::ImageType>;
+  auto l2i = L2IType::New();
+  l2i->SetInput(shapeFilter->GetOutput());
+  l2i->Update();
+  itk::ImageRegionConstIterator<Utils::ImageType> it(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<Utils::ImageType> outputIt(l2i->GetOutput(), image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it, ++outputIt)
+  {
+    ASSERT_EQ(outputIt.Get(), it.Get()) << it.GetIndex();
+  }
+}
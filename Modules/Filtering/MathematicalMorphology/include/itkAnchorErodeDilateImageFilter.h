@@ -22,6 +22,7 @@
 #include "itkProgressReporter.h"
 #include "itkAnchorErodeDilateLine.h"
 #include "itkBresenhamLine.h"
+#include "itkAnchorUtilities.h"
 
 namespace itk
 {
@@ -33,6 +34,10 @@ namespace itk
  * The SetBoundary facility isn't necessary for operation of the
  * anchor method but is included for compatibility with other
  * morphology classes in itk.
+ *
+ * The lines of the structuring element parallel to an axis of the image,
+ * e.g. all the lines of a box, are processed with the van Herk/Gil-Werman
+ * algorithm instead, many neighbouring lines at once.
  * \ingroup ITKMathematicalMorphology
  */
 template <typename TImage, typename TKernel, typename TFunction1>
@@ -94,6 +99,9 @@ private:
 
   // the class that operates on lines
   using AnchorLineType = AnchorErodeDilateLine<InputImagePixelType, TFunction1>;
+
+  // the extreme of the lines along an axis
+  using ExtremeFunctorType = AnchorExtremeFunctor<InputImagePixelType, TFunction1>;
 }; // end of class
 } // end namespace itk
 
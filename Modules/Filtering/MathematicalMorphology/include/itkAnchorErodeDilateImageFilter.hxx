@@ -96,12 +96,21 @@ AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenera
       ++SELength;
     }
 
-    const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
+    unsigned int axis = 0;
+    if (IsLineAlongAxis<KernelLType>(ThisLine, axis))
+    {
+      // many lines at once, with the van Herk/Gil-Werman algorithm
+      DoAxisAlignedFace<TImage, ExtremeFunctorType>(input, output, m_Boundary, axis, SELength, IReg);
+    }
+    else
+    {
+      const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
 
-    AnchorLine.SetSize(SELength);
+      AnchorLine.SetSize(SELength);
 
-    DoAnchorFace<TImage, BresType, AnchorLineType, KernelLType>(
-      input, output, m_Boundary, ThisLine, AnchorLine, TheseOffsets, inbuffer, buffer, IReg, BigFace);
+      DoAnchorFace<TImage, BresType, AnchorLineType, KernelLType>(
+        input, output, m_Boundary, ThisLine, AnchorLine, TheseOffsets, inbuffer, buffer, IReg, BigFace);
+    }
     // after the first pass the input will be taken from the output
     input = internalbuffer;
   }
@@ -23,6 +23,7 @@
 #include "itkAnchorOpenCloseLine.h"
 #include "itkAnchorErodeDilateLine.h"
 #include "itkBresenhamLine.h"
+#include "itkAnchorUtilities.h"
 
 namespace itk
 {
@@ -45,6 +46,10 @@ namespace itk
  * in more complex template parameters because the appropriate
  * comparison operations need to be passed in. The less
  *
+ * The erosions and dilations by lines parallel to an axis of the image,
+ * including the opening or closing by the last line, are done with the van
+ * Herk/Gil-Werman algorithm, many neighbouring lines at once.
+ *
  * \ingroup ITKMathematicalMorphology
  */
 template <typename TImage, typename TKernel, typename TCompare1, typename TCompare2>
@@ -111,6 +116,10 @@ private:
   // the class that does the dilation
   using AnchorLineDilateType = AnchorErodeDilateLine<InputImagePixelType, TCompare2>;
 
+  // the extremes of the erosions and dilations along an axis
+  using ErodeExtremeFunctorType = AnchorExtremeFunctor<InputImagePixelType, TCompare1>;
+  using DilateExtremeFunctorType = AnchorExtremeFunctor<InputImagePixelType, TCompare2>;
+
   void
   DoFaceOpen(InputImageConstPointer             input,
              InputImagePointer                  output,
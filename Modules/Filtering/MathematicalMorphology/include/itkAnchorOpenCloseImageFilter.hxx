@@ -103,11 +103,19 @@ AnchorOpenCloseImageFilter<TImage, TKernel, TCompare1, TCompare2>::DynamicThread
     {
       ++SELength;
     }
-    AnchorLineErode.SetSize(SELength);
+    unsigned int axis = 0;
+    if (IsLineAlongAxis<KernelLType>(ThisLine, axis))
+    {
+      DoAxisAlignedFace<TImage, ErodeExtremeFunctorType>(input, output, m_Boundary1, axis, SELength, IReg);
+    }
+    else
+    {
+      AnchorLineErode.SetSize(SELength);
 
-    const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
-    DoAnchorFace<TImage, BresType, AnchorLineErodeType, KernelLType>(
-      input, output, m_Boundary1, ThisLine, AnchorLineErode, TheseOffsets, inbuffer, buffer, IReg, BigFace);
+      const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
+      DoAnchorFace<TImage, BresType, AnchorLineErodeType, KernelLType>(
+        input, output, m_Boundary1, ThisLine, AnchorLineErode, TheseOffsets, inbuffer, buffer, IReg, BigFace);
+    }
 
     // after the first pass the input will be taken from the output
     input = internalbuffer;
@@ -124,13 +132,25 @@ AnchorOpenCloseImageFilter<TImage, TKernel, TCompare1, TCompare2>::DynamicThread
       ++SELength;
     }
 
-    AnchorLineOpen.SetSize(SELength);
-    const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
+    unsigned int axis = 0;
+    if (IsLineAlongAxis<KernelLType>(ThisLine, axis))
+    {
+      // an erosion followed by a dilation along the axis, which also
+      // handles the images that have no face for this line
+      DoAxisAlignedFace<TImage, ErodeExtremeFunctorType>(input, output, m_Boundary1, axis, SELength, IReg);
+      input = internalbuffer;
+      DoAxisAlignedFace<TImage, DilateExtremeFunctorType>(input, output, m_Boundary2, axis, SELength, IReg);
+    }
+    else
+    {
+      AnchorLineOpen.SetSize(SELength);
+      const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
 
-    // Now figure out which faces of the image we should be starting
-    // from with this line
-    DoFaceOpen(input, output, m_Boundary1, ThisLine, AnchorLineOpen, TheseOffsets, buffer, IReg, BigFace);
-    // equivalent to two passes
+      // Now figure out which faces of the image we should be starting
+      // from with this line
+      DoFaceOpen(input, output, m_Boundary1, ThisLine, AnchorLineOpen, TheseOffsets, buffer, IReg, BigFace);
+      // equivalent to two passes
+    }
   }
 
   // Now for the rest of the dilations -- note that i needs to be signed
@@ -145,11 +165,19 @@ AnchorOpenCloseImageFilter<TImage, TKernel, TCompare1, TCompare2>::DynamicThread
       ++SELength;
     }
 
-    AnchorLineDilate.SetSize(SELength);
+    unsigned int axis = 0;
+    if (IsLineAlongAxis<KernelLType>(ThisLine, axis))
+    {
+      DoAxisAlignedFace<TImage, DilateExtremeFunctorType>(input, output, m_Boundary2, axis, SELength, IReg);
+    }
+    else
+    {
+      AnchorLineDilate.SetSize(SELength);
 
-    const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
-    DoAnchorFace<TImage, BresType, AnchorLineDilateType, KernelLType>(
-      input, output, m_Boundary2, ThisLine, AnchorLineDilate, TheseOffsets, inbuffer, buffer, IReg, BigFace);
+      const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
+      DoAnchorFace<TImage, BresType, AnchorLineDilateType, KernelLType>(
+        input, output, m_Boundary2, ThisLine, AnchorLineDilate, TheseOffsets, inbuffer, buffer, IReg, BigFace);
+    }
   }
 
   // copy internal buffer to output
@@ -21,6 +21,7 @@
 #include <list>
 
 #include "itkSharedMorphologyUtilities.h"
+#include "itkVanHerkGilWermanUtilities.h"
 
 namespace itk
 {
@@ -41,6 +42,20 @@ ComputeStartEnd(const typename TImage::IndexType  StartIndex,
                 unsigned int &                    start,
                 unsigned int &                    end);
 
+// The extreme of two values according to the strict comparison of an
+// anchor method, e.g. the maximum for std::greater. The lines along an axis
+// of the image are processed with DoAxisAlignedFace, which needs it.
+template <typename TPixel, typename TCompare>
+class AnchorExtremeFunctor
+{
+public:
+  inline TPixel
+  operator()(const TPixel & A, const TPixel & B) const
+  {
+    return TCompare()(A, B) ? A : B;
+  }
+};
+
 template <typename TImage, typename TBres, typename TAnchor, typename TLine>
 void
 DoAnchorFace(const TImage *                            input,
@@ -74,6 +74,12 @@ template <typename TLine>
 unsigned int
 GetLinePixels(const TLine line);
 
+// figure out whether the line is parallel to an axis of the image, and
+// which one
+template <typename TLine>
+bool
+IsLineAlongAxis(const TLine line, unsigned int & axis);
+
 } // namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -455,6 +455,22 @@ GetLinePixels(const TLine line)
   N *= correction;
   return static_cast<int>(N + 0.5);
 }
+
+template <typename TLine>
+bool
+IsLineAlongAxis(const TLine line, unsigned int & axis)
+{
+  unsigned int nonZeroComponents = 0;
+  for (unsigned int i = 0; i < TLine::Dimension; ++i)
+  {
+    if (line[i] != 0)
+    {
+      axis = i;
+      ++nonZeroComponents;
+    }
+  }
+  return nonZeroComponents == 1;
+}
 } // namespace itk
 
 #endif
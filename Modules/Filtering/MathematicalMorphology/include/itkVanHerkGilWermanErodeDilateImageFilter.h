@@ -36,6 +36,10 @@ class KernelImageFilter;
  * The SetBoundary facility isn't necessary for operation of the
  * anchor method but is included for compatibility with other
  * morphology classes in itk.
+ *
+ * The lines of the structuring element parallel to an axis of the image,
+ * e.g. all the lines of a box, are processed many neighbouring lines at
+ * once, in loops that the compiler can vectorize.
  * \ingroup ITKMathematicalMorphology
  */
 template <typename TImage, typename TKernel, typename TFunction1>
@@ -100,10 +100,18 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThre
       ++SELength;
     }
 
-    const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
+    unsigned int axis = 0;
+    if (IsLineAlongAxis<KernelLType>(ThisLine, axis))
+    {
+      DoAxisAlignedFace<TImage, TFunction1>(input, output, m_Boundary, axis, SELength, IReg);
+    }
+    else
+    {
+      const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
 
-    DoFace<TImage, BresType, TFunction1, KernelLType>(
-      input, output, m_Boundary, ThisLine, TheseOffsets, SELength, buffer, forward, reverse, IReg, BigFace);
+      DoFace<TImage, BresType, TFunction1, KernelLType>(
+        input, output, m_Boundary, ThisLine, TheseOffsets, SELength, buffer, forward, reverse, IReg, BigFace);
+    }
 
     // after the first pass the input will be taken from the output
     input = internalbuffer;
@@ -58,6 +58,20 @@ DoFace(typename TImage::ConstPointer             input,
        std::vector<typename TImage::PixelType> & rExtBuffer,
        const typename TImage::RegionType         AllImage,
        const typename TImage::RegionType         face);
+
+/** Same as DoFace, for a line along the axis \c direction of the image. All
+ * the lines of AllImage along that axis have the same length, so they are
+ * processed in blocks: the pixels of the lines of a block are interleaved in
+ * the buffers, and the extremes are computed for all the lines of the block
+ * in the innermost loops, which the compiler can vectorize. */
+template <typename TImage, typename TFunction>
+void
+DoAxisAlignedFace(const TImage *                    input,
+                  TImage *                          output,
+                  typename TImage::PixelType        border,
+                  const unsigned int                direction,
+                  const unsigned int                KernLen,
+                  const typename TImage::RegionType AllImage);
 } // namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
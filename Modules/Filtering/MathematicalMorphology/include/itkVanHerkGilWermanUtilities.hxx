@@ -22,6 +22,10 @@
 #include "itkIndexRange.h"
 #include "itkNeighborhoodAlgorithm.h"
 
+#include <algorithm>
+#include <array>
+#include <memory>
+
 namespace itk
 {
 /**
@@ -201,6 +205,219 @@ DoFace(typename TImage::ConstPointer             input,
   }
 }
 
+// The extremes of a block of lines interleaved in the buffers, i.e. the
+// pixel i of the line l of the block is at i * VLanes + l. This follows
+// FillForwardExt, FillReverseExt and DoFace, a row of VLanes pixels at a
+// time.
+template <typename PixelType, typename TFunction, unsigned int VLanes>
+void
+DoLineBlock(PixelType * const  pix,
+            PixelType * const  fExt,
+            PixelType * const  rExt,
+            const unsigned int KernLen,
+            const unsigned int size)
+{
+  TFunction m_TF;
+
+  // forward extremes, restarting at each block of KernLen pixels
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    const PixelType * V = pix + i * VLanes;
+    PixelType *       F = fExt + i * VLanes;
+    if (i % KernLen == 0)
+    {
+      std::copy_n(V, VLanes, F);
+    }
+    else
+    {
+      const PixelType * previousF = F - VLanes;
+      for (unsigned int l = 0; l < VLanes; ++l)
+      {
+        F[l] = m_TF(V[l], previousF[l]);
+      }
+    }
+  }
+
+  // reverse extremes, restarting at the end of each block and of the line
+  for (unsigned int i = size; i-- > 0;)
+  {
+    const PixelType * V = pix + i * VLanes;
+    PixelType *       R = rExt + i * VLanes;
+    if (i == size - 1 || (i + 1) % KernLen == 0)
+    {
+      std::copy_n(V, VLanes, R);
+    }
+    else
+    {
+      const PixelType * nextR = R + VLanes;
+      for (unsigned int l = 0; l < VLanes; ++l)
+      {
+        R[l] = m_TF(V[l], nextR[l]);
+      }
+    }
+  }
+
+  // now compute result
+  const unsigned int half = KernLen / 2;
+  if (size <= half)
+  {
+    for (unsigned int j = 0; j < size; ++j)
+    {
+      std::copy_n(fExt + (size - 1) * VLanes, VLanes, pix + j * VLanes);
+    }
+  }
+  else if (size <= KernLen)
+  {
+    for (unsigned int j = 0; j < size - half; ++j)
+    {
+      std::copy_n(fExt + (j + half) * VLanes, VLanes, pix + j * VLanes);
+    }
+    for (unsigned int j = size - half; j <= half; ++j)
+    {
+      std::copy_n(fExt + (size - 1) * VLanes, VLanes, pix + j * VLanes);
+    }
+    for (unsigned int j = half + 1; j < size; ++j)
+    {
+      std::copy_n(rExt + (j - half) * VLanes, VLanes, pix + j * VLanes);
+    }
+  }
+  else
+  {
+    // line beginning
+    for (unsigned int j = 0; j < half; ++j)
+    {
+      std::copy_n(fExt + (j + half) * VLanes, VLanes, pix + j * VLanes);
+    }
+    for (unsigned int j = half; j < size - half; ++j)
+    {
+      const PixelType * V1 = fExt + (j + half) * VLanes;
+      const PixelType * V2 = rExt + (j - half) * VLanes;
+      PixelType *       P = pix + j * VLanes;
+      for (unsigned int l = 0; l < VLanes; ++l)
+      {
+        P[l] = m_TF(V1[l], V2[l]);
+      }
+    }
+    // line end -- involves resetting the end of the reverse
+    // extreme array
+    for (unsigned int j = size - 2; (j > 0) && (j >= (size - KernLen - 1)); j--)
+    {
+      PixelType *       R = rExt + j * VLanes;
+      const PixelType * nextR = R + VLanes;
+      for (unsigned int l = 0; l < VLanes; ++l)
+      {
+        R[l] = m_TF(nextR[l], R[l]);
+      }
+    }
+    for (unsigned int j = size - half; j < size; ++j)
+    {
+      std::copy_n(rExt + (j - half) * VLanes, VLanes, pix + j * VLanes);
+    }
+  }
+}
+
+template <typename TImage, typename TFunction>
+void
+DoAxisAlignedFace(const TImage *                    input,
+                  TImage *                          output,
+                  typename TImage::PixelType        border,
+                  const unsigned int                direction,
+                  const unsigned int                KernLen,
+                  const typename TImage::RegionType AllImage)
+{
+  using PixelType = typename TImage::PixelType;
+
+  // a row of the block fills a cache line
+  constexpr unsigned int Lanes = std::max<unsigned int>(1, 64 / sizeof(PixelType));
+
+  const unsigned int len = AllImage.GetSize(direction);
+  // compat
+  const unsigned int size = len + 2;
+
+  const auto pixbuffer = std::make_unique<PixelType[]>(size * Lanes);
+  const auto fExtBuffer = std::make_unique<PixelType[]>(size * Lanes);
+  const auto rExtBuffer = std::make_unique<PixelType[]>(size * Lanes);
+  std::fill_n(pixbuffer.get(), Lanes, border);
+  std::fill_n(pixbuffer.get() + (size - 1) * Lanes, Lanes, border);
+
+  const PixelType * const inputBuffer = input->GetBufferPointer();
+  PixelType * const       outputBuffer = output->GetBufferPointer();
+  const OffsetValueType   inputStride = input->GetOffsetTable()[direction];
+  const OffsetValueType   outputStride = output->GetOffsetTable()[direction];
+
+  // the lines start on the face of AllImage orthogonal to the direction
+  typename TImage::RegionType face = AllImage;
+  face.SetSize(direction, 1);
+
+  std::array<OffsetValueType, Lanes> inputStarts;
+  std::array<OffsetValueType, Lanes> outputStarts;
+  unsigned int                       numberOfLines = 0;
+
+  const auto doBlock = [&]() {
+    // when the lines of the block are contiguous in an image, a row of the
+    // block is contiguous too
+    constexpr auto lastLane = static_cast<OffsetValueType>(Lanes - 1);
+    const bool     full = numberOfLines == Lanes;
+    if (full && inputStarts[Lanes - 1] - inputStarts[0] == lastLane)
+    {
+      for (unsigned int i = 0; i < len; ++i)
+      {
+        std::copy_n(inputBuffer + inputStarts[0] + i * inputStride, Lanes, pixbuffer.get() + (i + 1) * Lanes);
+      }
+    }
+    else
+    {
+      for (unsigned int l = 0; l < numberOfLines; ++l)
+      {
+        const PixelType * in = inputBuffer + inputStarts[l];
+        for (unsigned int i = 0; i < len; ++i)
+        {
+          pixbuffer[(i + 1) * Lanes + l] = in[i * inputStride];
+        }
+      }
+    }
+
+    DoLineBlock<PixelType, TFunction, Lanes>(pixbuffer.get(), fExtBuffer.get(), rExtBuffer.get(), KernLen, size);
+
+    if (full && outputStarts[Lanes - 1] - outputStarts[0] == lastLane)
+    {
+      for (unsigned int i = 0; i < len; ++i)
+      {
+        std::copy_n(pixbuffer.get() + (i + 1) * Lanes, Lanes, outputBuffer + outputStarts[0] + i * outputStride);
+      }
+    }
+    else
+    {
+      for (unsigned int l = 0; l < numberOfLines; ++l)
+      {
+        PixelType * out = outputBuffer + outputStarts[l];
+        for (unsigned int i = 0; i < len; ++i)
+        {
+          out[i * outputStride] = pixbuffer[(i + 1) * Lanes + l];
+        }
+      }
+    }
+    // the borders are overwritten by the result
+    std::fill_n(pixbuffer.get(), Lanes, border);
+    std::fill_n(pixbuffer.get() + (size - 1) * Lanes, Lanes, border);
+    numberOfLines = 0;
+  };
+
+  for (const auto & index : MakeIndexRange(face))
+  {
+    inputStarts[numberOfLines] = input->ComputeOffset(index);
+    outputStarts[numberOfLines] = output->ComputeOffset(index);
+    if (++numberOfLines == Lanes)
+    {
+      doBlock();
+    }
+  }
+  if (numberOfLines > 0)
+  {
+    doBlock();
+  }
+}
+
 } // namespace itk
 
 #endif
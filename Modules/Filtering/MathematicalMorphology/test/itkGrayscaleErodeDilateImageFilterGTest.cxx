@@ -0,0 +1,198 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFlatStructuringElement.h"
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkGrayscaleErodeImageFilter.h"
+#include "itkGrayscaleMorphologicalClosingImageFilter.h"
+#include "itkGrayscaleMorphologicalOpeningImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkGTest.h"
+
+#include <random>
+
+namespace
+{
+using AlgorithmEnum = itk::MathematicalMorphologyEnums::Algorithm;
+
+template <typename TImage>
+typename TImage::Pointer
+MakeRandomImage(const typename TImage::SizeType & size, unsigned int seed)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  std::mt19937 generator(seed);
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename TImage::PixelType>(generator() % 200));
+  }
+  return image;
+}
+
+template <typename TFilter>
+typename TFilter::OutputImageType::Pointer
+Filter(const typename TFilter::InputImageType *    image,
+       const typename TFilter::KernelType &        kernel,
+       AlgorithmEnum                               algorithm,
+       typename TFilter::InputImageType::PixelType boundary)
+{
+  auto filter = TFilter::New();
+  filter->SetInput(image);
+  filter->SetKernel(kernel);
+  filter->SetAlgorithm(algorithm);
+  filter->SetBoundary(boundary);
+  // Several work units, so that the lines are split between them.
+  filter->SetNumberOfWorkUnits(3);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+template <typename TImage>
+void
+ExpectEqualImages(const TImage * image, const TImage * expectedImage)
+{
+  const auto numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  ASSERT_EQ(numberOfPixels, expectedImage->GetBufferedRegion().GetNumberOfPixels());
+  unsigned int numberOfMismatches = 0;
+  for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    numberOfMismatches += image->GetBufferPointer()[i] != expectedImage->GetBufferPointer()[i];
+  }
+  EXPECT_EQ(numberOfMismatches, 0u);
+}
+
+// The anchor and van Herk/Gil-Werman algorithms process the lines of a box
+// many at once. Check them against the basic algorithm.
+template <typename TPixel, unsigned int VDimension>
+void
+CheckBoxes(const itk::Size<VDimension> & size, unsigned int seed)
+{
+  using ImageType = itk::Image<TPixel, VDimension>;
+  using KernelType = itk::FlatStructuringElement<VDimension>;
+  using DilateFilterType = itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>;
+  using ErodeFilterType = itk::GrayscaleErodeImageFilter<ImageType, ImageType, KernelType>;
+
+  const auto image = MakeRandomImage<ImageType>(size, seed);
+
+  for (const itk::SizeValueType radius : { 1, 3, 9 })
+  {
+    auto boxRadius = itk::Size<VDimension>::Filled(radius);
+    boxRadius[0] = radius / 2 + 1;
+    const KernelType kernel = KernelType::Box(boxRadius);
+
+    for (const TPixel boundary : { TPixel{ 100 }, itk::NumericTraits<TPixel>::NonpositiveMin() })
+    {
+      const auto expectedDilation = Filter<DilateFilterType>(image, kernel, AlgorithmEnum::BASIC, boundary);
+      const auto expectedErosion = Filter<ErodeFilterType>(image, kernel, AlgorithmEnum::BASIC, boundary);
+      for (const auto algorithm : { AlgorithmEnum::ANCHOR, AlgorithmEnum::VHGW })
+      {
+        SCOPED_TRACE(testing::Message() << "size " << size << ", radius " << boxRadius << ", algorithm " << algorithm
+                                        << ", boundary " << +boundary);
+        ExpectEqualImages(Filter<DilateFilterType>(image, kernel, algorithm, boundary).GetPointer(),
+                          expectedDilation.GetPointer());
+        ExpectEqualImages(Filter<ErodeFilterType>(image, kernel, algorithm, boundary).GetPointer(),
+                          expectedErosion.GetPointer());
+      }
+    }
+  }
+}
+
+template <typename TFilter>
+typename TFilter::OutputImageType::Pointer
+OpenOrClose(const typename TFilter::InputImageType * image,
+            const typename TFilter::KernelType &     kernel,
+            AlgorithmEnum                            algorithm,
+            bool                                     safeBorder)
+{
+  auto filter = TFilter::New();
+  filter->SetInput(image);
+  filter->SetKernel(kernel);
+  filter->SetAlgorithm(algorithm);
+  filter->SetSafeBorder(safeBorder);
+  filter->SetNumberOfWorkUnits(3);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+// The openings and closings chain an erosion and a dilation, which the
+// anchor opening also processes many lines at once. Check them against the
+// basic algorithm.
+template <typename TPixel, unsigned int VDimension>
+void
+CheckBoxOpeningsAndClosings(const itk::Size<VDimension> & size, unsigned int seed)
+{
+  using ImageType = itk::Image<TPixel, VDimension>;
+  using KernelType = itk::FlatStructuringElement<VDimension>;
+  using OpeningFilterType = itk::GrayscaleMorphologicalOpeningImageFilter<ImageType, ImageType, KernelType>;
+  using ClosingFilterType = itk::GrayscaleMorphologicalClosingImageFilter<ImageType, ImageType, KernelType>;
+
+  const auto image = MakeRandomImage<ImageType>(size, seed);
+
+  for (const itk::SizeValueType radius : { 1, 3, 9 })
+  {
+    auto boxRadius = itk::Size<VDimension>::Filled(radius);
+    boxRadius[0] = radius / 2 + 1;
+    const KernelType kernel = KernelType::Box(boxRadius);
+
+    for (const bool safeBorder : { true, false })
+    {
+      const auto expectedOpening = OpenOrClose<OpeningFilterType>(image, kernel, AlgorithmEnum::BASIC, safeBorder);
+      const auto expectedClosing = OpenOrClose<ClosingFilterType>(image, kernel, AlgorithmEnum::BASIC, safeBorder);
+      for (const auto algorithm : { AlgorithmEnum::ANCHOR, AlgorithmEnum::VHGW })
+      {
+        SCOPED_TRACE(testing::Message() << "size " << size << ", radius " << boxRadius << ", algorithm " << algorithm
+                                        << ", safe border " << safeBorder);
+        ExpectEqualImages(OpenOrClose<OpeningFilterType>(image, kernel, algorithm, safeBorder).GetPointer(),
+                          expectedOpening.GetPointer());
+        ExpectEqualImages(OpenOrClose<ClosingFilterType>(image, kernel, algorithm, safeBorder).GetPointer(),
+                          expectedClosing.GetPointer());
+      }
+    }
+  }
+}
+} // namespace
+
+
+TEST(GrayscaleErodeDilateImageFilter, BoxesMatchBasicAlgorithm)
+{
+  CheckBoxes<unsigned char, 2>(itk::MakeSize(37, 21), 1);
+  CheckBoxes<short, 3>(itk::MakeSize(19, 8, 13), 2);
+  CheckBoxes<float, 3>(itk::MakeSize(5, 23, 17), 3);
+  CheckBoxes<double, 2>(itk::MakeSize(3, 40), 4);
+}
+
+TEST(GrayscaleErodeDilateImageFilter, BoxesMatchBasicAlgorithmOnThinImages)
+{
+  CheckBoxes<unsigned char, 2>(itk::MakeSize(30, 1), 5);
+  CheckBoxes<unsigned short, 3>(itk::MakeSize(1, 12, 9), 6);
+}
+
+TEST(GrayscaleErodeDilateImageFilter, BoxOpeningsAndClosingsMatchBasicAlgorithm)
+{
+  CheckBoxOpeningsAndClosings<unsigned char, 2>(itk::MakeSize(37, 21), 7);
+  CheckBoxOpeningsAndClosings<short, 3>(itk::MakeSize(19, 8, 13), 8);
+  CheckBoxOpeningsAndClosings<float, 3>(itk::MakeSize(5, 23, 17), 9);
+}
+
+TEST(GrayscaleErodeDilateImageFilter, BoxOpeningsAndClosingsMatchBasicAlgorithmOnThinImages)
+{
+  CheckBoxOpeningsAndClosings<unsigned char, 2>(itk::MakeSize(30, 1), 10);
+  CheckBoxOpeningsAndClosings<unsigned short, 3>(itk::MakeSize(1, 12, 9), 11);
+  CheckBoxOpeningsAndClosings<double, 3>(itk::MakeSize(14, 1, 6), 12);
+}
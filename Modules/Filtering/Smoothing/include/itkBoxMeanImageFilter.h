@@ -19,6 +19,7 @@
 #define itkBoxMeanImageFilter_h
 
 #include "itkBoxImageFilter.h"
+#include "itkIntegralImageFilter.h"
 
 namespace itk
 {
@@ -67,6 +68,18 @@ public:
   using typename Superclass::OutputImageRegionType;
   using OutputPixelType = typename TOutputImage::PixelType;
 
+  /** Type of the integral image (see IntegralImageFilter) of the input. */
+  using IntegralImageType = Image<Vector<IntegralImageValueType<PixelType>, 2>, TInputImage::ImageDimension>;
+
+  /** Set/Get an integral image of the input, computed by IntegralImageFilter,
+   * from which the box sums are taken instead of accumulating the input on
+   * each update. One integral image can be shared by several filters, and
+   * filters with different radii. Its largest possible region must be that of
+   * the input, and it must be buffered as a whole. Only supported for scalar
+   * pixels. */
+  itkSetInputMacro(IntegralImage, IntegralImageType);
+  itkGetInputMacro(IntegralImage, IntegralImageType);
+
   /** Image related type alias. */
   static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
   static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
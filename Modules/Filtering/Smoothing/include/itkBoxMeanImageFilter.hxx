@@ -44,6 +44,32 @@ void
 BoxMeanImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if (const IntegralImageType * integralImage = this->GetIntegralImage())
+  {
+    if constexpr (std::is_arithmetic_v<PixelType>)
+    {
+      if (integralImage->GetLargestPossibleRegion() != this->GetInput()->GetLargestPossibleRegion() ||
+          integralImage->GetBufferedRegion() != integralImage->GetLargestPossibleRegion())
+      {
+        itkExceptionMacro("The integral image must be of the input, and buffered as a whole.");
+      }
+      using RealType = typename NumericTraits<OutputPixelType>::RealType;
+      BoxSumsFromIntegralImageFunction(
+        integralImage,
+        this->GetOutput(),
+        outputRegionForThread,
+        this->GetRadius(),
+        [](const typename IntegralImageType::PixelType & sums, const SizeValueType numberOfPixels) {
+          return static_cast<OutputPixelType>(static_cast<RealType>(sums[0]) / static_cast<RealType>(numberOfPixels));
+        });
+      return;
+    }
+    else
+    {
+      itkExceptionMacro("An integral image is only supported for scalar pixels.");
+    }
+  }
+
   // Accumulate type is too small
   using AccPixType = typename NumericTraits<PixelType>::RealType;
   using AccumImageType = Image<AccPixType, TInputImage::ImageDimension>;
@@ -45,6 +45,33 @@ void
 BoxSigmaImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if (const IntegralImageType * integralImage = this->GetIntegralImage())
+  {
+    if (integralImage->GetLargestPossibleRegion() != this->GetInput()->GetLargestPossibleRegion() ||
+        integralImage->GetBufferedRegion() != integralImage->GetLargestPossibleRegion())
+    {
+      itkExceptionMacro("The integral image must be of the input, and buffered as a whole.");
+    }
+    using RealType = typename NumericTraits<OutputPixelType>::RealType;
+    BoxSumsFromIntegralImageFunction(
+      integralImage,
+      this->GetOutput(),
+      outputRegionForThread,
+      this->GetRadius(),
+      [](const typename IntegralImageType::PixelType & sums, const SizeValueType numberOfPixels) {
+        if (numberOfPixels <= 1)
+        {
+          return OutputPixelType{};
+        }
+        const auto sum = static_cast<RealType>(sums[0]);
+        const auto n = static_cast<RealType>(numberOfPixels);
+        // Rounding may make the sum of squared deviations slightly negative.
+        const RealType squaredDeviations = std::max(static_cast<RealType>(sums[1]) - sum * sum / n, RealType{});
+        return static_cast<OutputPixelType>(std::sqrt(squaredDeviations / (n - 1)));
+      });
+    return;
+  }
+
   // Accumulate type is too small
   using AccValueType = typename itk::NumericTraits<PixelType>::RealType;
   using AccPixType = itk::Vector<AccValueType, 2>;
@@ -21,13 +21,14 @@
 #include "itkProgressReporter.h"
 #include "itkShapedNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkConstantBoundaryCondition.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 #include "itkOffset.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
-#include <algorithm> // For min.
+#include <algorithm> // For min and max.
 
 /*
  *
@@ -548,6 +549,99 @@ BoxSigmaCalculatorFunction(const TInputImage *               accImage,
   }
 }
 
+/** Sets each pixel of outputRegion to function(sums, numberOfPixels), where
+ * sums are the sums over the box of the given radius around the pixel,
+ * cropped to the largest possible region, taken from the corners of the box
+ * in integralImage (see IntegralImageFilter). The integral image must be
+ * buffered as a whole. The corner values are combined in the pixel type of
+ * the integral image, so that 64 bit integer sums remain exact. */
+template <typename TIntegralImage, typename TOutputImage, typename TFunction>
+void
+BoxSumsFromIntegralImageFunction(const TIntegralImage *            integralImage,
+                                 TOutputImage *                    outputImage,
+                                 typename TOutputImage::RegionType outputRegion,
+                                 typename TIntegralImage::SizeType radius,
+                                 TFunction                         function)
+{
+  using IndexType = typename TIntegralImage::IndexType;
+  using IntegralPixelType = typename TIntegralImage::PixelType;
+  static constexpr unsigned int ImageDimension = TIntegralImage::ImageDimension;
+  static constexpr unsigned int NumberOfOtherCorners = 1u << (ImageDimension - 1);
+
+  const auto                region = integralImage->GetLargestPossibleRegion();
+  const IndexType           start = region.GetIndex();
+  const IndexType           last = region.GetUpperIndex();
+  const IntegralPixelType * buffer = integralImage->GetBufferPointer();
+  const auto &              offsetTable = integralImage->GetOffsetTable();
+
+  ImageScanlineIterator<TOutputImage> outIt(outputImage, outputRegion);
+  while (!outIt.IsAtEnd())
+  {
+    // The corners of the box in the dimensions other than the first are the same along the line.
+    // A lower corner is just outside the box, and is left out if it is outside the image.
+    const IndexType lineIndex = outIt.GetIndex();
+    IndexType       lower;
+    IndexType       upper;
+    SizeValueType   otherNumberOfPixels = 1;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      lower[d] = std::max(lineIndex[d] - static_cast<IndexValueType>(radius[d]), start[d]) - 1;
+      upper[d] = std::min(lineIndex[d] + static_cast<IndexValueType>(radius[d]), last[d]);
+      otherNumberOfPixels *= (d > 0) ? static_cast<SizeValueType>(upper[d] - lower[d]) : 1;
+    }
+
+    OffsetValueType cornerOffsets[NumberOfOtherCorners];
+    bool            cornerIsUpper[NumberOfOtherCorners];
+    unsigned int    numberOfCorners = 0;
+    for (unsigned int corner = 0; corner < NumberOfOtherCorners; ++corner)
+    {
+      OffsetValueType offset = -start[0];
+      unsigned int    numberOfLowerSides = 0;
+      bool            inside = true;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        const bool           isUpper = (corner >> (d - 1)) & 1u;
+        const IndexValueType cornerIndex = isUpper ? upper[d] : lower[d];
+        inside = inside && cornerIndex >= start[d];
+        numberOfLowerSides += isUpper ? 0 : 1;
+        offset += (cornerIndex - start[d]) * offsetTable[d];
+      }
+      if (inside)
+      {
+        cornerOffsets[numberOfCorners] = offset;
+        cornerIsUpper[numberOfCorners] = (numberOfLowerSides % 2) == 0;
+        ++numberOfCorners;
+      }
+    }
+
+    for (IndexValueType x = lineIndex[0]; !outIt.IsAtEndOfLine(); ++outIt, ++x)
+    {
+      const IndexValueType xLower = std::max(x - static_cast<IndexValueType>(radius[0]), start[0]) - 1;
+      const IndexValueType xUpper = std::min(x + static_cast<IndexValueType>(radius[0]), last[0]);
+
+      IntegralPixelType sums{};
+      for (unsigned int k = 0; k < numberOfCorners; ++k)
+      {
+        IntegralPixelType lineSums = buffer[cornerOffsets[k] + xUpper];
+        if (xLower >= start[0])
+        {
+          lineSums -= buffer[cornerOffsets[k] + xLower];
+        }
+        if (cornerIsUpper[k])
+        {
+          sums += lineSums;
+        }
+        else
+        {
+          sums -= lineSums;
+        }
+      }
+      outIt.Set(function(sums, static_cast<SizeValueType>(xUpper - xLower) * otherNumberOfPixels));
+    }
+    outIt.NextLine();
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 BoxSquareAccumulateFunction(const TInputImage *               inputImage,
@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIntegralImageFilter_h
+#define itkIntegralImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkPixelTraits.h"
+#include "itkVector.h"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace itk
+{
+/** Value type in which the sums of pixels of type TPixel, and of their
+ * squares, are accumulated by default: 64 bit integers, which are exact, for
+ * integer pixels of up to 16 bits, and double otherwise. The sums of squares
+ * of 16 bit pixels fit 64 bits for images of up to 2^31 pixels (unsigned) or
+ * 2^33 pixels (signed). */
+template <typename TPixel>
+using IntegralImageValueType = std::conditional_t<std::is_integral_v<TPixel> && sizeof(TPixel) <= 2, int64_t, double>;
+
+/**
+ * \class IntegralImageFilter
+ * \brief Computes the integral image (summed-area table) of a scalar image.
+ *
+ * Each output pixel holds the sum of the input pixels from the start of the
+ * largest possible region up to and including its index. From the integral
+ * image, the sum over any box is a combination of the values at its 2^N
+ * corners, whatever its size. BoxMeanImageFilter and BoxSigmaImageFilter
+ * accept an integral image (SetIntegralImage), so that it is computed once
+ * and shared by several filters and radii.
+ *
+ * If the output pixel has two components, as with the default output image
+ * type (a Vector of two IntegralImageValueType), the second one holds the
+ * sum of the squares of the input pixels. With a scalar output pixel, only
+ * the sums are computed.
+ *
+ * Sums of integer pixels of up to 16 bits are accumulated exactly in 64 bits
+ * by default, so box sums obtained by subtracting large corner values lose
+ * no precision. An integer output type must hold the number of pixels times
+ * the largest magnitude of the input pixel type, or its square when the
+ * squares are summed; otherwise the filter throws an ExceptionObject. Floating
+ * point sums are accumulated with Kahan compensation.
+ *
+ * The integral image is computed one dimension at a time: a running sum
+ * along the lines of the first dimension, followed, for every other
+ * dimension, by the addition of each line to the next one, a loop over
+ * contiguous memory which the compiler vectorizes.
+ *
+ * \sa BoxMeanImageFilter BoxSigmaImageFilter
+ * \ingroup ITKSmoothing
+ */
+template <typename TInputImage,
+          typename TOutputImage =
+            Image<Vector<IntegralImageValueType<typename TInputImage::PixelType>, 2>, TInputImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT IntegralImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IntegralImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = IntegralImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(IntegralImageFilter);
+
+  /** Image related type alias. */
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename TInputImage::PixelType;
+  using OutputPixelType = typename TOutputImage::PixelType;
+  using OutputValueType = typename PixelTraits<OutputPixelType>::ValueType;
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int NumberOfOutputComponents = PixelTraits<OutputPixelType>::Dimension;
+
+  static_assert(std::is_arithmetic_v<InputPixelType>, "IntegralImageFilter requires a scalar input pixel type.");
+  static_assert(NumberOfOutputComponents == 1 || NumberOfOutputComponents == 2,
+                "The output pixel holds the sum, and optionally the sum of squares, of the input pixels.");
+  static_assert(sizeof(OutputPixelType) == NumberOfOutputComponents * sizeof(OutputValueType),
+                "The components of the output pixel must be contiguous.");
+
+  itkConceptMacro(SameDimension, (Concept::SameDimension<TInputImage::ImageDimension, TOutputImage::ImageDimension>));
+
+protected:
+  IntegralImageFilter() = default;
+  ~IntegralImageFilter() override = default;
+
+  /** The integral image needs the whole input. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** The integral image is computed as a whole. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+private:
+  // Number of values of a block of lines added up by a single work item.
+  static constexpr SizeValueType ChunkLength = 1024;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkIntegralImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIntegralImageFilter_hxx
+#define itkIntegralImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkImageScanlineConstIterator.h"
+
+#include <algorithm> // For min and max.
+#include <cmath>
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage>
+void
+IntegralImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (const auto input = const_cast<InputImageType *>(this->GetInput()))
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+IntegralImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+IntegralImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  if constexpr (std::is_integral_v<OutputValueType>)
+  {
+    // The last value of the integral image may reach the number of pixels times the largest magnitude of an input
+    // pixel, or its square.
+    const double largestMagnitude =
+      std::max(std::abs(static_cast<double>(NumericTraits<InputPixelType>::NonpositiveMin())),
+               static_cast<double>(NumericTraits<InputPixelType>::max()));
+    const double largestValue = (NumberOfOutputComponents == 2) ? largestMagnitude * largestMagnitude : largestMagnitude;
+    const auto   numberOfPixels = this->GetInput()->GetLargestPossibleRegion().GetNumberOfPixels();
+    if (static_cast<double>(numberOfPixels) * largestValue > static_cast<double>(NumericTraits<OutputValueType>::max()))
+    {
+      itkExceptionMacro("The sums of the " << numberOfPixels
+                                           << " input pixels may overflow the integer output values. Use a floating "
+                                              "point output image type.");
+    }
+  }
+
+  this->AllocateOutputs();
+
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+  const auto             region = output->GetBufferedRegion();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // The output buffer, seen as an array of values, with the components of each pixel next to each other.
+  const auto data = reinterpret_cast<OutputValueType *>(output->GetBufferPointer());
+
+  // Copy the input, and the squares of its pixels, to the output.
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [input, output, data](const typename OutputImageType::RegionType & lineRegion) {
+      ImageScanlineConstIterator<InputImageType> inIt(input, lineRegion);
+      while (!inIt.IsAtEnd())
+      {
+        OutputValueType * out = data + NumberOfOutputComponents * output->ComputeOffset(inIt.GetIndex());
+        while (!inIt.IsAtEndOfLine())
+        {
+          const auto value = static_cast<OutputValueType>(inIt.Get());
+          out[0] = value;
+          if constexpr (NumberOfOutputComponents == 2)
+          {
+            out[1] = value * value;
+          }
+          out += NumberOfOutputComponents;
+          ++inIt;
+        }
+        inIt.NextLine();
+      }
+    },
+    nullptr);
+
+  // For each dimension, add each line along it to the next one. The lines of a block of
+  // `stride` consecutive values are independent, and are processed in chunks of
+  // ChunkLength values, so that there is enough work to distribute for all dimensions.
+  const auto &  size = region.GetSize();
+  SizeValueType stride = NumberOfOutputComponents;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const SizeValueType length = size[d];
+    SizeValueType       numberOfBlocks = 1;
+    for (unsigned int i = d + 1; i < ImageDimension; ++i)
+    {
+      numberOfBlocks *= size[i];
+    }
+    const SizeValueType numberOfChunks = (stride + ChunkLength - 1) / ChunkLength;
+
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfBlocks * numberOfChunks,
+      [data, stride, length, numberOfChunks](const SizeValueType index) {
+        const SizeValueType chunkBegin = (index % numberOfChunks) * ChunkLength;
+        const SizeValueType chunkLength = std::min(ChunkLength, stride - chunkBegin);
+        OutputValueType *   line = data + (index / numberOfChunks) * stride * length + chunkBegin;
+
+        if constexpr (std::is_floating_point_v<OutputValueType>)
+        {
+          // Kahan summation, with the compensation of each running sum.
+          OutputValueType compensation[ChunkLength]{};
+          for (SizeValueType j = 1; j < length; ++j, line += stride)
+          {
+            OutputValueType * next = line + stride;
+            for (SizeValueType i = 0; i < chunkLength; ++i)
+            {
+              const OutputValueType y = next[i] - compensation[i];
+              const OutputValueType t = line[i] + y;
+              compensation[i] = (t - line[i]) - y;
+              next[i] = t;
+            }
+          }
+        }
+        else
+        {
+          for (SizeValueType j = 1; j < length; ++j, line += stride)
+          {
+            OutputValueType * next = line + stride;
+            for (SizeValueType i = 0; i < chunkLength; ++i)
+            {
+              next[i] += line[i];
+            }
+          }
+        }
+      },
+      nullptr);
+
+    stride *= length;
+  }
+}
+} // end namespace itk
+
+#endif
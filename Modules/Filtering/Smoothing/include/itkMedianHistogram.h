@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMedianHistogram_h
+#define itkMedianHistogram_h
+
+#include "itkIntTypes.h"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace itk::Function
+{
+
+/** \class MedianHistogram
+ * \brief Histogram of a sliding window of 8 or 16 bit integer pixels which
+ * keeps track of the median of its entries.
+ *
+ * This is the rank structure of Huang's median filter algorithm: pixels
+ * entering and leaving the window are added and removed in constant time,
+ * and the median is found by moving a pointer from the previous median,
+ * which usually takes only a few steps as the window slides. Counts are also
+ * kept per block of 256 consecutive values, so that the pointer moves across
+ * sparsely populated parts of a 16 bit histogram a block at a time.
+ *
+ * The median of N entries is the entry of rank N/2 (counting from zero) in
+ * ascending order, the same element std::nth_element selects.
+ *
+ * The vector based histograms of the moving histogram filters in
+ * ITKMathematicalMorphology (e.g. VectorRankHistogram) recompute the rank
+ * value from the first bin for each query instead.
+ *
+ * \ingroup ITKSmoothing
+ */
+template <typename TPixel>
+class MedianHistogram
+{
+public:
+  static_assert(std::is_integral_v<TPixel> && !std::is_same_v<TPixel, bool> && sizeof(TPixel) <= 2,
+                "MedianHistogram only supports 8 and 16 bit integer pixels.");
+
+  MedianHistogram() = default;
+
+  void
+  AddPixel(const TPixel pixel)
+  {
+    const size_t bin = ToBin(pixel);
+    ++m_Counts[bin];
+    ++m_BlockCounts[bin >> BlockShift];
+    ++m_Entries;
+    if (bin < m_MedianBin)
+    {
+      ++m_Below;
+    }
+  }
+
+  void
+  RemovePixel(const TPixel pixel)
+  {
+    const size_t bin = ToBin(pixel);
+    --m_Counts[bin];
+    --m_BlockCounts[bin >> BlockShift];
+    --m_Entries;
+    if (bin < m_MedianBin)
+    {
+      --m_Below;
+    }
+  }
+
+  SizeValueType
+  GetNumberOfEntries() const
+  {
+    return m_Entries;
+  }
+
+  /** Returns the median of the current entries. The histogram must not be empty. */
+  TPixel
+  GetMedian()
+  {
+    const CountType target = m_Entries / 2;
+
+    // Move down while there are too many entries below the median bin.
+    while (m_Below > target)
+    {
+      if ((m_MedianBin & BlockMask) == 0 && m_Below - m_BlockCounts[(m_MedianBin >> BlockShift) - 1] > target)
+      {
+        m_MedianBin -= BlockSize;
+        m_Below -= m_BlockCounts[m_MedianBin >> BlockShift];
+      }
+      else
+      {
+        --m_MedianBin;
+        m_Below -= m_Counts[m_MedianBin];
+      }
+    }
+
+    // Move up while the median bin and everything below it do not reach the target rank.
+    while (m_Below + m_Counts[m_MedianBin] <= target)
+    {
+      if ((m_MedianBin & BlockMask) == 0 && m_Below + m_BlockCounts[m_MedianBin >> BlockShift] <= target)
+      {
+        m_Below += m_BlockCounts[m_MedianBin >> BlockShift];
+        m_MedianBin += BlockSize;
+      }
+      else
+      {
+        m_Below += m_Counts[m_MedianBin];
+        ++m_MedianBin;
+      }
+    }
+    return FromBin(m_MedianBin);
+  }
+
+private:
+  // 32 bits are plenty for any neighborhood, and halve the cache footprint of a 16 bit histogram.
+  using CountType = uint32_t;
+
+  static constexpr size_t NumberOfBins = size_t{ 1 } << (8 * sizeof(TPixel));
+  static constexpr size_t BlockShift = 8;
+  static constexpr size_t BlockSize = size_t{ 1 } << BlockShift;
+  static constexpr size_t BlockMask = BlockSize - 1;
+
+  static size_t
+  ToBin(const TPixel pixel)
+  {
+    return static_cast<size_t>(static_cast<int64_t>(pixel) - std::numeric_limits<TPixel>::min());
+  }
+
+  static TPixel
+  FromBin(const size_t bin)
+  {
+    return static_cast<TPixel>(static_cast<int64_t>(bin) + std::numeric_limits<TPixel>::min());
+  }
+
+  std::vector<CountType> m_Counts = std::vector<CountType>(NumberOfBins);
+  std::vector<CountType> m_BlockCounts = std::vector<CountType>(NumberOfBins / BlockSize);
+
+  // Bin currently holding the median, and the number of entries in the bins below it.
+  size_t    m_MedianBin{ 0 };
+  CountType m_Below{ 0 };
+  CountType m_Entries{ 0 };
+};
+
+} // namespace itk::Function
+
+#endif
@@ -20,6 +20,9 @@
 
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
+#include "itkTotalProgressReporter.h"
+
+#include <type_traits>
 
 namespace itk
 {
@@ -36,6 +39,16 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * The median computation is selected automatically by pixel type and
+ * radius. For 8 and 16 bit integer pixels and neighborhoods of at least
+ * 25 (8 bit) or 49 (16 bit) pixels, the image is processed scanline by
+ * scanline with a sliding histogram (Huang's algorithm, see
+ * Function::MedianHistogram), whose cost per pixel grows with the size of
+ * a neighborhood slab rather than with the whole neighborhood. Integer
+ * 3x3 neighborhoods use a median-of-nine sorting network. All other cases
+ * select the median with std::nth_element. The output does not depend on
+ * the method used.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -104,6 +117,32 @@ protected:
    *     ImageToImageFilter::GenerateData() */
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  /** Whether the median of InputPixelType can be tracked with a Function::MedianHistogram. */
+  static constexpr bool IsHistogramSupported = std::is_integral_v<InputPixelType> &&
+                                               !std::is_same_v<InputPixelType, bool> && sizeof(InputPixelType) <= 2;
+
+  /** Smallest neighborhood for which the sliding histogram outperforms std::nth_element. */
+  static constexpr size_t MinimumNeighborhoodSizeForHistogram = (sizeof(InputPixelType) == 1) ? 25 : 49;
+
+  /** Computes the output for the specified region, selecting the median of each neighborhood
+   * with std::nth_element, or with MedianOfNine for integer 3x3 neighborhoods. */
+  template <typename TPixelAccessPolicy>
+  void
+  GenerateDataUsingSelection(const OutputImageRegionType & region, TotalProgressReporter & progress);
+
+  /** Computes the output for the specified region, sliding a Function::MedianHistogram along its
+   * scanlines. The histogram must be empty, and is left empty. */
+  template <typename TPixelAccessPolicy, typename THistogram>
+  void
+  GenerateDataUsingHistogram(const OutputImageRegionType & region,
+                             THistogram &                  histogram,
+                             TotalProgressReporter &       progress);
+
+  /** Median of nine values, using a sorting network. Reorders the values. */
+  static InputPixelType
+  MedianOfNine(InputPixelType * values);
 };
 } // end namespace itk
 
@@ -21,14 +21,18 @@
 #include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkImageRegionRange.h"
+#include "itkImageScanlineIterator.h"
 #include "itkIndexRange.h"
+#include "itkMedianHistogram.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkShapedImageNeighborhoodRange.h"
 #include "itkTotalProgressReporter.h"
+#include "itkZeroFluxNeumannImageNeighborhoodPixelAccessPolicy.h"
 
 #include <vector>
 #include <algorithm>
+#include <utility> // For swap.
 
 namespace itk
 {
@@ -57,53 +61,217 @@ MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(radius);
   const auto neighborhoodSize = neighborhoodOffsets.size();
 
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  // The non-boundary subregion uses a faster pixel access policy without boundary extrapolation.
+  using NonBoundaryPixelAccessPolicy = BufferedImageNeighborhoodPixelAccessPolicy<InputImageType>;
+  using BoundaryPixelAccessPolicy = ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy<InputImageType>;
+
+  const auto nonBoundaryRegion = calculatorResult.GetNonBoundaryRegion();
+
+  if constexpr (IsHistogramSupported)
+  {
+    if (neighborhoodSize >= MinimumNeighborhoodSizeForHistogram)
+    {
+      Function::MedianHistogram<InputPixelType> histogram;
+
+      // Sliding a histogram only pays off along scanlines that are longer than the neighborhood.
+      const auto hasLongScanlines = [&radius](const OutputImageRegionType & region) {
+        return region.GetSize(0) > 2 * radius[0];
+      };
+
+      if (!nonBoundaryRegion.GetSize().empty())
+      {
+        if (hasLongScanlines(nonBoundaryRegion))
+        {
+          this->template GenerateDataUsingHistogram<NonBoundaryPixelAccessPolicy>(
+            nonBoundaryRegion, histogram, progress);
+        }
+        else
+        {
+          this->template GenerateDataUsingSelection<NonBoundaryPixelAccessPolicy>(nonBoundaryRegion, progress);
+        }
+      }
+      for (const auto & boundaryFace : calculatorResult.GetBoundaryFaces())
+      {
+        if (hasLongScanlines(boundaryFace))
+        {
+          this->template GenerateDataUsingHistogram<BoundaryPixelAccessPolicy>(boundaryFace, histogram, progress);
+        }
+        else
+        {
+          this->template GenerateDataUsingSelection<BoundaryPixelAccessPolicy>(boundaryFace, progress);
+        }
+      }
+      return;
+    }
+  }
+
+  if (!nonBoundaryRegion.GetSize().empty())
+  {
+    this->template GenerateDataUsingSelection<NonBoundaryPixelAccessPolicy>(nonBoundaryRegion, progress);
+  }
+
+  // Process each of the boundary faces.  These are N-d regions which border
+  // the edge of the buffer.
+  for (const auto & boundaryFace : calculatorResult.GetBoundaryFaces())
+  {
+    this->template GenerateDataUsingSelection<BoundaryPixelAccessPolicy>(boundaryFace, progress);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TPixelAccessPolicy>
+void
+MedianImageFilter<TInputImage, TOutputImage>::GenerateDataUsingSelection(const OutputImageRegionType & region,
+                                                                         TotalProgressReporter &       progress)
+{
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(this->GetRadius());
+  const auto neighborhoodSize = neighborhoodOffsets.size();
+
   // All of our neighborhoods have an odd number of pixels, so there is
   // always a median.
   std::vector<InputPixelType> pixels(neighborhoodSize);
   const auto                  medianIterator = pixels.begin() + (neighborhoodSize / 2);
 
+  auto neighborhoodRange = ShapedImageNeighborhoodRange<const InputImageType, TPixelAccessPolicy>(
+    *input, Index<InputImageDimension>(), neighborhoodOffsets);
+  auto outputIterator = ImageRegionRange<OutputImageType>(*output, region).begin();
 
-  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
-
-  const auto nonBoundaryRegion = calculatorResult.GetNonBoundaryRegion();
-  if (!nonBoundaryRegion.GetSize().empty())
+  for (const auto & index : MakeIndexRange(region))
   {
-    // Process the non-boundary subregion, using a faster pixel access policy without boundary extrapolation.
-    auto neighborhoodRange =
-      ShapedImageNeighborhoodRange<const InputImageType, BufferedImageNeighborhoodPixelAccessPolicy<InputImageType>>(
-        *input, Index<InputImageDimension>(), neighborhoodOffsets);
-    auto outputIterator = ImageRegionRange<OutputImageType>(*output, nonBoundaryRegion).begin();
+    neighborhoodRange.SetLocation(index);
+    std::copy_n(neighborhoodRange.cbegin(), neighborhoodSize, pixels.begin());
 
-    for (const auto & index : MakeIndexRange(nonBoundaryRegion))
+    if constexpr (std::is_integral_v<InputPixelType>)
     {
-      neighborhoodRange.SetLocation(index);
-      std::copy_n(neighborhoodRange.cbegin(), neighborhoodSize, pixels.begin());
-      std::nth_element(pixels.begin(), medianIterator, pixels.end());
-      *outputIterator = *medianIterator;
-      ++outputIterator;
-      progress.CompletedPixel();
+      if (neighborhoodSize == 9)
+      {
+        *outputIterator = MedianOfNine(pixels.data());
+        ++outputIterator;
+        progress.CompletedPixel();
+        continue;
+      }
     }
+    std::nth_element(pixels.begin(), medianIterator, pixels.end());
+    *outputIterator = *medianIterator;
+    ++outputIterator;
+    progress.CompletedPixel();
   }
+}
 
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for (const auto & boundaryFace : calculatorResult.GetBoundaryFaces())
+template <typename TInputImage, typename TOutputImage>
+template <typename TPixelAccessPolicy, typename THistogram>
+void
+MedianImageFilter<TInputImage, TOutputImage>::GenerateDataUsingHistogram(const OutputImageRegionType & region,
+                                                                         THistogram &                  histogram,
+                                                                         TotalProgressReporter &       progress)
+{
+  using NeighborhoodRangeType = ShapedImageNeighborhoodRange<const InputImageType, TPixelAccessPolicy>;
+
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  const auto radius = this->GetRadius();
+  const auto radius0 = static_cast<OffsetValueType>(radius[0]);
+  const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(radius);
+
+  // When the window moves one pixel along the scanline, the slab of pixels at the
+  // low end of the previous window leaves it, and the slab at the high end enters it.
+  std::vector<typename InputImageType::OffsetType> leavingOffsets;
+  std::vector<typename InputImageType::OffsetType> enteringOffsets;
+  for (const auto & offset : neighborhoodOffsets)
+  {
+    if (offset[0] == radius0)
+    {
+      enteringOffsets.push_back(offset);
+      auto leavingOffset = offset;
+      leavingOffset[0] = -radius0 - 1;
+      leavingOffsets.push_back(leavingOffset);
+    }
+  }
+
+  NeighborhoodRangeType neighborhoodRange(*input, Index<InputImageDimension>(), neighborhoodOffsets);
+  NeighborhoodRangeType leavingRange(*input, Index<InputImageDimension>(), leavingOffsets);
+  NeighborhoodRangeType enteringRange(*input, Index<InputImageDimension>(), enteringOffsets);
+
+  ImageScanlineIterator<OutputImageType> outputIterator(output, region);
+  while (!outputIterator.IsAtEnd())
   {
-    auto neighborhoodRange =
-      ShapedImageNeighborhoodRange<const InputImageType>(*input, Index<InputImageDimension>(), neighborhoodOffsets);
-    auto outputIterator = ImageRegionRange<OutputImageType>(*output, boundaryFace).begin();
+    auto index = outputIterator.GetIndex();
+    neighborhoodRange.SetLocation(index);
+    for (const InputPixelType pixel : neighborhoodRange)
+    {
+      histogram.AddPixel(pixel);
+    }
+    outputIterator.Set(static_cast<OutputPixelType>(histogram.GetMedian()));
+    ++outputIterator;
 
-    for (const auto & index : MakeIndexRange(boundaryFace))
+    while (!outputIterator.IsAtEndOfLine())
     {
-      neighborhoodRange.SetLocation(index);
-      std::copy_n(neighborhoodRange.cbegin(), neighborhoodSize, pixels.begin());
-      std::nth_element(pixels.begin(), medianIterator, pixels.end());
-      *outputIterator = *medianIterator;
+      ++index[0];
+      leavingRange.SetLocation(index);
+      for (const InputPixelType pixel : leavingRange)
+      {
+        histogram.RemovePixel(pixel);
+      }
+      enteringRange.SetLocation(index);
+      for (const InputPixelType pixel : enteringRange)
+      {
+        histogram.AddPixel(pixel);
+      }
+      outputIterator.Set(static_cast<OutputPixelType>(histogram.GetMedian()));
       ++outputIterator;
-      progress.CompletedPixel();
     }
+
+    // Empty the histogram, which is cheaper than clearing all of its bins.
+    neighborhoodRange.SetLocation(index);
+    for (const InputPixelType pixel : neighborhoodRange)
+    {
+      histogram.RemovePixel(pixel);
+    }
+
+    progress.Completed(region.GetSize(0));
+    outputIterator.NextLine();
   }
 }
+
+template <typename TInputImage, typename TOutputImage>
+auto
+MedianImageFilter<TInputImage, TOutputImage>::MedianOfNine(InputPixelType * values) -> InputPixelType
+{
+  const auto sortPair = [values](const unsigned int i, const unsigned int j) {
+    if (values[j] < values[i])
+    {
+      std::swap(values[i], values[j]);
+    }
+  };
+
+  // Median network of Paeth, "Median Finding on a 3x3 Grid", Graphics Gems, 1990.
+  sortPair(1, 2);
+  sortPair(4, 5);
+  sortPair(7, 8);
+  sortPair(0, 1);
+  sortPair(3, 4);
+  sortPair(6, 7);
+  sortPair(1, 2);
+  sortPair(4, 5);
+  sortPair(7, 8);
+  sortPair(0, 3);
+  sortPair(5, 8);
+  sortPair(4, 7);
+  sortPair(3, 6);
+  sortPair(1, 4);
+  sortPair(2, 5);
+  sortPair(4, 7);
+  sortPair(4, 2);
+  sortPair(6, 4);
+  sortPair(4, 2);
+  return values[4];
+}
 } // end namespace itk
 
 #endif
@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkIntegralImageFilter.h"
+
+#include "itkBoxMeanImageFilter.h"
+#include "itkBoxSigmaImageFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeRandomImage(const typename TImage::RegionType & region, const double maximum)
+{
+  const auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(42);
+
+  const auto image = TImage::New();
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIterator<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename TImage::PixelType>(generator->GetUniformVariate(0.0, maximum)));
+  }
+  return image;
+}
+
+// Compares the integral image with sums computed by brute force.
+template <typename TImage, typename TIntegralImage>
+void
+ExpectIntegralImageHoldsSums(const TImage * image, const TIntegralImage * integralImage, const double relativeTolerance)
+{
+  using RegionType = typename TImage::RegionType;
+  const RegionType region = image->GetLargestPossibleRegion();
+
+  for (itk::ImageRegionConstIteratorWithIndex<TIntegralImage> it(integralImage, region); !it.IsAtEnd(); ++it)
+  {
+    RegionType sumRegion = region;
+    for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+    {
+      sumRegion.SetSize(d, it.GetIndex()[d] - region.GetIndex(d) + 1);
+    }
+    double sum = 0.0;
+    double squareSum = 0.0;
+    for (itk::ImageRegionConstIterator<TImage> imageIt(image, sumRegion); !imageIt.IsAtEnd(); ++imageIt)
+    {
+      sum += imageIt.Get();
+      squareSum += static_cast<double>(imageIt.Get()) * imageIt.Get();
+    }
+    if constexpr (itk::PixelTraits<typename TIntegralImage::PixelType>::Dimension == 2)
+    {
+      EXPECT_NEAR(it.Get()[0], sum, relativeTolerance * sum) << " at index " << it.GetIndex();
+      EXPECT_NEAR(it.Get()[1], squareSum, relativeTolerance * squareSum) << " at index " << it.GetIndex();
+    }
+    else
+    {
+      EXPECT_NEAR(it.Get(), sum, relativeTolerance * sum) << " at index " << it.GetIndex();
+    }
+  }
+}
+} // namespace
+
+
+TEST(IntegralImageFilter, HoldsSumsAndSquareSums)
+{
+  using ImageType = itk::Image<unsigned short, 3>;
+  const ImageType::RegionType region({ { -2, 3, 1 } }, { { 7, 5, 4 } });
+  const auto                  image = MakeRandomImage<ImageType>(region, 65535.0);
+
+  const auto filter = itk::IntegralImageFilter<ImageType>::New();
+  filter->SetInput(image);
+  filter->Update();
+
+  static_assert(std::is_same_v<itk::IntegralImageFilter<ImageType>::OutputValueType, int64_t>,
+                "The sums of 16 bit pixels should be accumulated in 64 bit integers.");
+  // 64 bit integer sums are exact.
+  ExpectIntegralImageHoldsSums(image.GetPointer(), filter->GetOutput(), 0.0);
+}
+
+
+TEST(IntegralImageFilter, HoldsSumsOfFloatingPointPixels)
+{
+  using ImageType = itk::Image<float, 2>;
+  const ImageType::RegionType region({ { 0, 0 } }, { { 3000, 3 } });
+  const auto                  image = MakeRandomImage<ImageType>(region, 1.0);
+
+  // A scalar output pixel holds the sums only.
+  const auto filter = itk::IntegralImageFilter<ImageType, itk::Image<double, 2>>::New();
+  filter->SetInput(image);
+  filter->Update();
+
+  ExpectIntegralImageHoldsSums(image.GetPointer(), filter->GetOutput(), 1e-10);
+}
+
+
+// An integer output type which may overflow for the size of the input is rejected.
+TEST(IntegralImageFilter, ThrowsWhenIntegerSumsMayOverflow)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  using FilterType = itk::IntegralImageFilter<ImageType, itk::Image<itk::Vector<int32_t, 2>, 2>>;
+
+  // The sums of squares of up to 2^31 / 255^2, about 33000, pixels fit 32 bits.
+  const auto filter = FilterType::New();
+  filter->SetInput(MakeRandomImage<ImageType>(ImageType::RegionType{ { { 180, 180 } } }, 255.0));
+  EXPECT_NO_THROW(filter->Update());
+
+  filter->SetInput(MakeRandomImage<ImageType>(ImageType::RegionType{ { { 200, 200 } } }, 255.0));
+  EXPECT_THROW(filter->Update(), itk::ExceptionObject);
+
+  // The sums alone fit.
+  const auto sumFilter = itk::IntegralImageFilter<ImageType, itk::Image<int32_t, 2>>::New();
+  sumFilter->SetInput(filter->GetInput());
+  EXPECT_NO_THROW(sumFilter->Update());
+}
+
+
+// Box filters which share an integral image produce the same output as when they accumulate the input themselves.
+TEST(IntegralImageFilter, SharedByBoxFilters)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  using RealImageType = itk::Image<float, 2>;
+  const auto image = MakeRandomImage<ImageType>(ImageType::RegionType({ { 4, -3 } }, { { 37, 23 } }), 255.0);
+
+  using IntegralImageFilterType = itk::IntegralImageFilter<ImageType>;
+  const auto integralImageFilter = IntegralImageFilterType::New();
+  integralImageFilter->SetInput(image);
+  integralImageFilter->Update();
+  const auto updateTime = integralImageFilter->GetOutput()->GetUpdateMTime();
+
+  for (const unsigned int radius : { 0u, 1u, 4u, 30u })
+  {
+    using MeanFilterType = itk::BoxMeanImageFilter<ImageType, RealImageType>;
+    static_assert(std::is_same_v<MeanFilterType::IntegralImageType, IntegralImageFilterType::OutputImageType>);
+    const auto mean = MeanFilterType::New();
+    mean->SetInput(image);
+    mean->SetRadius(radius);
+    mean->Update();
+    const auto sharedMean = MeanFilterType::New();
+    sharedMean->SetInput(image);
+    sharedMean->SetIntegralImage(integralImageFilter->GetOutput());
+    sharedMean->SetRadius(radius);
+    sharedMean->Update();
+
+    using SigmaFilterType = itk::BoxSigmaImageFilter<ImageType, RealImageType>;
+    const auto sigma = SigmaFilterType::New();
+    sigma->SetInput(image);
+    sigma->SetRadius(radius);
+    sigma->Update();
+    const auto sharedSigma = SigmaFilterType::New();
+    sharedSigma->SetInput(image);
+    sharedSigma->SetIntegralImage(integralImageFilter->GetOutput());
+    sharedSigma->SetRadius(radius);
+    sharedSigma->Update();
+
+    for (itk::ImageRegionConstIteratorWithIndex<RealImageType> it(mean->GetOutput(),
+                                                                 image->GetLargestPossibleRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      const auto & index = it.GetIndex();
+      EXPECT_FLOAT_EQ(sharedMean->GetOutput()->GetPixel(index), it.Get()) << "radius " << radius << " at " << index;
+      EXPECT_NEAR(sharedSigma->GetOutput()->GetPixel(index), sigma->GetOutput()->GetPixel(index), 1e-3)
+        << "radius " << radius << " at " << index;
+    }
+  }
+  // The integral image was computed once.
+  EXPECT_EQ(integralImageFilter->GetOutput()->GetUpdateMTime(), updateTime);
+}
@@ -21,8 +21,10 @@
 
 #include "itkImage.h"
 #include "itkImageBufferRange.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
 
-#include <numeric> // For iota.
+#include <algorithm> // For transform.
+#include <numeric>   // For iota.
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -92,6 +94,58 @@ Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numb
   EXPECT_EQ(outputPixelValues, expectedPixelValues);
 }
 
+
+// Expects the same output from an integer image, which may use the histogram or sorting network based median, as
+// from a floating point image with the same pixel values, which always uses std::nth_element.
+template <typename TPixel, unsigned int VDimension>
+void
+Expect_same_output_as_floating_point_image_of_random_values(const itk::Size<VDimension> & imageSize,
+                                                            const itk::Size<VDimension> & radius,
+                                                            const int                     minimumValue,
+                                                            const int                     maximumValue)
+{
+  using IntegerImageType = itk::Image<TPixel, VDimension>;
+  using FloatImageType = itk::Image<float, VDimension>;
+
+  const auto integerImage = IntegerImageType::New();
+  integerImage->SetRegions(imageSize);
+  integerImage->Allocate();
+  const auto floatImage = FloatImageType::New();
+  floatImage->SetRegions(imageSize);
+  floatImage->Allocate();
+
+  const auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  const itk::ImageBufferRange integerRange{ *integerImage };
+  for (auto && pixel : integerRange)
+  {
+    pixel = static_cast<TPixel>(minimumValue + static_cast<int>(generator->GetIntegerVariate(
+                                                 static_cast<uint32_t>(maximumValue - minimumValue))));
+  }
+  const itk::ImageBufferRange floatRange{ *floatImage };
+  std::transform(integerRange.cbegin(), integerRange.cend(), floatRange.begin(), [](const TPixel pixel) {
+    return static_cast<float>(pixel);
+  });
+
+  const auto integerFilter = itk::MedianImageFilter<IntegerImageType, IntegerImageType>::New();
+  integerFilter->SetInput(integerImage);
+  integerFilter->SetRadius(radius);
+  integerFilter->Update();
+
+  const auto floatFilter = itk::MedianImageFilter<FloatImageType, FloatImageType>::New();
+  floatFilter->SetInput(floatImage);
+  floatFilter->SetRadius(radius);
+  floatFilter->Update();
+
+  const auto integerOutput = itk::MakeImageBufferRange(integerFilter->GetOutput());
+  const auto floatOutput = itk::MakeImageBufferRange(floatFilter->GetOutput());
+  ASSERT_EQ(integerOutput.size(), floatOutput.size());
+  for (size_t i = 0; i < integerOutput.size(); ++i)
+  {
+    ASSERT_EQ(static_cast<float>(integerOutput[i]), floatOutput[i]) << "Radius " << radius << ", pixel " << i;
+  }
+}
+
 } // namespace
 
 
@@ -122,3 +176,34 @@ TEST(MedianImageFilter, ExpectedOutputPixelValuesForSequenceOfNaturalNumbers)
   Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numbers<itk::Image<int, 3>>(
     itk::Size<3>{ { 2, 2, 2 } }, { 3, 3, 3, 4, 5, 6, 6, 6 });
 }
+
+
+// Tests that the sliding histogram and the sorting network yield the same median as std::nth_element.
+TEST(MedianImageFilter, IntegerFastPathsMatchFloatingPointResult)
+{
+  using Size2D = itk::Size<2>;
+  using Size3D = itk::Size<3>;
+
+  // Sorting network, 3x3.
+  Expect_same_output_as_floating_point_image_of_random_values<uint8_t, 2>(
+    Size2D{ { 13, 11 } }, Size2D{ { 1, 1 } }, 0, 255);
+  Expect_same_output_as_floating_point_image_of_random_values<int>(Size2D{ { 13, 11 } }, Size2D{ { 1, 1 } }, -50, 50);
+
+  // Sliding histogram, including a radius of zero along the scanline, a neighborhood larger than the image, and
+  // narrow value ranges.
+  Expect_same_output_as_floating_point_image_of_random_values<uint8_t, 2>(Size2D{ { 5, 4 } }, Size2D{ { 3, 3 } }, 0, 9);
+  Expect_same_output_as_floating_point_image_of_random_values<uint8_t, 2>(
+    Size2D{ { 40, 30 } }, Size2D{ { 3, 2 } }, 0, 255);
+  Expect_same_output_as_floating_point_image_of_random_values<int8_t, 2>(
+    Size2D{ { 40, 30 } }, Size2D{ { 2, 3 } }, -128, 127);
+  Expect_same_output_as_floating_point_image_of_random_values<int8_t, 2>(
+    Size2D{ { 30, 40 } }, Size2D{ { 0, 15 } }, -3, 3);
+  Expect_same_output_as_floating_point_image_of_random_values<uint16_t, 2>(
+    Size2D{ { 40, 30 } }, Size2D{ { 4, 4 } }, 0, 65535);
+  Expect_same_output_as_floating_point_image_of_random_values<int16_t, 2>(
+    Size2D{ { 40, 30 } }, Size2D{ { 5, 3 } }, -20000, 20000);
+  Expect_same_output_as_floating_point_image_of_random_values<uint16_t, 3>(
+    Size3D{ { 16, 12, 10 } }, Size3D{ { 2, 2, 2 } }, 1000, 1200);
+  Expect_same_output_as_floating_point_image_of_random_values<uint8_t, 3>(
+    Size3D{ { 16, 12, 10 } }, Size3D{ { 1, 1, 1 } }, 0, 255);
+}
@@ -28,6 +28,7 @@
 #include "itkMetaDataObjectBase.h"
 #include "itkMetaDataDictionary.h"
 #include <memory> // For unique_ptr.
+#include <vector>
 
 // itk namespace first suppresses
 // kwstyle error for the H5 namespace below
@@ -138,6 +139,23 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Type of the chunk size, in voxels, in ITK dimension order (fastest
+   * moving dimension first). */
+  using ChunkSizeType = std::vector<SizeValueType>;
+
+  /** Set/Get the shape of the chunks in which VoxelData is stored and
+   * compressed when writing. HDF5 reads and decompresses whole chunks, so a
+   * streamed read only touches the chunks intersecting the requested region,
+   * and a streamed write is split on chunk boundaries of the slowest moving
+   * dimension.
+   *
+   * Entries of 0, and dimensions beyond the size of the vector, use the
+   * full extent of the image. The default, an empty vector, stores each
+   * slice of an image of three or more dimensions in its own chunks, tiled
+   * in-plane so that a chunk holds at most about 1 MiB. */
+  itkSetMacro(ChunkSize, ChunkSizeType);
+  itkGetConstReferenceMacro(ChunkSize, ChunkSizeType);
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO() override;
@@ -148,6 +166,15 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  unsigned int
+  GetActualNumberOfSplitsForWritingCanStreamWrite(unsigned int          numberOfRequestedSplits,
+                                                  const ImageIORegion & pasteRegion) const override;
+
+  ImageIORegion
+  GetSplitRegionForWritingCanStreamWrite(unsigned int          ithPiece,
+                                         unsigned int          numberOfActualSplits,
+                                         const ImageIORegion & pasteRegion) const override;
+
 private:
   void
   WriteString(const std::string & path, const std::string & value);
@@ -204,6 +231,11 @@ private:
   void
   SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpace);
 
+  /** The chunk size used for writing: m_ChunkSize, with defaults filled
+   * in and clamped to the image dimensions. */
+  ChunkSizeType
+  GetChunkSizeForWriting() const;
+
   /* A convenience function to ensure that the
    * state of the HDF5ImageIO object is returned
    * to a state similar to constructing a new
@@ -217,6 +249,7 @@ private:
   std::unique_ptr<H5::H5File>  m_H5File;
   std::unique_ptr<H5::DataSet> m_VoxelDataSet;
   bool                         m_ImageInformationWritten{ false };
+  ChunkSizeType                m_ChunkSize{};
 };
 } // end namespace itk
 
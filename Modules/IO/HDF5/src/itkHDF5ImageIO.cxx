@@ -22,8 +22,11 @@
 #include "itksys/SystemTools.hxx"
 #include "itk_H5Cpp.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkPrintHelper.h"
 
 #include <algorithm>
+#include <functional>  // For multiplies.
+#include <numeric>     // For accumulate.
 #include <type_traits> // For is_signed_v.
 
 namespace itk
@@ -49,9 +52,12 @@ HDF5ImageIO::~HDF5ImageIO() { this->ResetToInitialState(); }
 void
 HDF5ImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
+  using namespace print_helper;
+
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << m_H5File.get() << std::endl;
+  os << indent << "ChunkSize: " << m_ChunkSize << std::endl;
 }
 
 //
@@ -270,6 +276,71 @@ doesAttrExist(const H5::H5Object & object, const char * const name)
   return (H5Aexists(object.getId(), name) > 0 ? true : false);
 }
 
+// Default upper bound of the number of bytes per chunk: the size of the
+// default HDF5 chunk cache.
+constexpr size_t DefaultMaximumChunkNumberOfBytes = size_t{ 1 } << 20;
+
+// Upper bound of the chunk cache of VoxelData.
+constexpr size_t MaximumChunkCacheNumberOfBytes = size_t{ 64 } << 20;
+
+// Access properties for VoxelData with a chunk cache large enough to hold
+// a layer of chunks across the slowest moving dimension (dims and chunkDims
+// are in HDF5 order), so that a streamed read or write which splits such a
+// layer decompresses and compresses each chunk only once.
+H5::DSetAccPropList
+MakeVoxelDataAccessPropList(const int numDims, const hsize_t * dims, const hsize_t * chunkDims, const size_t voxelSize)
+{
+  size_t numberOfChunks = 1;
+  size_t chunkNumberOfBytes = voxelSize;
+  for (int i = 0; i < numDims; ++i)
+  {
+    if (i > 0)
+    {
+      numberOfChunks *= (dims[i] + chunkDims[i] - 1) / chunkDims[i];
+    }
+    chunkNumberOfBytes *= chunkDims[i];
+  }
+  const size_t layerNumberOfBytes = numberOfChunks * chunkNumberOfBytes;
+
+  const H5::DSetAccPropList dapl;
+  if (layerNumberOfBytes > DefaultMaximumChunkNumberOfBytes)
+  {
+    // HDF5 recommends about 100 hash table slots per cached chunk.
+    const size_t cacheNumberOfBytes = std::min(layerNumberOfBytes, MaximumChunkCacheNumberOfBytes);
+    const size_t numberOfSlots = 100 * std::max<size_t>(cacheNumberOfBytes / chunkNumberOfBytes, 1) + 1;
+    dapl.setChunkCache(numberOfSlots, cacheNumberOfBytes, H5D_CHUNK_CACHE_W0_DEFAULT);
+  }
+  return dapl;
+}
+
+// The layers of chunks which a streamed write splits: the slowest moving
+// dimension of region with more than one voxel, and the range of chunk
+// indices along it. Returns false if region cannot be split.
+bool
+GetChunkLayers(const ImageIORegion &                region,
+               const HDF5ImageIO::ChunkSizeType & chunkSize,
+               unsigned int &                       splitAxis,
+               SizeValueType &                      firstLayer,
+               SizeValueType &                      numberOfLayers)
+{
+  splitAxis = region.GetImageDimension();
+  while (splitAxis > 0 && region.GetSize(splitAxis - 1) <= 1)
+  {
+    --splitAxis;
+  }
+  if (splitAxis == 0)
+  {
+    return false;
+  }
+  --splitAxis;
+
+  const SizeValueType layerSize = (splitAxis < chunkSize.size()) ? chunkSize[splitAxis] : 1;
+  const auto          start = static_cast<SizeValueType>(region.GetIndex(splitAxis));
+  firstLayer = start / layerSize;
+  numberOfLayers = (start + region.GetSize(splitAxis) - 1) / layerSize - firstLayer + 1;
+  return true;
+}
+
 } // namespace
 
 void
@@ -744,6 +815,23 @@ HDF5ImageIO::ReadImageInformation()
     std::string VoxelDataName(groupName);
     VoxelDataName += VoxelData;
     *(m_VoxelDataSet) = m_H5File->openDataSet(VoxelDataName);
+    {
+      // Reopen chunked voxel data with a chunk cache which suits streaming.
+      const H5::DSetCreatPropList plist = m_VoxelDataSet->getCreatePlist();
+      if (plist.getLayout() == H5D_CHUNKED)
+      {
+        const H5::DataSpace space = m_VoxelDataSet->getSpace();
+        const int           nDims = space.getSimpleExtentNdims();
+        const auto          Dims = make_unique_for_overwrite<hsize_t[]>(nDims);
+        const auto          chunkDims = make_unique_for_overwrite<hsize_t[]>(nDims);
+        space.getSimpleExtentDims(Dims.get());
+        plist.getChunk(nDims, chunkDims.get());
+        const size_t voxelSize = m_VoxelDataSet->getDataType().getSize();
+        m_VoxelDataSet->close();
+        *(m_VoxelDataSet) = m_H5File->openDataSet(
+          VoxelDataName, MakeVoxelDataAccessPropList(nDims, Dims.get(), chunkDims.get(), voxelSize));
+      }
+    }
     H5::DataSet         imageSet = *(m_VoxelDataSet);
     const H5::DataSpace imageSpace = imageSet.getSpace();
     //
@@ -995,6 +1083,95 @@ HDF5ImageIO::SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpac
   imageSpace->selectHyperslab(H5S_SELECT_SET, HDFSize.get(), offset.get());
 }
 
+HDF5ImageIO::ChunkSizeType
+HDF5ImageIO::GetChunkSizeForWriting() const
+{
+  const unsigned int numDims = this->GetNumberOfDimensions();
+  ChunkSizeType      chunkSize(m_Dimensions.begin(), m_Dimensions.begin() + numDims);
+
+  if (!m_ChunkSize.empty())
+  {
+    for (unsigned int i = 0; i < numDims && i < m_ChunkSize.size(); ++i)
+    {
+      if (m_ChunkSize[i] > 0)
+      {
+        chunkSize[i] = std::min(m_ChunkSize[i], chunkSize[i]);
+      }
+    }
+    return chunkSize;
+  }
+
+  // One slice per chunk, as the slowest moving dimension is the one to
+  // stream along, with the slice tiled by halving its largest extent.
+  unsigned int tiledDims = numDims;
+  if (numDims >= 3)
+  {
+    chunkSize[numDims - 1] = 1;
+    --tiledDims;
+  }
+  const SizeValueType voxelSize = this->GetComponentSize() * this->GetNumberOfComponents();
+  const auto          chunkNumberOfBytes = [&chunkSize, voxelSize] {
+    return std::accumulate(chunkSize.cbegin(), chunkSize.cend(), voxelSize, std::multiplies<>());
+  };
+  while (chunkNumberOfBytes() > DefaultMaximumChunkNumberOfBytes)
+  {
+    // Prefer halving slower moving dimensions, which keeps rows contiguous.
+    const auto largest = std::max_element(chunkSize.rbegin() + (numDims - tiledDims), chunkSize.rend());
+    if (*largest <= 1)
+    {
+      break;
+    }
+    *largest = (*largest + 1) / 2;
+  }
+  return chunkSize;
+}
+
+unsigned int
+HDF5ImageIO::GetActualNumberOfSplitsForWritingCanStreamWrite(unsigned int          numberOfRequestedSplits,
+                                                             const ImageIORegion & pasteRegion) const
+{
+  // Split on chunk boundaries, so that each chunk is compressed and written
+  // once, by a single piece.
+  unsigned int  splitAxis = 0;
+  SizeValueType firstLayer = 0;
+  SizeValueType numberOfLayers = 0;
+  if (!GetChunkLayers(pasteRegion, this->GetChunkSizeForWriting(), splitAxis, firstLayer, numberOfLayers))
+  {
+    return 1;
+  }
+  numberOfRequestedSplits = std::max(1u, numberOfRequestedSplits);
+  const SizeValueType layersPerPiece = (numberOfLayers + numberOfRequestedSplits - 1) / numberOfRequestedSplits;
+  return static_cast<unsigned int>((numberOfLayers + layersPerPiece - 1) / layersPerPiece);
+}
+
+ImageIORegion
+HDF5ImageIO::GetSplitRegionForWritingCanStreamWrite(unsigned int          ithPiece,
+                                                    unsigned int          numberOfActualSplits,
+                                                    const ImageIORegion & pasteRegion) const
+{
+  const ChunkSizeType chunkSize = this->GetChunkSizeForWriting();
+  unsigned int        splitAxis = 0;
+  SizeValueType       firstLayer = 0;
+  SizeValueType       numberOfLayers = 0;
+  if (!GetChunkLayers(pasteRegion, chunkSize, splitAxis, firstLayer, numberOfLayers))
+  {
+    return pasteRegion;
+  }
+  const SizeValueType layerSize = (splitAxis < chunkSize.size()) ? chunkSize[splitAxis] : 1;
+  const SizeValueType layersPerPiece = (numberOfLayers + numberOfActualSplits - 1) / numberOfActualSplits;
+  const SizeValueType pieceFirstLayer = firstLayer + ithPiece * layersPerPiece;
+  const SizeValueType pieceEndLayer = std::min(pieceFirstLayer + layersPerPiece, firstLayer + numberOfLayers);
+
+  const auto          start = static_cast<SizeValueType>(pasteRegion.GetIndex(splitAxis));
+  const SizeValueType begin = std::max(start, pieceFirstLayer * layerSize);
+  const SizeValueType end = std::min(start + pasteRegion.GetSize(splitAxis), pieceEndLayer * layerSize);
+
+  ImageIORegion splitRegion = pasteRegion;
+  splitRegion.SetIndex(splitAxis, static_cast<IndexValueType>(begin));
+  splitRegion.SetSize(splitAxis, end - begin);
+  return splitRegion;
+}
+
 void
 HDF5ImageIO::Read(void * buffer)
 {
@@ -1183,21 +1360,36 @@ HDF5ImageIO::WriteImageInformation()
     const H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
 
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
-    // region
     const H5::DSetCreatPropList plist;
 
     // we have implicit compression enabled here?
-    plist.setDeflate(this->GetCompressionLevel());
+    if (this->GetCompressionLevel() > 0)
+    {
+      plist.setDeflate(this->GetCompressionLevel());
+    }
 
-    dims[0] = 1;
-    plist.setChunk(numDims, dims.get());
-    dims.reset();
+    const ChunkSizeType chunkSize = this->GetChunkSizeForWriting();
+    const auto          chunkDims = make_unique_for_overwrite<hsize_t[]>(numDims);
+    for (int i(0), j(static_cast<int>(this->GetNumberOfDimensions()) - 1); j >= 0; i++, j--)
+    {
+      chunkDims[i] = chunkSize[j];
+    }
+    if (numComponents > 1)
+    {
+      chunkDims[numDims - 1] = numComponents;
+    }
+    plist.setChunk(numDims, chunkDims.get());
 
     std::string VoxelDataName(ImageGroup);
     VoxelDataName += "/0";
     VoxelDataName += VoxelData;
-    *(m_VoxelDataSet) = m_H5File->createDataSet(VoxelDataName, dataType, imageSpace, plist);
+    *(m_VoxelDataSet) = m_H5File->createDataSet(
+      VoxelDataName,
+      dataType,
+      imageSpace,
+      plist,
+      MakeVoxelDataAccessPropList(numDims, dims.get(), chunkDims.get(), this->GetComponentSize()));
+    dims.reset();
     std::string MetaDataGroupName(groupName);
     MetaDataGroupName += MetaDataName;
     m_H5File->createGroup(MetaDataGroupName);
@@ -15,6 +15,7 @@
  *  limitations under the License.
  *
  *=========================================================================*/
+#include "itkHDF5ImageIO.h"
 #include "itkHDF5ImageIOFactory.h"
 #include "itkIOTestHelper.h"
 #include "itkPipelineMonitorImageFilter.h"
@@ -237,6 +238,112 @@ HDF5ReadWriteTest2(const char * fileName)
   return EXIT_SUCCESS;
 }
 
+template <typename TPixel>
+int
+HDF5ChunkedReadWriteTest(const char * fileName)
+{
+  {
+    using ImageType = itk::Image<TPixel, 3>;
+
+    typename ImageType::SizeType size;
+    size.Fill(5);
+    const typename itk::DemoImageSource<ImageType>::Pointer imageSource = itk::DemoImageSource<ImageType>::New();
+    imageSource->SetSize(size);
+
+    // Write image with streaming, in chunks of 3 x 2 x 2 voxels.
+    auto                                  imageIO = itk::HDF5ImageIO::New();
+    const itk::HDF5ImageIO::ChunkSizeType chunkSize{ 3, 2, 2 };
+    imageIO->SetChunkSize(chunkSize);
+    if (imageIO->GetChunkSize() != chunkSize)
+    {
+      std::cout << "GetChunkSize() doesn't return the chunk size set" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    using WriterType = itk::ImageFileWriter<ImageType>;
+    auto writer = WriterType::New();
+    using MonitorFilterType = itk::PipelineMonitorImageFilter<ImageType>;
+    auto writerMonitor = MonitorFilterType::New();
+    writerMonitor->SetInput(imageSource->GetOutput());
+    writer->SetFileName(fileName);
+    writer->SetImageIO(imageIO);
+    writer->SetInput(writerMonitor->GetOutput());
+    writer->SetNumberOfStreamDivisions(5);
+    try
+    {
+      writer->Write();
+    }
+    catch (const itk::ExceptionObject & err)
+    {
+      std::cout << "itkHDF5ImageIOTest" << std::endl << "Exception Object caught: " << std::endl << err << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The five requested divisions are merged to the three layers of chunks along the slowest dimension.
+    if (!writerMonitor->VerifyInputFilterExecutedStreaming(3))
+    {
+      return EXIT_FAILURE;
+    }
+    typename MonitorFilterType::RegionVectorType writerRegionVector = writerMonitor->GetUpdatedBufferedRegions();
+    for (typename ImageType::RegionType::IndexValueType iRegion = 0; iRegion < 3; ++iRegion)
+    {
+      typename ImageType::RegionType expectedRegion = imageSource->GetOutput()->GetLargestPossibleRegion();
+      expectedRegion.SetIndex(2, 2 * iRegion);
+      expectedRegion.SetSize(2, (iRegion < 2) ? 2 : 1);
+      if (writerRegionVector[iRegion] != expectedRegion)
+      {
+        std::cout << "Written image region number " << iRegion << " :" << writerRegionVector[iRegion]
+                  << " doesn't match expected one: " << expectedRegion << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Force writer close.
+    writer = typename WriterType::Pointer();
+
+    // Read a region which crosses chunk boundaries.
+    using ReaderType = itk::ImageFileReader<ImageType>;
+    auto reader = ReaderType::New();
+    reader->SetFileName(fileName);
+    reader->SetUseStreaming(true);
+    typename ImageType::RegionType roi;
+    roi.SetIndex({ { 1, 2, 1 } });
+    roi.SetSize({ { 3, 2, 3 } });
+    try
+    {
+      reader->UpdateOutputInformation();
+      reader->GetOutput()->SetRequestedRegion(roi);
+      reader->Update();
+    }
+    catch (const itk::ExceptionObject & err)
+    {
+      std::cout << "itkHDF5ImageIOTest" << std::endl << "Exception Object caught: " << std::endl << err << std::endl;
+      return EXIT_FAILURE;
+    }
+    const typename ImageType::Pointer image = reader->GetOutput();
+    if (image->GetBufferedRegion() != roi)
+    {
+      std::cout << "Read image buffered region: " << image->GetBufferedRegion()
+                << " doesn't match requested one: " << roi << std::endl;
+      return EXIT_FAILURE;
+    }
+    itk::ImageRegionIterator<ImageType> it(image, roi);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const typename ImageType::IndexType idx = it.ComputeIndex();
+      const TPixel                        origValue(idx[2] * 100 + idx[1] * 10 + idx[0]);
+      if (itk::Math::NotAlmostEquals(it.Get(), origValue))
+      {
+        std::cout << "Original Pixel (" << origValue << ") doesn't match read-in Pixel (" << it.Get() << ')'
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  itk::IOTestHelper::Remove(fileName);
+  return EXIT_SUCCESS;
+}
+
 int
 itkHDF5ImageIOStreamingReadWriteTest(int argc, char * argv[])
 {
@@ -253,5 +360,7 @@ itkHDF5ImageIOStreamingReadWriteTest(int argc, char * argv[])
   result += HDF5ReadWriteTest2<unsigned char>("StreamingUCharImage.hdf5");
   result += HDF5ReadWriteTest2<float>("StreamingFloatImage.hdf5");
   result += HDF5ReadWriteTest2<itk::RGBPixel<unsigned char>>("StreamingRGBImage.hdf5");
+  result += HDF5ChunkedReadWriteTest<float>("ChunkedFloatImage.hdf5");
+  result += HDF5ChunkedReadWriteTest<itk::RGBPixel<unsigned char>>("ChunkedRGBImage.hdf5");
   return result != 0;
 }
@@ -121,6 +121,24 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
   /** @ITKEndGrouping */
+
+  /** Set/Get whether the pixel buffer of the output may be a memory mapping
+   * of the file, instead of a newly allocated buffer into which the file is
+   * read. Mapping makes reading a large image almost instantaneous, and the
+   * operating system only pages in the parts of the image which are actually
+   * accessed.
+   *
+   * The file is mapped when the ImageIO reports the location of the pixel
+   * data (see ImageIOBase::GetRawPixelDataLocation()), the whole image is
+   * read at once, and no pixel type conversion is needed. Otherwise the image
+   * is read as usual. The mapping is private and copy-on-write: modifying the
+   * output image never modifies the file. The file must not be modified while
+   * the output image uses it. Default is false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+  /** @ITKEndGrouping */
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -156,6 +174,12 @@ protected:
   void
   GenerateData() override;
 
+  /** Make the output buffer a memory mapping of the pixel data in the file,
+   * if possible. Returns false if the pixel data has to be read instead.
+   * \sa SetUseMemoryMapping */
+  bool
+  MapPixelDataToOutput();
+
   ImageIOBase::Pointer m_ImageIO{};
 
   bool m_UserSpecifiedImageIO{}; // keep track whether the
@@ -163,6 +187,8 @@ protected:
 
   bool m_UseStreaming{};
 
+  bool m_UseMemoryMapping{ false };
+
 private:
   std::string m_ExceptionMessage{};
 
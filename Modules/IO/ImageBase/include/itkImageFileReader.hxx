@@ -24,10 +24,12 @@
 #include "itkPixelTraits.h"
 #include "itkVectorImage.h"
 #include "itkMetaDataObject.h"
+#include "itkMemoryMappedFile.h"
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
 #include <fstream>
+#include <type_traits> // For is_trivially_destructible_v.
 
 namespace itk
 {
@@ -49,6 +51,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  itkPrintSelfBooleanMacro(UseMemoryMapping);
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
@@ -356,13 +359,6 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
   const typename TOutputImage::Pointer output = this->GetOutput();
 
-  itkDebugMacro("ImageFileReader::GenerateData() \n"
-                << "Allocating the buffer with the EnlargedRequestedRegion \n"
-                << output->GetRequestedRegion() << '\n');
-
-  // allocated the output image to the size of the enlarge requested region
-  this->AllocateOutputs();
-
   // Test if the file exists and if it can be opened.
   // An exception will be thrown otherwise, since we can't
   // successfully read the file. We catch the exception because some
@@ -385,6 +381,19 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   itkDebugMacro("Setting imageIO IORegion to: " << m_ActualIORegion);
   m_ImageIO->SetIORegion(m_ActualIORegion);
 
+  if (m_UseMemoryMapping && this->MapPixelDataToOutput())
+  {
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
+  itkDebugMacro("ImageFileReader::GenerateData() \n"
+                << "Allocating the buffer with the EnlargedRequestedRegion \n"
+                << output->GetRequestedRegion() << '\n');
+
+  // allocated the output image to the size of the enlarge requested region
+  this->AllocateOutputs();
+
   // the size of the buffer is computed based on the actual number of
   // pixels to be read and the actual size of the pixels to be read
   // (as opposed to the sizes of the output)
@@ -441,6 +450,70 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MapPixelDataToOutput()
+{
+  // The pixels are used as stored in the file, without construction or destruction.
+  if constexpr (!std::is_trivially_destructible_v<OutputImagePixelType>)
+  {
+    return false;
+  }
+  else
+  {
+    const typename TOutputImage::Pointer output = this->GetOutput();
+
+    // Only the whole image, without pixel conversion, can be mapped.
+    const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+    if (m_ImageIO->GetComponentType() != ioType ||
+        m_ImageIO->GetNumberOfComponents() != output->GetNumberOfComponentsPerPixel() ||
+        m_ActualIORegion.GetNumberOfPixels() != output->GetRequestedRegion().GetNumberOfPixels())
+    {
+      return false;
+    }
+    for (unsigned int i = 0; i < m_ImageIO->GetNumberOfDimensions(); ++i)
+    {
+      if (i >= m_ActualIORegion.GetImageDimension() || m_ActualIORegion.GetIndex(i) != 0 ||
+          m_ActualIORegion.GetSize(i) != m_ImageIO->GetDimensions(i))
+      {
+        return false;
+      }
+    }
+
+    std::string   dataFileName;
+    SizeValueType offset = 0;
+    if (!m_ImageIO->GetRawPixelDataLocation(dataFileName, offset) ||
+        offset % alignof(OutputImagePixelType) != 0)
+    {
+      return false;
+    }
+
+    const SizeValueType numberOfBytes = m_ActualIORegion.GetNumberOfPixels() * m_ImageIO->GetComponentSize() *
+                                        m_ImageIO->GetNumberOfComponents();
+    if (numberOfBytes % sizeof(OutputImagePixelType) != 0)
+    {
+      return false;
+    }
+
+    const auto mappedFile = MemoryMappedFile::New();
+    if (!mappedFile->Map(dataFileName, offset, numberOfBytes))
+    {
+      itkDebugMacro("Could not memory map " << dataFileName << ", reading it instead.");
+      return false;
+    }
+    itkDebugMacro("Memory mapped " << numberOfBytes << " bytes of " << dataFileName << " at offset " << offset);
+
+    // Equivalent to AllocateOutputs(), except that the buffer is imported.
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->GetPixelContainer()->SetImportPointerWithOwner(
+      static_cast<OutputImagePixelType *>(mappedFile->GetData()),
+      static_cast<typename TOutputImage::PixelContainer::ElementIdentifier>(numberOfBytes /
+                                                                             sizeof(OutputImagePixelType)),
+      mappedFile);
+    return true;
+  }
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(const void * inputData, size_t numberOfPixels)
@@ -518,6 +518,18 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Get the location in the file of the pixel data of the whole image, so
+   * that it can be memory mapped instead of read. Returns true if the pixels
+   * are stored uncompressed and contiguously in a single file, exactly as
+   * Read() would return them (components of GetComponentType(), in the byte
+   * order of this machine), and sets fileName to the name of that file and
+   * offset to the position of the first byte of pixel data. Returns false
+   * otherwise, which is what the default implementation does.
+   * Assumes ReadImageInformation() has been called.
+   * \sa ImageFileReader::SetUseMemoryMapping */
+  virtual bool
+  GetRawPixelDataLocation(std::string & fileName, SizeValueType & offset);
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedFile_h
+#define itkMemoryMappedFile_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+
+#include <string>
+
+namespace itk
+{
+/** \class MemoryMappedFile
+ * \brief Private, copy-on-write memory mapping of a part of a file.
+ *
+ * The mapped bytes can be read and modified like ordinary memory. The file
+ * itself is never modified: the operating system pages the bytes in from the
+ * file as they are accessed, and gives a page a private copy when it is first
+ * written to. The mapping is released when the object is destroyed.
+ *
+ * The file must not be truncated or modified while it is mapped.
+ *
+ * \sa ImageFileReader::SetUseMemoryMapping
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT MemoryMappedFile : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedFile);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedFile;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedFile);
+
+  /** Map numberOfBytes bytes of the file, starting at byte offset. Returns
+   * false, leaving the object unmapped, if the file cannot be opened or
+   * mapped, or if it is shorter than offset + numberOfBytes. A previous
+   * mapping is released first. */
+  bool
+  Map(const std::string & fileName, SizeValueType offset, SizeValueType numberOfBytes);
+
+  /** Release the mapping. Does nothing if nothing is mapped. */
+  void
+  Unmap();
+
+  /** Pointer to the byte at the offset passed to Map(), or nullptr if nothing is mapped. */
+  void *
+  GetData() const
+  {
+    return m_Data;
+  }
+
+  /** Number of bytes passed to Map(), or zero if nothing is mapped. */
+  SizeValueType
+  GetNumberOfBytes() const
+  {
+    return m_NumberOfBytes;
+  }
+
+protected:
+  MemoryMappedFile() = default;
+  ~MemoryMappedFile() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  // The mapping starts at the allocation granularity boundary at or before the requested offset.
+  void *        m_MappedAddress{ nullptr };
+  SizeValueType m_MappedLength{ 0 };
+  void *        m_Data{ nullptr };
+  SizeValueType m_NumberOfBytes{ 0 };
+  std::string   m_FileName{};
+};
+} // namespace itk
+
+#endif // itkMemoryMappedFile_h
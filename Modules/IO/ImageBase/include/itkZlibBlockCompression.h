@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZlibBlockCompression_h
+#define itkZlibBlockCompression_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkMacro.h"
+
+#include <cstddef>
+#include <functional>
+
+namespace itk
+{
+/** \class ZlibBlockCompression
+ * \brief Multi-threaded gzip compression and decompression of a buffer.
+ *
+ * Compress() splits the buffer into blocks which are deflated concurrently
+ * with the ITK thread pool, each into an independent member of a gzip file
+ * (RFC 1952). Any gzip reader inflates the concatenated members as one
+ * stream. As in the BGZF format, the header of every member holds an extra
+ * field with the size of the member (an "IK" subfield), which gzip readers
+ * skip. It lets Uncompress() find the next members without inflating them,
+ * and inflate them concurrently as well. Other gzip data is inflated
+ * sequentially.
+ *
+ * The functions process a batch of blocks, one per work unit, at a time.
+ * The data is streamed through the given write and read functions, so that
+ * only the compressed blocks of the current batch are held in memory.
+ *
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT ZlibBlockCompression
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ZlibBlockCompression);
+  ZlibBlockCompression() = default;
+  virtual ~ZlibBlockCompression() = default;
+
+  /** Writes the given number of bytes. Throws an ExceptionObject on failure. */
+  using WriteFunctionType = std::function<void(const void * bytes, size_t numberOfBytes)>;
+
+  /** Reads at most the given number of bytes, and returns the number of bytes read, 0 at the end of the data. */
+  using ReadFunctionType = std::function<size_t(void * bytes, size_t numberOfBytes)>;
+
+  /** Number of uncompressed bytes per block. */
+  static constexpr size_t DefaultBlockSize = size_t{ 1 } << 20;
+
+  /** Deflate numberOfBytes bytes of data with the given zlib compression
+   * level (0-9), and write them as gzip members. numberOfWorkUnits limits
+   * the number of concurrent blocks, 0 uses the global default number of
+   * threads. A blockSize of 0 uses DefaultBlockSize. Throws an
+   * ExceptionObject if zlib fails. */
+  static void
+  Compress(const void *              data,
+           size_t                    numberOfBytes,
+           int                       compressionLevel,
+           const WriteFunctionType & write,
+           unsigned int              numberOfWorkUnits = 0,
+           size_t                    blockSize = 0);
+
+  /** Deflate numberOfBytes bytes of data like Compress(), but into a
+   * single zlib stream (RFC 1950), for readers which inflate only one
+   * stream, such as MetaIO. As in pigz, each block is deflated with the end
+   * of the preceding one as dictionary, and all but the last block end with
+   * a sync flush, so that the blocks join into one deflate stream. Their
+   * Adler-32 checksums are combined for the trailer. The stream is inflated
+   * sequentially. */
+  static void
+  CompressStream(const void *              data,
+                 size_t                    numberOfBytes,
+                 int                       compressionLevel,
+                 const WriteFunctionType & write,
+                 unsigned int              numberOfWorkUnits = 0,
+                 size_t                    blockSize = 0);
+
+  /** Read gzip data, and inflate it into exactly numberOfBytes bytes of
+   * data. The data does not have to be written by Compress(). The members
+   * written by Compress() are read up to the one which completes the data,
+   * other gzip data may be read further, in chunks. Throws an
+   * ExceptionObject if the gzip data is corrupt, or does not hold
+   * numberOfBytes bytes. */
+  static void
+  Uncompress(const ReadFunctionType & read, void * data, size_t numberOfBytes, unsigned int numberOfWorkUnits = 0);
+};
+} // namespace itk
+
+#endif // itkZlibBlockCompression_h
@@ -15,11 +15,14 @@ itk_module(
   ENABLE_SHARED
   DEPENDS
     ITKCommon
+  PRIVATE_DEPENDS
+    ITKZLIB
   TEST_DEPENDS
     ITKGoogleTest
     ITKTestKernel
     ITKIOGDCM
     ITKIOMeta
     ITKImageIntensity
+    ITKZLIB
   DESCRIPTION "${DOCUMENTATION}"
 )
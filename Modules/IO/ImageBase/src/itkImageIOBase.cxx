@@ -364,6 +364,12 @@ ImageIOBase::GetComponentSize() const
   itkExceptionMacro("Unknown component type: " << m_ComponentType);
 }
 
+bool
+ImageIOBase::GetRawPixelDataLocation(std::string & itkNotUsed(fileName), SizeValueType & itkNotUsed(offset))
+{
+  return false;
+}
+
 std::string
 ImageIOBase::GetFileTypeAsString(IOFileEnum t) const
 {
@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMemoryMappedFile.h"
+
+#include <cstdint>
+#include <limits>
+
+#if defined(_WIN32)
+#  include "itksys/Encoding.hxx"
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+  this->Unmap();
+}
+
+bool
+MemoryMappedFile::Map(const std::string & fileName, SizeValueType offset, SizeValueType numberOfBytes)
+{
+  this->Unmap();
+
+  if (numberOfBytes == 0 || offset > std::numeric_limits<SizeValueType>::max() - numberOfBytes)
+  {
+    return false;
+  }
+
+#if defined(_WIN32)
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const SizeValueType granularity = systemInfo.dwAllocationGranularity;
+  const SizeValueType mappedOffset = offset - offset % granularity;
+  const SizeValueType mappedLength = offset - mappedOffset + numberOfBytes;
+
+  const HANDLE file = CreateFileW(itksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || static_cast<SizeValueType>(fileSize.QuadPart) < offset + numberOfBytes)
+  {
+    CloseHandle(file);
+    return false;
+  }
+  // The view keeps the file mapping, and the file mapping keeps the file, open after the handles are closed.
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+  {
+    return false;
+  }
+  void * const address = MapViewOfFile(mapping,
+                                       FILE_MAP_COPY,
+                                       static_cast<DWORD>(static_cast<uint64_t>(mappedOffset) >> 32),
+                                       static_cast<DWORD>(mappedOffset & 0xFFFFFFFFu),
+                                       static_cast<SIZE_T>(mappedLength));
+  CloseHandle(mapping);
+  if (address == nullptr)
+  {
+    return false;
+  }
+#else
+  const auto          granularity = static_cast<SizeValueType>(sysconf(_SC_PAGESIZE));
+  const SizeValueType mappedOffset = offset - offset % granularity;
+  const SizeValueType mappedLength = offset - mappedOffset + numberOfBytes;
+  if (mappedOffset > static_cast<SizeValueType>(std::numeric_limits<off_t>::max()))
+  {
+    return false;
+  }
+
+  const int file = open(fileName.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    return false;
+  }
+  // Accessing mapped pages beyond the end of the file raises SIGBUS, so the file must be long enough.
+  struct stat fileStatus;
+  if (fstat(file, &fileStatus) != 0 || static_cast<SizeValueType>(fileStatus.st_size) < offset + numberOfBytes)
+  {
+    close(file);
+    return false;
+  }
+  void * const address = mmap(nullptr,
+                              static_cast<size_t>(mappedLength),
+                              PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE,
+                              file,
+                              static_cast<off_t>(mappedOffset));
+  // The mapping keeps the file open.
+  close(file);
+  if (address == MAP_FAILED)
+  {
+    return false;
+  }
+#endif
+
+  m_MappedAddress = address;
+  m_MappedLength = mappedLength;
+  m_Data = static_cast<char *>(address) + (offset - mappedOffset);
+  m_NumberOfBytes = numberOfBytes;
+  m_FileName = fileName;
+  this->Modified();
+  return true;
+}
+
+void
+MemoryMappedFile::Unmap()
+{
+  if (m_MappedAddress == nullptr)
+  {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(m_MappedAddress);
+#else
+  munmap(m_MappedAddress, static_cast<size_t>(m_MappedLength));
+#endif
+  m_MappedAddress = nullptr;
+  m_MappedLength = 0;
+  m_Data = nullptr;
+  m_NumberOfBytes = 0;
+  m_FileName.clear();
+  this->Modified();
+}
+
+void
+MemoryMappedFile::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "Data: " << m_Data << std::endl;
+  os << indent << "NumberOfBytes: " << m_NumberOfBytes << std::endl;
+}
+
+} // namespace itk
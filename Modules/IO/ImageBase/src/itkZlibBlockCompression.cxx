@@ -0,0 +1,494 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkZlibBlockCompression.h"
+#include "itkMultiThreaderBase.h"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace itk
+{
+namespace
+{
+// Blocks of at most 1 GiB keep all lengths passed to zlib, and the sizes of the members, within 32 bits.
+constexpr size_t MaximumBlockSize = size_t{ 1 } << 30;
+
+// The header of a member: the fixed part of a gzip header with the FEXTRA flag, the length of the extra field, and
+// the "IK" subfield, which holds the size of the whole member.
+constexpr size_t        MemberHeaderSize = 10 + 2 + 4 + 4;
+constexpr unsigned char SubfieldId[2] = { 'I', 'K' };
+
+// The trailer of a member: the CRC-32 and the size of the uncompressed data.
+constexpr size_t MemberTrailerSize = 8;
+
+constexpr size_t SequentialChunkSize = size_t{ 1 } << 20;
+
+void
+WriteLittleEndian(unsigned char * bytes, const uint32_t value, const unsigned int numberOfBytes)
+{
+  for (unsigned int i = 0; i < numberOfBytes; ++i)
+  {
+    bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+  }
+}
+
+uint32_t
+ReadLittleEndian(const unsigned char * bytes, const unsigned int numberOfBytes)
+{
+  uint32_t value = 0;
+  for (unsigned int i = 0; i < numberOfBytes; ++i)
+  {
+    value |= uint32_t{ bytes[i] } << (8 * i);
+  }
+  return value;
+}
+
+uint32_t
+ComputeCrc(const unsigned char * data, const size_t numberOfBytes)
+{
+  return static_cast<uint32_t>(crc32(crc32(0, nullptr, 0), data, static_cast<uInt>(numberOfBytes)));
+}
+
+MultiThreaderBase::Pointer
+MakeThreader(const unsigned int numberOfWorkUnits)
+{
+  auto threader = MultiThreaderBase::New();
+  if (numberOfWorkUnits > 0)
+  {
+    threader->SetMaximumNumberOfThreads(numberOfWorkUnits);
+    threader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  }
+  return threader;
+}
+
+// Number of blocks which are processed concurrently.
+size_t
+GetBatchSize(const unsigned int numberOfWorkUnits)
+{
+  return (numberOfWorkUnits > 0) ? numberOfWorkUnits : MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+}
+
+// Reads numberOfBytes bytes, unless the data ends before, and returns the number of bytes read.
+size_t
+ReadFully(const ZlibBlockCompression::ReadFunctionType & read, unsigned char * bytes, const size_t numberOfBytes)
+{
+  size_t numberOfReadBytes = 0;
+  while (numberOfReadBytes < numberOfBytes)
+  {
+    const size_t count = read(bytes + numberOfReadBytes, numberOfBytes - numberOfReadBytes);
+    if (count == 0)
+    {
+      break;
+    }
+    numberOfReadBytes += count;
+  }
+  return numberOfReadBytes;
+}
+
+// Whether the header is that of a member written by CompressMember().
+bool
+IsBlockHeader(const unsigned char * header)
+{
+  return header[0] == 0x1f && header[1] == 0x8b && header[2] == Z_DEFLATED && header[3] == 4 &&
+         ReadLittleEndian(header + 10, 2) == 8 && header[12] == SubfieldId[0] && header[13] == SubfieldId[1] &&
+         ReadLittleEndian(header + 14, 2) == 4;
+}
+
+// Deflates a block into a complete gzip member.
+bool
+CompressMember(const unsigned char *        data,
+               const size_t                 numberOfBytes,
+               const int                    compressionLevel,
+               std::vector<unsigned char> & member)
+{
+  z_stream stream{};
+  if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+  // A single deflate() call finishes the stream when the output has room for deflateBound() bytes.
+  const uLong maximumCompressedSize = deflateBound(&stream, static_cast<uLong>(numberOfBytes));
+  member.resize(MemberHeaderSize + maximumCompressedSize + MemberTrailerSize);
+  stream.next_in = const_cast<Bytef *>(data);
+  stream.avail_in = static_cast<uInt>(numberOfBytes);
+  stream.next_out = member.data() + MemberHeaderSize;
+  stream.avail_out = static_cast<uInt>(maximumCompressedSize);
+  const bool succeeded = deflate(&stream, Z_FINISH) == Z_STREAM_END;
+  const auto compressedSize = static_cast<size_t>(stream.total_out);
+  deflateEnd(&stream);
+  if (!succeeded)
+  {
+    return false;
+  }
+
+  member.resize(MemberHeaderSize + compressedSize + MemberTrailerSize);
+  unsigned char * const header = member.data();
+  // Extra flags: maximum compression (2) or fastest (4). Operating system: unknown (255).
+  const unsigned char extraFlags = (compressionLevel == 9) ? 2 : ((compressionLevel == 1) ? 4 : 0);
+  const unsigned char fixedHeader[10] = { 0x1f, 0x8b, Z_DEFLATED, 4, 0, 0, 0, 0, extraFlags, 255 };
+  std::copy(std::begin(fixedHeader), std::end(fixedHeader), header);
+  WriteLittleEndian(header + 10, 8, 2);
+  header[12] = SubfieldId[0];
+  header[13] = SubfieldId[1];
+  WriteLittleEndian(header + 14, 4, 2);
+  WriteLittleEndian(header + 16, static_cast<uint32_t>(member.size()), 4);
+
+  unsigned char * const trailer = member.data() + member.size() - MemberTrailerSize;
+  WriteLittleEndian(trailer, ComputeCrc(data, numberOfBytes), 4);
+  WriteLittleEndian(trailer + 4, static_cast<uint32_t>(numberOfBytes), 4);
+  return true;
+}
+
+// Deflates a block of a zlib stream into raw deflate data, with the preceding data as dictionary. A block other than
+// the last one ends with the empty stored block of a sync flush, on a byte boundary, so that the next block follows.
+bool
+CompressStreamBlock(const unsigned char *        data,
+                    const size_t                 numberOfBytes,
+                    const size_t                 dictionarySize,
+                    const int                    compressionLevel,
+                    const bool                   isLastBlock,
+                    std::vector<unsigned char> & block)
+{
+  z_stream stream{};
+  if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+  if (dictionarySize > 0 &&
+      deflateSetDictionary(&stream, data - dictionarySize, static_cast<uInt>(dictionarySize)) != Z_OK)
+  {
+    deflateEnd(&stream);
+    return false;
+  }
+  // deflateBound() leaves no room for the empty stored block of a sync flush.
+  const uLong maximumCompressedSize = deflateBound(&stream, static_cast<uLong>(numberOfBytes)) + 16;
+  block.resize(maximumCompressedSize);
+  stream.next_in = const_cast<Bytef *>(data);
+  stream.avail_in = static_cast<uInt>(numberOfBytes);
+  stream.next_out = block.data();
+  stream.avail_out = static_cast<uInt>(maximumCompressedSize);
+  const int  result = deflate(&stream, isLastBlock ? Z_FINISH : Z_SYNC_FLUSH);
+  const bool succeeded =
+    isLastBlock ? (result == Z_STREAM_END) : (result == Z_OK && stream.avail_in == 0 && stream.avail_out > 0);
+  block.resize(static_cast<size_t>(stream.total_out));
+  deflateEnd(&stream);
+  return succeeded;
+}
+
+size_t
+GetBlockSize(const size_t blockSize)
+{
+  return std::min((blockSize == 0) ? ZlibBlockCompression::DefaultBlockSize : blockSize, MaximumBlockSize);
+}
+
+// Empty data is written as a single empty block.
+size_t
+GetNumberOfBlocks(const size_t numberOfBytes, const size_t blockSize)
+{
+  return std::max<size_t>(1, (numberOfBytes + blockSize - 1) / blockSize);
+}
+
+// Compresses the blocks of the data concurrently, a batch of blocks at a time, and writes them in order. The
+// compressBlock function gets the offset and the number of bytes of a block, and its compressed bytes to fill in.
+void
+CompressBlocks(const size_t                                                              numberOfBytes,
+               const size_t                                                              blockSize,
+               const unsigned int                                                        numberOfWorkUnits,
+               const std::function<bool(size_t, size_t, std::vector<unsigned char> &)> & compressBlock,
+               const ZlibBlockCompression::WriteFunctionType &                          write)
+{
+  const size_t numberOfBlocks = GetNumberOfBlocks(numberOfBytes, blockSize);
+  const size_t batchSize = std::min(GetBatchSize(numberOfWorkUnits), numberOfBlocks);
+
+  const MultiThreaderBase::Pointer        threader = MakeThreader(numberOfWorkUnits);
+  std::vector<std::vector<unsigned char>> blocks(batchSize);
+  for (size_t firstBlock = 0; firstBlock < numberOfBlocks; firstBlock += batchSize)
+  {
+    const size_t      numberOfBatchBlocks = std::min(batchSize, numberOfBlocks - firstBlock);
+    std::atomic<bool> failed{ false };
+    threader->ParallelizeArray(
+      0,
+      numberOfBatchBlocks,
+      [&](const SizeValueType i) {
+        const size_t offset = (firstBlock + i) * blockSize;
+        if (!compressBlock(offset, std::min(blockSize, numberOfBytes - offset), blocks[i]))
+        {
+          failed = true;
+        }
+      },
+      nullptr);
+    if (failed)
+    {
+      itkGenericExceptionMacro("ZlibBlockCompression: zlib could not compress the data.");
+    }
+    for (size_t i = 0; i < numberOfBatchBlocks; ++i)
+    {
+      write(blocks[i].data(), blocks[i].size());
+    }
+  }
+}
+
+// Inflates a member written by CompressMember(), without its header, into exactly numberOfBytes bytes.
+bool
+UncompressMember(const std::vector<unsigned char> & member, unsigned char * data, const size_t numberOfBytes)
+{
+  z_stream stream{};
+  if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+  {
+    return false;
+  }
+  const size_t compressedSize = member.size() - MemberTrailerSize;
+  stream.next_in = const_cast<Bytef *>(member.data());
+  stream.avail_in = static_cast<uInt>(compressedSize);
+  stream.next_out = data;
+  stream.avail_out = static_cast<uInt>(numberOfBytes);
+  int result = inflate(&stream, Z_FINISH);
+  if (result == Z_BUF_ERROR && stream.avail_out == 0 && stream.avail_in > 0)
+  {
+    // What is left is the end of the deflate stream, which must not produce any more output.
+    unsigned char excess;
+    stream.next_out = &excess;
+    stream.avail_out = 1;
+    result = inflate(&stream, Z_FINISH);
+  }
+  const bool succeeded = result == Z_STREAM_END && stream.total_out == numberOfBytes && stream.avail_in == 0;
+  inflateEnd(&stream);
+  return succeeded &&
+         ReadLittleEndian(member.data() + compressedSize, 4) == ComputeCrc(data, numberOfBytes);
+}
+
+// Inflates gzip data of any origin, member after member, starting with the bytes which are already read.
+void
+UncompressSequentially(std::vector<unsigned char>                     input,
+                       const ZlibBlockCompression::ReadFunctionType & read,
+                       unsigned char *                                data,
+                       const size_t                                   numberOfBytes)
+{
+  z_stream stream{};
+  if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK)
+  {
+    itkGenericExceptionMacro("ZlibBlockCompression: zlib could not initialize the decompression.");
+  }
+  stream.next_in = input.data();
+  stream.avail_in = static_cast<uInt>(input.size());
+
+  size_t        remainingNumberOfBytes = numberOfBytes;
+  unsigned char excess;
+  const char *  error = nullptr;
+  while (error == nullptr)
+  {
+    if (stream.avail_in == 0)
+    {
+      input.resize(SequentialChunkSize);
+      input.resize(read(input.data(), input.size()));
+      if (input.empty())
+      {
+        error = "the gzip data ends before all data is read";
+        break;
+      }
+      stream.next_in = input.data();
+      stream.avail_in = static_cast<uInt>(input.size());
+    }
+    // Once all data is inflated, a byte of excess output detects a longer member.
+    const auto chunk = static_cast<uInt>(std::min<size_t>(remainingNumberOfBytes, std::numeric_limits<uInt>::max()));
+    stream.next_out = (chunk > 0) ? data + (numberOfBytes - remainingNumberOfBytes) : &excess;
+    stream.avail_out = (chunk > 0) ? chunk : 1;
+    const int result = inflate(&stream, Z_NO_FLUSH);
+    if (chunk == 0 && stream.avail_out == 0)
+    {
+      error = "the gzip data holds more data than expected";
+      break;
+    }
+    remainingNumberOfBytes -= chunk - ((chunk > 0) ? stream.avail_out : 0);
+    if (result == Z_STREAM_END)
+    {
+      if (remainingNumberOfBytes == 0)
+      {
+        break;
+      }
+      // The next member of a gzip file.
+      inflateReset(&stream);
+    }
+    else if (result != Z_OK && result != Z_BUF_ERROR)
+    {
+      error = "the gzip data is corrupt";
+    }
+  }
+  inflateEnd(&stream);
+  if (error != nullptr)
+  {
+    itkGenericExceptionMacro("ZlibBlockCompression: " << error << '.');
+  }
+}
+} // namespace
+
+
+void
+ZlibBlockCompression::Compress(const void *              data,
+                               const size_t              numberOfBytes,
+                               const int                 compressionLevel,
+                               const WriteFunctionType & write,
+                               const unsigned int        numberOfWorkUnits,
+                               const size_t              blockSize)
+{
+  const auto * const bytes = static_cast<const unsigned char *>(data);
+  CompressBlocks(
+    numberOfBytes,
+    GetBlockSize(blockSize),
+    numberOfWorkUnits,
+    [bytes, compressionLevel](const size_t offset, const size_t length, std::vector<unsigned char> & member) {
+      return CompressMember(bytes + offset, length, compressionLevel, member);
+    },
+    write);
+}
+
+
+void
+ZlibBlockCompression::CompressStream(const void *              data,
+                                     const size_t              numberOfBytes,
+                                     const int                 compressionLevel,
+                                     const WriteFunctionType & write,
+                                     const unsigned int        numberOfWorkUnits,
+                                     size_t                    blockSize)
+{
+  blockSize = GetBlockSize(blockSize);
+  const auto * const    bytes = static_cast<const unsigned char *>(data);
+  std::vector<uint32_t> checksums(GetNumberOfBlocks(numberOfBytes, blockSize));
+
+  // The zlib header: deflate with a 32 KiB window, and the compression level, rounded as zlib does.
+  const unsigned char compressionMethod = 0x78;
+  const unsigned int  levelFlags =
+    (compressionLevel == Z_DEFAULT_COMPRESSION || compressionLevel == 6)
+       ? 2
+       : ((compressionLevel < 2) ? 0 : ((compressionLevel < 6) ? 1 : 3));
+  const unsigned int  flags = (levelFlags << 6) + (31 - (compressionMethod * 256u + (levelFlags << 6)) % 31) % 31;
+  const unsigned char header[2] = { compressionMethod, static_cast<unsigned char>(flags) };
+  write(header, sizeof(header));
+
+  CompressBlocks(
+    numberOfBytes,
+    blockSize,
+    numberOfWorkUnits,
+    [bytes, numberOfBytes, blockSize, compressionLevel, &checksums](
+      const size_t offset, const size_t length, std::vector<unsigned char> & block) {
+      checksums[offset / blockSize] =
+        static_cast<uint32_t>(adler32(adler32(0, nullptr, 0), bytes + offset, static_cast<uInt>(length)));
+      // As in pigz, the end of the preceding block is the dictionary, so that the blocks compress as well as a
+      // single one.
+      const size_t dictionarySize = std::min<size_t>(offset, size_t{ 1 } << MAX_WBITS);
+      return CompressStreamBlock(
+        bytes + offset, length, dictionarySize, compressionLevel, offset + length == numberOfBytes, block);
+    },
+    write);
+
+  // The zlib trailer: the Adler-32 checksum of the data, combined from those of the blocks, in big-endian order.
+  uLong checksum = checksums[0];
+  for (size_t i = 1; i < checksums.size(); ++i)
+  {
+    checksum = adler32_combine(
+      checksum, checksums[i], static_cast<z_off_t>(std::min(blockSize, numberOfBytes - i * blockSize)));
+  }
+  const unsigned char trailer[4] = { static_cast<unsigned char>(checksum >> 24),
+                                     static_cast<unsigned char>(checksum >> 16),
+                                     static_cast<unsigned char>(checksum >> 8),
+                                     static_cast<unsigned char>(checksum) };
+  write(trailer, sizeof(trailer));
+}
+
+
+void
+ZlibBlockCompression::Uncompress(const ReadFunctionType & read,
+                                 void *                   data,
+                                 const size_t             numberOfBytes,
+                                 const unsigned int       numberOfWorkUnits)
+{
+  auto * const                            bytes = static_cast<unsigned char *>(data);
+  const size_t                            batchSize = GetBatchSize(numberOfWorkUnits);
+  const MultiThreaderBase::Pointer        threader = MakeThreader(numberOfWorkUnits);
+  std::vector<std::vector<unsigned char>> members(batchSize);
+  std::vector<size_t>                     offsets(batchSize + 1);
+
+  size_t offset = 0;
+  while (offset < numberOfBytes)
+  {
+    // Read the members of a batch, up to the first one not written by Compress().
+    unsigned char header[MemberHeaderSize];
+    size_t        headerSize = 0;
+    size_t        numberOfBatchMembers = 0;
+    offsets[0] = offset;
+    while (numberOfBatchMembers < batchSize && offsets[numberOfBatchMembers] < numberOfBytes)
+    {
+      headerSize = ReadFully(read, header, MemberHeaderSize);
+      if (headerSize < MemberHeaderSize || !IsBlockHeader(header))
+      {
+        break;
+      }
+      headerSize = 0;
+
+      const size_t memberSize = ReadLittleEndian(header + 16, 4);
+      if (memberSize < MemberHeaderSize + MemberTrailerSize)
+      {
+        itkGenericExceptionMacro("ZlibBlockCompression: the gzip data is corrupt.");
+      }
+      std::vector<unsigned char> & member = members[numberOfBatchMembers];
+      member.resize(memberSize - MemberHeaderSize);
+      if (ReadFully(read, member.data(), member.size()) != member.size())
+      {
+        itkGenericExceptionMacro("ZlibBlockCompression: the gzip data ends before all data is read.");
+      }
+      const size_t memberNumberOfBytes = ReadLittleEndian(member.data() + member.size() - 4, 4);
+      if (memberNumberOfBytes > numberOfBytes - offsets[numberOfBatchMembers])
+      {
+        itkGenericExceptionMacro("ZlibBlockCompression: the gzip data holds more data than expected.");
+      }
+      offsets[numberOfBatchMembers + 1] = offsets[numberOfBatchMembers] + memberNumberOfBytes;
+      ++numberOfBatchMembers;
+    }
+
+    std::atomic<bool> failed{ false };
+    threader->ParallelizeArray(
+      0,
+      numberOfBatchMembers,
+      [&](const SizeValueType i) {
+        if (!UncompressMember(members[i], bytes + offsets[i], offsets[i + 1] - offsets[i]))
+        {
+          failed = true;
+        }
+      },
+      nullptr);
+    if (failed)
+    {
+      itkGenericExceptionMacro("ZlibBlockCompression: the gzip data is corrupt.");
+    }
+    offset = offsets[numberOfBatchMembers];
+
+    if (numberOfBatchMembers < batchSize && offset < numberOfBytes)
+    {
+      // Not written by Compress(), or truncated.
+      UncompressSequentially(
+        std::vector<unsigned char>(header, header + headerSize), read, bytes + offset, numberOfBytes - offset);
+      return;
+    }
+  }
+}
+} // namespace itk
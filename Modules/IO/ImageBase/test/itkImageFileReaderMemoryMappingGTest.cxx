@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkVectorImage.h"
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+struct ImageFileReaderMemoryMapping : public ::testing::Test
+{
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+  }
+
+  using ImageType = itk::Image<short, 3>;
+
+  static ImageType::Pointer
+  MakeImage()
+  {
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 17, 9, 5 } });
+    image->Allocate();
+    short value = -300;
+    for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(value);
+      value += 7;
+    }
+    return image;
+  }
+
+  template <typename TImage>
+  static typename TImage::Pointer
+  Read(const std::string & fileName, const bool useMemoryMapping)
+  {
+    const auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(fileName);
+    reader->SetUseMemoryMapping(useMemoryMapping);
+    reader->Update();
+    return reader->GetOutput();
+  }
+
+  template <typename TImage>
+  static bool
+  IsMapped(const TImage & image)
+  {
+    return image.GetPixelContainer()->GetImportPointerOwner() != nullptr;
+  }
+
+  template <typename TImage>
+  static void
+  ExpectEqualPixels(const TImage & image, const TImage & expected)
+  {
+    ASSERT_EQ(image.GetBufferedRegion(), expected.GetBufferedRegion());
+    const size_t numberOfValues = image.GetPixelContainer()->Size();
+    ASSERT_EQ(numberOfValues, expected.GetPixelContainer()->Size());
+    for (size_t i = 0; i < numberOfValues; ++i)
+    {
+      ASSERT_EQ(image.GetBufferPointer()[i], expected.GetBufferPointer()[i]) << i;
+    }
+  }
+};
+} // namespace
+
+
+TEST_F(ImageFileReaderMemoryMapping, MapsUncompressedMetaImages)
+{
+  const auto image = MakeImage();
+  itk::WriteImage(image, "itkImageFileReaderMemoryMapping.mhd");
+
+  const auto mapped = Read<ImageType>("itkImageFileReaderMemoryMapping.mhd", true);
+  EXPECT_TRUE(IsMapped(*mapped));
+  ExpectEqualPixels(*mapped, *image);
+
+  // The mapping is copy-on-write: modifying the image leaves the file unchanged.
+  mapped->SetPixel({ { 1, 2, 3 } }, 12345);
+  const auto read = Read<ImageType>("itkImageFileReaderMemoryMapping.mhd", false);
+  EXPECT_FALSE(IsMapped(*read));
+  ExpectEqualPixels(*read, *image);
+
+  // Releasing the buffer releases the mapping.
+  mapped->Initialize();
+  EXPECT_FALSE(IsMapped(*mapped));
+}
+
+
+TEST_F(ImageFileReaderMemoryMapping, ReadsLocalMetaImageData)
+{
+  // Whether the pixel data that follows the header can be mapped depends on the alignment of its offset, the
+  // pixels are read correctly either way.
+  const auto image = MakeImage();
+  itk::WriteImage(image, "itkImageFileReaderMemoryMapping.mha");
+  ExpectEqualPixels(*Read<ImageType>("itkImageFileReaderMemoryMapping.mha", true), *image);
+
+  using CharImageType = itk::Image<unsigned char, 2>;
+  auto charImage = CharImageType::New();
+  charImage->SetRegions(CharImageType::SizeType{ { 5, 3 } });
+  charImage->Allocate();
+  for (size_t i = 0; i < charImage->GetPixelContainer()->Size(); ++i)
+  {
+    charImage->GetBufferPointer()[i] = static_cast<unsigned char>(3 * i);
+  }
+  itk::WriteImage(charImage, "itkImageFileReaderMemoryMappingChar.mha");
+  const auto mapped = Read<CharImageType>("itkImageFileReaderMemoryMappingChar.mha", true);
+  EXPECT_TRUE(IsMapped(*mapped));
+  ExpectEqualPixels(*mapped, *charImage);
+}
+
+
+TEST_F(ImageFileReaderMemoryMapping, MapsVectorImages)
+{
+  using VectorImageType = itk::VectorImage<float, 2>;
+  auto image = VectorImageType::New();
+  image->SetRegions(VectorImageType::SizeType{ { 6, 4 } });
+  image->SetNumberOfComponentsPerPixel(3);
+  image->Allocate();
+  for (size_t i = 0; i < image->GetPixelContainer()->Size(); ++i)
+  {
+    image->GetBufferPointer()[i] = 0.25f * i;
+  }
+  itk::WriteImage(image, "itkImageFileReaderMemoryMappingVector.mhd");
+
+  const auto mapped = Read<VectorImageType>("itkImageFileReaderMemoryMappingVector.mhd", true);
+  EXPECT_TRUE(IsMapped(*mapped));
+  EXPECT_EQ(mapped->GetNumberOfComponentsPerPixel(), 3u);
+  ExpectEqualPixels(*mapped, *image);
+}
+
+
+TEST_F(ImageFileReaderMemoryMapping, ReadsWhenMappingIsNotPossible)
+{
+  const auto image = MakeImage();
+
+  // Compressed pixel data.
+  itk::WriteImage(image, "itkImageFileReaderMemoryMappingCompressed.mha", true);
+  const auto decompressed = Read<ImageType>("itkImageFileReaderMemoryMappingCompressed.mha", true);
+  EXPECT_FALSE(IsMapped(*decompressed));
+  ExpectEqualPixels(*decompressed, *image);
+
+  // Pixel type conversion.
+  itk::WriteImage(image, "itkImageFileReaderMemoryMapping.mha");
+  using FloatImageType = itk::Image<float, 3>;
+  const auto converted = Read<FloatImageType>("itkImageFileReaderMemoryMapping.mha", true);
+  EXPECT_FALSE(IsMapped(*converted));
+  EXPECT_EQ(converted->GetPixel({ { 1, 0, 0 } }), -293.0f);
+
+  // Streaming a part of the image.
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName("itkImageFileReaderMemoryMapping.mha");
+  reader->SetUseMemoryMapping(true);
+  const ImageType::RegionType requestedRegion{ { { 0, 0, 2 } }, { { 17, 9, 2 } } };
+  reader->GetOutput()->SetRequestedRegion(requestedRegion);
+  reader->Update();
+  EXPECT_FALSE(IsMapped(*reader->GetOutput()));
+  EXPECT_EQ(reader->GetOutput()->GetPixel({ { 4, 3, 2 } }), image->GetPixel({ { 4, 3, 2 } }));
+}
@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Measures the throughput of ZlibBlockCompression against the number of work units, for the gzip members of
+// Compress(), the zlib stream of CompressStream(), and the sequential compression of MetaIO as reference.
+
+#include "itkZlibBlockCompression.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTimeProbe.h"
+#include "itkTestingMacros.h"
+#include "metaUtils.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <vector>
+
+namespace
+{
+std::vector<unsigned char>
+MakeBenchmarkData(const size_t numberOfBytes)
+{
+  // Smooth, image-like data with some noise.
+  std::vector<unsigned char> data(numberOfBytes);
+  uint32_t                   state = 12345;
+  for (size_t i = 0; i < numberOfBytes; ++i)
+  {
+    state = state * 1664525u + 1013904223u;
+    data[i] = static_cast<unsigned char>((i / 7) % 251 + (state >> 29));
+  }
+  return data;
+}
+
+void
+ReportThroughput(const char *           name,
+                 const unsigned int     numberOfWorkUnits,
+                 const size_t           numberOfBytes,
+                 const itk::TimeProbe & probe,
+                 const size_t           compressedSize)
+{
+  std::cout << std::setw(16) << name << std::setw(12) << numberOfWorkUnits << std::setw(14) << std::fixed
+            << std::setprecision(1) << numberOfBytes / probe.GetMean() / (1 << 20) << std::setw(14)
+            << std::setprecision(3) << static_cast<double>(numberOfBytes) / compressedSize << std::endl;
+}
+} // namespace
+
+int
+itkZlibBlockCompressionBenchmark(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " numberOfMegabytes compressionLevel [numberOfRuns]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  const size_t       numberOfBytes = std::stoul(argv[1]) << 20;
+  const int          compressionLevel = std::stoi(argv[2]);
+  const unsigned int numberOfRuns = (argc > 3) ? std::stoi(argv[3]) : 3;
+
+  const auto data = MakeBenchmarkData(numberOfBytes);
+
+  std::cout << std::setw(16) << "Compression" << std::setw(12) << "Work units" << std::setw(14) << "MB/s"
+            << std::setw(14) << "Ratio" << std::endl;
+
+  itk::TimeProbe sequentialProbe;
+  size_t         sequentialSize = 0;
+  for (unsigned int run = 0; run < numberOfRuns; ++run)
+  {
+    std::streamoff compressedSize = 0;
+    sequentialProbe.Start();
+    const unsigned char * compressed =
+      MET_PerformCompression(data.data(), static_cast<std::streamoff>(data.size()), &compressedSize, compressionLevel);
+    sequentialProbe.Stop();
+    delete[] compressed;
+    sequentialSize = static_cast<size_t>(compressedSize);
+  }
+  ReportThroughput("MetaIO", 1, numberOfBytes, sequentialProbe, sequentialSize);
+
+  const unsigned int maximumNumberOfWorkUnits = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  unsigned int       numberOfWorkUnits = 1;
+  while (true)
+  {
+    for (const bool stream : { false, true })
+    {
+      itk::TimeProbe probe;
+      size_t         compressedSize = 0;
+      for (unsigned int run = 0; run < numberOfRuns; ++run)
+      {
+        compressedSize = 0;
+        const auto write = [&compressedSize](const void *, const size_t count) { compressedSize += count; };
+        probe.Start();
+        if (stream)
+        {
+          itk::ZlibBlockCompression::CompressStream(
+            data.data(), data.size(), compressionLevel, write, numberOfWorkUnits);
+        }
+        else
+        {
+          itk::ZlibBlockCompression::Compress(data.data(), data.size(), compressionLevel, write, numberOfWorkUnits);
+        }
+        probe.Stop();
+      }
+      ReportThroughput(stream ? "CompressStream" : "Compress", numberOfWorkUnits, numberOfBytes, probe, compressedSize);
+    }
+    if (numberOfWorkUnits >= maximumNumberOfWorkUnits)
+    {
+      break;
+    }
+    numberOfWorkUnits = std::min(2 * numberOfWorkUnits, maximumNumberOfWorkUnits);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
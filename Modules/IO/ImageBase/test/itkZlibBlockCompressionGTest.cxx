@@ -0,0 +1,316 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkZlibBlockCompression.h"
+#include "itkGTest.h"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+std::vector<unsigned char>
+MakeData(const size_t numberOfBytes)
+{
+  // Compressible, but not trivially so.
+  std::vector<unsigned char> data(numberOfBytes);
+  uint32_t                   state = 12345;
+  for (size_t i = 0; i < numberOfBytes; ++i)
+  {
+    state = state * 1664525u + 1013904223u;
+    data[i] = static_cast<unsigned char>((i / 7) % 251 + (state >> 30));
+  }
+  return data;
+}
+
+std::vector<unsigned char>
+Compress(const std::vector<unsigned char> & data,
+         const int                          compressionLevel,
+         const unsigned int                 numberOfWorkUnits,
+         const size_t                       blockSize)
+{
+  std::vector<unsigned char> compressed;
+  itk::ZlibBlockCompression::Compress(
+    data.data(),
+    data.size(),
+    compressionLevel,
+    [&compressed](const void * bytes, const size_t numberOfBytes) {
+      const auto * const first = static_cast<const unsigned char *>(bytes);
+      compressed.insert(compressed.end(), first, first + numberOfBytes);
+    },
+    numberOfWorkUnits,
+    blockSize);
+  return compressed;
+}
+
+std::vector<unsigned char>
+CompressStream(const std::vector<unsigned char> & data,
+               const int                          compressionLevel,
+               const unsigned int                 numberOfWorkUnits,
+               const size_t                       blockSize)
+{
+  std::vector<unsigned char> compressed;
+  itk::ZlibBlockCompression::CompressStream(
+    data.data(),
+    data.size(),
+    compressionLevel,
+    [&compressed](const void * bytes, const size_t numberOfBytes) {
+      const auto * const first = static_cast<const unsigned char *>(bytes);
+      compressed.insert(compressed.end(), first, first + numberOfBytes);
+    },
+    numberOfWorkUnits,
+    blockSize);
+  return compressed;
+}
+
+// Reads the compressed data in chunks of at most chunkSize bytes, and records how far it is read.
+class Reader
+{
+public:
+  Reader(const std::vector<unsigned char> & compressed, const size_t chunkSize)
+    : m_Compressed(compressed)
+    , m_ChunkSize(chunkSize)
+  {}
+
+  size_t
+  operator()(void * bytes, const size_t numberOfBytes)
+  {
+    const size_t count = std::min({ numberOfBytes, m_ChunkSize, m_Compressed.size() - Position });
+    std::copy_n(m_Compressed.cbegin() + Position, count, static_cast<unsigned char *>(bytes));
+    Position += count;
+    return count;
+  }
+
+  size_t Position{ 0 };
+
+private:
+  const std::vector<unsigned char> & m_Compressed;
+  const size_t                       m_ChunkSize;
+};
+
+std::vector<unsigned char>
+Uncompress(const std::vector<unsigned char> & compressed,
+           const size_t                       numberOfBytes,
+           const unsigned int                 numberOfWorkUnits = 0,
+           size_t *                           position = nullptr)
+{
+  std::vector<unsigned char> data(numberOfBytes);
+  Reader                     reader(compressed, 1000);
+  itk::ZlibBlockCompression::Uncompress(
+    [&reader](void * bytes, const size_t count) { return reader(bytes, count); },
+    data.data(),
+    data.size(),
+    numberOfWorkUnits);
+  if (position)
+  {
+    *position = reader.Position;
+  }
+  return data;
+}
+
+// Inflates the members of a gzip file one after the other, the way gzip does, and counts them.
+std::vector<unsigned char>
+InflateSequentially(const std::vector<unsigned char> & compressed, unsigned int & numberOfMembers)
+{
+  std::vector<unsigned char> data;
+  z_stream                   stream{};
+  EXPECT_EQ(inflateInit2(&stream, 16 + MAX_WBITS), Z_OK);
+  stream.next_in = const_cast<Bytef *>(compressed.data());
+  stream.avail_in = static_cast<uInt>(compressed.size());
+  numberOfMembers = 0;
+  while (stream.avail_in > 0)
+  {
+    unsigned char chunk[4096];
+    stream.next_out = chunk;
+    stream.avail_out = sizeof(chunk);
+    const int result = inflate(&stream, Z_NO_FLUSH);
+    data.insert(data.end(), chunk, chunk + sizeof(chunk) - stream.avail_out);
+    if (result == Z_STREAM_END)
+    {
+      ++numberOfMembers;
+      inflateReset(&stream);
+    }
+    else if (result != Z_OK)
+    {
+      ADD_FAILURE() << "inflate returned " << result;
+      break;
+    }
+  }
+  inflateEnd(&stream);
+  return data;
+}
+
+// Inflates a single zlib stream, the way MetaIO does, and checks that the stream ends with the compressed data.
+std::vector<unsigned char>
+InflateZlibStream(const std::vector<unsigned char> & compressed, const size_t numberOfBytes)
+{
+  std::vector<unsigned char> data(numberOfBytes + 1);
+  z_stream                   stream{};
+  EXPECT_EQ(inflateInit(&stream), Z_OK);
+  stream.next_in = const_cast<Bytef *>(compressed.data());
+  stream.avail_in = static_cast<uInt>(compressed.size());
+  stream.next_out = data.data();
+  stream.avail_out = static_cast<uInt>(data.size());
+  EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+  EXPECT_EQ(stream.avail_in, 0u);
+  data.resize(stream.total_out);
+  inflateEnd(&stream);
+  return data;
+}
+
+// Compresses the data into a single gzip member with zlib.
+std::vector<unsigned char>
+DeflateWithZlib(const std::vector<unsigned char> & data)
+{
+  z_stream stream{};
+  EXPECT_EQ(deflateInit2(&stream, 6, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY), Z_OK);
+  std::vector<unsigned char> compressed(deflateBound(&stream, static_cast<uLong>(data.size())));
+  stream.next_in = const_cast<Bytef *>(data.data());
+  stream.avail_in = static_cast<uInt>(data.size());
+  stream.next_out = compressed.data();
+  stream.avail_out = static_cast<uInt>(compressed.size());
+  EXPECT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+  compressed.resize(stream.total_out);
+  deflateEnd(&stream);
+  return compressed;
+}
+} // namespace
+
+
+TEST(ZlibBlockCompression, WritesStandardGzipMembers)
+{
+  for (const size_t numberOfBytes : { size_t{ 0 }, size_t{ 1 }, size_t{ 1000 }, size_t{ 300000 }, size_t{ 300001 } })
+  {
+    const auto   data = MakeData(numberOfBytes);
+    unsigned int numberOfMembers = 0;
+    EXPECT_EQ(InflateSequentially(Compress(data, 6, 4, 100000), numberOfMembers), data) << numberOfBytes;
+    EXPECT_EQ(numberOfMembers, std::max<size_t>(1, (numberOfBytes + 99999) / 100000));
+  }
+}
+
+
+TEST(ZlibBlockCompression, OutputDoesNotDependOnNumberOfWorkUnits)
+{
+  const auto data = MakeData(1000000);
+  const auto expected = Compress(data, 1, 1, 65536);
+  for (const unsigned int numberOfWorkUnits : { 2u, 3u, 8u })
+  {
+    EXPECT_EQ(Compress(data, 1, numberOfWorkUnits, 65536), expected);
+  }
+}
+
+
+TEST(ZlibBlockCompression, UncompressesBlocksConcurrently)
+{
+  for (const size_t numberOfBytes : { size_t{ 0 }, size_t{ 1 }, size_t{ 65536 }, size_t{ 65537 }, size_t{ 1000000 } })
+  {
+    const auto data = MakeData(numberOfBytes);
+    auto       compressed = Compress(data, 9, 0, 65536);
+    const auto compressedSize = compressed.size();
+    // Reading stops at the end of the data.
+    compressed.push_back(0);
+    for (const unsigned int numberOfWorkUnits : { 1u, 4u })
+    {
+      size_t position = 0;
+      EXPECT_EQ(Uncompress(compressed, numberOfBytes, numberOfWorkUnits, &position), data) << numberOfBytes;
+      EXPECT_EQ(position, (numberOfBytes > 0) ? compressedSize : 0);
+    }
+  }
+}
+
+
+TEST(ZlibBlockCompression, UncompressesOtherGzipData)
+{
+  const auto data = MakeData(200000);
+  auto       compressed = DeflateWithZlib(data);
+  EXPECT_EQ(Uncompress(compressed, data.size()), data);
+
+  // Members of Compress() followed by other members.
+  const std::vector<unsigned char> firstHalf(data.cbegin(), data.cbegin() + 100000);
+  const std::vector<unsigned char> secondHalf(data.cbegin() + 100000, data.cend());
+  compressed = Compress(firstHalf, 6, 2, 30000);
+  const auto other = DeflateWithZlib(secondHalf);
+  compressed.insert(compressed.end(), other.cbegin(), other.cend());
+  compressed.insert(compressed.end(), other.cbegin(), other.cend());
+  for (const unsigned int numberOfWorkUnits : { 1u, 2u, 3u })
+  {
+    EXPECT_EQ(Uncompress(compressed, data.size(), numberOfWorkUnits), data);
+  }
+}
+
+
+TEST(ZlibBlockCompression, ThrowsOnUnexpectedData)
+{
+  const auto data = MakeData(200000);
+  for (const bool written : { true, false })
+  {
+    auto compressed = written ? Compress(data, 6, 0, 65536) : DeflateWithZlib(data);
+
+    // A different number of uncompressed bytes.
+    EXPECT_THROW(Uncompress(compressed, data.size() + 1), itk::ExceptionObject);
+    EXPECT_THROW(Uncompress(compressed, data.size() - 1), itk::ExceptionObject);
+
+    // Truncated data.
+    EXPECT_THROW(Uncompress(std::vector<unsigned char>(compressed.cbegin(), compressed.cend() - 1), data.size()),
+                 itk::ExceptionObject);
+
+    // Corrupt data.
+    compressed[compressed.size() / 2] ^= 0x55;
+    EXPECT_THROW(Uncompress(compressed, data.size()), itk::ExceptionObject) << written;
+  }
+}
+
+
+TEST(ZlibBlockCompression, WritesSingleZlibStream)
+{
+  for (const size_t numberOfBytes : { size_t{ 0 }, size_t{ 1 }, size_t{ 1000 }, size_t{ 300000 }, size_t{ 300001 } })
+  {
+    const auto data = MakeData(numberOfBytes);
+    for (const int compressionLevel : { 0, 1, 6, 9, Z_DEFAULT_COMPRESSION })
+    {
+      const auto compressed = CompressStream(data, compressionLevel, 4, 100000);
+      EXPECT_EQ(InflateZlibStream(compressed, numberOfBytes), data) << numberOfBytes << ' ' << compressionLevel;
+
+      // The header holds the compression level, as that of zlib does.
+      ASSERT_GE(compressed.size(), 6u);
+      EXPECT_EQ((compressed[0] * 256u + compressed[1]) % 31, 0u);
+      const int levelFlags = (compressionLevel == 0 || compressionLevel == 1) ? 0 : ((compressionLevel == 9) ? 3 : 2);
+      EXPECT_EQ(compressed[1] >> 6, levelFlags);
+    }
+  }
+}
+
+
+TEST(ZlibBlockCompression, StreamDoesNotDependOnNumberOfWorkUnits)
+{
+  const auto data = MakeData(1000000);
+  const auto expected = CompressStream(data, 2, 1, 65536);
+  for (const unsigned int numberOfWorkUnits : { 2u, 3u, 8u })
+  {
+    EXPECT_EQ(CompressStream(data, 2, numberOfWorkUnits, 65536), expected);
+  }
+
+  // With the end of the preceding block as dictionary, the blocks compress about as well as a single block.
+  const auto singleBlock = CompressStream(data, 2, 1, data.size());
+  EXPECT_EQ(InflateZlibStream(singleBlock, data.size()), data);
+  EXPECT_LT(expected.size(), singleBlock.size() + singleBlock.size() / 50);
+}
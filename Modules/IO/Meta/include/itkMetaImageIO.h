@@ -83,6 +83,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Supported for uncompressed binary data, stored in a single file, in
+   * the byte order of this machine. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeValueType & offset) override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -201,7 +206,19 @@ private:
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(unsigned int, DefaultDoublePrecision);
 
-  MetaImage m_MetaImage{};
+  /** MetaImage which compresses its element data in parallel, into the
+   * single zlib stream that MetaIO reads, by
+   * ZlibBlockCompression::CompressStream(). */
+  class ParallelCompressionMetaImage : public MetaImage
+  {
+  protected:
+    unsigned char *
+    M_PerformCompression(const unsigned char * source,
+                         std::streamoff        sourceSize,
+                         std::streamoff *      compressedDataSize) override;
+  };
+
+  ParallelCompressionMetaImage m_MetaImage{};
 
   unsigned int m_SubSamplingFactor{};
 
@@ -24,9 +24,12 @@
 #include "itkNumberToString.h"
 #include "itkSingleton.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkZlibBlockCompression.h"
 #include "metaImageUtils.h"
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
 
 namespace itk
@@ -360,6 +363,73 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::GetRawPixelDataLocation(std::string & fileName, SizeValueType & offset)
+{
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() ||
+      (m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB() && this->GetComponentSize() > 1))
+  {
+    return false;
+  }
+
+  const std::string dataFileName = m_MetaImage.ElementDataFileName();
+  const bool        isLocal = itksys::SystemTools::UpperCase(dataFileName) == "LOCAL";
+  if (isLocal)
+  {
+    fileName = m_FileName;
+  }
+  else
+  {
+    // Lists and numbered series of data files are not supported.
+    if (dataFileName.compare(0, 4, "LIST") == 0 || dataFileName.find('%') != std::string::npos)
+    {
+      return false;
+    }
+    // Like MetaImage, look for a relative data file next to the header.
+    const std::string headerPath = itksys::SystemTools::GetFilenamePath(m_FileName);
+    fileName = (headerPath.empty() || itksys::SystemTools::FileIsFullPath(dataFileName))
+                 ? dataFileName
+                 : headerPath + '/' + dataFileName;
+  }
+
+  if (m_MetaImage.HeaderSize() > 0)
+  {
+    offset = static_cast<SizeValueType>(m_MetaImage.HeaderSize());
+  }
+  else if (m_MetaImage.HeaderSize() == -1)
+  {
+    // The pixel data is at the end of the file.
+    const SizeValueType fileLength = itksys::SystemTools::FileLength(fileName);
+    const SizeValueType numberOfBytes = this->GetImageSizeInBytes();
+    if (fileLength < numberOfBytes)
+    {
+      return false;
+    }
+    offset = fileLength - numberOfBytes;
+  }
+  else if (isLocal)
+  {
+    // The pixel data directly follows the header, so parse the header again to find its end.
+    std::ifstream stream(fileName.c_str(), std::ios::in | std::ios::binary);
+    MetaImage     header;
+    if (!stream.is_open() || !header.ReadStream(0, &stream, false))
+    {
+      return false;
+    }
+    const std::streamoff endOfHeader = stream.tellg();
+    if (endOfHeader < 0)
+    {
+      return false;
+    }
+    offset = static_cast<SizeValueType>(endOfHeader);
+  }
+  else
+  {
+    offset = 0;
+  }
+  return true;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
@@ -759,6 +829,28 @@ MetaImageIO::Write(const void * buffer)
   }
 }
 
+unsigned char *
+MetaImageIO::ParallelCompressionMetaImage::M_PerformCompression(const unsigned char * source,
+                                                                std::streamoff        sourceSize,
+                                                                std::streamoff *      compressedDataSize)
+{
+  std::vector<unsigned char> compressed;
+  ZlibBlockCompression::CompressStream(
+    source,
+    static_cast<size_t>(sourceSize),
+    m_CompressionLevel,
+    [&compressed](const void * bytes, const size_t numberOfBytes) {
+      const auto * const first = static_cast<const unsigned char *>(bytes);
+      compressed.insert(compressed.end(), first, first + numberOfBytes);
+    });
+
+  // MetaImage deletes the compressed data with delete[].
+  auto * const compressedData = new unsigned char[compressed.size()];
+  std::copy(compressed.cbegin(), compressed.cend(), compressedData);
+  *compressedDataSize = static_cast<std::streamoff>(compressed.size());
+  return compressedData;
+}
+
 /** Given a requested region, determine what could be the region that we can
  * read from the file. This is called the streamable region, which will be
  * smaller than the LargestPossibleRegion and greater or equal to the
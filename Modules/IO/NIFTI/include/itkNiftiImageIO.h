@@ -159,6 +159,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Supported for uncompressed, unscaled images of integer scalar, RGB or
+   * RGBA pixels, in the byte order of this machine. Floating point data is
+   * not supported, because Read() replaces non-finite values by zero. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeValueType & offset) override;
+
   //-------- This part of the interfaces deals with writing data. -----
 
   /** Determine if the file can be written with this ImageIO implementation.
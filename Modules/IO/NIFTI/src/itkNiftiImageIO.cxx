@@ -289,6 +289,31 @@ ConvertRASToFromLPS_XYZTC(TBuffer * buffer, size_t size)
 }
 } // namespace
 
+bool
+NiftiImageIO::GetRawPixelDataLocation(std::string & fileName, SizeValueType & offset)
+{
+  // Read() converts or reorders the pixel data of rescaled, floating point and multi-component images.
+  const IOPixelEnum pixelType = this->GetPixelType();
+  const bool        isScalar = pixelType == IOPixelEnum::SCALAR && this->GetNumberOfComponents() == 1;
+  const bool        isColor = pixelType == IOPixelEnum::RGB || pixelType == IOPixelEnum::RGBA;
+  if (this->MustRescale() || !(isScalar || isColor) || this->m_ComponentType == IOComponentEnum::FLOAT ||
+      this->m_ComponentType == IOComponentEnum::DOUBLE || this->m_ComponentType == IOComponentEnum::LDOUBLE)
+  {
+    return false;
+  }
+
+  const std::unique_ptr<nifti_image, NiftiImageDeleter> header(nifti_image_read(this->GetFileName(), false));
+  if (!header || header->iname == nullptr || header->nifti_type == NIFTI_FTYPE_ASCII ||
+      nifti_is_gzfile(header->iname) || header->iname_offset < 0 ||
+      (header->swapsize > 1 && header->byteorder != nifti_short_order()))
+  {
+    return false;
+  }
+  fileName = header->iname;
+  offset = static_cast<SizeValueType>(header->iname_offset);
+  return true;
+}
+
 void
 NiftiImageIO::Read(void * buffer)
 {
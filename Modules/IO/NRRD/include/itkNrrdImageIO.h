@@ -125,6 +125,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Supported for raw encoded data in a single (attached or detached)
+   * data file, in the byte order of this machine, whose pixel components
+   * are stored along the fastest axis. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeValueType & offset) override;
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
@@ -226,6 +232,9 @@ protected:
   const NrrdEncoding_t * m_NrrdCompressionEncoding{ nullptr };
 
   AxesReorderEnum m_AxesReorder{ AxesReorderEnum::UseAnyRangeAxisAsPixel };
+
+  /** Whether the data is gzip compressed in a single data file, which Read() then inflates itself. */
+  bool m_ReadGzipData{ false };
 };
 } // end namespace itk
 
@@ -24,8 +24,11 @@
 #include "itkFloatingPointExceptions.h"
 #include "itkNumericLocale.h"
 #include "itkNumberToString.h"
+#include "itkZlibBlockCompression.h"
+#include "itksys/SystemTools.hxx"
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <sstream>
 #include <type_traits>
@@ -314,6 +317,94 @@ TryDispatchNrrdReservedField(NrrdWriteReservedFieldCtx & ctx, const char * keyFi
   return false;
 }
 
+// Data writer of the gzip encoding, which deflates blocks of the data concurrently, into independent gzip members.
+int
+WriteGzipBlocks(FILE * file, const void * data, size_t elementNum, const Nrrd * nrrd, NrrdIoState * nio)
+{
+  // nrrd calls this function through a C function pointer, so exceptions must not escape.
+  try
+  {
+    itk::ZlibBlockCompression::Compress(
+      data, elementNum * nrrdElementSize(nrrd), nio->zlibLevel, [file](const void * bytes, const size_t numberOfBytes) {
+        if (std::fwrite(bytes, 1, numberOfBytes, file) != numberOfBytes)
+        {
+          itkGenericExceptionMacro("Could not write the gzip data.");
+        }
+      });
+    return 0;
+  }
+  catch (const std::exception &)
+  {}
+  biffAddf(NRRD, "%s: error writing gzip data", "WriteGzipBlocks");
+  return 1;
+}
+
+const NrrdEncoding *
+GetGzipBlocksEncoding()
+{
+  static const NrrdEncoding encoding = [] {
+    NrrdEncoding gzipBlocks = *nrrdEncodingGzip;
+    gzipBlocks.write = WriteGzipBlocks;
+    return gzipBlocks;
+  }();
+  return &encoding;
+}
+
+// Loads the header of a nrrd whose data is gzip compressed in a single data file, and inflates the data into the
+// given buffer, streaming it from the file. Returns nullptr for any other nrrd. Throws an ExceptionObject if the
+// data is corrupt.
+Nrrd *
+LoadGzipData(const char * fileName, void * buffer, size_t numberOfBytes)
+{
+  Nrrd *        nrrd = nrrdNew();
+  NrrdIoState * nio = nrrdIoStateNew();
+  bool          isLoaded = false;
+  std::string   error;
+
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+  if (nrrdLoad(nrrd, fileName, nio) != 0)
+  {
+    free(biffGetDone(NRRD));
+  }
+  else if (nio->dataFile && nio->encoding == nrrdEncodingGzip && !nio->dataFNFormat && nio->dataFNArr->len <= 1 &&
+           nio->byteSkip == 0 && nrrdElementNumber(nrrd) * nrrdElementSize(nrrd) == numberOfBytes)
+  {
+    FILE * const file = nio->dataFile;
+    try
+    {
+      itk::ZlibBlockCompression::Uncompress(
+        [file](void * bytes, const size_t count) { return std::fread(bytes, 1, count, file); }, buffer, numberOfBytes);
+      nrrd->data = buffer;
+      if (nrrdElementSize(nrrd) > 1 && nio->endian != airEndianUnknown && nio->endian != airMyEndian())
+      {
+        nrrdSwapEndian(nrrd);
+      }
+      isLoaded = true;
+    }
+    catch (const itk::ExceptionObject & exception)
+    {
+      error = exception.GetDescription();
+    }
+  }
+
+  if (nio->dataFile)
+  {
+    nio->dataFile = airFclose(nio->dataFile);
+  }
+  nrrdIoStateNix(nio);
+  if (!isLoaded)
+  {
+    nrrdNuke(nrrd);
+    if (!error.empty())
+    {
+      itkGenericExceptionMacro("Error reading the gzip data of " << fileName << ": " << error);
+    }
+    return nullptr;
+  }
+  return nrrd;
+}
+
 } // namespace
 
 namespace itk
@@ -374,6 +465,7 @@ NrrdImageIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
 
   os << indent << "NrrdCompressionEncoding: " << m_NrrdCompressionEncoding << std::endl;
+  itkPrintSelfBooleanMacro(ReadGzipData);
 }
 
 void
@@ -641,6 +733,9 @@ NrrdImageIO::ReadImageInformation()
     {
       this->SetFileTypeToBinary();
     }
+    // Read() inflates the gzip data of a single data file itself, concurrently.
+    m_ReadGzipData = nio->encoding == nrrdEncodingGzip && !nio->dataFNFormat && nio->dataFNArr->len <= 1 &&
+                     nio->byteSkip == 0;
     // set type of pixel components; this is orthogonal to pixel type
 
     const IOComponentEnum cmpType = this->NrrdToITKComponentType(nrrd->type);
@@ -1127,7 +1222,15 @@ NrrdImageIO::Read(void * buffer)
 
   // Read in the nrrd.  Yes, this means that the header is being read
   // twice: once by NrrdImageIO::ReadImageInformation, and once here
-  if (nrrdLoad(nrrd, this->GetFileName(), nullptr) != 0)
+  Nrrd * const nrrdWithGzipData = (m_ReadGzipData && !nrrdAllocated)
+                                    ? LoadGzipData(this->GetFileName(), buffer, this->GetImageSizeInBytes())
+                                    : nullptr;
+  if (nrrdWithGzipData != nullptr)
+  {
+    nrrdNix(nrrd);
+    nrrd = nrrdWithGzipData;
+  }
+  else if (nrrdLoad(nrrd, this->GetFileName(), nullptr) != 0)
   {
     char * err = biffGetDone(NRRD); // would be nice to free(err)
     itkExceptionMacro("Read: Error reading " << this->GetFileName() << ":\n" << err);
@@ -1215,6 +1318,79 @@ NrrdImageIO::Read(void * buffer)
   }
 }
 
+bool
+NrrdImageIO::GetRawPixelDataLocation(std::string & fileName, SizeValueType & offset)
+{
+  Nrrd *        nrrd = nrrdNew();
+  NrrdIoState * nio = nrrdIoStateNew();
+  bool          isMappable = false;
+
+  // nrrd causes exceptions on purpose, so mask them
+  bool saveFPEState(false);
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    saveFPEState = FloatingPointExceptions::GetEnabled();
+    FloatingPointExceptions::Disable();
+  }
+
+  {
+    const NumericLocale cLocale;
+
+    // Read the header again, but keep the data file open: nrrd leaves it at the first byte of pixel data, after any
+    // line and byte skips.
+    nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+    nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+    if (nrrdLoad(nrrd, this->GetFileName(), nio) != 0)
+    {
+      free(biffGetDone(NRRD));
+    }
+    else if (nio->dataFile && nio->encoding == nrrdEncodingRaw && !nio->dataFNFormat && nio->dataFNArr->len <= 1 &&
+             (nrrdElementSize(nrrd) == 1 || nio->endian == airMyEndian()))
+    {
+      int                       pixelAxisIndex{ -1 };
+      std::vector<unsigned int> imageAxes_nrrd;
+      unsigned int              numberOfDomainAxes{ 0 };
+      bool                      needPermutation{ false };
+      GetAxisOrderForFileReading(
+        nrrd, imageAxes_nrrd, pixelAxisIndex, numberOfDomainAxes, needPermutation, this->GetAxesReorder());
+
+      // Read() permutes the axes, or crops the mask of masked tensors, in memory.
+      const long position = ftell(nio->dataFile);
+      if (!needPermutation && (pixelAxisIndex < 0 || nrrd->axis[pixelAxisIndex].kind != nrrdKind3DMaskedSymMatrix) &&
+          position >= 0)
+      {
+        if (nio->dataFNArr->len == 0)
+        {
+          // attached header
+          fileName = this->GetFileName();
+        }
+        else
+        {
+          const std::string dataFileName = nio->dataFN[0];
+          fileName = (itksys::SystemTools::FileIsFullPath(dataFileName) || !nio->path)
+                       ? dataFileName
+                       : std::string(nio->path) + '/' + dataFileName;
+        }
+        offset = static_cast<SizeValueType>(position);
+        isMappable = true;
+      }
+    }
+  }
+
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    FloatingPointExceptions::SetEnabled(saveFPEState);
+  }
+
+  if (nio->dataFile)
+  {
+    nio->dataFile = airFclose(nio->dataFile);
+  }
+  nrrdIoStateNix(nio);
+  nrrdNuke(nrrd);
+  return isMappable;
+}
+
 bool
 NrrdImageIO::CanWriteFile(const char * name)
 {
@@ -1405,7 +1581,8 @@ NrrdImageIO::Write(const void * buffer)
   if (this->GetUseCompression() && this->m_NrrdCompressionEncoding != nullptr &&
       this->m_NrrdCompressionEncoding->available())
   {
-    nio->encoding = this->m_NrrdCompressionEncoding;
+    nio->encoding = (this->m_NrrdCompressionEncoding == nrrdEncodingGzip) ? GetGzipBlocksEncoding()
+                                                                          : this->m_NrrdCompressionEncoding;
     nio->zlibLevel = this->GetCompressionLevel();
     // nio->zlibStrategy = default
   }
@@ -0,0 +1,89 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNrrdImageIO.h"
+#include "itkTestingMacros.h"
+
+// Writes an image with gzip compression, which is deflated in parallel blocks, and reads it back.
+int
+itkNrrdImageIOCompressionTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 3 };
+  using PixelType = unsigned short;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  // Large enough for several blocks of compressed data.
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 160, 128, 64 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<PixelType>(index[0] * index[1] + 7 * index[2] + (index[0] ^ index[2])));
+  }
+
+  int result = EXIT_SUCCESS;
+  for (const int compressionLevel : { 1, 6, 9 })
+  {
+    const std::string fileName =
+      std::string(argv[1]) + "/NrrdImageIOCompressionTest" + std::to_string(compressionLevel) + ".nrrd";
+
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(itk::NrrdImageIO::New());
+    writer->SetInput(image);
+    writer->SetFileName(fileName);
+    writer->UseCompressionOn();
+    writer->SetCompressionLevel(compressionLevel);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(itk::NrrdImageIO::New());
+    reader->SetFileName(fileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+    const ImageType * const output = reader->GetOutput();
+    ITK_TEST_EXPECT_EQUAL(output->GetLargestPossibleRegion(), image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> expectedIt(image, image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> it(output, output->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it, ++expectedIt)
+    {
+      if (it.Get() != expectedIt.Get())
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Compression level " << compressionLevel << ": pixel " << it.GetIndex() << " is " << it.Get()
+                  << " instead of " << expectedIt.Get() << std::endl;
+        result = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
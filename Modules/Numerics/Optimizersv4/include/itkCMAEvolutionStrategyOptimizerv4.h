@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCMAEvolutionStrategyOptimizerv4_h
+#define itkCMAEvolutionStrategyOptimizerv4_h
+
+#include "itkObjectToObjectOptimizerBase.h"
+#include "itkRandomVariateGeneratorBase.h"
+#include <string>
+
+namespace itk
+{
+/**
+ * \class CMAEvolutionStrategyOptimizerv4
+ * \brief Covariance matrix adaptation evolution strategy (CMA-ES) optimizer.
+ *
+ * This derivative-free optimizer minimizes the metric by sampling, at each
+ * iteration, a population of candidate parameters from a multivariate normal
+ * distribution. The mean of the distribution moves to the weighted mean of
+ * the fittest half of the population, and its covariance matrix and step
+ * size are adapted to the successful steps, following the (mu/mu_w, lambda)
+ * CMA-ES of Hansen, "The CMA Evolution Strategy: A Tutorial",
+ * arXiv:1604.00772.
+ *
+ * The candidates of an iteration are independent, so they are evaluated
+ * concurrently with EvaluateCandidatesConcurrently. The random variates are
+ * always drawn in the same order, so the result does not depend on it.
+ *
+ * The distribution is sampled in scaled parameter space, i.e. the initial
+ * step size along the parameter \c i is InitialSigma / scales[i]. The
+ * optimization stops after NumberOfIterations iterations, when the step
+ * size along all the axes of the distribution falls below MinimumStepSize,
+ * or when StopOptimization() is called. The metric is then left at the
+ * best parameters found.
+ *
+ * Users must plug in a random unit normal variate generator using
+ * SetNormalVariateGenerator().
+ *
+ * \sa OnePlusOneEvolutionaryOptimizerv4
+ * \sa NormalVariateGenerator
+ * \ingroup ITKOptimizersv4
+ */
+template <typename TInternalComputationValueType>
+class ITK_TEMPLATE_EXPORT CMAEvolutionStrategyOptimizerv4
+  : public ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CMAEvolutionStrategyOptimizerv4);
+
+  /** Standard class type aliases. */
+  using Self = CMAEvolutionStrategyOptimizerv4;
+  using Superclass = ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(CMAEvolutionStrategyOptimizerv4);
+
+  /** Normal random variate generator type. */
+  using NormalVariateGeneratorType = Statistics::RandomVariateGeneratorBase;
+
+  /** Measure type */
+  using typename Superclass::MeasureType;
+
+  /** Parameters type */
+  using typename Superclass::ParametersType;
+
+  /** Scales type */
+  using typename Superclass::ScalesType;
+
+  /** Stop condition type */
+  using typename Superclass::StopConditionReturnStringType;
+  using typename Superclass::StopConditionDescriptionType;
+
+  /** Set/Get the normal random variate generator. */
+  /** @ITKStartGrouping */
+  itkSetObjectMacro(NormalVariateGenerator, NormalVariateGeneratorType);
+  itkGetModifiableObjectMacro(NormalVariateGenerator, NormalVariateGeneratorType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the number of candidates sampled at each iteration. The default,
+   * 0, selects 4 + floor(3 ln(n)) candidates for n parameters. Larger
+   * populations explore more globally, and keep more work units busy. */
+  /** @ITKStartGrouping */
+  itkSetMacro(PopulationSize, unsigned int);
+  itkGetConstReferenceMacro(PopulationSize, unsigned int);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the initial step size, in scaled parameter space. Default is 1. */
+  /** @ITKStartGrouping */
+  itkSetMacro(InitialSigma, double);
+  itkGetConstReferenceMacro(InitialSigma, double);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the step size, in scaled parameter space, below which the
+   * optimization stops. Default is 1e-6. */
+  /** @ITKStartGrouping */
+  itkSetMacro(MinimumStepSize, double);
+  itkGetConstReferenceMacro(MinimumStepSize, double);
+  /** @ITKEndGrouping */
+
+  /** Get the current step size. */
+  itkGetConstReferenceMacro(CurrentSigma, double);
+
+  /** Get the number of candidates sampled at each iteration of the last
+   * optimization. */
+  itkGetConstReferenceMacro(NumberOfCandidates, unsigned int);
+
+  /** Get the reason for termination */
+  itkGetConstReferenceMacro(StopCondition, StopConditionObjectToObjectOptimizerEnum);
+
+  /** Start optimization. */
+  void
+  StartOptimization(bool doOnlyInitialization = false) override;
+
+  /** Stop optimization at the end of the current iteration. */
+  void
+  StopOptimization();
+
+  /** Get the reason for termination */
+  StopConditionReturnStringType
+  GetStopConditionDescription() const override;
+
+protected:
+  CMAEvolutionStrategyOptimizerv4();
+  ~CMAEvolutionStrategyOptimizerv4() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Normal random variate generator. */
+  typename NormalVariateGeneratorType::Pointer m_NormalVariateGenerator{};
+
+  unsigned int m_PopulationSize{ 0 };
+  double       m_InitialSigma{ 1.0 };
+  double       m_MinimumStepSize{ 1e-6 };
+  double       m_CurrentSigma{ 0.0 };
+  unsigned int m_NumberOfCandidates{ 0 };
+
+  /** Flag to stop the optimization at the end of the current iteration. */
+  bool m_Stop{ false };
+
+  StopConditionObjectToObjectOptimizerEnum m_StopCondition{};
+  StopConditionDescriptionType             m_StopConditionDescription{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCMAEvolutionStrategyOptimizerv4.hxx"
+#endif
+
+#endif
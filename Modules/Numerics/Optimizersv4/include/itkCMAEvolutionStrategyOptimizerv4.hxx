@@ -0,0 +1,269 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCMAEvolutionStrategyOptimizerv4_hxx
+#define itkCMAEvolutionStrategyOptimizerv4_hxx
+
+#include "itkSymmetricEigenDecomposition.h"
+#include "vnl/vnl_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <numeric>
+#include <vector>
+
+namespace itk
+{
+template <typename TInternalComputationValueType>
+CMAEvolutionStrategyOptimizerv4<TInternalComputationValueType>::CMAEvolutionStrategyOptimizerv4()
+  : m_StopCondition(StopConditionObjectToObjectOptimizerEnum::MAXIMUM_NUMBER_OF_ITERATIONS)
+{
+  m_StopConditionDescription.str("");
+}
+
+template <typename TInternalComputationValueType>
+void
+CMAEvolutionStrategyOptimizerv4<TInternalComputationValueType>::StopOptimization()
+{
+  itkDebugMacro("StopOptimization called");
+  m_Stop = true;
+}
+
+template <typename TInternalComputationValueType>
+void
+CMAEvolutionStrategyOptimizerv4<TInternalComputationValueType>::StartOptimization(bool doOnlyInitialization)
+{
+  itkDebugMacro("StartOptimization");
+
+  Superclass::StartOptimization(doOnlyInitialization);
+  if (doOnlyInitialization)
+  {
+    return;
+  }
+
+  if (m_NormalVariateGenerator.IsNull())
+  {
+    itkExceptionStringMacro("Normal variate generator is not set!");
+  }
+
+  const unsigned int spaceDimension = this->m_Metric->GetNumberOfParameters();
+  const ScalesType & scales = this->GetScales();
+  if (scales.size() != spaceDimension)
+  {
+    itkExceptionMacro("The size of Scales is " << scales.size() << ", but the NumberOfParameters is " << spaceDimension
+                                               << '.');
+  }
+
+  // Strategy parameters, with the default settings of the tutorial.
+  const auto n = static_cast<double>(spaceDimension);
+  const auto lambda = (m_PopulationSize > 0) ? m_PopulationSize
+                                             : 4 + static_cast<unsigned int>(std::floor(3.0 * std::log(n)));
+  if (lambda < 2)
+  {
+    itkExceptionMacro("PopulationSize must be at least 2, but it is " << lambda << '.');
+  }
+  m_NumberOfCandidates = lambda;
+
+  const unsigned int mu = lambda / 2;
+  vnl_vector<double> weights(mu);
+  for (unsigned int i = 0; i < mu; ++i)
+  {
+    weights[i] = std::log(mu + 0.5) - std::log(i + 1.0);
+  }
+  weights /= weights.sum();
+  const double mueff = 1.0 / weights.squared_magnitude();
+
+  const double cc = (4.0 + mueff / n) / (n + 4.0 + 2.0 * mueff / n);
+  const double cs = (mueff + 2.0) / (n + mueff + 5.0);
+  const double c1 = 2.0 / ((n + 1.3) * (n + 1.3) + mueff);
+  const double cmu = std::min(1.0 - c1, 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((n + 2.0) * (n + 2.0) + mueff));
+  const double damps = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff - 1.0) / (n + 1.0)) - 1.0) + cs;
+  const double chiN = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+  // State of the distribution, in scaled parameter space.
+  vnl_vector<double> mean(spaceDimension);
+  for (unsigned int i = 0; i < spaceDimension; ++i)
+  {
+    mean[i] = this->GetCurrentPosition()[i] * scales[i];
+  }
+  vnl_vector<double> pc(spaceDimension, 0.0);
+  vnl_vector<double> ps(spaceDimension, 0.0);
+  vnl_matrix<double> C(spaceDimension, spaceDimension);
+  C.set_identity();
+  m_CurrentSigma = m_InitialSigma;
+
+  // The best parameters found, starting with the initial ones.
+  ParametersType bestPosition = this->GetCurrentPosition();
+  MeasureType    bestValue = this->m_Metric->GetValue();
+  this->m_CurrentMetricValue = bestValue;
+
+  // The candidates of an iteration, and their steps from the mean.
+  typename Superclass::ParametersListType candidates(lambda, ParametersType(spaceDimension));
+  std::vector<vnl_vector<double>>         steps(lambda, vnl_vector<double>(spaceDimension));
+  typename Superclass::MeasureListType    values;
+  typename Superclass::ExceptionListType  exceptions;
+  std::vector<unsigned int>               ranking(lambda);
+  vnl_vector<double>                      z(spaceDimension);
+  vnl_vector<double>                      D(spaceDimension);
+
+  m_Stop = false;
+  m_StopCondition = StopConditionObjectToObjectOptimizerEnum::MAXIMUM_NUMBER_OF_ITERATIONS;
+  m_StopConditionDescription.str("");
+  m_StopConditionDescription << this->GetNameOfClass() << ": ";
+
+  this->InvokeEvent(StartEvent());
+
+  for (this->m_CurrentIteration = 0; this->m_CurrentIteration < this->m_NumberOfIterations;
+       ++this->m_CurrentIteration)
+  {
+    // C = B D^2 B^T
+    const SymmetricEigenDecomposition<double> eigenSystem(C);
+    const vnl_matrix<double> &                B = eigenSystem.V;
+    for (unsigned int i = 0; i < spaceDimension; ++i)
+    {
+      D[i] = std::sqrt(std::max(eigenSystem.get_eigenvalue(i), 0.0));
+    }
+
+    // Sample the candidates, drawing the variates in turn.
+    for (unsigned int k = 0; k < lambda; ++k)
+    {
+      for (unsigned int i = 0; i < spaceDimension; ++i)
+      {
+        z[i] = D[i] * m_NormalVariateGenerator->GetVariate();
+      }
+      steps[k] = B * z;
+      for (unsigned int i = 0; i < spaceDimension; ++i)
+      {
+        candidates[k][i] = (mean[i] + m_CurrentSigma * steps[k][i]) / scales[i];
+      }
+    }
+
+    this->EvaluateCandidates(candidates, values, &exceptions);
+
+    // Rank the candidates by fitness, the failing ones last.
+    std::iota(ranking.begin(), ranking.end(), 0u);
+    std::stable_sort(ranking.begin(), ranking.end(), [&values, &exceptions](unsigned int a, unsigned int b) {
+      if ((exceptions[a] == nullptr) != (exceptions[b] == nullptr))
+      {
+        return exceptions[a] == nullptr;
+      }
+      return values[a] < values[b];
+    });
+    if (exceptions[ranking[0]])
+    {
+      // The metric could not be evaluated at any candidate.
+      this->m_Metric->SetParameters(bestPosition);
+      std::rethrow_exception(exceptions[ranking[0]]);
+    }
+    if (values[ranking[0]] < bestValue)
+    {
+      bestValue = values[ranking[0]];
+      bestPosition = candidates[ranking[0]];
+    }
+
+    // Move the mean to the weighted mean of the mu fittest candidates.
+    vnl_vector<double> meanStep(spaceDimension, 0.0);
+    for (unsigned int j = 0; j < mu; ++j)
+    {
+      meanStep += weights[j] * steps[ranking[j]];
+    }
+    mean += m_CurrentSigma * meanStep;
+
+    // Cumulate the evolution paths, with C^-1/2 = B D^-1 B^T.
+    vnl_vector<double> whitenedStep = B.transpose() * meanStep;
+    for (unsigned int i = 0; i < spaceDimension; ++i)
+    {
+      whitenedStep[i] = (D[i] > 0.0) ? whitenedStep[i] / D[i] : 0.0;
+    }
+    ps = (1.0 - cs) * ps + std::sqrt(cs * (2.0 - cs) * mueff) * (B * whitenedStep);
+    const double psNorm = ps.two_norm();
+    const bool   hsig = psNorm / std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * (this->m_CurrentIteration + 1))) / chiN <
+                      1.4 + 2.0 / (n + 1.0);
+    pc *= 1.0 - cc;
+    if (hsig)
+    {
+      pc += std::sqrt(cc * (2.0 - cc) * mueff) * meanStep;
+    }
+
+    // Adapt the covariance matrix, with the rank-one and the rank-mu updates.
+    C *= 1.0 - c1 - cmu + (hsig ? 0.0 : c1 * cc * (2.0 - cc));
+    C += c1 * outer_product(pc, pc);
+    for (unsigned int j = 0; j < mu; ++j)
+    {
+      C += (cmu * weights[j]) * outer_product(steps[ranking[j]], steps[ranking[j]]);
+    }
+
+    // Adapt the step size.
+    m_CurrentSigma *= std::exp((cs / damps) * (psNorm / chiN - 1.0));
+
+    this->m_CurrentMetricValue = bestValue;
+    this->m_Metric->SetParameters(bestPosition);
+
+    itkDebugMacro("iter: " << this->m_CurrentIteration << ": best fitness: " << bestValue
+                           << ": sigma: " << m_CurrentSigma);
+
+    this->InvokeEvent(IterationEvent());
+
+    if (m_Stop)
+    {
+      m_StopConditionDescription << "StopOptimization() called";
+      break;
+    }
+    if (m_CurrentSigma * D.max_value() < m_MinimumStepSize)
+    {
+      m_StopCondition = StopConditionObjectToObjectOptimizerEnum::STEP_TOO_SMALL;
+      m_StopConditionDescription << "Step size (" << m_CurrentSigma * D.max_value()
+                                 << ") is less than MinimumStepSize (" << m_MinimumStepSize << ") at iteration #"
+                                 << this->m_CurrentIteration;
+      break;
+    }
+  }
+  if (this->m_CurrentIteration >= this->m_NumberOfIterations)
+  {
+    m_StopConditionDescription << "Maximum number of iterations (" << this->m_NumberOfIterations << ") exceeded.";
+  }
+  this->InvokeEvent(EndEvent());
+}
+
+template <typename TInternalComputationValueType>
+auto
+CMAEvolutionStrategyOptimizerv4<TInternalComputationValueType>::GetStopConditionDescription() const
+  -> StopConditionReturnStringType
+{
+  return m_StopConditionDescription.str();
+}
+
+template <typename TInternalComputationValueType>
+void
+CMAEvolutionStrategyOptimizerv4<TInternalComputationValueType>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(NormalVariateGenerator);
+  os << indent << "PopulationSize: " << m_PopulationSize << std::endl;
+  os << indent << "InitialSigma: " << m_InitialSigma << std::endl;
+  os << indent << "MinimumStepSize: " << m_MinimumStepSize << std::endl;
+  os << indent << "CurrentSigma: " << m_CurrentSigma << std::endl;
+  os << indent << "NumberOfCandidates: " << m_NumberOfCandidates << std::endl;
+  itkPrintSelfBooleanMacro(Stop);
+  os << indent << "StopCondition: " << m_StopCondition << std::endl;
+  os << indent << "StopConditionDescription: " << m_StopConditionDescription.str() << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -78,6 +78,10 @@ namespace itk
  * start_parameter[d] = - stepLength * scaling[d] * numberOfSteps[d]
  *   end_parameter[d] = + stepLength * scaling[d] * numberOfSteps[d]
  *
+ * With EvaluateCandidatesConcurrently on, the metric is evaluated at the
+ * next grid positions in batches, concurrently. The positions are then
+ * visited in the same order, and with the same events, as above.
+ *
  * \ingroup ITKOptimizersv4
  */
 template <typename TInternalComputationValueType>
@@ -165,6 +169,11 @@ protected:
   void
   IncrementIndex(ParametersType & newPosition);
 
+  /** Compute up to \c numberOfPositions grid positions, starting with the
+   * current one, without advancing. */
+  void
+  ComputeNextPositions(typename Superclass::ParametersListType & positions, SizeValueType numberOfPositions);
+
 protected:
   ParametersType m_InitialPosition{};
   MeasureType    m_CurrentValue{ 0 };
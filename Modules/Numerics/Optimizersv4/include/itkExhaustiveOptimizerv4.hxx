@@ -41,6 +41,7 @@ void
 ExhaustiveOptimizerv4<TInternalComputationValueType>::StartWalking()
 {
   itkDebugMacro("StartWalking");
+  this->ReleaseMetricClones();
   this->InvokeEvent(StartEvent());
   m_StopConditionDescription.str("");
   m_StopConditionDescription << this->GetNameOfClass() << ": Running";
@@ -100,6 +101,12 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalking()
   itkDebugMacro("ResumeWalk");
   m_Stop = false;
 
+  // The values at the next positions, when they are evaluated concurrently, and the exceptions thrown by their
+  // evaluation. An exception is rethrown when its position is visited, as with the serial evaluation.
+  typename Superclass::MeasureListType   values;
+  typename Superclass::ExceptionListType exceptions;
+  size_t                                 nextValue = 0;
+
   while (!m_Stop)
   {
     const ParametersType currentPosition = this->GetCurrentPosition();
@@ -110,7 +117,25 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalking()
       break;
     }
 
-    m_CurrentValue = this->m_Metric->GetValue();
+    if (this->m_EvaluateCandidatesConcurrently)
+    {
+      if (nextValue == values.size())
+      {
+        typename Superclass::ParametersListType positions;
+        this->ComputeNextPositions(positions, 16 * static_cast<SizeValueType>(this->m_NumberOfWorkUnits));
+        this->EvaluateCandidates(positions, values, &exceptions);
+        nextValue = 0;
+      }
+      if (exceptions[nextValue])
+      {
+        std::rethrow_exception(exceptions[nextValue]);
+      }
+      m_CurrentValue = values[nextValue++];
+    }
+    else
+    {
+      m_CurrentValue = this->m_Metric->GetValue();
+    }
 
     if (m_CurrentValue > m_MaximumMetricValue)
     {
@@ -207,6 +232,37 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::IncrementIndex(ParametersT
   }
 }
 
+template <typename TInternalComputationValueType>
+void
+ExhaustiveOptimizerv4<TInternalComputationValueType>::ComputeNextPositions(
+  typename Superclass::ParametersListType & positions,
+  SizeValueType                             numberOfPositions)
+{
+  // IncrementIndex() advances the walk: restore its state afterwards.
+  const ParametersType currentIndex = m_CurrentIndex;
+  const bool           stop = m_Stop;
+  const std::string    stopConditionDescription = m_StopConditionDescription.str();
+
+  const unsigned int spaceDimension = this->m_Metric->GetParameters().GetSize();
+
+  positions.clear();
+  positions.push_back(this->GetCurrentPosition());
+  while (positions.size() < numberOfPositions)
+  {
+    ParametersType position(spaceDimension);
+    this->IncrementIndex(position);
+    if (m_Stop)
+    {
+      break;
+    }
+    positions.push_back(position);
+  }
+
+  m_CurrentIndex = currentIndex;
+  m_Stop = stop;
+  m_StopConditionDescription.str(stopConditionDescription);
+}
+
 template <typename TInternalComputationValueType>
 std::string
 ExhaustiveOptimizerv4<TInternalComputationValueType>::GetStopConditionDescription() const
@@ -0,0 +1,124 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLinearFitConvergenceMonitoringFunction_h
+#define itkLinearFitConvergenceMonitoringFunction_h
+
+#include "itkConvergenceMonitoringFunction.h"
+
+namespace itk::Function
+{
+/**
+ * \class LinearFitConvergenceMonitoringFunction
+ * \brief Class which monitors convergence with the least squares slope of a window of the energy profile.
+ *
+ * As WindowConvergenceMonitoringFunction, the convergence value is the
+ * negated slope of a line fitted to the last WindowSize energy values,
+ * normalized by the total energy, over the parametric window [0, 1]. The
+ * line is the least squares fit, in closed form: the sums it depends on are
+ * updated as the window slides, so adding an energy value and getting the
+ * convergence value take constant time and allocate no memory, rather than
+ * fitting a B-spline to the window at each iteration.
+ *
+ * The sums are recomputed from the window once every WindowSize energy
+ * values, so that rounding errors do not accumulate.
+ *
+ * \sa WindowConvergenceMonitoringFunction
+ *
+ * \ingroup ITKOptimizersv4
+ */
+
+template <typename TScalar = double>
+class ITK_TEMPLATE_EXPORT LinearFitConvergenceMonitoringFunction
+  : public ConvergenceMonitoringFunction<TScalar, TScalar>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(LinearFitConvergenceMonitoringFunction);
+
+  using Self = LinearFitConvergenceMonitoringFunction;
+  using Superclass = ConvergenceMonitoringFunction<TScalar, TScalar>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(LinearFitConvergenceMonitoringFunction);
+
+  using ScalarType = TScalar;
+  using RealType = typename NumericTraits<ScalarType>::RealType;
+
+  using typename Superclass::EnergyValueType;
+  using typename Superclass::EnergyValueContainerType;
+  using typename Superclass::EnergyValueContainerSizeType;
+  using EnergyValueIterator = typename EnergyValueContainerType::iterator;
+  using EnergyValueConstIterator = typename EnergyValueContainerType::const_iterator;
+
+  /** Add energy value */
+  void
+  AddEnergyValue(const EnergyValueType) override;
+
+  /* Clear energy values and set total energy to 0 */
+  void
+  ClearEnergyValues() override;
+
+  /** Set/Get window size over which the convergence value is calculated.
+   * Setting a smaller window discards the oldest energy values. Default is 10. */
+  /** @ITKStartGrouping */
+  void
+  SetWindowSize(EnergyValueContainerSizeType windowSize);
+  itkGetConstMacro(WindowSize, EnergyValueContainerSizeType);
+  /** @ITKEndGrouping */
+
+  /** Calculate convergence value by fitting a line to a window of the energy profile */
+  RealType
+  GetConvergenceValue() const override;
+
+protected:
+  LinearFitConvergenceMonitoringFunction() = default;
+
+  ~LinearFitConvergenceMonitoringFunction() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Recompute the sums of the energy values in the window. */
+  void
+  ComputeWindowSums();
+
+  EnergyValueContainerSizeType m_WindowSize{ 10 };
+
+  RealType m_TotalEnergy{};
+
+  /** Sum of the energy values in the window, and of the energy values times
+   * their position in the window. */
+  RealType m_WindowSum{};
+  RealType m_WindowWeightedSum{};
+
+  /** Number of energy values removed from the window since the sums were
+   * recomputed. */
+  EnergyValueContainerSizeType m_NumberOfRemovedValues{ 0 };
+};
+} // namespace itk::Function
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkLinearFitConvergenceMonitoringFunction.hxx"
+#endif
+
+#endif
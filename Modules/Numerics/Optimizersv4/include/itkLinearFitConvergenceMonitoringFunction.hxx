@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLinearFitConvergenceMonitoringFunction_hxx
+#define itkLinearFitConvergenceMonitoringFunction_hxx
+
+#include "itkMath.h"
+
+namespace itk::Function
+{
+
+template <typename TScalar>
+void
+LinearFitConvergenceMonitoringFunction<TScalar>::AddEnergyValue(const EnergyValueType value)
+{
+  itkDebugMacro("Adding energy value " << value);
+
+  // The new value is at the end of the window.
+  this->m_WindowWeightedSum += static_cast<RealType>(this->GetNumberOfEnergyValues()) * value;
+  this->m_WindowSum += value;
+  this->m_EnergyValues.push_back(value);
+
+  if (this->GetNumberOfEnergyValues() > this->m_WindowSize)
+  {
+    // The positions of the other values decrease by one.
+    this->m_WindowSum -= this->m_EnergyValues.front();
+    this->m_EnergyValues.pop_front();
+    this->m_WindowWeightedSum -= this->m_WindowSum;
+
+    if (++this->m_NumberOfRemovedValues >= this->m_WindowSize)
+    {
+      this->ComputeWindowSums();
+    }
+  }
+  this->m_TotalEnergy += itk::Math::Absolute(value);
+
+  this->Modified();
+}
+
+template <typename TScalar>
+void
+LinearFitConvergenceMonitoringFunction<TScalar>::ClearEnergyValues()
+{
+  Superclass::ClearEnergyValues();
+  this->m_TotalEnergy = RealType{};
+  this->ComputeWindowSums();
+}
+
+template <typename TScalar>
+void
+LinearFitConvergenceMonitoringFunction<TScalar>::SetWindowSize(const EnergyValueContainerSizeType windowSize)
+{
+  itkDebugMacro("setting WindowSize to " << windowSize);
+  if (this->m_WindowSize != windowSize)
+  {
+    this->m_WindowSize = windowSize;
+    while (this->GetNumberOfEnergyValues() > this->m_WindowSize)
+    {
+      this->m_EnergyValues.pop_front();
+    }
+    this->ComputeWindowSums();
+    this->Modified();
+  }
+}
+
+template <typename TScalar>
+void
+LinearFitConvergenceMonitoringFunction<TScalar>::ComputeWindowSums()
+{
+  this->m_WindowSum = RealType{};
+  this->m_WindowWeightedSum = RealType{};
+  for (EnergyValueContainerSizeType n = 0; n < this->GetNumberOfEnergyValues(); ++n)
+  {
+    this->m_WindowSum += this->m_EnergyValues[n];
+    this->m_WindowWeightedSum += static_cast<RealType>(n) * this->m_EnergyValues[n];
+  }
+  this->m_NumberOfRemovedValues = 0;
+}
+
+template <typename TScalar>
+auto
+LinearFitConvergenceMonitoringFunction<TScalar>::GetConvergenceValue() const -> RealType
+{
+  if (this->GetNumberOfEnergyValues() < this->m_WindowSize || this->m_WindowSize < 2)
+  {
+    return NumericTraits<RealType>::max();
+  }
+  if (this->m_TotalEnergy == RealType{})
+  {
+    return RealType{};
+  }
+
+  // The least squares slope of the energy values E_n against n / (N - 1), for
+  // 0 <= n < N, is 12 (sum(n E_n) - (N - 1) / 2 sum(E_n)) / (N (N + 1)).
+  const auto     windowSize = static_cast<RealType>(this->m_WindowSize);
+  const RealType slope = 12.0 * (this->m_WindowWeightedSum - 0.5 * (windowSize - 1.0) * this->m_WindowSum) /
+                         (windowSize * (windowSize + 1.0));
+
+  const RealType convergenceValue = -slope / this->m_TotalEnergy;
+
+  return convergenceValue;
+}
+
+/**
+ * Standard "PrintSelf" method
+ */
+template <typename TScalar>
+void
+LinearFitConvergenceMonitoringFunction<TScalar>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Window size: " << this->m_WindowSize << std::endl;
+  os << indent << "Total energy: " << this->m_TotalEnergy << std::endl;
+  os << indent << "Window sum: " << this->m_WindowSum << std::endl;
+  os << indent << "Window weighted sum: " << this->m_WindowWeightedSum << std::endl;
+  os << indent << "Number of removed values: " << this->m_NumberOfRemovedValues << std::endl;
+}
+
+} // namespace itk::Function
+
+#endif
@@ -36,6 +36,9 @@ namespace itk
  *   focus modifying the parameter sample space.  This is why we place the burden on the user to provide
  *   the parameter samples over which to optimize.
  *
+ *   Without local optimizer, the metric is evaluated at the start points concurrently when
+ *   EvaluateCandidatesConcurrently is on. The local optimizations run one after the other.
+ *
  * \ingroup ITKOptimizersv4
  */
 template <typename TInternalComputationValueType>
@@ -157,6 +157,20 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
   this->m_StopConditionDescription << this->GetNameOfClass() << ": ";
   this->InvokeEvent(StartEvent());
 
+  // Without local optimizer, the metric values at the remaining start points
+  // may be evaluated concurrently, and are then reported in turn.
+  const bool          evaluateConcurrently = this->m_EvaluateCandidatesConcurrently && this->m_LocalOptimizer.IsNull();
+  const SizeValueType firstIteration = this->m_CurrentIteration;
+
+  MetricValuesListType                   values;
+  typename Superclass::ExceptionListType exceptions;
+  if (evaluateConcurrently)
+  {
+    const ParametersListType startPoints(this->m_ParametersList.begin() + firstIteration,
+                                         this->m_ParametersList.end());
+    this->EvaluateCandidates(startPoints, values, &exceptions);
+  }
+
   this->m_Stop = false;
   while (!this->m_Stop)
   {
@@ -164,13 +178,25 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
     try
     {
       this->m_Metric->SetParameters(this->m_ParametersList[this->m_CurrentIteration]);
-      if (this->m_LocalOptimizer)
+      if (evaluateConcurrently)
+      {
+        const SizeValueType startPoint = this->m_CurrentIteration - firstIteration;
+        if (exceptions[startPoint])
+        {
+          std::rethrow_exception(exceptions[startPoint]);
+        }
+        this->m_CurrentMetricValue = values[startPoint];
+      }
+      else
       {
-        this->m_LocalOptimizer->SetMetric(this->m_Metric);
-        this->m_LocalOptimizer->StartOptimization();
-        this->m_ParametersList[this->m_CurrentIteration] = this->m_Metric->GetParameters();
+        if (this->m_LocalOptimizer)
+        {
+          this->m_LocalOptimizer->SetMetric(this->m_Metric);
+          this->m_LocalOptimizer->StartOptimization();
+          this->m_ParametersList[this->m_CurrentIteration] = this->m_Metric->GetParameters();
+        }
+        this->m_CurrentMetricValue = this->m_Metric->GetValue();
       }
-      this->m_CurrentMetricValue = this->m_Metric->GetValue();
       this->m_MetricValuesList.push_back(this->m_CurrentMetricValue);
     }
     catch (const ExceptionObject &)
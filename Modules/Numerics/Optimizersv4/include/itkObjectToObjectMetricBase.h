@@ -249,6 +249,20 @@ public:
     return MetricCategoryEnum::UNKNOWN_METRIC;
   }
 
+  /** Create an initialized copy of the metric, to be evaluated at other
+   * parameters concurrently with this metric and with the other copies.
+   * The copy has the settings of this metric, shares its read-only inputs,
+   * e.g. images and interpolators, has its own copy of the active transform,
+   * and evaluates in the calling thread. This metric must be initialized.
+   *
+   * Optimizers evaluating candidate parameters concurrently use it.
+   * Returns nullptr, the default, when the metric does not support it. */
+  virtual Pointer
+  CloneForConcurrentEvaluation() const
+  {
+    return nullptr;
+  }
+
 protected:
   ObjectToObjectMetricBaseTemplate();
   ~ObjectToObjectMetricBaseTemplate() override = default;
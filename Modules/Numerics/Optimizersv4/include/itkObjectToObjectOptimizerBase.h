@@ -25,6 +25,9 @@
 #include "itkObjectToObjectMetricBase.h"
 #include "itkIntTypes.h"
 
+#include <exception>
+#include <vector>
+
 namespace itk
 {
 /** \class ObjectToObjectOptimizerBaseTemplateEnums
@@ -104,6 +107,16 @@ extern ITKOptimizersv4_EXPORT std::ostream &
  * Threading of some optimizer operations may be handled within
  * derived classes, for example in GradientDescentOptimizer.
  *
+ * Optimizers which evaluate several independent candidate parameters per
+ * iteration, e.g. ExhaustiveOptimizerv4, MultiStartOptimizerv4,
+ * OnePlusOneEvolutionaryOptimizerv4 and CMAEvolutionStrategyOptimizerv4,
+ * can evaluate them concurrently, see SetEvaluateCandidatesConcurrently().
+ * Each work unit then evaluates its candidates with its own copy of the
+ * metric, created by ObjectToObjectMetricBaseTemplate::CloneForConcurrentEvaluation(),
+ * in the calling thread only. For cheap metrics, e.g. on small or sparsely
+ * sampled images, this scales much better than the multithreading within
+ * each evaluation of the metric.
+ *
  * \note Derived classes must override StartOptimization, and then call
  * this base class version to perform common initializations.
  *
@@ -245,6 +258,17 @@ public:
   /** Get the number of work units set to be used. */
   itkGetConstReferenceMacro(NumberOfWorkUnits, ThreadIdType);
 
+  /** Option to evaluate the candidate parameters of an iteration
+   * concurrently, on NumberOfWorkUnits copies of the metric. It is only used
+   * by the optimizers evaluating several candidates per iteration, and only
+   * when the metric supports CloneForConcurrentEvaluation(); otherwise the
+   * candidates are evaluated one at a time. Default is false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(EvaluateCandidatesConcurrently, bool);
+  itkGetConstReferenceMacro(EvaluateCandidatesConcurrently, bool);
+  itkBooleanMacro(EvaluateCandidatesConcurrently);
+  /** @ITKEndGrouping */
+
   /** Return current number of iterations. */
   itkGetConstMacro(CurrentIteration, SizeValueType);
 
@@ -289,6 +313,32 @@ protected:
 
   ~ObjectToObjectOptimizerBaseTemplate() override;
 
+  using ParametersListType = std::vector<ParametersType>;
+  using MeasureListType = std::vector<MeasureType>;
+  using ExceptionListType = std::vector<std::exception_ptr>;
+
+  /** Evaluate the metric at each of the candidate parameters, in \c values.
+   * With EvaluateCandidatesConcurrently, the candidates are distributed
+   * over the work units, each evaluating them with its own copy of the
+   * metric. The copies are created at the first call, and released by
+   * StartOptimization() or ReleaseMetricClones(). Otherwise the candidates
+   * are evaluated in turn with the metric, whose parameters are restored
+   * afterwards.
+   *
+   * When \c exceptions is given, the exception thrown by the evaluation of a
+   * candidate is stored at its position, and its value is set to the
+   * maximum of MeasureType. Otherwise the exception of the first failing
+   * candidate is rethrown. */
+  void
+  EvaluateCandidates(const ParametersListType & candidates,
+                     MeasureListType &          values,
+                     ExceptionListType *        exceptions = nullptr);
+
+  /** Release the copies of the metric used to evaluate the candidates
+   * concurrently. Called when the metric may have changed. */
+  void
+  ReleaseMetricClones();
+
   MetricTypePointer m_Metric{};
   ThreadIdType      m_NumberOfWorkUnits{};
   SizeValueType     m_CurrentIteration{};
@@ -321,6 +371,12 @@ protected:
    */
   bool m_DoEstimateScales{};
 
+  /** Flag to evaluate the candidates of an iteration concurrently. */
+  bool m_EvaluateCandidatesConcurrently{ false };
+
+  /** Copies of the metric, one per work unit, to evaluate the candidates concurrently. */
+  std::vector<MetricTypePointer> m_MetricClones{};
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 };
@@ -55,6 +55,9 @@ namespace itk
  * For more details refer to the following articles \cite styner2000
  * and \cite styner1997.
  *
+ * With SetNumberOfChildren(), several children are drawn at each iteration,
+ * and the fittest one replaces the parent when it is fitter.
+ *
  * \sa NormalVariateGenerator
  * \ingroup ITKOptimizersv4
  */
@@ -164,6 +167,15 @@ public:
   itkGetConstReferenceMacro(MetricWorstPossibleValue, double);
   itkSetMacro(MetricWorstPossibleValue, double);
 
+  /** Set/Get the number of children drawn at each iteration, which is 1 by
+   * default. The fittest child competes with the parent, so the optimizer is a
+   * (1+lambda) evolution strategy. The children of an iteration are evaluated
+   * concurrently with EvaluateCandidatesConcurrently. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(NumberOfChildren, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstReferenceMacro(NumberOfChildren, unsigned int);
+  /** @ITKEndGrouping */
+
   std::string
   GetStopConditionDescription() const override;
 
@@ -184,6 +196,9 @@ private:
   bool   m_CatchGetValueException{};
   double m_MetricWorstPossibleValue{};
 
+  /** Number of children drawn at each iteration. */
+  unsigned int m_NumberOfChildren{ 1 };
+
   /** The minimal size of search radius
    * (frobenius_norm of covariance matrix). */
   double m_Epsilon{};
@@ -20,6 +20,8 @@
 
 #include "itkMath.h"
 #include "vnl/vnl_matrix.h"
+
+#include <exception>
 namespace itk
 {
 template <typename TInternalComputationValueType>
@@ -97,6 +99,13 @@ OnePlusOneEvolutionaryOptimizerv4<TInternalComputationValueType>::StartOptimizat
   ParametersType parentPosition(spaceDimension);
   ParametersType childPosition(spaceDimension);
 
+  // The children of a generation: their random vectors, offsets and fitness.
+  std::vector<vnl_vector<double>>        f_norms(m_NumberOfChildren, vnl_vector<double>(spaceDimension));
+  std::vector<vnl_vector<double>>        deltas(m_NumberOfChildren, vnl_vector<double>(spaceDimension));
+  typename Superclass::ParametersListType childPositions(m_NumberOfChildren, ParametersType(spaceDimension));
+  typename Superclass::MeasureListType   cvalues;
+  typename Superclass::ExceptionListType exceptions;
+
   for (unsigned int i = 0; i < spaceDimension; ++i)
   {
     parentPosition[i] = parent[i];
@@ -150,45 +159,53 @@ OnePlusOneEvolutionaryOptimizerv4<TInternalComputationValueType>::StartOptimizat
       break;
     }
 
-    for (unsigned int i = 0; i < spaceDimension; ++i)
+    for (unsigned int k = 0; k < m_NumberOfChildren; ++k)
     {
-      if (!m_RandomGenerator)
+      for (unsigned int i = 0; i < spaceDimension; ++i)
       {
-        itkExceptionStringMacro("Random Generator is not set!");
+        if (!m_RandomGenerator)
+        {
+          itkExceptionStringMacro("Random Generator is not set!");
+        }
+        f_norms[k][i] = m_RandomGenerator->GetVariate();
       }
-      f_norm[i] = m_RandomGenerator->GetVariate();
-    }
 
-    delta = A * f_norm;
-    child = parent + delta;
-
-    for (unsigned int i = 0; i < spaceDimension; ++i)
-    {
-      childPosition[i] = child[i];
+      deltas[k] = A * f_norms[k];
+      for (unsigned int i = 0; i < spaceDimension; ++i)
+      {
+        childPositions[k][i] = parent[i] + deltas[k][i];
+      }
     }
-    // Update the metric so we can check the metric value in childPosition
-    this->m_Metric->SetParameters(childPosition);
 
-    double cvalue = m_MetricWorstPossibleValue;
-    try
-    {
-      cvalue = this->m_Metric->GetValue();
-      // While we got the metric value in childPosition,
-      // the metric parameters are set back to parentPosition
-      this->m_Metric->SetParameters(parentPosition);
-    }
-    catch (...)
+    // Check the metric value in the child positions, concurrently with
+    // EvaluateCandidatesConcurrently. The metric parameters are set back to
+    // parentPosition.
+    this->EvaluateCandidates(childPositions, cvalues, &exceptions);
+
+    // Select the fittest child, the first one of equally fit children.
+    unsigned int selected = 0;
+    for (unsigned int k = 0; k < m_NumberOfChildren; ++k)
     {
-      if (m_CatchGetValueException)
+      if (exceptions[k])
       {
-        cvalue = m_MetricWorstPossibleValue;
+        if (!m_CatchGetValueException)
+        {
+          std::rethrow_exception(exceptions[k]);
+        }
+        cvalues[k] = m_MetricWorstPossibleValue;
       }
-      else
+      if (cvalues[k] < cvalues[selected])
       {
-        throw;
+        selected = k;
       }
     }
 
+    f_norm = f_norms[selected];
+    delta = deltas[selected];
+    child = parent + delta;
+    childPosition = childPositions[selected];
+    const double cvalue = cvalues[selected];
+
     itkDebugMacro("iter: " << this->m_CurrentIteration << ": parent position: " << parentPosition);
     itkDebugMacro("iter: " << this->m_CurrentIteration << ": parent fitness: " << pvalue);
     itkDebugMacro("iter: " << this->m_CurrentIteration << ": random vector: " << f_norm);
@@ -313,6 +330,7 @@ OnePlusOneEvolutionaryOptimizerv4<TInternalComputationValueType>::PrintSelf(std:
   os << indent << "Frobenius Norm    " << GetFrobeniusNorm() << std::endl;
   os << indent << "CatchGetValueException   " << GetCatchGetValueException() << std::endl;
   os << indent << "MetricWorstPossibleValue " << GetMetricWorstPossibleValue() << std::endl;
+  os << indent << "NumberOfChildren  " << GetNumberOfChildren() << std::endl;
 }
 } // end of namespace itk
 #endif
@@ -145,6 +145,9 @@ public:
   /** Type of Jacobian of transform. */
   using JacobianType = typename TMetric::JacobianType;
 
+  /** Type of the parameter indices of the columns of a sparse Jacobian. */
+  using NonZeroJacobianIndicesType = typename MovingTransformType::NonZeroJacobianIndicesType;
+
   /** SetMetric sets the metric used in the estimation process.
    *  The transforms from the metric will be used for estimation, along
    *  with the images when appropriate.
@@ -260,6 +263,15 @@ protected:
   void
   ComputeSquaredJacobianNorms(const VirtualPointType & point, ParametersType & squareNorms);
 
+  /** Compute the non-zero columns of the Jacobian of the transform in use
+   * w.r.t. its parameters at a physical point, and the indices of their
+   * parameters. For a B-spline transform, these are the parameters whose
+   * support contains the point. */
+  void
+  ComputeSparseJacobian(const VirtualPointType &     point,
+                        JacobianType &               jacobian,
+                        NonZeroJacobianIndicesType & nonZeroJacobianIndices);
+
   /** Check if the transform being optimized has local support. */
   bool
   TransformHasLocalSupportForScalesEstimation();
@@ -264,35 +264,36 @@ void
 RegistrationParameterScalesEstimator<TMetric>::ComputeSquaredJacobianNorms(const VirtualPointType & point,
                                                                            ParametersType &         squareNorms)
 {
-  const SizeValueType numPara = this->GetNumberOfLocalParameters();
-  const SizeValueType dim = this->GetDimension();
-  JacobianType        jacobian(dim, numPara);
+  JacobianType               jacobian;
+  NonZeroJacobianIndicesType nonZeroJacobianIndices;
+  this->ComputeSparseJacobian(point, jacobian, nonZeroJacobianIndices);
 
-  if (this->GetTransformForward())
+  squareNorms.Fill(typename ParametersType::ValueType{});
+  for (SizeValueType k = 0; k < nonZeroJacobianIndices.size(); ++k)
   {
-    this->m_Metric->GetMovingTransform()->ComputeJacobianWithRespectToParameters(point, jacobian);
-
-    for (SizeValueType p = 0; p < numPara; ++p)
+    for (SizeValueType d = 0; d < jacobian.rows(); ++d)
     {
-      squareNorms[p] = typename ParametersType::ValueType{};
-      for (SizeValueType d = 0; d < dim; ++d)
-      {
-        squareNorms[p] += jacobian[d][p] * jacobian[d][p];
-      }
+      squareNorms[nonZeroJacobianIndices[k]] += jacobian[d][k] * jacobian[d][k];
     }
   }
+}
+
+template <typename TMetric>
+void
+RegistrationParameterScalesEstimator<TMetric>::ComputeSparseJacobian(
+  const VirtualPointType &     point,
+  JacobianType &               jacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices)
+{
+  if (this->GetTransformForward())
+  {
+    this->m_Metric->GetMovingTransform()->ComputeSparseJacobianWithRespectToParameters(
+      point, jacobian, nonZeroJacobianIndices);
+  }
   else
   {
-    this->m_Metric->GetFixedTransform()->ComputeJacobianWithRespectToParameters(point, jacobian);
-
-    for (SizeValueType p = 0; p < numPara; ++p)
-    {
-      squareNorms[p] = typename ParametersType::ValueType{};
-      for (SizeValueType d = 0; d < dim; ++d)
-      {
-        squareNorms[p] += jacobian[d][p] * jacobian[d][p];
-      }
-    }
+    this->m_Metric->GetFixedTransform()->ComputeSparseJacobianWithRespectToParameters(
+      point, jacobian, nonZeroJacobianIndices);
   }
 }
 
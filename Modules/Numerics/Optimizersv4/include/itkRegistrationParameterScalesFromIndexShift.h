@@ -62,6 +62,7 @@ public:
   using typename Superclass::MovingTransformType;
   using typename Superclass::FixedTransformType;
   using typename Superclass::JacobianType;
+  using typename Superclass::NonZeroJacobianIndicesType;
   using typename Superclass::VirtualImageConstPointer;
 
   using FixedImageType = typename TMetric::FixedImageType;
@@ -93,6 +94,11 @@ protected:
   void
   ComputeSampleShifts(const ParametersType & deltaParameters, ScalesType & sampleShifts) override;
 
+  /** The shift of the continuous index of the mapped point, in the moving
+   * image, or in the fixed image when the transform is not forward. */
+  FloatType
+  ComputeShiftOfDisplacement(const Array<FloatType> & displacement) override;
+
   template <typename TContinuousIndexType>
   void
   TransformPointToContinuousIndex(const VirtualPointType & point, TContinuousIndexType & mappedIndex);
@@ -102,6 +108,10 @@ private:
   void
   ComputeSampleShiftsInternal(const ParametersType & deltaParameters, ScalesType & sampleShifts);
 
+  template <typename TImage>
+  static FloatType
+  ComputeIndexShiftOfDisplacement(const TImage * image, const Array<FloatType> & displacement);
+
 }; // class RegistrationParameterScalesFromIndexShift
 
 } // namespace itk
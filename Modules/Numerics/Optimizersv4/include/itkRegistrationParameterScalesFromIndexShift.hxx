@@ -83,6 +83,45 @@ RegistrationParameterScalesFromIndexShift<TMetric>::ComputeSampleShiftsInternal(
   transform->SetParameters(oldParameters);
 }
 
+template <typename TMetric>
+auto
+RegistrationParameterScalesFromIndexShift<TMetric>::ComputeShiftOfDisplacement(const Array<FloatType> & displacement)
+  -> FloatType
+{
+  if (this->GetTransformForward())
+  {
+    return Self::ComputeIndexShiftOfDisplacement(this->m_Metric->GetMovingImage(), displacement);
+  }
+  return Self::ComputeIndexShiftOfDisplacement(this->m_Metric->GetFixedImage(), displacement);
+}
+
+template <typename TMetric>
+template <typename TImage>
+auto
+RegistrationParameterScalesFromIndexShift<TMetric>::ComputeIndexShiftOfDisplacement(
+  const TImage *           image,
+  const Array<FloatType> & displacement) -> FloatType
+{
+  // The mapping of a physical point to its continuous index is affine: the
+  // displacement of the index is the displacement of the point, rotated by the
+  // inverse direction and divided by the spacing.
+  const auto & inverseDirection = image->GetInverseDirection();
+  const auto & spacing = image->GetSpacing();
+
+  FloatType squaredShift{};
+  for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+  {
+    FloatType indexShift{};
+    for (unsigned int j = 0; j < TImage::ImageDimension; ++j)
+    {
+      indexShift += inverseDirection[i][j] * displacement[j];
+    }
+    indexShift /= spacing[i];
+    squaredShift += indexShift * indexShift;
+  }
+  return std::sqrt(squaredShift);
+}
+
 /** Transform a physical point to its continuous index */
 template <typename TMetric>
 template <typename TContinuousIndexType>
@@ -68,6 +68,7 @@ public:
   using typename Superclass::MovingTransformType;
   using typename Superclass::FixedTransformType;
   using typename Superclass::JacobianType;
+  using typename Superclass::NonZeroJacobianIndicesType;
   using typename Superclass::VirtualImageConstPointer;
 
   /** Estimate parameter scales from average Jacobian norms.
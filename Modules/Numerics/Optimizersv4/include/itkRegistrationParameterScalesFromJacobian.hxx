@@ -41,15 +41,22 @@ RegistrationParameterScalesFromJacobian<TMetric>::EstimateScales(ScalesType & pa
   norms.Fill(typename ParametersType::ValueType{});
   parameterScales.Fill(NumericTraits<typename ScalesType::ValueType>::OneValue());
 
-  // checking each sample point
+  JacobianType               jacobian;
+  NonZeroJacobianIndicesType nonZeroJacobianIndices;
+
+  // checking each sample point, accumulating the squared norms of the non-zero Jacobian columns only
   for (SizeValueType c = 0; c < numSamples; ++c)
   {
-    const VirtualPointType point = this->m_SamplePoints[c];
-
-    ParametersType squaredNorms(numPara);
-    this->ComputeSquaredJacobianNorms(point, squaredNorms);
+    const VirtualPointType & point = this->m_SamplePoints[c];
 
-    norms = norms + squaredNorms;
+    this->ComputeSparseJacobian(point, jacobian, nonZeroJacobianIndices);
+    for (SizeValueType k = 0; k < nonZeroJacobianIndices.size(); ++k)
+    {
+      for (SizeValueType d = 0; d < jacobian.rows(); ++d)
+      {
+        norms[nonZeroJacobianIndices[k]] += jacobian[d][k] * jacobian[d][k];
+      }
+    }
   } // for numSamples
 
   if (numSamples > 0)
@@ -137,29 +144,40 @@ RegistrationParameterScalesFromJacobian<TMetric>::ComputeSampleStepScales(const
                         (this->GetTransformForward() ? this->m_Metric->GetMovingTransform()->GetNumberOfParameters()
                                                      : this->m_Metric->GetFixedTransform()->GetNumberOfParameters()));
 
+  NonZeroJacobianIndicesType nonZeroJacobianIndices;
 
   // checking each sample point
   for (SizeValueType c = 0; c < numSamples; ++c)
   {
     const VirtualPointType & point = this->m_SamplePoints[c];
 
-    if (this->GetTransformForward())
-    {
-      this->m_Metric->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-        point, jacobian, jacobianCache);
-    }
-    else
-    {
-      this->m_Metric->GetFixedTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-        point, jacobian, jacobianCache);
-    }
-
     if (!this->IsDisplacementFieldTransform())
     {
-      dTdt = jacobian * step;
+      // dTdt = jacobian * step, from the non-zero columns of the Jacobian only
+      this->ComputeSparseJacobian(point, jacobian, nonZeroJacobianIndices);
+      dTdt.Fill(FloatType{});
+      for (SizeValueType k = 0; k < nonZeroJacobianIndices.size(); ++k)
+      {
+        const FloatType stepValue = step[nonZeroJacobianIndices[k]];
+        for (SizeValueType d = 0; d < dim; ++d)
+        {
+          dTdt[d] += jacobian[d][k] * stepValue;
+        }
+      }
     }
     else
     {
+      if (this->GetTransformForward())
+      {
+        this->m_Metric->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+          point, jacobian, jacobianCache);
+      }
+      else
+      {
+        this->m_Metric->GetFixedTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+          point, jacobian, jacobianCache);
+      }
+
       const SizeValueType offset = this->m_Metric->ComputeParameterOffsetFromVirtualPoint(point, numPara);
 
       ParametersType localStep(numPara);
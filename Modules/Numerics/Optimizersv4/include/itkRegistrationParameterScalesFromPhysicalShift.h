@@ -62,6 +62,7 @@ public:
   using typename Superclass::MovingTransformType;
   using typename Superclass::FixedTransformType;
   using typename Superclass::JacobianType;
+  using typename Superclass::NonZeroJacobianIndicesType;
   using typename Superclass::VirtualImageConstPointer;
 
 protected:
@@ -71,6 +71,7 @@ public:
   using typename Superclass::MovingTransformType;
   using typename Superclass::FixedTransformType;
   using typename Superclass::JacobianType;
+  using typename Superclass::NonZeroJacobianIndicesType;
   using typename Superclass::VirtualImageConstPointer;
 
   /** Estimate parameter scales */
@@ -107,6 +108,19 @@ protected:
   virtual void
   ComputeSampleShifts(const ParametersType & deltaParameters, ScalesType & localShifts) = 0;
 
+  /** Compute the shift of a sample whose mapped point is moved by the given
+   * displacement, in the physical space of the transform output. It is used
+   * to estimate the scales of a B-spline transform from the sparse Jacobians
+   * of the samples, in a single pass over the samples, instead of a pass per
+   * parameter. The default is the physical length of the displacement. */
+  virtual FloatType
+  ComputeShiftOfDisplacement(const Array<FloatType> & displacement);
+
+  /** Compute the maximum shift over the samples generated by the variation
+   * of each parameter alone, from the sparse Jacobians of the samples. */
+  void
+  ComputeMaximumShiftsFromSparseJacobians(ScalesType & maximumShifts);
+
 private:
   // A small variation of parameters
   ParametersValueType m_SmallParameterVariation{};
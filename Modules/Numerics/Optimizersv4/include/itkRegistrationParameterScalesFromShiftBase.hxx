@@ -68,20 +68,37 @@ RegistrationParameterScalesFromShiftBase<TMetric>::EstimateScales(ScalesType & p
     }
   }
 
-  // compute voxel shift generated from each transform parameter
-  for (SizeValueType i = 0; i < numLocalPara; ++i)
+  if (this->IsBSplineTransform())
   {
-    // For local support, we need to refill deltaParameters with zeros at each loop
-    // since smoothing may change the values around the local voxel.
-    deltaParameters.Fill(typename ParametersType::ValueType{});
-    deltaParameters[offset + i] = this->m_SmallParameterVariation;
+    // A B-spline parameter only moves the samples in its support: a single pass
+    // over the samples finds the shifts of all the parameters.
+    this->ComputeMaximumShiftsFromSparseJacobians(parameterScales);
+    for (SizeValueType i = 0; i < numLocalPara; ++i)
+    {
+      maxShift = parameterScales[i];
+      if (maxShift > NumericTraits<FloatType>::epsilon() && maxShift < minNonZeroShift)
+      {
+        minNonZeroShift = maxShift;
+      }
+    }
+  }
+  else
+  {
+    // compute voxel shift generated from each transform parameter
+    for (SizeValueType i = 0; i < numLocalPara; ++i)
+    {
+      // For local support, we need to refill deltaParameters with zeros at each loop
+      // since smoothing may change the values around the local voxel.
+      deltaParameters.Fill(typename ParametersType::ValueType{});
+      deltaParameters[offset + i] = this->m_SmallParameterVariation;
 
-    maxShift = this->ComputeMaximumVoxelShift(deltaParameters);
+      maxShift = this->ComputeMaximumVoxelShift(deltaParameters);
 
-    parameterScales[i] = maxShift;
-    if (maxShift > NumericTraits<FloatType>::epsilon() && maxShift < minNonZeroShift)
-    {
-      minNonZeroShift = maxShift;
+      parameterScales[i] = maxShift;
+      if (maxShift > NumericTraits<FloatType>::epsilon() && maxShift < minNonZeroShift)
+      {
+        minNonZeroShift = maxShift;
+      }
     }
   }
 
@@ -212,6 +229,42 @@ RegistrationParameterScalesFromShiftBase<TMetric>::ComputeMaximumVoxelShift(cons
   return maxShift;
 }
 
+template <typename TMetric>
+auto
+RegistrationParameterScalesFromShiftBase<TMetric>::ComputeShiftOfDisplacement(const Array<FloatType> & displacement)
+  -> FloatType
+{
+  return displacement.two_norm();
+}
+
+template <typename TMetric>
+void
+RegistrationParameterScalesFromShiftBase<TMetric>::ComputeMaximumShiftsFromSparseJacobians(ScalesType & maximumShifts)
+{
+  maximumShifts.Fill(typename ScalesType::ValueType{});
+
+  JacobianType               jacobian;
+  NonZeroJacobianIndicesType nonZeroJacobianIndices;
+  Array<FloatType>           displacement(this->GetDimension());
+
+  const auto numSamples = static_cast<const SizeValueType>(this->m_SamplePoints.size());
+  for (SizeValueType c = 0; c < numSamples; ++c)
+  {
+    // The variation of the parameter of column k moves the mapped point of
+    // the sample by the column k of the Jacobian, times the variation.
+    this->ComputeSparseJacobian(this->m_SamplePoints[c], jacobian, nonZeroJacobianIndices);
+    for (SizeValueType k = 0; k < nonZeroJacobianIndices.size(); ++k)
+    {
+      for (SizeValueType d = 0; d < displacement.size(); ++d)
+      {
+        displacement[d] = this->m_SmallParameterVariation * jacobian[d][k];
+      }
+      FloatType & maximumShift = maximumShifts[nonZeroJacobianIndices[k]];
+      maximumShift = std::max(maximumShift, this->ComputeShiftOfDisplacement(displacement));
+    }
+  }
+}
+
 /** Print the information about this class */
 template <typename TMetric>
 void
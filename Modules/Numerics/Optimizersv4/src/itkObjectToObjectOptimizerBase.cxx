@@ -18,8 +18,12 @@
 #define ITK_TEMPLATE_EXPLICIT_ObjectToObjectOptimizerBaseTemplate
 #include "itkObjectToObjectOptimizerBase.h"
 #include "itkMultiThreaderBase.h"
+#include "itkPlatformMultiThreader.h"
 #include "itkPrintHelper.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace itk
 {
 
@@ -63,6 +67,8 @@ ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::PrintSelf(st
 
   itkPrintSelfBooleanMacro(WeightsAreIdentity);
   itkPrintSelfBooleanMacro(DoEstimateScales);
+  itkPrintSelfBooleanMacro(EvaluateCandidatesConcurrently);
+  os << indent << "NumberOfMetricClones: " << m_MetricClones.size() << std::endl;
 }
 
 template <typename TInternalComputationValueType>
@@ -91,6 +97,9 @@ ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::StartOptimiz
     itkExceptionStringMacro("m_Metric must be set.");
   }
 
+  /* The metric may have been set, or initialized again, since the last optimization. */
+  this->ReleaseMetricClones();
+
   /* Estimate the parameter scales if requested. */
   if (this->m_DoEstimateScales && this->m_ScalesEstimator.IsNotNull())
   {
@@ -195,6 +204,116 @@ ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::GetScalesIni
   return m_Scales.Size() > 0;
 }
 
+template <typename TInternalComputationValueType>
+void
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::EvaluateCandidates(
+  const ParametersListType & candidates,
+  MeasureListType &          values,
+  ExceptionListType *        exceptions)
+{
+  if (this->m_Metric.IsNull())
+  {
+    itkExceptionStringMacro("m_Metric must be set.");
+  }
+
+  const SizeValueType numberOfCandidates = candidates.size();
+  values.assign(numberOfCandidates, NumericTraits<MeasureType>::max());
+  if (exceptions)
+  {
+    exceptions->assign(numberOfCandidates, nullptr);
+  }
+
+  const auto numberOfWorkUnits =
+    static_cast<ThreadIdType>(std::min<SizeValueType>(this->m_NumberOfWorkUnits, numberOfCandidates));
+  if (this->m_EvaluateCandidatesConcurrently && numberOfWorkUnits > 1)
+  {
+    while (this->m_MetricClones.size() < numberOfWorkUnits)
+    {
+      const MetricTypePointer clone = this->m_Metric->CloneForConcurrentEvaluation();
+      if (clone.IsNull())
+      {
+        break;
+      }
+      this->m_MetricClones.push_back(clone);
+    }
+  }
+
+  const auto numberOfClones =
+    static_cast<ThreadIdType>(std::min<SizeValueType>(this->m_MetricClones.size(), numberOfWorkUnits));
+  if (this->m_EvaluateCandidatesConcurrently && numberOfClones > 1)
+  {
+    ExceptionListType          candidateExceptions(numberOfCandidates);
+    std::atomic<SizeValueType> nextCandidate{ 0 };
+
+    // Each work unit blocks in the evaluation of its metric, which may itself
+    // use the thread pool: run the work units on threads of their own.
+    const auto threader = PlatformMultiThreader::New();
+    threader->SetNumberOfWorkUnits(numberOfClones);
+    threader->ParallelizeArray(
+      0,
+      numberOfClones,
+      [this, &candidates, &values, &candidateExceptions, &nextCandidate, numberOfCandidates](SizeValueType workUnit) {
+        MetricType * const metric = this->m_MetricClones[workUnit];
+        for (SizeValueType i = nextCandidate++; i < numberOfCandidates; i = nextCandidate++)
+        {
+          try
+          {
+            ParametersType parameters(candidates[i]);
+            metric->SetParameters(parameters);
+            values[i] = metric->GetValue();
+          }
+          catch (...)
+          {
+            candidateExceptions[i] = std::current_exception();
+          }
+        }
+      },
+      nullptr);
+
+    if (exceptions)
+    {
+      exceptions->swap(candidateExceptions);
+      return;
+    }
+    for (const auto & exception : candidateExceptions)
+    {
+      if (exception)
+      {
+        std::rethrow_exception(exception);
+      }
+    }
+    return;
+  }
+
+  ParametersType initialParameters(this->m_Metric->GetParameters());
+  for (SizeValueType i = 0; i < numberOfCandidates; ++i)
+  {
+    try
+    {
+      ParametersType parameters(candidates[i]);
+      this->m_Metric->SetParameters(parameters);
+      values[i] = this->m_Metric->GetValue();
+    }
+    catch (...)
+    {
+      if (!exceptions)
+      {
+        this->m_Metric->SetParameters(initialParameters);
+        throw;
+      }
+      (*exceptions)[i] = std::current_exception();
+    }
+  }
+  this->m_Metric->SetParameters(initialParameters);
+}
+
+template <typename TInternalComputationValueType>
+void
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::ReleaseMetricClones()
+{
+  this->m_MetricClones.clear();
+}
+
 template class ITKOptimizersv4_EXPORT ObjectToObjectOptimizerBaseTemplate<double>;
 template class ITKOptimizersv4_EXPORT ObjectToObjectOptimizerBaseTemplate<float>;
 
@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCMAEvolutionStrategyOptimizerv4.h"
+#include "itkNormalVariateGenerator.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+#include <atomic>
+
+namespace
+{
+/**
+ * \class CMAEvolutionStrategyMetric
+ *
+ * An ill-conditioned, rotated quadratic form of 4 parameters:
+ *
+ *   f(x) = (d0 + d1)^2 + 100 (d0 - d1)^2 + 10 d2^2 + 1000 d3^2,  d = x - c
+ *
+ * whose minimum is at c = | 1 -2 3 -4 |. The metric supports
+ * CloneForConcurrentEvaluation(), unless it is disabled, and counts its
+ * clones.
+ */
+class CMAEvolutionStrategyMetric : public itk::ObjectToObjectMetricBase
+{
+public:
+  using Self = CMAEvolutionStrategyMetric;
+  using Superclass = itk::ObjectToObjectMetricBase;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+  itkNewMacro(Self);
+
+  enum
+  {
+    SpaceDimension = 4
+  };
+
+  using ParametersType = Superclass::ParametersType;
+  using DerivativeType = Superclass::DerivativeType;
+  using MeasureType = Superclass::MeasureType;
+
+  CMAEvolutionStrategyMetric() { m_Parameters.SetSize(SpaceDimension); }
+
+  MeasureType
+  GetValue() const override
+  {
+    const double d0 = m_Parameters[0] - 1.0;
+    const double d1 = m_Parameters[1] + 2.0;
+    const double d2 = m_Parameters[2] - 3.0;
+    const double d3 = m_Parameters[3] + 4.0;
+    return (d0 + d1) * (d0 + d1) + 100.0 * (d0 - d1) * (d0 - d1) + 10.0 * d2 * d2 + 1000.0 * d3 * d3;
+  }
+
+  void
+  GetDerivative(DerivativeType &) const override
+  {
+    itkGenericExceptionMacro("CMAEvolutionStrategyOptimizerv4 is not supposed to call GetDerivative()");
+  }
+
+  void
+  GetValueAndDerivative(MeasureType & value, DerivativeType & derivative) const override
+  {
+    value = GetValue();
+    GetDerivative(derivative);
+  }
+
+  void
+  Initialize() override
+  {}
+
+  unsigned int
+  GetNumberOfLocalParameters() const override
+  {
+    return SpaceDimension;
+  }
+
+  unsigned int
+  GetNumberOfParameters() const override
+  {
+    return SpaceDimension;
+  }
+
+  void
+  SetParameters(ParametersType & parameters) override
+  {
+    m_Parameters = parameters;
+  }
+
+  const ParametersType &
+  GetParameters() const override
+  {
+    return m_Parameters;
+  }
+
+  bool
+  HasLocalSupport() const override
+  {
+    return false;
+  }
+
+  void
+  UpdateTransformParameters(const DerivativeType &, ParametersValueType) override
+  {}
+
+  Superclass::Pointer
+  CloneForConcurrentEvaluation() const override
+  {
+    if (!m_SupportsClones)
+    {
+      return nullptr;
+    }
+    ++m_NumberOfClones;
+    auto clone = Self::New();
+    clone->m_Parameters = m_Parameters;
+    return clone.GetPointer();
+  }
+
+  void
+  SetSupportsClones(bool supportsClones)
+  {
+    m_SupportsClones = supportsClones;
+  }
+
+  unsigned int
+  GetNumberOfClones() const
+  {
+    return m_NumberOfClones;
+  }
+
+private:
+  ParametersType                    m_Parameters;
+  bool                              m_SupportsClones{ true };
+  mutable std::atomic<unsigned int> m_NumberOfClones{ 0 };
+};
+
+using OptimizerType = itk::CMAEvolutionStrategyOptimizerv4<double>;
+using ParametersType = CMAEvolutionStrategyMetric::ParametersType;
+
+// Optimize the metric from the origin, with the same random variates.
+ParametersType
+Optimize(OptimizerType * optimizer, CMAEvolutionStrategyMetric * metric)
+{
+  auto generator = itk::Statistics::NormalVariateGenerator::New();
+  generator->Initialize(2024);
+  optimizer->SetNormalVariateGenerator(generator);
+
+  ParametersType initialPosition(CMAEvolutionStrategyMetric::SpaceDimension);
+  initialPosition.Fill(0.0);
+  metric->SetParameters(initialPosition);
+  optimizer->SetMetric(metric);
+  optimizer->StartOptimization();
+
+  std::cout << "Solution: " << optimizer->GetCurrentPosition() << " after " << optimizer->GetCurrentIteration()
+            << " iterations, value: " << optimizer->GetValue() << std::endl;
+  std::cout << "Stop description: " << optimizer->GetStopConditionDescription() << std::endl;
+  return optimizer->GetCurrentPosition();
+}
+} // namespace
+
+int
+itkCMAEvolutionStrategyOptimizerv4Test(int, char *[])
+{
+  auto optimizer = OptimizerType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(optimizer, CMAEvolutionStrategyOptimizerv4, ObjectToObjectOptimizerBaseTemplate);
+
+  auto metric = CMAEvolutionStrategyMetric::New();
+  optimizer->SetMetric(metric);
+
+  // The normal variate generator is required.
+  ITK_TRY_EXPECT_EXCEPTION(optimizer->StartOptimization());
+
+  ITK_TEST_SET_GET_VALUE(0, optimizer->GetPopulationSize());
+  ITK_TEST_SET_GET_VALUE(1.0, optimizer->GetInitialSigma());
+  ITK_TEST_SET_GET_VALUE(1e-6, optimizer->GetMinimumStepSize());
+
+  constexpr double initialSigma{ 2.0 };
+  optimizer->SetInitialSigma(initialSigma);
+  ITK_TEST_SET_GET_VALUE(initialSigma, optimizer->GetInitialSigma());
+
+  constexpr double minimumStepSize{ 1e-8 };
+  optimizer->SetMinimumStepSize(minimumStepSize);
+  ITK_TEST_SET_GET_VALUE(minimumStepSize, optimizer->GetMinimumStepSize());
+
+  optimizer->SetNumberOfIterations(2000);
+  optimizer->SetNumberOfWorkUnits(4);
+
+  // The default population size, evaluated one candidate at a time.
+  ITK_TEST_SET_GET_BOOLEAN(optimizer, EvaluateCandidatesConcurrently, false);
+  const ParametersType defaultSolution = Optimize(optimizer, metric);
+  ITK_TEST_EXPECT_EQUAL(optimizer->GetNumberOfCandidates(), 8);
+  ITK_TEST_EXPECT_EQUAL(optimizer->GetStopCondition(), itk::StopConditionObjectToObjectOptimizerEnum::STEP_TOO_SMALL);
+  ITK_TEST_EXPECT_EQUAL(metric->GetNumberOfClones(), 0);
+
+  constexpr double trueParameters[4]{ 1, -2, 3, -4 };
+  for (unsigned int j = 0; j < 4; ++j)
+  {
+    ITK_TEST_EXPECT_TRUE(itk::Math::Absolute(defaultSolution[j] - trueParameters[j]) < 1e-4);
+  }
+
+  // A larger population, evaluated in turn and concurrently, finds the same solution.
+  constexpr unsigned int populationSize{ 16 };
+  optimizer->SetPopulationSize(populationSize);
+  ITK_TEST_SET_GET_VALUE(populationSize, optimizer->GetPopulationSize());
+
+  const ParametersType serialSolution = Optimize(optimizer, metric);
+  const auto           serialIterations = optimizer->GetCurrentIteration();
+  for (unsigned int j = 0; j < 4; ++j)
+  {
+    ITK_TEST_EXPECT_TRUE(itk::Math::Absolute(serialSolution[j] - trueParameters[j]) < 1e-4);
+  }
+
+  ITK_TEST_SET_GET_BOOLEAN(optimizer, EvaluateCandidatesConcurrently, true);
+  const ParametersType concurrentSolution = Optimize(optimizer, metric);
+  ITK_TEST_EXPECT_EQUAL(concurrentSolution, serialSolution);
+  ITK_TEST_EXPECT_EQUAL(optimizer->GetCurrentIteration(), serialIterations);
+  ITK_TEST_EXPECT_EQUAL(metric->GetNumberOfClones(), 4);
+
+  // A metric without clones is evaluated in turn.
+  auto metricWithoutClones = CMAEvolutionStrategyMetric::New();
+  metricWithoutClones->SetSupportsClones(false);
+  ITK_TEST_EXPECT_EQUAL(Optimize(optimizer, metricWithoutClones), serialSolution);
+
+  // The population must have at least two candidates.
+  optimizer->SetPopulationSize(1);
+  optimizer->SetMetric(metric);
+  ITK_TRY_EXPECT_EXCEPTION(optimizer->StartOptimization());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
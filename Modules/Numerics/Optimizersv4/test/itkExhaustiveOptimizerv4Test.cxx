@@ -69,6 +69,11 @@ public:
 
     std::cout << "GetValue ( " << x << " , " << y << ") = ";
 
+    if (x == m_FailingX)
+    {
+      itkExceptionMacro("The metric fails at x = " << x);
+    }
+
     const MeasureType val = 0.5 * (3 * x * x + 4 * x * y + 6 * y * y) - 2 * x + 8 * y;
 
     std::cout << val << std::endl;
@@ -144,9 +149,16 @@ public:
   UpdateTransformParameters(const DerivativeType &, ParametersValueType) override
   {}
 
+  void
+  SetFailingX(double failingX)
+  {
+    m_FailingX = failingX;
+  }
+
 private:
   ParametersType m_Parameters;
   bool           m_HasLocalSupport{ false };
+  double         m_FailingX{ itk::NumericTraits<double>::max() };
 };
 
 
@@ -328,6 +340,29 @@ itkExhaustiveOptimizerv4Test(int, char *[])
   }
 
 
+  // When the positions are evaluated in batches, the positions before a failing one are visited, and the
+  // exception is thrown at the failing position, as when they are evaluated in turn.
+  for (const bool evaluateCandidatesConcurrently : { false, true })
+  {
+    auto failingOptimizer = OptimizerType::New();
+    auto failingObserver = IndexObserver::New();
+    failingOptimizer->AddObserver(itk::IterationEvent(), failingObserver);
+    auto failingMetric = ExhaustiveOptimizedMetricV4::New();
+    failingMetric->SetParameters(initialPosition);
+    failingMetric->SetFailingX(-5.0);
+    failingOptimizer->SetMetric(failingMetric);
+    failingOptimizer->SetScales(parametersScale);
+    failingOptimizer->SetStepLength(stepLength);
+    failingOptimizer->SetNumberOfSteps(steps);
+    failingOptimizer->SetEvaluateCandidatesConcurrently(evaluateCandidatesConcurrently);
+
+    ITK_TRY_EXPECT_EXCEPTION(failingOptimizer->StartOptimization());
+    ITK_TEST_EXPECT_EQUAL(failingObserver->m_VisitedIndices.size(), 5);
+    ITK_TEST_EXPECT_EQUAL(failingOptimizer->GetCurrentIndex()[0], 5.0);
+    ITK_TEST_EXPECT_EQUAL(failingOptimizer->GetMaximumMetricValue(), 926.0);
+  }
+
+
   std::cout << "Test passed." << std::endl;
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLinearFitConvergenceMonitoringFunction.h"
+#include "itkGTest.h"
+
+#include <cmath>
+#include <deque>
+
+namespace
+{
+// The least squares slope of the window against the parametric window [0, 1],
+// computed from scratch.
+double
+ComputeConvergenceValue(const std::deque<double> & window, double totalEnergy)
+{
+  const auto n = static_cast<double>(window.size());
+  double     meanT = 0.0;
+  double     meanE = 0.0;
+  for (size_t i = 0; i < window.size(); ++i)
+  {
+    meanT += i / (n - 1.0);
+    meanE += window[i];
+  }
+  meanT /= n;
+  meanE /= n;
+
+  double covariance = 0.0;
+  double variance = 0.0;
+  for (size_t i = 0; i < window.size(); ++i)
+  {
+    const double t = i / (n - 1.0) - meanT;
+    covariance += t * (window[i] - meanE);
+    variance += t * t;
+  }
+  return -covariance / variance / totalEnergy;
+}
+} // namespace
+
+TEST(LinearFitConvergenceMonitoringFunction, MatchesLeastSquaresFit)
+{
+  using ConvergenceMonitoringType = itk::Function::LinearFitConvergenceMonitoringFunction<double>;
+  auto convergenceMonitoring = ConvergenceMonitoringType::New();
+
+  EXPECT_EQ(convergenceMonitoring->GetWindowSize(), 10u);
+
+  for (const unsigned int windowSize : { 2u, 5u, 10u })
+  {
+    convergenceMonitoring->ClearEnergyValues();
+    convergenceMonitoring->SetWindowSize(windowSize);
+    EXPECT_EQ(convergenceMonitoring->GetWindowSize(), windowSize);
+
+    std::deque<double> window;
+    double             totalEnergy = 0.0;
+    for (unsigned int x = 0; x < 1000; ++x)
+    {
+      const double value = -std::exp(-0.01 * x) + 0.1 * std::sin(0.7 * x);
+      convergenceMonitoring->AddEnergyValue(value);
+      window.push_back(value);
+      if (window.size() > windowSize)
+      {
+        window.pop_front();
+      }
+      totalEnergy += std::abs(value);
+
+      if (window.size() < windowSize)
+      {
+        EXPECT_EQ(convergenceMonitoring->GetConvergenceValue(), itk::NumericTraits<double>::max());
+      }
+      else
+      {
+        const double expectedValue = ComputeConvergenceValue(window, totalEnergy);
+        EXPECT_NEAR(convergenceMonitoring->GetConvergenceValue(), expectedValue, 1e-10 * std::abs(expectedValue) + 1e-15);
+      }
+    }
+    EXPECT_EQ(convergenceMonitoring->GetNumberOfEnergyValues(), windowSize);
+  }
+
+  // A smaller window keeps the last energy values.
+  convergenceMonitoring->ClearEnergyValues();
+  convergenceMonitoring->SetWindowSize(10);
+  for (unsigned int x = 0; x < 20; ++x)
+  {
+    convergenceMonitoring->AddEnergyValue(x < 16 ? 100.0 - x : 0.0);
+  }
+  convergenceMonitoring->SetWindowSize(4);
+  EXPECT_EQ(convergenceMonitoring->GetNumberOfEnergyValues(), 4u);
+  EXPECT_EQ(convergenceMonitoring->GetConvergenceValue(), 0.0);
+
+  convergenceMonitoring->Print(std::cout, 3);
+}
+
+TEST(LinearFitConvergenceMonitoringFunction, LinearProfile)
+{
+  using ConvergenceMonitoringType = itk::Function::LinearFitConvergenceMonitoringFunction<float>;
+  auto convergenceMonitoring = ConvergenceMonitoringType::New();
+  convergenceMonitoring->SetWindowSize(5);
+
+  // A decreasing energy converges at a rate proportional to its slope.
+  double totalEnergy = 0.0;
+  for (unsigned int x = 0; x < 8; ++x)
+  {
+    const float value = 10.0f - 2.0f * x;
+    convergenceMonitoring->AddEnergyValue(value);
+    totalEnergy += std::abs(value);
+  }
+  EXPECT_NEAR(convergenceMonitoring->GetConvergenceValue(), 2.0 * 4.0 / totalEnergy, 1e-6);
+
+  // All-zero energies have converged.
+  convergenceMonitoring->ClearEnergyValues();
+  EXPECT_EQ(convergenceMonitoring->GetNumberOfEnergyValues(), 0u);
+  for (unsigned int x = 0; x < 5; ++x)
+  {
+    convergenceMonitoring->AddEnergyValue(0.0f);
+  }
+  EXPECT_EQ(convergenceMonitoring->GetConvergenceValue(), 0.0);
+
+  // A window of one value has no slope.
+  convergenceMonitoring->SetWindowSize(1);
+  EXPECT_EQ(convergenceMonitoring->GetConvergenceValue(), itk::NumericTraits<double>::max());
+}
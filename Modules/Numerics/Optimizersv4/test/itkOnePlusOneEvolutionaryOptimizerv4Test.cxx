@@ -285,6 +285,27 @@ itkOnePlusOneEvolutionaryOptimizerv4Test(int, char *[])
   itkOptimizer->Print(std::cout);
   std::cout << "Stop description   = " << itkOptimizer->GetStopConditionDescription() << std::endl;
 
+  // Draw several children at each iteration, from the same initial position.
+  ITK_TEST_SET_GET_VALUE(1, itkOptimizer->GetNumberOfChildren());
+  constexpr unsigned int numberOfChildren{ 4 };
+  itkOptimizer->SetNumberOfChildren(numberOfChildren);
+  ITK_TEST_SET_GET_VALUE(numberOfChildren, itkOptimizer->GetNumberOfChildren());
+
+  metric->SetParameters(initialPosition);
+  ITK_TRY_EXPECT_NO_EXCEPTION(itkOptimizer->StartOptimization());
+
+  finalPosition = itkOptimizer->GetCurrentPosition();
+  std::cout << "Solution with " << numberOfChildren << " children = (";
+  std::cout << finalPosition[0] << ',';
+  std::cout << finalPosition[1] << ')' << std::endl;
+  for (unsigned int j = 0; j < 2; ++j)
+  {
+    if (itk::Math::Absolute(finalPosition[j] - trueParameters[j]) > 0.01)
+    {
+      pass = false;
+    }
+  }
+
   if (!pass)
   {
     std::cout << "Test failed." << std::endl;
@@ -22,10 +22,15 @@
 
 #include "itkPoint.h"
 #include "itkIntTypes.h"
-#include "itkKdTree.h"
-#include "itkKdTreeGenerator.h"
 #include "itkVectorContainer.h"
-#include "itkVectorContainerToListSampleAdaptor.h"
+#if !defined(ITK_LEGACY_REMOVE)
+#  include "itkKdTree.h"
+#  include "itkKdTreeGenerator.h"
+#  include "itkVectorContainerToListSampleAdaptor.h"
+#endif
+
+#include <utility>
+#include <vector>
 
 namespace itk
 {
@@ -36,6 +41,18 @@ namespace itk
  * This class accelerates the search for the closest point to a user-provided
  * point, by using constructing a Kd-Tree structure for the PointSetContainer.
  *
+ * The tree is a static, balanced Kd-Tree stored in flat arrays, together with
+ * a copy of the points in the order of its leaves, so that queries do not
+ * allocate memory except for their results, and may be called concurrently.
+ * The closest points are returned sorted by increasing distance, and by
+ * increasing identifier for equal distances.
+ *
+ * When the points have moved, e.g. after being transformed again, Refit()
+ * updates the tree in linear time, instead of building it again. The batched
+ * queries answer the queries of a whole container with several threads. A
+ * positive ApproximationError makes the closest point searches approximate,
+ * and faster.
+ *
  * \ingroup ITKRegistrationCommon
  */
 template <typename TPointsContainer = VectorContainer<Point<float, 3>>>
@@ -70,16 +87,19 @@ public:
   using PointsContainerConstIterator = typename PointsContainer::ConstIterator;
   using PointsContainerIterator = typename PointsContainer::Iterator;
 
-  /** Type of the PointsContainer to List Adaptor. */
+  /** Type of the identifiers of the points found by the searches. */
+  using NeighborsIdentifierType = std::vector<IdentifierType>;
+
+#if !defined(ITK_LEGACY_REMOVE)
+  /** Types of the Statistics::KdTree that the locator used, which it no
+   * longer builds. Kept for backwards compatibility. */
   using SampleAdaptorType = Statistics::VectorContainerToListSampleAdaptor<PointsContainer>;
   using SampleAdaptorPointer = typename SampleAdaptorType::Pointer;
-
-  /** Types of the KdTreeGenerator */
   using TreeGeneratorType = Statistics::KdTreeGenerator<SampleAdaptorType>;
   using TreeGeneratorPointer = typename TreeGeneratorType::Pointer;
   using TreeType = typename TreeGeneratorType::KdTreeType;
   using TreeConstPointer = typename TreeType::ConstPointer;
-  using NeighborsIdentifierType = typename TreeType::InstanceIdentifierVectorType;
+#endif
 
   /** Set/Get the points from which the bounding box should be computed. */
   itkSetObjectMacro(Points, PointsContainer);
@@ -87,10 +107,35 @@ public:
   /** Set/Get the points from which the bounding box should be computed. */
   itkGetModifiableObjectMacro(Points, PointsContainer);
 
+  /** Set/Get the maximum number of points in a leaf of the tree. Used by
+   * Initialize(). Defaults to 16. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(BucketSize, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(BucketSize, unsigned int);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the relative error allowed for the closest points. With an error
+   * eps, the distance to the k-th returned point is at most (1 + eps) times the
+   * distance to the true k-th closest point. Defaults to 0, i.e. exact
+   * searches. Searches within a radius are always exact. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(ApproximationError, double, 0.0, NumericTraits<double>::max());
+  itkGetConstMacro(ApproximationError, double);
+  /** @ITKEndGrouping */
+
   /** Compute the kd-tree that will facilitate the querying the points. */
   void
   Initialize();
 
+  /** Update the tree for new positions of the same points, keeping its
+   * structure and only recomputing the bounds of its nodes, in linear time.
+   * The searches remain exact, but become slower as the bounds of the leaves
+   * overlap more. Calls Initialize() if the number of points has changed, or
+   * if the total volume of the leaves, relative to the one of the root, has
+   * doubled since the tree was built. */
+  void
+  Refit();
+
   /** Find the closest point */
   PointIdentifier
   FindClosestPoint(const PointType & query) const;
@@ -107,17 +152,105 @@ public:
   void
   FindPointsWithinRadius(const PointType &, double, NeighborsIdentifierType &) const;
 
+  /** Find the closest point to each of the query points, with several threads.
+   * The point ids are returned in the order of the query container. */
+  void
+  FindClosestPoints(const PointsContainer * queries, std::vector<PointIdentifier> & closestPoints) const;
+
+  /** Find the closest N points to each of the query points, with several
+   * threads. The point ids are returned in the order of the query container. */
+  void
+  FindClosestNPoints(const PointsContainer *                queries,
+                     unsigned int                           numberOfNeighborsRequested,
+                     std::vector<NeighborsIdentifierType> & neighbors) const;
+
 protected:
-  PointsLocator();
+  PointsLocator() = default;
   ~PointsLocator() override = default;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  using CoordinateType = typename PointType::ValueType;
+
+  /** A node of the tree, bounding the points [Begin, End) of the tree. Its left
+   * child directly follows it, and a leaf has no right child. */
+  struct Node
+  {
+    PointType     Lower;
+    PointType     Upper;
+    SizeValueType Begin;
+    SizeValueType End;
+    SizeValueType RightChild;
+  };
+
+  /** The closest points found so far, sorted by distance and identifier. */
+  using NeighborType = std::pair<double, SizeValueType>;
+  using NeighborsType = std::vector<NeighborType>;
+
+  /** Copy the points of a container, in its order. */
+  static std::vector<PointType>
+  GetContainerPoints(const PointsContainer * points);
+
+  SizeValueType
+  BuildNode(const std::vector<PointType> & points, SizeValueType begin, SizeValueType end);
+
+  void
+  RefitNode(SizeValueType nodeIndex);
+
+  void
+  ComputeNodeBounds(Node & node) const;
+
+  /** The total volume of the leaves, relative to the volume of the root. */
+  double
+  ComputeLeafVolumeRatio() const;
+
+  double
+  ComputeSquaredDistanceToNode(const PointType & query, const Node & node) const;
+
+  void
+  SearchClosestPoint(const PointType & query, SizeValueType nodeIndex, NeighborType & closestPoint) const;
+
+  void
+  SearchClosestNPoints(const PointType & query,
+                       SizeValueType     nodeIndex,
+                       unsigned int      numberOfNeighbors,
+                       NeighborsType &   closestPoints) const;
+
+  void
+  SearchPointsWithinRadius(const PointType &         query,
+                           SizeValueType             nodeIndex,
+                           double                    squaredRadius,
+                           NeighborsIdentifierType & identifiers) const;
+
+  /** Clamp the number of requested neighbors to the number of points. */
+  unsigned int
+  ClampNumberOfNeighbors(unsigned int numberOfNeighborsRequested) const;
+
+  /** The closest points found by SearchClosestNPoints(), from the root. */
+  void
+  ComputeClosestNPoints(const PointType & query, unsigned int numberOfNeighbors, NeighborsType & closestPoints) const;
+
+  bool
+  IsCloser(const NeighborType & neighbor, const NeighborType & otherNeighbor) const
+  {
+    return neighbor.first < otherNeighbor.first ||
+           (neighbor.first == otherNeighbor.first &&
+            m_TreePointIdentifiers[neighbor.second] < m_TreePointIdentifiers[otherNeighbor.second]);
+  }
+
   PointsContainerPointer m_Points{};
-  SampleAdaptorPointer   m_SampleAdaptor{};
-  TreeGeneratorPointer   m_KdTreeGenerator{};
-  TreeConstPointer       m_Tree{};
+
+  unsigned int m_BucketSize{ 16 };
+  double       m_ApproximationError{ 0.0 };
+
+  std::vector<Node>            m_Nodes{};
+  double                       m_BuildLeafVolumeRatio{ 0.0 };
+  std::vector<PointType>       m_TreePoints{};
+  std::vector<PointIdentifier> m_TreePointIdentifiers{};
+
+  /** The position in the container of each point of the tree. */
+  std::vector<SizeValueType> m_TreePointPositions{};
 };
 
 } // end namespace itk
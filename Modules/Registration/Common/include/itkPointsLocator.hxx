@@ -18,14 +18,28 @@
 #ifndef itkPointsLocator_hxx
 #define itkPointsLocator_hxx
 
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
 namespace itk
 {
 
 template <typename TPointsContainer>
-PointsLocator<TPointsContainer>::PointsLocator()
-  : m_SampleAdaptor(SampleAdaptorType::New())
-  , m_KdTreeGenerator(TreeGeneratorType::New())
-{}
+auto
+PointsLocator<TPointsContainer>::GetContainerPoints(const PointsContainer * points) -> std::vector<PointType>
+{
+  std::vector<PointType> containerPoints;
+  containerPoints.reserve(points->Size());
+  for (PointsContainerConstIterator it = points->Begin(); it != points->End(); ++it)
+  {
+    containerPoints.push_back(it.Value());
+  }
+  return containerPoints;
+}
 
 template <typename TPointsContainer>
 void
@@ -40,30 +54,369 @@ PointsLocator<TPointsContainer>::Initialize()
     itkExceptionStringMacro("The number of points is 0.");
   }
 
-  this->m_SampleAdaptor = SampleAdaptorType::New();
-  this->m_KdTreeGenerator = TreeGeneratorType::New();
+  const std::vector<PointType> points = GetContainerPoints(this->m_Points);
+  const auto                   numberOfPoints = static_cast<SizeValueType>(points.size());
+
+  this->m_TreePointPositions.resize(numberOfPoints);
+  std::iota(this->m_TreePointPositions.begin(), this->m_TreePointPositions.end(), SizeValueType{ 0 });
+
+  this->m_Nodes.clear();
+  this->m_Nodes.reserve(2 * (numberOfPoints / this->m_BucketSize + 1));
+  this->BuildNode(points, 0, numberOfPoints);
+
+  // Store the points in the order of the leaves of the tree.
+  this->m_TreePoints.resize(numberOfPoints);
+  this->m_TreePointIdentifiers.resize(numberOfPoints);
+  std::vector<PointIdentifier> identifiers;
+  identifiers.reserve(numberOfPoints);
+  for (PointsContainerConstIterator it = this->m_Points->Begin(); it != this->m_Points->End(); ++it)
+  {
+    identifiers.push_back(it.Index());
+  }
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    this->m_TreePoints[i] = points[this->m_TreePointPositions[i]];
+    this->m_TreePointIdentifiers[i] = identifiers[this->m_TreePointPositions[i]];
+  }
+  this->m_BuildLeafVolumeRatio = this->ComputeLeafVolumeRatio();
+}
+
+template <typename TPointsContainer>
+SizeValueType
+PointsLocator<TPointsContainer>::BuildNode(const std::vector<PointType> & points,
+                                           SizeValueType                  begin,
+                                           SizeValueType                  end)
+{
+  const auto nodeIndex = static_cast<SizeValueType>(this->m_Nodes.size());
+
+  Node node;
+  node.Begin = begin;
+  node.End = end;
+  node.RightChild = 0;
+  node.Lower = points[this->m_TreePointPositions[begin]];
+  node.Upper = node.Lower;
+  for (SizeValueType i = begin + 1; i < end; ++i)
+  {
+    const PointType & point = points[this->m_TreePointPositions[i]];
+    for (unsigned int d = 0; d < PointDimension; ++d)
+    {
+      node.Lower[d] = std::min(node.Lower[d], point[d]);
+      node.Upper[d] = std::max(node.Upper[d], point[d]);
+    }
+  }
+  this->m_Nodes.push_back(node);
+
+  // Split at the median along the dimension of largest extent.
+  unsigned int splitDimension = 0;
+  for (unsigned int d = 1; d < PointDimension; ++d)
+  {
+    if (node.Upper[d] - node.Lower[d] > node.Upper[splitDimension] - node.Lower[splitDimension])
+    {
+      splitDimension = d;
+    }
+  }
+  if (end - begin <= this->m_BucketSize || !(node.Upper[splitDimension] > node.Lower[splitDimension]))
+  {
+    return nodeIndex;
+  }
+
+  const SizeValueType median = begin + (end - begin) / 2;
+  std::nth_element(this->m_TreePointPositions.begin() + begin,
+                   this->m_TreePointPositions.begin() + median,
+                   this->m_TreePointPositions.begin() + end,
+                   [&points, splitDimension](SizeValueType a, SizeValueType b) {
+                     return points[a][splitDimension] < points[b][splitDimension];
+                   });
+
+  this->BuildNode(points, begin, median);
+  const SizeValueType rightChild = this->BuildNode(points, median, end);
+  this->m_Nodes[nodeIndex].RightChild = rightChild;
+  return nodeIndex;
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::Refit()
+{
+  if (!this->m_Points)
+  {
+    itkExceptionStringMacro("The points have not been set (m_Points == nullptr)");
+  }
+  if (this->m_Nodes.empty() || this->m_Points->Size() != this->m_TreePoints.size())
+  {
+    this->Initialize();
+    return;
+  }
+
+  const std::vector<PointType> points = GetContainerPoints(this->m_Points);
+  SizeValueType                position = 0;
+  std::vector<PointIdentifier> identifiers(points.size());
+  for (PointsContainerConstIterator it = this->m_Points->Begin(); it != this->m_Points->End(); ++it, ++position)
+  {
+    identifiers[position] = it.Index();
+  }
+  for (SizeValueType i = 0; i < this->m_TreePoints.size(); ++i)
+  {
+    this->m_TreePoints[i] = points[this->m_TreePointPositions[i]];
+    this->m_TreePointIdentifiers[i] = identifiers[this->m_TreePointPositions[i]];
+  }
+  this->RefitNode(0);
+
+  // Build the tree again when its leaves overlap too much, e.g. after a large
+  // rotation of the points.
+  if (this->ComputeLeafVolumeRatio() > 2.0 * this->m_BuildLeafVolumeRatio)
+  {
+    this->Initialize();
+  }
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::RefitNode(SizeValueType nodeIndex)
+{
+  Node & node = this->m_Nodes[nodeIndex];
+  if (node.RightChild == 0)
+  {
+    this->ComputeNodeBounds(node);
+    return;
+  }
+
+  this->RefitNode(nodeIndex + 1);
+  this->RefitNode(node.RightChild);
+  const Node & leftChild = this->m_Nodes[nodeIndex + 1];
+  const Node & rightChild = this->m_Nodes[node.RightChild];
+  for (unsigned int d = 0; d < PointDimension; ++d)
+  {
+    node.Lower[d] = std::min(leftChild.Lower[d], rightChild.Lower[d]);
+    node.Upper[d] = std::max(leftChild.Upper[d], rightChild.Upper[d]);
+  }
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::ComputeNodeBounds(Node & node) const
+{
+  node.Lower = this->m_TreePoints[node.Begin];
+  node.Upper = node.Lower;
+  for (SizeValueType i = node.Begin + 1; i < node.End; ++i)
+  {
+    const PointType & point = this->m_TreePoints[i];
+    for (unsigned int d = 0; d < PointDimension; ++d)
+    {
+      node.Lower[d] = std::min(node.Lower[d], point[d]);
+      node.Upper[d] = std::max(node.Upper[d], point[d]);
+    }
+  }
+}
+
+template <typename TPointsContainer>
+double
+PointsLocator<TPointsContainer>::ComputeLeafVolumeRatio() const
+{
+  // Flat leaves, e.g. of points on a surface, are given a minimal thickness.
+  const Node & root = this->m_Nodes[0];
+  double       minimumExtent = 0.0;
+  for (unsigned int d = 0; d < PointDimension; ++d)
+  {
+    minimumExtent = std::max(minimumExtent, static_cast<double>(root.Upper[d]) - static_cast<double>(root.Lower[d]));
+  }
+  minimumExtent = std::max(1e-3 * minimumExtent, std::numeric_limits<double>::min());
+
+  const auto computeVolume = [minimumExtent](const Node & node) {
+    double volume = 1.0;
+    for (unsigned int d = 0; d < PointDimension; ++d)
+    {
+      volume *= std::max(static_cast<double>(node.Upper[d]) - static_cast<double>(node.Lower[d]), minimumExtent);
+    }
+    return volume;
+  };
+
+  double leafVolume = 0.0;
+  for (const Node & node : this->m_Nodes)
+  {
+    if (node.RightChild == 0)
+    {
+      leafVolume += computeVolume(node);
+    }
+  }
+  const double rootVolume = computeVolume(root);
+  return rootVolume > 0.0 ? leafVolume / rootVolume : 1.0;
+}
+
+template <typename TPointsContainer>
+double
+PointsLocator<TPointsContainer>::ComputeSquaredDistanceToNode(const PointType & query, const Node & node) const
+{
+  double squaredDistance = 0.0;
+  for (unsigned int d = 0; d < PointDimension; ++d)
+  {
+    double difference = 0.0;
+    if (query[d] < node.Lower[d])
+    {
+      difference = static_cast<double>(node.Lower[d]) - static_cast<double>(query[d]);
+    }
+    else if (query[d] > node.Upper[d])
+    {
+      difference = static_cast<double>(query[d]) - static_cast<double>(node.Upper[d]);
+    }
+    squaredDistance += difference * difference;
+  }
+  return squaredDistance;
+}
 
-  // Lack of const-correctness in the PointSetAdaptor should be fixed.
-  this->m_SampleAdaptor->SetVectorContainer(const_cast<PointsContainer *>(this->m_Points.GetPointer()));
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::SearchClosestPoint(const PointType & query,
+                                                    SizeValueType     nodeIndex,
+                                                    NeighborType &    closestPoint) const
+{
+  const Node & node = this->m_Nodes[nodeIndex];
+  if (node.RightChild == 0)
+  {
+    for (SizeValueType i = node.Begin; i < node.End; ++i)
+    {
+      const NeighborType neighbor(static_cast<double>(query.SquaredEuclideanDistanceTo(this->m_TreePoints[i])), i);
+      if (this->IsCloser(neighbor, closestPoint))
+      {
+        closestPoint = neighbor;
+      }
+    }
+    return;
+  }
 
-  this->m_SampleAdaptor->SetMeasurementVectorSize(PointDimension);
+  // Search the closer child first.
+  const double  approximationFactor = Math::sqr(1.0 + this->m_ApproximationError);
+  SizeValueType children[2] = { nodeIndex + 1, node.RightChild };
+  double        distances[2] = { this->ComputeSquaredDistanceToNode(query, this->m_Nodes[children[0]]),
+                                 this->ComputeSquaredDistanceToNode(query, this->m_Nodes[children[1]]) };
+  if (distances[1] < distances[0])
+  {
+    std::swap(children[0], children[1]);
+    std::swap(distances[0], distances[1]);
+  }
+  for (unsigned int c = 0; c < 2; ++c)
+  {
+    if (distances[c] * approximationFactor <= closestPoint.first)
+    {
+      this->SearchClosestPoint(query, children[c], closestPoint);
+    }
+  }
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::SearchClosestNPoints(const PointType & query,
+                                                      SizeValueType     nodeIndex,
+                                                      unsigned int      numberOfNeighbors,
+                                                      NeighborsType &   closestPoints) const
+{
+  const Node & node = this->m_Nodes[nodeIndex];
+  if (node.RightChild == 0)
+  {
+    for (SizeValueType i = node.Begin; i < node.End; ++i)
+    {
+      const NeighborType neighbor(static_cast<double>(query.SquaredEuclideanDistanceTo(this->m_TreePoints[i])), i);
+      if (closestPoints.size() == numberOfNeighbors)
+      {
+        if (!this->IsCloser(neighbor, closestPoints.back()))
+        {
+          continue;
+        }
+        closestPoints.pop_back();
+      }
+      // Insert in order, the number of neighbors being usually small.
+      auto position = closestPoints.end();
+      while (position != closestPoints.begin() && this->IsCloser(neighbor, *(position - 1)))
+      {
+        --position;
+      }
+      closestPoints.insert(position, neighbor);
+    }
+    return;
+  }
+
+  const double  approximationFactor = Math::sqr(1.0 + this->m_ApproximationError);
+  SizeValueType children[2] = { nodeIndex + 1, node.RightChild };
+  double        distances[2] = { this->ComputeSquaredDistanceToNode(query, this->m_Nodes[children[0]]),
+                                 this->ComputeSquaredDistanceToNode(query, this->m_Nodes[children[1]]) };
+  if (distances[1] < distances[0])
+  {
+    std::swap(children[0], children[1]);
+    std::swap(distances[0], distances[1]);
+  }
+  for (unsigned int c = 0; c < 2; ++c)
+  {
+    if (closestPoints.size() < numberOfNeighbors || distances[c] * approximationFactor <= closestPoints.back().first)
+    {
+      this->SearchClosestNPoints(query, children[c], numberOfNeighbors, closestPoints);
+    }
+  }
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::SearchPointsWithinRadius(const PointType &         query,
+                                                          SizeValueType             nodeIndex,
+                                                          double                    squaredRadius,
+                                                          NeighborsIdentifierType & identifiers) const
+{
+  const Node & node = this->m_Nodes[nodeIndex];
+  if (this->ComputeSquaredDistanceToNode(query, node) > squaredRadius)
+  {
+    return;
+  }
+  if (node.RightChild == 0)
+  {
+    for (SizeValueType i = node.Begin; i < node.End; ++i)
+    {
+      if (static_cast<double>(query.SquaredEuclideanDistanceTo(this->m_TreePoints[i])) <= squaredRadius)
+      {
+        identifiers.push_back(this->m_TreePointIdentifiers[i]);
+      }
+    }
+    return;
+  }
+  this->SearchPointsWithinRadius(query, nodeIndex + 1, squaredRadius, identifiers);
+  this->SearchPointsWithinRadius(query, node.RightChild, squaredRadius, identifiers);
+}
 
-  this->m_KdTreeGenerator->SetSample(this->m_SampleAdaptor);
-  this->m_KdTreeGenerator->SetBucketSize(16);
+template <typename TPointsContainer>
+unsigned int
+PointsLocator<TPointsContainer>::ClampNumberOfNeighbors(unsigned int numberOfNeighborsRequested) const
+{
+  unsigned int N = numberOfNeighborsRequested;
+  if (N > this->m_TreePoints.size())
+  {
+    N = static_cast<unsigned int>(this->m_TreePoints.size());
 
-  this->m_KdTreeGenerator->Update();
+    itkWarningMacro("The number of requested neighbors is greater than the "
+                    << "total number of points.  Only returning " << N << " points.");
+  }
+  return N;
+}
 
-  this->m_Tree = this->m_KdTreeGenerator->GetOutput();
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::ComputeClosestNPoints(const PointType & query,
+                                                       unsigned int      numberOfNeighbors,
+                                                       NeighborsType &   closestPoints) const
+{
+  closestPoints.clear();
+  closestPoints.reserve(numberOfNeighbors + 1);
+  if (numberOfNeighbors > 0)
+  {
+    this->SearchClosestNPoints(query, 0, numberOfNeighbors, closestPoints);
+  }
 }
 
 template <typename TPointsContainer>
 auto
 PointsLocator<TPointsContainer>::FindClosestPoint(const PointType & query) const -> PointIdentifier
 {
-  NeighborsIdentifierType identifiers;
-  this->m_Tree->Search(query, 1u, identifiers);
+  NeighborType closestPoint(std::numeric_limits<double>::infinity(), 0);
+  this->SearchClosestPoint(query, 0, closestPoint);
 
-  return identifiers[0];
+  return this->m_TreePointIdentifiers[closestPoint.second];
 }
 
 
@@ -73,15 +426,14 @@ PointsLocator<TPointsContainer>::FindClosestNPoints(const PointType &         qu
                                                     unsigned int              numberOfNeighborsRequested,
                                                     NeighborsIdentifierType & identifiers) const
 {
-  unsigned int N = numberOfNeighborsRequested;
-  if (N > this->m_Points->Size())
-  {
-    N = this->m_Points->Size();
+  NeighborsType closestPoints;
+  this->ComputeClosestNPoints(query, this->ClampNumberOfNeighbors(numberOfNeighborsRequested), closestPoints);
 
-    itkWarningMacro("The number of requested neighbors is greater than the "
-                    << "total number of points.  Only returning " << N << " points.");
+  identifiers.resize(closestPoints.size());
+  for (size_t i = 0; i < closestPoints.size(); ++i)
+  {
+    identifiers[i] = this->m_TreePointIdentifiers[closestPoints[i].second];
   }
-  this->m_Tree->Search(query, N, identifiers);
 }
 
 template <typename TPointsContainer>
@@ -91,15 +443,16 @@ PointsLocator<TPointsContainer>::FindClosestNPoints(const PointType &         qu
                                                     NeighborsIdentifierType & identifiers,
                                                     std::vector<double> &     distances) const
 {
-  unsigned int N = numberOfNeighborsRequested;
-  if (N > this->m_Points->Size())
-  {
-    N = this->m_Points->Size();
+  NeighborsType closestPoints;
+  this->ComputeClosestNPoints(query, this->ClampNumberOfNeighbors(numberOfNeighborsRequested), closestPoints);
 
-    itkWarningMacro("The number of requested neighbors is greater than the "
-                    << "total number of points.  Only returning " << N << " points.");
+  identifiers.resize(closestPoints.size());
+  distances.resize(closestPoints.size());
+  for (size_t i = 0; i < closestPoints.size(); ++i)
+  {
+    identifiers[i] = this->m_TreePointIdentifiers[closestPoints[i].second];
+    distances[i] = query.EuclideanDistanceTo(this->m_TreePoints[closestPoints[i].second]);
   }
-  this->m_Tree->Search(query, N, identifiers, distances);
 }
 
 template <typename TPointsContainer>
@@ -108,7 +461,49 @@ PointsLocator<TPointsContainer>::FindPointsWithinRadius(const PointType &
                                                         double                    radius,
                                                         NeighborsIdentifierType & identifiers) const
 {
-  this->m_Tree->Search(query, radius, identifiers);
+  identifiers.clear();
+  this->SearchPointsWithinRadius(query, 0, radius * radius, identifiers);
+  std::sort(identifiers.begin(), identifiers.end());
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::FindClosestPoints(const PointsContainer *        queries,
+                                                   std::vector<PointIdentifier> & closestPoints) const
+{
+  const std::vector<PointType> queryPoints = GetContainerPoints(queries);
+  closestPoints.resize(queryPoints.size());
+
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    queryPoints.size(),
+    [this, &queryPoints, &closestPoints](SizeValueType i) { closestPoints[i] = this->FindClosestPoint(queryPoints[i]); },
+    nullptr);
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::FindClosestNPoints(const PointsContainer *                queries,
+                                                    unsigned int                           numberOfNeighborsRequested,
+                                                    std::vector<NeighborsIdentifierType> & neighbors) const
+{
+  const std::vector<PointType> queryPoints = GetContainerPoints(queries);
+  neighbors.resize(queryPoints.size());
+
+  const unsigned int numberOfNeighbors = this->ClampNumberOfNeighbors(numberOfNeighborsRequested);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    queryPoints.size(),
+    [this, &queryPoints, &neighbors, numberOfNeighbors](SizeValueType i) {
+      NeighborsType closestPoints;
+      this->ComputeClosestNPoints(queryPoints[i], numberOfNeighbors, closestPoints);
+      neighbors[i].resize(closestPoints.size());
+      for (size_t j = 0; j < closestPoints.size(); ++j)
+      {
+        neighbors[i][j] = this->m_TreePointIdentifiers[closestPoints[j].second];
+      }
+    },
+    nullptr);
 }
 
 /**
@@ -119,6 +514,11 @@ void
 PointsLocator<TPointsContainer>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Points);
+  os << indent << "BucketSize: " << m_BucketSize << std::endl;
+  os << indent << "ApproximationError: " << m_ApproximationError << std::endl;
+  os << indent << "NumberOfNodes: " << m_Nodes.size() << std::endl;
 }
 
 } // end namespace itk
@@ -0,0 +1,191 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPointsLocator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkGTest.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using PointType = itk::Point<double, Dimension>;
+using PointsContainerType = itk::VectorContainer<itk::IdentifierType, PointType>;
+using PointsLocatorType = itk::PointsLocator<PointsContainerType>;
+
+// Clustered points, on a coarse grid so that many distances are equal.
+PointsContainerType::Pointer
+CreatePoints(unsigned int numberOfPoints, itk::Statistics::MersenneTwisterRandomVariateGenerator * generator)
+{
+  auto points = PointsContainerType::New();
+  for (unsigned int i = 0; i < numberOfPoints; ++i)
+  {
+    PointType point;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      point[d] = 0.5 * generator->GetIntegerVariate(40) + (i % 3 == 0 ? 100.0 : 0.0);
+    }
+    points->InsertElement(i, point);
+  }
+  return points;
+}
+
+// The closest points sorted by distance and identifier, by brute force.
+std::vector<PointsLocatorType::PointIdentifier>
+FindClosestNPointsByBruteForce(const PointsContainerType * points, const PointType & query, unsigned int n)
+{
+  std::vector<std::pair<double, PointsLocatorType::PointIdentifier>> neighbors;
+  for (auto it = points->Begin(); it != points->End(); ++it)
+  {
+    neighbors.emplace_back(query.SquaredEuclideanDistanceTo(it.Value()), it.Index());
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+
+  std::vector<PointsLocatorType::PointIdentifier> identifiers;
+  for (unsigned int i = 0; i < n && i < neighbors.size(); ++i)
+  {
+    identifiers.push_back(neighbors[i].second);
+  }
+  return identifiers;
+}
+} // namespace
+
+TEST(PointsLocator, MatchesBruteForce)
+{
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(42);
+
+  auto points = CreatePoints(2000, generator);
+  auto queries = CreatePoints(300, generator);
+
+  auto pointsLocator = PointsLocatorType::New();
+  EXPECT_EQ(pointsLocator->GetBucketSize(), 16u);
+  EXPECT_EQ(pointsLocator->GetApproximationError(), 0.0);
+  pointsLocator->SetBucketSize(4);
+  pointsLocator->SetPoints(points);
+  pointsLocator->Initialize();
+
+  std::vector<PointsLocatorType::PointIdentifier>        closestPoints;
+  std::vector<PointsLocatorType::NeighborsIdentifierType> neighbors;
+  pointsLocator->FindClosestPoints(queries, closestPoints);
+  pointsLocator->FindClosestNPoints(queries, 7, neighbors);
+  ASSERT_EQ(closestPoints.size(), queries->Size());
+  ASSERT_EQ(neighbors.size(), queries->Size());
+
+  for (unsigned int i = 0; i < queries->Size(); ++i)
+  {
+    const PointType & query = queries->ElementAt(i);
+    const auto        expectedNeighbors = FindClosestNPointsByBruteForce(points, query, 7);
+
+    EXPECT_EQ(pointsLocator->FindClosestPoint(query), expectedNeighbors[0]);
+    EXPECT_EQ(closestPoints[i], expectedNeighbors[0]);
+
+    PointsLocatorType::NeighborsIdentifierType identifiers;
+    pointsLocator->FindClosestNPoints(query, 7, identifiers);
+    EXPECT_EQ(std::vector<PointsLocatorType::PointIdentifier>(identifiers.begin(), identifiers.end()),
+              expectedNeighbors);
+    EXPECT_EQ(std::vector<PointsLocatorType::PointIdentifier>(neighbors[i].begin(), neighbors[i].end()),
+              expectedNeighbors);
+
+    std::vector<double> distances;
+    pointsLocator->FindClosestNPoints(query, 7, identifiers, distances);
+    ASSERT_EQ(distances.size(), 7u);
+    EXPECT_TRUE(std::is_sorted(distances.begin(), distances.end()));
+
+    const double radius = 2.0;
+    pointsLocator->FindPointsWithinRadius(query, radius, identifiers);
+    unsigned int numberOfPointsWithinRadius = 0;
+    for (auto it = points->Begin(); it != points->End(); ++it)
+    {
+      numberOfPointsWithinRadius += query.EuclideanDistanceTo(it.Value()) <= radius;
+    }
+    EXPECT_EQ(identifiers.size(), numberOfPointsWithinRadius);
+    EXPECT_TRUE(std::is_sorted(identifiers.begin(), identifiers.end()));
+  }
+}
+
+TEST(PointsLocator, Refit)
+{
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(7);
+
+  auto points = CreatePoints(1000, generator);
+  auto pointsLocator = PointsLocatorType::New();
+  pointsLocator->SetPoints(points);
+  pointsLocator->Initialize();
+
+  // Move the points, the tree keeping its structure.
+  for (auto it = points->Begin(); it != points->End(); ++it)
+  {
+    PointType & point = it.Value();
+    const auto  x = point[0];
+    point[0] = 0.8 * x - 0.6 * point[1] + 3.0;
+    point[1] = 0.6 * x + 0.8 * point[1];
+    point[2] += 0.1 * x;
+  }
+  pointsLocator->Refit();
+
+  auto queries = CreatePoints(200, generator);
+  for (auto it = queries->Begin(); it != queries->End(); ++it)
+  {
+    const auto expectedNeighbors = FindClosestNPointsByBruteForce(points, it.Value(), 5);
+    PointsLocatorType::NeighborsIdentifierType identifiers;
+    pointsLocator->FindClosestNPoints(it.Value(), 5, identifiers);
+    EXPECT_EQ(std::vector<PointsLocatorType::PointIdentifier>(identifiers.begin(), identifiers.end()),
+              expectedNeighbors);
+  }
+
+  // A different number of points builds the tree again.
+  points->InsertElement(points->Size(), PointType(-50.0));
+  pointsLocator->Refit();
+  EXPECT_EQ(pointsLocator->FindClosestPoint(PointType(-40.0)), points->Size() - 1);
+}
+
+TEST(PointsLocator, ApproximateSearch)
+{
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(3);
+
+  auto points = CreatePoints(3000, generator);
+  auto pointsLocator = PointsLocatorType::New();
+  pointsLocator->SetPoints(points);
+  pointsLocator->SetApproximationError(0.5);
+  pointsLocator->Initialize();
+
+  auto queries = CreatePoints(300, generator);
+  for (auto it = queries->Begin(); it != queries->End(); ++it)
+  {
+    const PointType & query = it.Value();
+    const auto        expectedNeighbors = FindClosestNPointsByBruteForce(points, query, 4);
+
+    const double closestDistance = query.EuclideanDistanceTo(points->ElementAt(expectedNeighbors[0]));
+    EXPECT_LE(query.EuclideanDistanceTo(points->ElementAt(pointsLocator->FindClosestPoint(query))),
+              1.5 * closestDistance + 1e-12);
+
+    PointsLocatorType::NeighborsIdentifierType identifiers;
+    pointsLocator->FindClosestNPoints(query, 4, identifiers);
+    ASSERT_EQ(identifiers.size(), 4u);
+    EXPECT_LE(query.EuclideanDistanceTo(points->ElementAt(identifiers.back())),
+              1.5 * query.EuclideanDistanceTo(points->ElementAt(expectedNeighbors.back())) + 1e-12);
+  }
+
+  pointsLocator->Print(std::cout);
+}
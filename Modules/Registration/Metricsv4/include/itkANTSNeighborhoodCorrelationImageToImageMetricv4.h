@@ -182,6 +182,10 @@ protected:
                                                                                  Superclass,
                                                                                  Self>;
 
+  /** Copy the settings of this metric into its clone. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
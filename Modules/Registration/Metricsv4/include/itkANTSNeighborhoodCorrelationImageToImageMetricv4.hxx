@@ -60,6 +60,30 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4<TFixedImage,
   Superclass::Initialize();
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+LightObject::Pointer
+ANTSNeighborhoodCorrelationImageToImageMetricv4<TFixedImage,
+                                                TMovingImage,
+                                                TVirtualImage,
+                                                TInternalComputationValueType,
+                                                TMetricTraits>::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_Radius = this->m_Radius;
+
+  return loPtr;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -541,6 +541,7 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
     if (!(sFixedFixed > NumericTraits<LocalRealType>::epsilon() &&
           sMovingMoving > NumericTraits<LocalRealType>::epsilon()))
     {
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivativesAreSparse = false;
       deriv.Fill(DerivativeValueType{});
       return;
     }
@@ -551,20 +552,12 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
                           (fixedI - sFixedMoving / sMovingMoving * movingI) * movingImageGradient[qq];
     }
 
-    /* Use a pre-allocated jacobian object for efficiency */
-    using JacobianReferenceType = JacobianType &;
-    JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+    /* Use a pre-allocated jacobian object for efficiency. With a sparse
+     * Jacobian, its columns are the parameters whose support holds the point. */
+    this->ComputeMovingTransformJacobian(scanMem.virtualPoint, threadId);
+    const JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-    /** For dense transforms, this returns identity */
-    this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      scanMem.virtualPoint, jacobian, jacobianPositional);
-
-    const NumberOfParametersType numberOfLocalParameters =
-      this->m_Associate->GetMovingTransform()->GetNumberOfLocalParameters();
-
-    for (NumberOfParametersType par = 0; par < numberOfLocalParameters; ++par)
+    for (NumberOfParametersType par = 0; par < jacobian.cols(); ++par)
     {
       deriv[par] = DerivativeValueType{};
       for (ImageDimensionType dim = 0; dim < TImageToImageMetric::MovingImageDimension; ++dim)
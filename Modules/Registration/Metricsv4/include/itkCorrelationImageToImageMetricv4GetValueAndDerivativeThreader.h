@@ -71,6 +71,8 @@ public:
 
   using typename Superclass::InternalComputationValueType;
   using typename Superclass::NumberOfParametersType;
+  using typename Superclass::NonZeroJacobianIndicesType;
+  using typename Superclass::VirtualPointBatch;
 
 protected:
   CorrelationImageToImageMetricv4GetValueAndDerivativeThreader();
@@ -104,6 +106,12 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId) override;
 
+  /** Overload: accumulate the sums of a whole block of points, in loops over
+   * the contiguous values, gradients and Jacobian rows of the block, as
+   * \c ProcessPoint does point by point. */
+  void
+  ProcessVirtualPoints(VirtualPointBatch & batch, const ThreadIdType threadId) override;
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -258,6 +258,90 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   return pointIsValid;
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TCorrelationMetric>
+void
+CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TCorrelationMetric>::ProcessVirtualPoints(VirtualPointBatch & batch, const ThreadIdType threadId)
+{
+  this->EvaluateVirtualPoints(batch);
+
+  const SizeValueType numberOfPoints = batch.NumberOfValidPoints;
+  this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints += numberOfPoints;
+
+  /* subtract the average of pixels (computed during InitializeIteration) */
+  const InternalComputationValueType averageFix = this->m_CorrelationAssociate->m_AverageFix;
+  const InternalComputationValueType averageMov = this->m_CorrelationAssociate->m_AverageMov;
+  InternalComputationValueType       f{};
+  InternalComputationValueType       m{};
+  InternalComputationValueType       f2{};
+  InternalComputationValueType       m2{};
+  InternalComputationValueType       fm{};
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    const InternalComputationValueType f1 = batch.FixedImageValues[i] - averageFix;
+    const InternalComputationValueType m1 = batch.MovingImageValues[i] - averageMov;
+    f += f1;
+    m += m1;
+    f2 += f1 * f1;
+    m2 += m1 * m1;
+    fm += f1 * m1;
+  }
+
+  AlignedCorrelationMetricValueDerivativePerThreadStruct & cumsum =
+    this->m_CorrelationMetricValueDerivativePerThreadVariables[threadId];
+  cumsum.f += f;
+  cumsum.m += m;
+  cumsum.f2 += f2;
+  cumsum.m2 += m2;
+  cumsum.fm += fm;
+
+  if (!this->m_CorrelationAssociate->GetComputeDerivative())
+  {
+    return;
+  }
+
+  /* Use a pre-allocated jacobian object for efficiency */
+  const typename TImageToImageMetric::JacobianType & jacobian =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+
+  DerivativeValueType * const fdm = cumsum.fdm.data_block();
+  DerivativeValueType * const mdm = cumsum.mdm.data_block();
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    const NonZeroJacobianIndicesType * const nonZeroJacobianIndices =
+      this->ComputeMovingTransformJacobian(batch.VirtualPoints[i], threadId);
+
+    const InternalComputationValueType f1 = batch.FixedImageValues[i] - averageFix;
+    const InternalComputationValueType m1 = batch.MovingImageValues[i] - averageMov;
+    const NumberOfParametersType       numberOfColumns = jacobian.cols();
+    for (SizeValueType dim = 0; dim < ImageToImageMetricv4Type::MovingImageDimension; ++dim)
+    {
+      const InternalComputationValueType fWeight = f1 * batch.MovingImageGradients[i][dim];
+      const InternalComputationValueType mWeight = m1 * batch.MovingImageGradients[i][dim];
+      const auto * const                 jacobianRow = jacobian[dim];
+      if (nonZeroJacobianIndices)
+      {
+        const auto * const indices = nonZeroJacobianIndices->data();
+        for (NumberOfParametersType k = 0; k < numberOfColumns; ++k)
+        {
+          fdm[indices[k]] += fWeight * jacobianRow[k];
+          mdm[indices[k]] += mWeight * jacobianRow[k];
+        }
+      }
+      else
+      {
+        for (NumberOfParametersType par = 0; par < numberOfColumns; ++par)
+        {
+          fdm[par] += fWeight * jacobianRow[par];
+          mdm[par] += mWeight * jacobianRow[par];
+        }
+      }
+    }
+  }
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TCorrelationMetric>
 bool
 CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -297,23 +381,20 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   if (this->m_CorrelationAssociate->GetComputeDerivative())
   {
     /* Use a pre-allocated jacobian object for efficiency */
-    using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
-    JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-
-    /** For dense transforms, this returns identity */
-    this->m_CorrelationAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      virtualPoint, jacobian, jacobianPositional);
+    const NonZeroJacobianIndicesType * const nonZeroJacobianIndices =
+      this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+    const typename TImageToImageMetric::JacobianType & jacobian =
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-    for (unsigned int par = 0; par < this->m_CorrelationAssociate->GetNumberOfLocalParameters(); ++par)
+    for (unsigned int k = 0; k < jacobian.cols(); ++k)
     {
       InternalComputationValueType sum{};
       for (SizeValueType dim = 0; dim < ImageToImageMetricv4Type::MovingImageDimension; ++dim)
       {
-        sum += movingImageGradient[dim] * jacobian(dim, par);
+        sum += movingImageGradient[dim] * jacobian(dim, k);
       }
 
+      const NumberOfParametersType par = nonZeroJacobianIndices ? (*nonZeroJacobianIndices)[k] : k;
       cumsum.fdm[par] += f1 * sum;
       cumsum.mdm[par] += m1 * sum;
     }
@@ -138,6 +138,10 @@ protected:
   using DemonsSparseGetValueAndDerivativeThreaderType =
     DemonsImageToImageMetricv4GetValueAndDerivativeThreader<ThreadedIndexedContainerPartitioner, Superclass, Self>;
 
+  /** Copy the settings of this metric into its clone. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
@@ -90,6 +90,27 @@ DemonsImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalCo
   Superclass::Initialize();
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+LightObject::Pointer
+DemonsImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_IntensityDifferenceThreshold = this->m_IntensityDifferenceThreshold;
+
+  return loPtr;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
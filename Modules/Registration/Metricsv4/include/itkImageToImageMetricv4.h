@@ -665,7 +665,24 @@ public:
     return MetricCategoryType::IMAGE_METRIC;
   }
 
+  /** Pointer type of the base class of the metrics. */
+  using MetricBasePointer = typename ObjectToObjectMetricBaseTemplate<TInternalComputationValueType>::Pointer;
+
+  /** Return a copy made by Clone(), initialized to evaluate with a single
+   * work unit.
+   * \sa ObjectToObjectMetricBaseTemplate::CloneForConcurrentEvaluation() */
+  MetricBasePointer
+  CloneForConcurrentEvaluation() const override;
+
 protected:
+  /** Create a metric with the settings and the inputs of this metric. The
+   * copy shares the images, masks, sampled point sets, interpolators,
+   * gradient filters and calculators and the fixed transform, and has a copy
+   * of the moving transform. It must be initialized before it is evaluated.
+   * Derived classes with settings of their own copy them in an override. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   /* Interpolators for image gradient filters. */
   using FixedImageGradientInterpolatorType =
     LinearInterpolateImageFunction<FixedImageGradientImageType, CoordinateRepresentationType>;
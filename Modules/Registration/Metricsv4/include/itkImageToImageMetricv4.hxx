@@ -631,6 +631,79 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   return region.GetNumberOfPixels();
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+LightObject::Pointer
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+
+  rval->m_GradientSource = this->m_GradientSource;
+  rval->m_FixedImage = this->m_FixedImage;
+  rval->m_MovingImage = this->m_MovingImage;
+  rval->m_FixedTransform = this->m_FixedTransform;
+  if (this->m_MovingTransform)
+  {
+    rval->m_MovingTransform = this->m_MovingTransform->Clone();
+  }
+  rval->m_VirtualImage = this->m_VirtualImage;
+  rval->m_UserHasSetVirtualDomain = this->m_UserHasSetVirtualDomain;
+
+  rval->m_FixedInterpolator = this->m_FixedInterpolator;
+  rval->m_MovingInterpolator = this->m_MovingInterpolator;
+  rval->m_FixedImageGradientInterpolator = this->m_FixedImageGradientInterpolator;
+  rval->m_MovingImageGradientInterpolator = this->m_MovingImageGradientInterpolator;
+  rval->m_UseFixedImageGradientFilter = this->m_UseFixedImageGradientFilter;
+  rval->m_UseMovingImageGradientFilter = this->m_UseMovingImageGradientFilter;
+  // Sharing the gradient filters, the gradient images are only computed once.
+  rval->m_FixedImageGradientFilter = this->m_FixedImageGradientFilter;
+  rval->m_MovingImageGradientFilter = this->m_MovingImageGradientFilter;
+  rval->m_FixedImageGradientCalculator = this->m_FixedImageGradientCalculator;
+  rval->m_MovingImageGradientCalculator = this->m_MovingImageGradientCalculator;
+
+  rval->m_FixedImageMask = this->m_FixedImageMask;
+  rval->m_MovingImageMask = this->m_MovingImageMask;
+  rval->m_FixedSampledPointSet = this->m_FixedSampledPointSet;
+  rval->m_VirtualSampledPointSet = this->m_VirtualSampledPointSet;
+  rval->m_UseSampledPointSet = this->m_UseSampledPointSet;
+  rval->m_UseVirtualSampledPointSet = this->m_UseVirtualSampledPointSet;
+
+  rval->m_UseFloatingPointCorrection = this->m_UseFloatingPointCorrection;
+  rval->m_FloatingPointCorrectionResolution = this->m_FloatingPointCorrectionResolution;
+  rval->SetMaximumNumberOfWorkUnits(this->GetMaximumNumberOfWorkUnits());
+
+  return loPtr;
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+auto
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  CloneForConcurrentEvaluation() const -> MetricBasePointer
+{
+  const typename Self::Pointer clone = dynamic_cast<Self *>(this->Clone().GetPointer());
+  if (clone.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  clone->SetMaximumNumberOfWorkUnits(1);
+  clone->Initialize();
+  return clone.GetPointer();
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -88,6 +88,7 @@ public:
   using typename Superclass::FixedOutputPointType;
   using typename Superclass::MovingTransformType;
   using typename Superclass::MovingOutputPointType;
+  using typename Superclass::NonZeroJacobianIndicesType;
 
   using typename Superclass::MeasureType;
   using typename Superclass::DerivativeType;
@@ -102,8 +103,8 @@ protected:
   /** Constructor. */
   ImageToImageMetricv4GetValueAndDerivativeThreader() = default;
 
-  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoint on every
-   * point. */
+  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoints on every
+   * block of VirtualPointBatchSize points. */
   void
   ThreadedExecution(const DomainType & imageSubRegion, const ThreadIdType threadId) override;
 
@@ -166,6 +167,7 @@ public:
   using typename Superclass::FixedOutputPointType;
   using typename Superclass::MovingTransformType;
   using typename Superclass::MovingOutputPointType;
+  using typename Superclass::NonZeroJacobianIndicesType;
 
   using typename Superclass::MeasureType;
   using typename Superclass::DerivativeType;
@@ -179,8 +181,8 @@ protected:
   /** Constructor. */
   ImageToImageMetricv4GetValueAndDerivativeThreader() = default;
 
-  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoint on every
-   * point. */
+  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoints on every
+   * block of VirtualPointBatchSize points. */
   void
   ThreadedExecution(const DomainType & indexSubRange, const ThreadIdType threadId) override;
 
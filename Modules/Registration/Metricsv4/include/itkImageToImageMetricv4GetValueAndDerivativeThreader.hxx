@@ -30,12 +30,22 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<
   TImageToImageMetricv4>::ThreadedExecution(const DomainType & imageSubRegion, const ThreadIdType threadId)
 {
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
-  VirtualPointType                              virtualPoint;
+  auto &                                        batch = this->m_GetValueAndDerivativePerThreadVariables[threadId].Batch;
+  batch.NumberOfPoints = 0;
   for (ImageRegionConstIteratorWithIndex it(virtualImage, imageSubRegion); !it.IsAtEnd(); ++it)
   {
     const VirtualIndexType & virtualIndex = it.GetIndex();
-    virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    batch.VirtualIndices[batch.NumberOfPoints] = virtualIndex;
+    virtualImage->TransformIndexToPhysicalPoint(virtualIndex, batch.VirtualPoints[batch.NumberOfPoints]);
+    if (++batch.NumberOfPoints == Superclass::VirtualPointBatchSize)
+    {
+      this->ProcessVirtualPoints(batch, threadId);
+      batch.NumberOfPoints = 0;
+    }
+  }
+  if (batch.NumberOfPoints > 0)
+  {
+    this->ProcessVirtualPoints(batch, threadId);
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
@@ -52,11 +62,22 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<ThreadedIndexedContainerPartit
   const ElementIdentifierType                   begin = indexSubRange[0];
   const ElementIdentifierType                   end = indexSubRange[1];
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
+  auto &                                        batch = this->m_GetValueAndDerivativePerThreadVariables[threadId].Batch;
+  batch.NumberOfPoints = 0;
   for (ElementIdentifierType i = begin; i <= end; ++i)
   {
     const VirtualPointType & virtualPoint = virtualSampledPointSet->GetPoint(i);
-    const auto               virtualIndex = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    batch.VirtualPoints[batch.NumberOfPoints] = virtualPoint;
+    batch.VirtualIndices[batch.NumberOfPoints] = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
+    if (++batch.NumberOfPoints == Superclass::VirtualPointBatchSize)
+    {
+      this->ProcessVirtualPoints(batch, threadId);
+      batch.NumberOfPoints = 0;
+    }
+  }
+  if (batch.NumberOfPoints > 0)
+  {
+    this->ProcessVirtualPoints(batch, threadId);
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
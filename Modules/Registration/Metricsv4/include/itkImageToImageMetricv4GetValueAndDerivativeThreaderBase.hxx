@@ -43,6 +43,11 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   // Cache some values
   this->m_CachedNumberOfParameters = this->m_Associate->GetNumberOfParameters();
   this->m_CachedNumberOfLocalParameters = this->m_Associate->GetNumberOfLocalParameters();
+  this->m_UseSparseMovingTransformJacobian =
+    this->m_Associate->GetComputeDerivative() &&
+    this->m_Associate->m_MovingTransform->GetTransformCategory() !=
+      MovingTransformType::TransformCategoryEnum::DisplacementField &&
+    this->m_Associate->m_MovingTransform->HasSparseJacobianWithRespectToParameters();
 
   /* Per-thread results */
   const ThreadIdType numWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
@@ -87,12 +92,26 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
     }
   }
 
+  for (ThreadIdType i = 0; i < numWorkUnitsUsed; ++i)
+  {
+    VirtualPointBatch & batch = this->m_GetValueAndDerivativePerThreadVariables[i].Batch;
+    batch.VirtualIndices.resize(VirtualPointBatchSize);
+    batch.VirtualPoints.resize(VirtualPointBatchSize);
+    batch.MappedFixedPoints.resize(VirtualPointBatchSize);
+    batch.FixedImageValues.resize(VirtualPointBatchSize);
+    batch.FixedImageGradients.resize(VirtualPointBatchSize);
+    batch.MappedMovingPoints.resize(VirtualPointBatchSize);
+    batch.MovingImageValues.resize(VirtualPointBatchSize);
+    batch.MovingImageGradients.resize(VirtualPointBatchSize);
+  }
+
   //---------------------------------------------------------------
   // Set initial values.
   for (ThreadIdType workUnit = 0; workUnit < numWorkUnitsUsed; ++workUnit)
   {
     this->m_GetValueAndDerivativePerThreadVariables[workUnit].NumberOfValidPoints = SizeValueType{};
     this->m_GetValueAndDerivativePerThreadVariables[workUnit].Measure = InternalComputationValueType{};
+    this->m_GetValueAndDerivativePerThreadVariables[workUnit].LocalDerivativesAreSparse = false;
     if (this->m_Associate->GetComputeDerivative())
     {
       if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
@@ -272,13 +291,181 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   return pointIsValid;
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::ProcessVirtualPoints(
+  VirtualPointBatch & batch,
+  const ThreadIdType  threadId)
+{
+  for (SizeValueType i = 0; i < batch.NumberOfPoints; ++i)
+  {
+    this->ProcessVirtualPoint(batch.VirtualIndices[i], batch.VirtualPoints[i], threadId);
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::EvaluateVirtualPoints(
+  VirtualPointBatch & batch) const
+{
+  const bool computeFixedGradient =
+    this->m_Associate->GetComputeDerivative() && this->m_Associate->GetGradientSourceIncludesFixed();
+  const bool computeMovingGradient =
+    this->m_Associate->GetComputeDerivative() && this->m_Associate->GetGradientSourceIncludesMoving();
+
+  /* Evaluate the fixed image first, then the moving image at the points
+   * still valid, compacting the valid points at the front of the arrays. */
+  try
+  {
+    SizeValueType numberOfValidPoints = 0;
+    for (SizeValueType i = 0; i < batch.NumberOfPoints; ++i)
+    {
+      if (this->m_Associate->TransformAndEvaluateFixedPoint(batch.VirtualPoints[i],
+                                                            batch.MappedFixedPoints[numberOfValidPoints],
+                                                            batch.FixedImageValues[numberOfValidPoints]))
+      {
+        batch.VirtualIndices[numberOfValidPoints] = batch.VirtualIndices[i];
+        batch.VirtualPoints[numberOfValidPoints] = batch.VirtualPoints[i];
+        ++numberOfValidPoints;
+      }
+    }
+    if (computeFixedGradient)
+    {
+      for (SizeValueType i = 0; i < numberOfValidPoints; ++i)
+      {
+        this->m_Associate->ComputeFixedImageGradientAtPoint(batch.MappedFixedPoints[i], batch.FixedImageGradients[i]);
+      }
+    }
+
+    const SizeValueType numberOfFixedValidPoints = numberOfValidPoints;
+    numberOfValidPoints = 0;
+    for (SizeValueType i = 0; i < numberOfFixedValidPoints; ++i)
+    {
+      if (this->m_Associate->TransformAndEvaluateMovingPoint(batch.VirtualPoints[i],
+                                                             batch.MappedMovingPoints[numberOfValidPoints],
+                                                             batch.MovingImageValues[numberOfValidPoints]))
+      {
+        if (numberOfValidPoints != i)
+        {
+          batch.VirtualIndices[numberOfValidPoints] = batch.VirtualIndices[i];
+          batch.VirtualPoints[numberOfValidPoints] = batch.VirtualPoints[i];
+          batch.MappedFixedPoints[numberOfValidPoints] = batch.MappedFixedPoints[i];
+          batch.FixedImageValues[numberOfValidPoints] = batch.FixedImageValues[i];
+          batch.FixedImageGradients[numberOfValidPoints] = batch.FixedImageGradients[i];
+        }
+        ++numberOfValidPoints;
+      }
+    }
+    if (computeMovingGradient)
+    {
+      for (SizeValueType i = 0; i < numberOfValidPoints; ++i)
+      {
+        this->m_Associate->ComputeMovingImageGradientAtPoint(batch.MappedMovingPoints[i],
+                                                             batch.MovingImageGradients[i]);
+      }
+    }
+    batch.NumberOfValidPoints = numberOfValidPoints;
+  }
+  catch (const ExceptionObject & exc)
+  {
+    std::string msg("Caught exception: \n");
+    msg += exc.what();
+    ExceptionObject err(__FILE__, __LINE__, msg);
+    throw err;
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ProcessEvaluatedVirtualPoints(const VirtualPointBatch & batch, const ThreadIdType threadId)
+{
+  for (SizeValueType i = 0; i < batch.NumberOfValidPoints; ++i)
+  {
+    bool        pointIsValid = false;
+    MeasureType metricValueResult;
+    try
+    {
+      pointIsValid = this->ProcessPoint(batch.VirtualIndices[i],
+                                        batch.VirtualPoints[i],
+                                        batch.MappedFixedPoints[i],
+                                        batch.FixedImageValues[i],
+                                        batch.FixedImageGradients[i],
+                                        batch.MappedMovingPoints[i],
+                                        batch.MovingImageValues[i],
+                                        batch.MovingImageGradients[i],
+                                        metricValueResult,
+                                        this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives,
+                                        threadId);
+    }
+    catch (const ExceptionObject & exc)
+    {
+      std::string msg("Exception in GetValueAndDerivativeProcessPoint:\n");
+      msg += exc.what();
+      ExceptionObject err(__FILE__, __LINE__, msg);
+      throw err;
+    }
+    if (pointIsValid)
+    {
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure += metricValueResult;
+      if (this->m_Associate->GetComputeDerivative())
+      {
+        this->StorePointDerivativeResult(batch.VirtualIndices[i], threadId);
+      }
+    }
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+auto
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ComputeMovingTransformJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const
+  -> const NonZeroJacobianIndicesType *
+{
+  auto & perThreadVariables = this->m_GetValueAndDerivativePerThreadVariables[threadId];
+  perThreadVariables.LocalDerivativesAreSparse = this->m_UseSparseMovingTransformJacobian;
+  if (this->m_UseSparseMovingTransformJacobian)
+  {
+    this->m_Associate->m_MovingTransform->ComputeSparseJacobianWithRespectToParameters(
+      virtualPoint, perThreadVariables.MovingTransformJacobian, perThreadVariables.MovingTransformJacobianIndices);
+    return &perThreadVariables.MovingTransformJacobianIndices;
+  }
+
+  /** For dense transforms, this returns identity */
+  this->m_Associate->m_MovingTransform->ComputeJacobianWithRespectToParametersCachedTemporaries(
+    virtualPoint, perThreadVariables.MovingTransformJacobian, perThreadVariables.MovingTransformJacobianPositional);
+  return nullptr;
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetricv4>
 void
 ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
   StorePointDerivativeResult(const VirtualIndexType & virtualIndex, const ThreadIdType threadId)
 {
-  if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
-      MovingTransformType::TransformCategoryEnum::DisplacementField)
+  auto & perThreadVariables = this->m_GetValueAndDerivativePerThreadVariables[threadId];
+  if (perThreadVariables.LocalDerivativesAreSparse)
+  {
+    /* Global support, with the derivatives of the non-zero Jacobian columns only */
+    perThreadVariables.LocalDerivativesAreSparse = false;
+    const NonZeroJacobianIndicesType & indices = perThreadVariables.MovingTransformJacobianIndices;
+    const size_t                       numberOfNonZeroDerivatives = indices.size();
+    if (this->m_Associate->GetUseFloatingPointCorrection())
+    {
+      const DerivativeValueType correctionResolution = this->m_Associate->GetFloatingPointCorrectionResolution();
+      for (size_t k = 0; k < numberOfNonZeroDerivatives; ++k)
+      {
+        auto test = static_cast<intmax_t>(perThreadVariables.LocalDerivatives[k] * correctionResolution);
+        perThreadVariables.LocalDerivatives[k] = static_cast<DerivativeValueType>(test / correctionResolution);
+      }
+    }
+    for (size_t k = 0; k < numberOfNonZeroDerivatives; ++k)
+    {
+      perThreadVariables.CompensatedDerivatives[indices[k]] += perThreadVariables.LocalDerivatives[k];
+    }
+  }
+  else if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
+           MovingTransformType::TransformCategoryEnum::DisplacementField)
   {
     /* Global support */
     if (this->m_Associate->GetUseFloatingPointCorrection())
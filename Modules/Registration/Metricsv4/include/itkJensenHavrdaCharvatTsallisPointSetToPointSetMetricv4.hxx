@@ -43,8 +43,11 @@ JensenHavrdaCharvatTsallisPointSetToPointSetMetricv4<TPointSet, TInternalComputa
 {
   Superclass::Initialize();
 
-  // Initialize the moving density function
-  this->m_MovingDensityFunction = DensityFunctionType::New();
+  // Initialize the moving density function, which reuses the locator and the gaussians of a previous initialization.
+  if (!this->m_MovingDensityFunction)
+  {
+    this->m_MovingDensityFunction = DensityFunctionType::New();
+  }
   this->m_MovingDensityFunction->SetKernelSigma(this->m_KernelSigma);
   this->m_MovingDensityFunction->SetRegularizationSigma(this->m_PointSetSigma);
   this->m_MovingDensityFunction->SetNormalize(true);
@@ -155,17 +155,12 @@ JointHistogramMutualInformationGetValueAndDerivativeThreader<
     scalingfactor = InternalComputationValueType{};
   }
 
-  /* Use a pre-allocated jacobian object for efficiency */
-  using JacobianReferenceType = JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-  JacobianReferenceType jacobianPositional =
-    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+  /* Use a pre-allocated jacobian object for efficiency. With a sparse
+   * Jacobian, its columns are the parameters whose support holds the point. */
+  this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+  const JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-  /** For dense transforms, this returns identity */
-  this->m_JointAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-    virtualPoint, jacobian, jacobianPositional);
-
-  for (NumberOfParametersType par = 0; par < this->GetCachedNumberOfLocalParameters(); ++par)
+  for (NumberOfParametersType par = 0; par < jacobian.cols(); ++par)
   {
     InternalComputationValueType sum{};
     for (SizeValueType dim = 0; dim < TImageToImageMetric::MovingImageDimension; ++dim)
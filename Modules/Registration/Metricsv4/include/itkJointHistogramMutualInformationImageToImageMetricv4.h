@@ -205,6 +205,10 @@ protected:
   using JointHistogramMutualInformationSparseGetValueAndDerivativeThreaderType =
     JointHistogramMutualInformationGetValueAndDerivativeThreader<ThreadedIndexedContainerPartitioner, Superclass, Self>;
 
+  /** Copy the settings of this metric into its clone. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   /** Standard PrintSelf method. */
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
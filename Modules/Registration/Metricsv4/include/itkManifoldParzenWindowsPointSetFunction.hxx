@@ -65,9 +65,19 @@ ManifoldParzenWindowsPointSetFunction<TPointSet, TOutput, TCoordinate>::SetInput
     },
     nullptr);
 
-  this->m_PointsLocator = PointsLocatorType::New();
-  this->m_PointsLocator->SetPoints(const_cast<PointsContainer *>(points));
-  this->m_PointsLocator->Initialize();
+  // A locator of previous points is refit to the new ones, which is cheaper than building it again, e.g. when the
+  // points have been transformed again.
+  if (this->m_PointsLocator)
+  {
+    this->m_PointsLocator->SetPoints(const_cast<PointsContainer *>(points));
+    this->m_PointsLocator->Refit();
+  }
+  else
+  {
+    this->m_PointsLocator = PointsLocatorType::New();
+    this->m_PointsLocator->SetPoints(const_cast<PointsContainer *>(points));
+    this->m_PointsLocator->Initialize();
+  }
 
   /**
    * Calculate covariance matrices
@@ -78,8 +88,11 @@ ManifoldParzenWindowsPointSetFunction<TPointSet, TOutput, TCoordinate>::SetInput
     [&](SizeValueType index) {
       PointType point = points->ElementAt(index);
 
-      this->m_Gaussians[index] = GaussianType::New();
-      this->m_Gaussians[index]->SetMeasurementVectorSize(PointDimension);
+      if (!this->m_Gaussians[index])
+      {
+        this->m_Gaussians[index] = GaussianType::New();
+        this->m_Gaussians[index]->SetMeasurementVectorSize(PointDimension);
+      }
       this->m_Gaussians[index]->SetMean(inputGaussians[index]->GetMean());
 
       if (this->m_CovarianceKNeighborhood > 0 && this->m_UseAnisotropicCovariances)
@@ -147,9 +147,39 @@ public:
   itkGetConstReferenceMacro(NumberOfHistogramBins, SizeValueType);
   /** @ITKEndGrouping */
 
+  /** Select how the derivative of the metric, with respect to the
+   * parameters of a transform that is not a displacement field, is computed.
+   * The choice is a trade-off between computation time and memory.
+   *
+   * UseExplicitPDFDerivatives = True computes, along with the joint PDF,
+   * the derivatives of each joint PDF bin with respect to each parameter,
+   * and then weighs them by the final joint PDF. The derivatives of the bins
+   * are stored in an image of (number of parameters) x (number of histogram
+   * bins)^2 values, and each work unit buffers its contributions before
+   * adding them to this image. This is well suited to transforms with a
+   * small number of parameters.
+   *
+   * UseExplicitPDFDerivatives = False visits the points twice. The first
+   * pass computes the joint PDF, the value of the metric, and the weight of
+   * each joint PDF bin in the derivative. The second pass adds the
+   * contribution of each point, weighted by the bins it falls into, directly
+   * to the derivative. Only the (number of histogram bins)^2 weights and a
+   * derivative per work unit are stored. This is well suited to transforms
+   * with a large number of parameters, such as BSplineTransform. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseExplicitPDFDerivatives, bool);
+  itkGetConstReferenceMacro(UseExplicitPDFDerivatives, bool);
+  itkBooleanMacro(UseExplicitPDFDerivatives);
+  /** @ITKEndGrouping */
+
   void
   Initialize() override;
 
+  /** Visit the points twice with UseExplicitPDFDerivatives off, and once
+   * otherwise. */
+  void
+  GetValueAndDerivative(MeasureType & value, DerivativeType & derivative) const override;
+
   /** The marginal PDFs are stored as std::vector. */
   // NOTE:  floating point precision is not as stable.
   // Double precision proves faster and more robust in real-world testing.
@@ -176,8 +206,8 @@ public:
   /**
    * Get the internal JointPDFDeriviative image that was used in
    * creating the metric derivative value.
-   * This is only created when a global support transform is used, and
-   * derivatives are requested.
+   * This is only created when a global support transform is used,
+   * derivatives are requested, and UseExplicitPDFDerivatives is on.
    */
   const typename JointPDFDerivativesType::Pointer
   GetJointPDFDerivatives() const
@@ -210,6 +240,10 @@ protected:
                                                                              Superclass,
                                                                              Self>;
 
+  /** Copy the settings of this metric into its clone. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
@@ -245,7 +279,20 @@ protected:
   PDFValueType  m_FixedImageBinSize{};
   PDFValueType  m_MovingImageBinSize{};
 
-  /** Helper array for storing the values of the JointPDF ratios. */
+  bool m_UseExplicitPDFDerivatives{ true };
+
+  /** Pass over the points, when computing the derivative with
+   * UseExplicitPDFDerivatives off. */
+  enum class ImplicitDerivativesPassEnum : uint8_t
+  {
+    None,
+    JointPDF,
+    Derivative
+  };
+  mutable ImplicitDerivativesPassEnum m_ImplicitDerivativesPass{ ImplicitDerivativesPassEnum::None };
+
+  /** Helper array for storing the values of the JointPDF ratios, which are
+   * the weights of the joint PDF bins in the derivative. */
   using PRatioType = PDFValueType;
   using PRatioArrayType = std::vector<PRatioType>;
 
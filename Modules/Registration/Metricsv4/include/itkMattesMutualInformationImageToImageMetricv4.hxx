@@ -338,13 +338,52 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TInternalComputationValueType,
                                             TMetricTraits>::FinalizeThread(const ThreadIdType threadId)
 {
-  if (this->GetComputeDerivative() && (!this->HasLocalSupport()))
+  if (this->GetComputeDerivative() && (!this->HasLocalSupport()) && this->m_UseExplicitPDFDerivatives)
   {
     this->m_ThreaderDerivativeManager[threadId].BlockAndReduce();
   }
 }
 
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::GetValueAndDerivative(MeasureType &    value,
+                                                                                  DerivativeType & derivative) const
+{
+  if (this->m_UseExplicitPDFDerivatives || this->HasLocalSupport())
+  {
+    Superclass::GetValueAndDerivative(value, derivative);
+    return;
+  }
+
+  try
+  {
+    // First pass: the joint PDF, the value, and the weights of the joint PDF bins in the derivative.
+    // Neither the image gradients nor the transform Jacobians are needed.
+    this->m_ImplicitDerivativesPass = ImplicitDerivativesPassEnum::JointPDF;
+    this->GetValue();
+
+    // Second pass: the derivative, from the weights of the bins each point falls into.
+    // The value computed by the first pass is left unchanged.
+    this->m_ImplicitDerivativesPass = ImplicitDerivativesPassEnum::Derivative;
+    Superclass::GetValueAndDerivative(value, derivative);
+  }
+  catch (...)
+  {
+    this->m_ImplicitDerivativesPass = ImplicitDerivativesPassEnum::None;
+    throw;
+  }
+  this->m_ImplicitDerivativesPass = ImplicitDerivativesPassEnum::None;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -412,6 +451,8 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
 
   static constexpr PDFValueType closeToZero = std::numeric_limits<PDFValueType>::epsilon();
   const PDFValueType            nFactor = 1.0 / (this->m_MovingImageBinSize * this->GetNumberOfValidPoints());
+  const bool                    computeImplicitDerivativeWeights =
+    this->m_ImplicitDerivativesPass == ImplicitDerivativesPassEnum::JointPDF;
 
   const auto temp_num_histogram_bins = this->m_NumberOfHistogramBins;
   /**
@@ -468,6 +509,10 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
               this->m_PRatioArray[index] = pRatio * nFactor;
             }
           }
+          else if (computeImplicitDerivativeWeights)
+          {
+            this->m_PRatioArray[movingIndex + (fixedIndex * this->m_NumberOfHistogramBins)] = pRatio * nFactor;
+          }
         } // end if( jointPDFValue > closeToZero && movingImageMarginalPDF > closeToZero )
       } // end for-loop over moving index
     } // end conditional for fixedMarginalPDF > close to zero
@@ -513,32 +558,71 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
 {
   const ThreadIdType localNumberOfWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
 
-  const SizeValueType       numberOfVoxels = this->m_NumberOfHistogramBins * this->m_NumberOfHistogramBins;
+  // The joint PDFs of the work units are summed into the first one by tiles of one moving image bin, in parallel.
+  // Every tile is read from all the work units while it is in cache, and the tiles are disjoint, so that no lock
+  // is needed. The per tile sums are added in order, so the result does not depend on the scheduling.
+  const SizeValueType       numberOfBins = this->m_NumberOfHistogramBins;
   JointPDFValueType * const pdfPtrStart = this->m_ThreaderJointPDF[0]->GetBufferPointer();
+  std::vector<PDFValueType> tileSums(numberOfBins);
+
+  MultiThreaderBase * const multiThreader = this->m_UseSampledPointSet
+                                              ? this->m_SparseGetValueAndDerivativeThreader->GetMultiThreader()
+                                              : this->m_DenseGetValueAndDerivativeThreader->GetMultiThreader();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBins,
+    [this, localNumberOfWorkUnitsUsed, numberOfBins, pdfPtrStart, &tileSums](const SizeValueType tile) {
+      JointPDFValueType * const tilePtr = pdfPtrStart + tile * numberOfBins;
+      for (unsigned int t = 1; t < localNumberOfWorkUnitsUsed; ++t)
+      {
+        const JointPDFValueType * const tPdfPtr = this->m_ThreaderJointPDF[t]->GetBufferPointer() + tile * numberOfBins;
+        for (SizeValueType i = 0; i < numberOfBins; ++i)
+        {
+          tilePtr[i] += tPdfPtr[i];
+        }
+        this->m_ThreaderFixedImageMarginalPDF[0][tile] += this->m_ThreaderFixedImageMarginalPDF[t][tile];
+      }
+      CompensatedSummation<PDFValueType> tileSum;
+      for (SizeValueType i = 0; i < numberOfBins; ++i)
+      {
+        tileSum += tilePtr[i];
+      }
+      tileSums[tile] = tileSum.GetSum();
+    },
+    nullptr);
 
-  for (unsigned int t = 1; t < localNumberOfWorkUnitsUsed; ++t)
+  CompensatedSummation<PDFValueType> jointPDFSum;
+  for (const PDFValueType tileSum : tileSums)
   {
-    JointPDFValueType *             pdfPtr = pdfPtrStart;
-    const JointPDFValueType *       tPdfPtr = this->m_ThreaderJointPDF[t]->GetBufferPointer();
-    const JointPDFValueType * const tPdfPtrEnd = tPdfPtr + numberOfVoxels;
-    while (tPdfPtr < tPdfPtrEnd)
-    {
-      *(pdfPtr++) += *(tPdfPtr++);
-    }
-    for (SizeValueType i = 0; i < this->m_NumberOfHistogramBins; ++i)
-    {
-      this->m_ThreaderFixedImageMarginalPDF[0][i] += this->m_ThreaderFixedImageMarginalPDF[t][i];
-    }
+    jointPDFSum += tileSum;
   }
+  this->m_JointPDFSum = jointPDFSum.GetSum();
+}
 
-  // Sum of this threads domain into the this->m_JointPDFSum that covers that part of the domain.
-  const JointPDFValueType *          pdfPtr = pdfPtrStart;
-  CompensatedSummation<PDFValueType> jointPDFSum;
-  for (SizeValueType i = 0; i < numberOfVoxels; ++i)
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+LightObject::Pointer
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
   {
-    jointPDFSum += *(pdfPtr++);
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
   }
-  this->m_JointPDFSum = jointPDFSum.GetSum();
+  rval->m_NumberOfHistogramBins = this->m_NumberOfHistogramBins;
+  rval->m_UseExplicitPDFDerivatives = this->m_UseExplicitPDFDerivatives;
+
+  return loPtr;
 }
 
 
@@ -555,6 +639,8 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TMetricTraits>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(UseExplicitPDFDerivatives);
 }
 
 template <typename TFixedImage,
@@ -65,6 +65,8 @@ public:
   using typename Superclass::DerivativeType;
   using typename Superclass::DerivativeValueType;
   using typename Superclass::NumberOfParametersType;
+  using typename Superclass::CompensatedDerivativeValueType;
+  using typename Superclass::VirtualPointBatch;
 
   using MovingTransformType = typename ImageToImageMetricv4Type::MovingTransformType;
 
@@ -97,6 +99,11 @@ protected:
   void
   AfterThreadedExecution() override;
 
+  /** Evaluate the images over the whole block of points, before adding the
+   * contribution of each valid point to the joint PDF. */
+  void
+  ProcessVirtualPoints(VirtualPointBatch & batch, const ThreadIdType threadId) override;
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -120,6 +127,12 @@ protected:
                                              const PDFValueType &            cubicBSplineDerivativeValue,
                                              DerivativeValueType *           localSupportDerivativeResultPtr) const;
 
+  /** Evaluate the cubic B-spline Parzen window of a moving image value, and
+   * its derivative, at the four bins it affects, given the fractional part
+   * of the position of the value in the histogram. */
+  static void
+  ComputeParzenWindow(const PDFValueType fraction, PDFValueType values[4], PDFValueType derivatives[4]);
+
 private:
   /** Internal pointer to the Mattes metric object in use by this threader.
    *  This will avoid costly dynamic casting in tight loops. */
@@ -44,6 +44,13 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     itkExceptionStringMacro("Dynamic casting of associate pointer failed.");
   }
 
+  if (this->m_MattesAssociate->m_ImplicitDerivativesPass ==
+      TMattesMutualInformationMetric::ImplicitDerivativesPassEnum::Derivative)
+  {
+    // The joint PDF, and the weights of its bins in the derivative, are those of the first pass.
+    return;
+  }
+
   /* Porting: these next blocks of code are from MattesMutualImageToImageMetric::Initialize */
 
   /*
@@ -130,10 +137,22 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   if (!this->m_MattesAssociate->GetComputeDerivative())
   {
     // We only need these if we're computing derivatives.
-    this->m_MattesAssociate->m_PRatioArray.clear();
     this->m_MattesAssociate->m_JointPdfIndex1DArray.clear();
     this->m_MattesAssociate->m_LocalDerivativeByParzenBin.clear();
     this->m_MattesAssociate->m_JointPDFDerivatives = nullptr;
+    if (this->m_MattesAssociate->m_ImplicitDerivativesPass ==
+        TMattesMutualInformationMetric::ImplicitDerivativesPassEnum::JointPDF)
+    {
+      // First of the two passes computing the derivative without the joint PDF derivatives:
+      // the weights of the bins are computed at the end of this pass, for the second one.
+      this->m_MattesAssociate->m_PRatioArray.assign(
+        this->m_MattesAssociate->m_NumberOfHistogramBins * this->m_MattesAssociate->m_NumberOfHistogramBins, 0.0);
+      this->m_MattesAssociate->m_ThreaderDerivativeManager.clear();
+    }
+    else
+    {
+      this->m_MattesAssociate->m_PRatioArray.clear();
+    }
   }
 
   if (this->m_MattesAssociate->GetComputeDerivative() && this->m_MattesAssociate->HasLocalSupport())
@@ -212,6 +231,17 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TMattesMutualInformationMetric>::ProcessVirtualPoints(VirtualPointBatch & batch, const ThreadIdType threadId)
+{
+  this->EvaluateVirtualPoints(batch);
+  this->ProcessEvaluatedVirtualPoints(batch, threadId);
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
 bool
 MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -225,9 +255,9 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
                                                 const MovingImagePointType &,
                                                 const MovingImagePixelType &    movingImageValue,
                                                 const MovingImageGradientType & movingImageGradient,
-                                                MeasureType &,
-                                                DerivativeType &,
-                                                const ThreadIdType threadId) const
+                                                MeasureType &                   metricValueReturn,
+                                                DerivativeType &                localDerivativeReturn,
+                                                const ThreadIdType              threadId) const
 {
   const bool doComputeDerivative = this->m_MattesAssociate->GetComputeDerivative();
   /**
@@ -263,17 +293,11 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     }
   }
   // Move the pointer to the first affected bin
-  OffsetValueType       pdfMovingIndex = movingImageParzenWindowIndex - 1;
-  const OffsetValueType pdfMovingIndexMax = movingImageParzenWindowIndex + 2;
+  const OffsetValueType pdfMovingIndex = movingImageParzenWindowIndex - 1;
 
   const OffsetValueType fixedImageParzenWindowIndex =
     this->m_MattesAssociate->ComputeSingleFixedImageParzenWindowIndex(fixedImageValue);
 
-  // Since a zero-order BSpline (box car) kernel is used for
-  // the fixed image marginal pdf, we need only increment the
-  // fixedImageParzenWindowIndex by value of 1.0.
-  this->m_MattesAssociate->m_ThreaderFixedImageMarginalPDF[threadId][fixedImageParzenWindowIndex] += 1;
-
   /**
    * The region of support of the parzen window determines which bins
    * of the joint PDF are effected by the pair of image values.
@@ -285,76 +309,100 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
    * zero-th (column) dimension and the fixed image bins corresponds
    * to the first (row) dimension.
    */
-  PDFValueType movingImageParzenWindowArg =
-    static_cast<PDFValueType>(pdfMovingIndex) - static_cast<PDFValueType>(movingImageParzenWindowTerm);
+  PDFValueType parzenWindowValues[4];
+  PDFValueType parzenWindowDerivatives[4];
+  Self::ComputeParzenWindow(movingImageParzenWindowTerm - static_cast<PDFValueType>(movingImageParzenWindowIndex),
+                            parzenWindowValues,
+                            parzenWindowDerivatives);
 
-  // Pointer to affected bin to be updated
-  JointPDFValueType * pdfPtr = this->m_MattesAssociate->m_ThreaderJointPDF[threadId]->GetBufferPointer() +
-                               (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_NumberOfHistogramBins) +
-                               pdfMovingIndex;
-
-  OffsetValueType localDerivativeOffset = 0;
-  // Store the pdf indices for this point.
-  // Just store the starting pdfMovingIndex and we'll iterate later
-  // over the next four to collect results.
-  if (doComputeDerivative && (this->m_MattesAssociate->HasLocalSupport()))
+  const OffsetValueType jointPdfIndex1D =
+    pdfMovingIndex + (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_NumberOfHistogramBins);
+
+  // Compute the transform Jacobian.
+  using JacobianReferenceType = JacobianType &;
+  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+
+  if (this->m_MattesAssociate->m_ImplicitDerivativesPass ==
+      TMattesMutualInformationMetric::ImplicitDerivativesPassEnum::Derivative)
   {
-    const OffsetValueType jointPdfIndex1D =
-      pdfMovingIndex + (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_NumberOfHistogramBins);
-    localDerivativeOffset = this->m_MattesAssociate->ComputeParameterOffsetFromVirtualIndex(
-      virtualIndex, this->GetCachedNumberOfLocalParameters());
-    for (NumberOfParametersType i = 0, numLocalParameters = this->GetCachedNumberOfLocalParameters();
-         i < numLocalParameters;
-         ++i)
+    // The joint PDF is complete: weigh the derivative of the point by the bins it falls into,
+    // and let the superclass accumulate it. With a sparse Jacobian, the derivative is only
+    // computed for the parameters whose support holds the point.
+    this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+    const PDFValueType * const pRatio = this->m_MattesAssociate->m_PRatioArray.data() + jointPdfIndex1D;
+    PDFValueType               weight = 0.0;
+    for (unsigned int bin = 0; bin < 4; ++bin)
+    {
+      weight += pRatio[bin] * parzenWindowDerivatives[bin];
+    }
+    for (NumberOfParametersType mu = 0, maxElement = jacobian.cols(); mu < maxElement; ++mu)
     {
-      this->m_MattesAssociate->m_JointPdfIndex1DArray[localDerivativeOffset + i] = jointPdfIndex1D;
+      PDFValueType innerProduct = 0.0;
+      for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+      {
+        innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+      }
+      localDerivativeReturn[mu] = -weight * innerProduct;
     }
+    metricValueReturn = MeasureType{};
+    return true;
+  }
+
+  // Since a zero-order BSpline (box car) kernel is used for
+  // the fixed image marginal pdf, we need only increment the
+  // fixedImageParzenWindowIndex by value of 1.0.
+  this->m_MattesAssociate->m_ThreaderFixedImageMarginalPDF[threadId][fixedImageParzenWindowIndex] += 1;
+
+  // Pointer to affected bin to be updated
+  JointPDFValueType * const pdfPtr =
+    this->m_MattesAssociate->m_ThreaderJointPDF[threadId]->GetBufferPointer() + jointPdfIndex1D;
+  for (unsigned int bin = 0; bin < 4; ++bin)
+  {
+    pdfPtr[bin] += parzenWindowValues[bin];
   }
 
-  // Compute the transform Jacobian.
-  using JacobianReferenceType = JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
   if (doComputeDerivative)
   {
+    // The joint PDF derivatives are laid out by parameter: the Jacobian is dense.
     JacobianReferenceType jacobianPositional =
       this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
     this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
       virtualPoint, jacobian, jacobianPositional);
-  }
 
-  SizeValueType movingParzenBin = 0;
-
-  const bool transformIsDisplacement = this->m_MattesAssociate->m_MovingTransform->GetTransformCategory() ==
-                                       MovingTransformType::TransformCategoryEnum::DisplacementField;
-  while (pdfMovingIndex <= pdfMovingIndexMax)
-  {
-    const auto val = CubicBSplineFunctionType::FastEvaluate(movingImageParzenWindowArg);
-    *(pdfPtr++) += val;
-
-    if (doComputeDerivative)
+    if (this->m_MattesAssociate->m_MovingTransform->GetTransformCategory() ==
+        MovingTransformType::TransformCategoryEnum::DisplacementField)
     {
-      // Compute the cubicBSplineDerivative for later repeated use.
-      const PDFValueType cubicBSplineDerivativeValue =
-        CubicBSplineDerivativeFunctionType::FastEvaluate(movingImageParzenWindowArg);
-
-      if (transformIsDisplacement)
+      // Store the pdf indices for this point.
+      // Just store the starting pdfMovingIndex and we'll iterate later
+      // over the next four to collect results.
+      const OffsetValueType localDerivativeOffset = this->m_MattesAssociate->ComputeParameterOffsetFromVirtualIndex(
+        virtualIndex, this->GetCachedNumberOfLocalParameters());
+      for (NumberOfParametersType i = 0, numLocalParameters = this->GetCachedNumberOfLocalParameters();
+           i < numLocalParameters;
+           ++i)
+      {
+        this->m_MattesAssociate->m_JointPdfIndex1DArray[localDerivativeOffset + i] = jointPdfIndex1D;
+      }
+      for (unsigned int bin = 0; bin < 4; ++bin)
       {
         // Pointer to local derivative partial result container.
         // Not used with global support transforms.
         // ptr to where the derivative result should go, for efficiency
         DerivativeValueType * localSupportDerivativeResultPtr =
-          &(this->m_MattesAssociate->m_LocalDerivativeByParzenBin[movingParzenBin][localDerivativeOffset]);
+          &(this->m_MattesAssociate->m_LocalDerivativeByParzenBin[bin][localDerivativeOffset]);
         // Compute PDF derivative contribution.
-
         this->ComputePDFDerivativesLocalSupportTransform(
-          jacobian, movingImageGradient, cubicBSplineDerivativeValue, localSupportDerivativeResultPtr);
+          jacobian, movingImageGradient, parzenWindowDerivatives[bin], localSupportDerivativeResultPtr);
       }
-      else
+    }
+    else
+    {
+      for (unsigned int bin = 0; bin < 4; ++bin)
       {
         // Update bins in the PDF derivatives for the current intensity pair
         const OffsetValueType ThisIndexOffset =
           (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[2]) +
-          (pdfMovingIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[1]);
+          ((pdfMovingIndex + bin) * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[1]);
 
         PDFValueType * derivativeContributionPtr =
           this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(ThisIndexOffset);
@@ -367,16 +415,12 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
             innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
           }
 
-          *(derivativeContributionPtr) = innerProduct * cubicBSplineDerivativeValue;
+          *(derivativeContributionPtr) = innerProduct * parzenWindowDerivatives[bin];
           ++derivativeContributionPtr;
         }
         this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].CheckAndReduceIfNecessary();
       }
     }
-
-    movingImageParzenWindowArg += 1.0;
-    ++pdfMovingIndex;
-    ++movingParzenBin;
   }
 
   // have to do this here since we're returning false
@@ -410,6 +454,32 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomain
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TMattesMutualInformationMetric>::ComputeParzenWindow(const PDFValueType fraction,
+                                                       PDFValueType       values[4],
+                                                       PDFValueType       derivatives[4])
+{
+  // The four bins are at the distances -1 - fraction, -fraction, 1 - fraction and 2 - fraction
+  // of the moving image value, and each of them is within a single piece of the cubic B-spline.
+  const PDFValueType complement = 1.0 - fraction;
+  const PDFValueType fraction2 = fraction * fraction;
+  const PDFValueType fraction3 = fraction2 * fraction;
+
+  values[0] = complement * complement * complement / 6.0;
+  values[1] = (4.0 - 6.0 * fraction2 + 3.0 * fraction3) / 6.0;
+  values[2] = (1.0 + 3.0 * fraction + 3.0 * fraction2 - 3.0 * fraction3) / 6.0;
+  values[3] = fraction3 / 6.0;
+
+  derivatives[0] = 0.5 * complement * complement;
+  derivatives[1] = fraction * (2.0 - 1.5 * fraction);
+  derivatives[2] = complement * (1.5 * complement - 2.0);
+  derivatives[3] = -0.5 * fraction2;
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
 void
 MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -418,6 +488,23 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   TMattesMutualInformationMetric>::AfterThreadedExecution()
 {
   const ThreadIdType localNumberOfWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
+
+  if (this->m_MattesAssociate->m_ImplicitDerivativesPass ==
+      TMattesMutualInformationMetric::ImplicitDerivativesPassEnum::Derivative)
+  {
+    // The value was computed by the first pass. Only sum the derivatives of the work units.
+    for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
+    {
+      CompensatedDerivativeValueType sum;
+      for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+      {
+        sum += this->m_GetValueAndDerivativePerThreadVariables[workUnitID].CompensatedDerivatives[p].GetSum();
+      }
+      (*(this->m_MattesAssociate->m_DerivativeResult))[p] += sum.GetSum();
+    }
+    return;
+  }
+
   /* Store the number of valid points in the enclosing class
    * m_NumberOfValidPoints by collecting the valid points per thread.
    * We do this here because we're skipping Superclass::AfterThreadedExecution*/
@@ -62,10 +62,21 @@ public:
   using typename Superclass::DerivativeType;
   using typename Superclass::DerivativeValueType;
   using typename Superclass::NumberOfParametersType;
+  using typename Superclass::InternalComputationValueType;
+  using typename Superclass::MovingTransformType;
+  using typename Superclass::VirtualPointBatch;
 
 protected:
   MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader() = default;
 
+  /** Accumulate the value, and the derivative for a transform with global
+   * support, over a whole block of points, in loops over the contiguous
+   * values, gradients and Jacobian rows of the block. The derivative of the
+   * block is added once to the compensated per-thread derivative. Other
+   * cases, such as vector pixels, are processed point by point. */
+  void
+  ProcessVirtualPoints(VirtualPointBatch & batch, const ThreadIdType threadId) override;
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -20,6 +20,9 @@
 
 #include "itkDefaultConvertPixelTraits.h"
 
+#include <algorithm>
+#include <type_traits>
+
 namespace itk
 {
 
@@ -56,17 +59,13 @@ MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader<
     return true;
   }
 
-  /* Use a pre-allocated jacobian object for efficiency */
-  using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-  JacobianReferenceType jacobianPositional =
-    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-
-  /** For dense transforms, this returns identity */
-  this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-    virtualPoint, jacobian, jacobianPositional);
+  /* Use a pre-allocated jacobian object for efficiency. With a sparse
+   * Jacobian, its columns are the parameters whose support holds the point. */
+  this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+  const typename TImageToImageMetric::JacobianType & jacobian =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-  for (unsigned int par = 0; par < this->GetCachedNumberOfLocalParameters(); ++par)
+  for (unsigned int par = 0; par < jacobian.cols(); ++par)
   {
     localDerivativeReturn[par] = DerivativeValueType{};
     for (unsigned int nc = 0; nc < nComponents; ++nc)
@@ -83,6 +82,84 @@ MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader<
   return true;
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMeanSquaresMetric>
+void
+MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TMeanSquaresMetric>::ProcessVirtualPoints(VirtualPointBatch & batch, const ThreadIdType threadId)
+{
+  this->EvaluateVirtualPoints(batch);
+
+  if constexpr (!std::is_arithmetic_v<FixedImagePixelType>)
+  {
+    this->ProcessEvaluatedVirtualPoints(batch, threadId);
+  }
+  else
+  {
+    const bool computeDerivative = this->GetComputeDerivative();
+    if (computeDerivative && (this->m_Associate->GetMovingTransform()->GetTransformCategory() ==
+                                MovingTransformType::TransformCategoryEnum::DisplacementField ||
+                              this->m_Associate->GetUseFloatingPointCorrection() ||
+                              this->GetUseSparseMovingTransformJacobian()))
+    {
+      // The derivative of every point is stored at its own offset, or rounded on its own, or
+      // only added to the parameters of the non-zero Jacobian columns of the point.
+      this->ProcessEvaluatedVirtualPoints(batch, threadId);
+      return;
+    }
+
+    auto &              perThreadVariables = this->m_GetValueAndDerivativePerThreadVariables[threadId];
+    const SizeValueType numberOfPoints = batch.NumberOfValidPoints;
+
+    InternalComputationValueType measure{};
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      const FixedImagePixelType diff = batch.FixedImageValues[i] - batch.MovingImageValues[i];
+      measure += static_cast<MeasureType>(diff) * static_cast<MeasureType>(diff);
+    }
+    perThreadVariables.Measure += measure;
+    perThreadVariables.NumberOfValidPoints += numberOfPoints;
+
+    if (!computeDerivative || numberOfPoints == 0)
+    {
+      return;
+    }
+
+    /* Use pre-allocated objects for efficiency. The local derivative holds the sum over the block. */
+    using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
+    JacobianReferenceType        jacobian = perThreadVariables.MovingTransformJacobian;
+    JacobianReferenceType        jacobianPositional = perThreadVariables.MovingTransformJacobianPositional;
+    const NumberOfParametersType numberOfParameters = this->GetCachedNumberOfLocalParameters();
+    DerivativeValueType * const  blockDerivative = perThreadVariables.LocalDerivatives.data_block();
+    std::fill_n(blockDerivative, numberOfParameters, DerivativeValueType{});
+
+    const auto * const movingTransform = this->m_Associate->GetMovingTransform();
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      movingTransform->ComputeJacobianWithRespectToParametersCachedTemporaries(
+        batch.VirtualPoints[i], jacobian, jacobianPositional);
+
+      const FixedImagePixelType diff = batch.FixedImageValues[i] - batch.MovingImageValues[i];
+      const MeasureType         twiceDiff = 2.0 * static_cast<MeasureType>(diff);
+      for (SizeValueType dim = 0; dim < ImageToImageMetricv4Type::MovingImageDimension; ++dim)
+      {
+        const DerivativeValueType weight = twiceDiff * batch.MovingImageGradients[i][dim];
+        const auto * const        jacobianRow = jacobian[dim];
+        for (NumberOfParametersType par = 0; par < numberOfParameters; ++par)
+        {
+          blockDerivative[par] += weight * jacobianRow[par];
+        }
+      }
+    }
+
+    for (NumberOfParametersType par = 0; par < numberOfParameters; ++par)
+    {
+      perThreadVariables.CompensatedDerivatives[par] += blockDerivative[par];
+    }
+  }
+}
+
 } // end namespace itk
 
 #endif
@@ -471,6 +471,11 @@ private:
   mutable bool m_MovingTransformPointLocatorsNeedInitialization{};
   mutable bool m_FixedTransformPointLocatorsNeedInitialization{};
 
+  // Whether the transformed points only moved since the points locators were
+  // initialized, so that their trees can be refit instead of built again.
+  mutable bool m_MovingTransformPointLocatorsCanBeRefit{};
+  mutable bool m_FixedTransformPointLocatorsCanBeRefit{};
+
   // Flag to keep track of whether a warning has already been issued
   // regarding the number of valid points.
   mutable bool m_HaveWarnedAboutNumberOfValidPoints{};
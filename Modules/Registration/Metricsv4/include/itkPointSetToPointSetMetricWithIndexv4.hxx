@@ -472,13 +472,15 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
 {
   // Transform the moving point set with the moving transform.
   // We calculate the value and derivatives in the moving space.
-  bool update = !this->m_MovingTransformedPointSet;
-  update = update || this->m_MovingTransformedPointSetTime < this->GetMTime();
-  update = update || (this->m_CalculateValueAndDerivativeInTangentSpace &&
-                      (this->m_MovingTransform->GetMTime() > this->m_MovingTransformedPointSetTime));
+  const bool pointSetModified =
+    !this->m_MovingTransformedPointSet || this->m_MovingTransformedPointSetTime < this->GetMTime();
+  const bool update = pointSetModified || (this->m_CalculateValueAndDerivativeInTangentSpace &&
+                                           (this->m_MovingTransform->GetMTime() > this->m_MovingTransformedPointSetTime));
   if (update)
   {
     this->m_MovingTransformPointLocatorsNeedInitialization = true;
+    // When only the transform was modified, the same points have moved.
+    this->m_MovingTransformPointLocatorsCanBeRefit = !pointSetModified;
     this->m_MovingTransformedPointSet = MovingTransformedPointSetType::New();
     this->m_MovingTransformedPointSet->Initialize();
 
@@ -515,8 +517,9 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
   TransformFixedAndCreateVirtualPointSet() const
 {
   // Transform the fixed point set through the virtual domain, and into the moving domain
-  bool update = !this->m_FixedTransformedPointSet || !this->m_VirtualTransformedPointSet;
-  update = update || this->m_FixedTransformedPointSetTime < this->GetMTime();
+  const bool pointSetModified = !this->m_FixedTransformedPointSet || !this->m_VirtualTransformedPointSet ||
+                                this->m_FixedTransformedPointSetTime < this->GetMTime();
+  bool update = pointSetModified;
   update = update || (this->m_CalculateValueAndDerivativeInTangentSpace &&
                       (this->m_FixedTransform->GetMTime() > this->m_FixedTransformedPointSetTime));
   update = update || (!this->m_CalculateValueAndDerivativeInTangentSpace &&
@@ -525,6 +528,7 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
   if (update)
   {
     this->m_FixedTransformPointLocatorsNeedInitialization = true;
+    this->m_FixedTransformPointLocatorsCanBeRefit = !pointSetModified;
     this->m_FixedTransformedPointSet = FixedTransformedPointSetType::New();
     this->m_FixedTransformedPointSet->Initialize();
     this->m_VirtualTransformedPointSet = VirtualPointSetType::New();
@@ -590,7 +594,14 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
       this->m_FixedTransformedPointsLocator = PointsLocatorType::New();
     }
     this->m_FixedTransformedPointsLocator->SetPoints(this->m_FixedTransformedPointSet->GetPoints());
-    this->m_FixedTransformedPointsLocator->Initialize();
+    if (this->m_FixedTransformPointLocatorsCanBeRefit)
+    {
+      this->m_FixedTransformedPointsLocator->Refit();
+    }
+    else
+    {
+      this->m_FixedTransformedPointsLocator->Initialize();
+    }
     this->m_FixedTransformPointLocatorsNeedInitialization = false;
   }
 
@@ -605,7 +616,14 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
       this->m_MovingTransformedPointsLocator = PointsLocatorType::New();
     }
     this->m_MovingTransformedPointsLocator->SetPoints(this->m_MovingTransformedPointSet->GetPoints());
-    this->m_MovingTransformedPointsLocator->Initialize();
+    if (this->m_MovingTransformPointLocatorsCanBeRefit)
+    {
+      this->m_MovingTransformedPointsLocator->Refit();
+    }
+    else
+    {
+      this->m_MovingTransformedPointsLocator->Initialize();
+    }
     this->m_MovingTransformPointLocatorsNeedInitialization = false;
   }
 }
@@ -656,6 +674,8 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
 
   itkPrintSelfBooleanMacro(MovingTransformPointLocatorsNeedInitialization);
   itkPrintSelfBooleanMacro(FixedTransformPointLocatorsNeedInitialization);
+  itkPrintSelfBooleanMacro(MovingTransformPointLocatorsCanBeRefit);
+  itkPrintSelfBooleanMacro(FixedTransformPointLocatorsCanBeRefit);
   itkPrintSelfBooleanMacro(HaveWarnedAboutNumberOfValidPoints);
   itkPrintSelfBooleanMacro(StoreDerivativeAsSparseFieldForLocalSupportTransforms);
 
@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkCorrelationImageToImageMetricv4.h"
+#include "itkDemonsImageToImageMetricv4.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkExhaustiveOptimizerv4.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkJointHistogramMutualInformationImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkMultiStartOptimizerv4.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+/* Verify that the copies of the image metrics created for the concurrent
+ * evaluation of candidate parameters compute the same values as the metrics,
+ * and that the optimizers find the same solutions evaluating their
+ * candidates concurrently. */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<double, Dimension>;
+using TranslationTransformType = itk::TranslationTransform<double, Dimension>;
+using ParametersType = TranslationTransformType::ParametersType;
+
+ImageType::Pointer
+MakeImage(const double centerX, const double centerY)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(32));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double dx = it.GetIndex()[0] - centerX;
+    const double dy = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(dx * dx + 0.5 * dy * dy) / 60.0) + 0.1 * it.GetIndex()[0]);
+  }
+  return image;
+}
+
+bool
+AreClose(const double value1, const double value2)
+{
+  return std::abs(value1 - value2) <= 1e-9 * std::max(1.0, std::abs(value1));
+}
+
+// Compare the values of the metric and of its copy at a few parameters.
+template <typename TMetric>
+bool
+TestClone(TMetric * metric, const std::vector<ParametersType> & parametersList)
+{
+  std::cout << metric->GetNameOfClass() << std::endl;
+
+  metric->Initialize();
+  const typename TMetric::MetricBasePointer metricClone = metric->CloneForConcurrentEvaluation();
+  const auto                                clone = dynamic_cast<TMetric *>(metricClone.GetPointer());
+  if (clone == nullptr || clone == metric || clone->GetMovingTransform() == metric->GetMovingTransform() ||
+      clone->GetMaximumNumberOfWorkUnits() != 1)
+  {
+    std::cerr << "  The copy of the metric is not set up for concurrent evaluation." << std::endl;
+    return false;
+  }
+
+  bool pass = true;
+  for (size_t i = 0; i < parametersList.size(); ++i)
+  {
+    ParametersType parameters = parametersList[i];
+    metric->SetParameters(parameters);
+    const double expectedValue = metric->GetValue();
+
+    // The copy has its own transform.
+    ParametersType otherParameters(parameters.GetSize());
+    otherParameters.Fill(0.5);
+    clone->SetParameters(otherParameters);
+    clone->GetValue();
+    clone->SetParameters(parameters);
+    const double value = clone->GetValue();
+
+    std::cout << "  Parameters #" << i << ": " << expectedValue << " " << value << std::endl;
+    if (!AreClose(value, expectedValue) || metric->GetParameters() != parameters)
+    {
+      std::cerr << "  The value of the copy differs." << std::endl;
+      pass = false;
+    }
+  }
+  return pass;
+}
+
+template <typename TMetric>
+typename TMetric::Pointer
+MakeMetric(const ImageType * fixedImage, const ImageType * movingImage)
+{
+  auto metric = TMetric::New();
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetFixedTransform(TranslationTransformType::New());
+  metric->SetMovingTransform(TranslationTransformType::New());
+  return metric;
+}
+} // namespace
+
+int
+itkImageToImageMetricv4ConcurrentEvaluationTest(int, char *[])
+{
+  const auto fixedImage = MakeImage(15.0, 16.0);
+  const auto movingImage = MakeImage(17.0, 15.0);
+
+  std::vector<ParametersType> translations;
+  for (const double x : { 0.0, 1.5, -2.25 })
+  {
+    ParametersType translation(Dimension);
+    translation[0] = x;
+    translation[1] = -0.5 * x;
+    translations.push_back(translation);
+  }
+
+  bool pass = true;
+
+  using MeanSquaresMetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+  pass &= TestClone(MakeMetric<MeanSquaresMetricType>(fixedImage, movingImage).GetPointer(), translations);
+
+  using CorrelationMetricType = itk::CorrelationImageToImageMetricv4<ImageType, ImageType>;
+  pass &= TestClone(MakeMetric<CorrelationMetricType>(fixedImage, movingImage).GetPointer(), translations);
+
+  using MattesMetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+  const auto mattesMetric = MakeMetric<MattesMetricType>(fixedImage, movingImage);
+  mattesMetric->SetNumberOfHistogramBins(24);
+  mattesMetric->SetUseSampledPointSet(true);
+  using PointSetType = MattesMetricType::FixedSampledPointSetType;
+  auto pointSet = PointSetType::New();
+  for (unsigned int i = 0; i < 200; ++i)
+  {
+    PointSetType::PointType point;
+    point[0] = 4.0 + (i * 7) % 24;
+    point[1] = 4.0 + (i * 11) % 24 + 0.25;
+    pointSet->SetPoint(i, point);
+  }
+  mattesMetric->SetFixedSampledPointSet(pointSet);
+  pass &= TestClone(mattesMetric.GetPointer(), translations);
+
+  using JointHistogramMetricType = itk::JointHistogramMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+  const auto jointHistogramMetric = MakeMetric<JointHistogramMetricType>(fixedImage, movingImage);
+  jointHistogramMetric->SetNumberOfHistogramBins(16);
+  jointHistogramMetric->SetVarianceForJointPDFSmoothing(2.0);
+  pass &= TestClone(jointHistogramMetric.GetPointer(), translations);
+
+  using ANTSMetricType = itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>;
+  const auto antsMetric = MakeMetric<ANTSMetricType>(fixedImage, movingImage);
+  antsMetric->SetRadius(itk::MakeSize(2, 1));
+  pass &= TestClone(antsMetric.GetPointer(), translations);
+
+  using DemonsMetricType = itk::DemonsImageToImageMetricv4<ImageType, ImageType>;
+  using DisplacementFieldTransformType = itk::DisplacementFieldTransform<double, Dimension>;
+  auto field = DisplacementFieldTransformType::DisplacementFieldType::New();
+  field->CopyInformation(fixedImage);
+  field->SetRegions(fixedImage->GetBufferedRegion());
+  field->Allocate(true);
+  auto displacementFieldTransform = DisplacementFieldTransformType::New();
+  displacementFieldTransform->SetDisplacementField(field);
+  auto demonsMetric = DemonsMetricType::New();
+  demonsMetric->SetFixedImage(fixedImage);
+  demonsMetric->SetMovingImage(movingImage);
+  demonsMetric->SetMovingTransform(displacementFieldTransform);
+  demonsMetric->SetIntensityDifferenceThreshold(0.01);
+  std::vector<ParametersType> displacements;
+  for (const double x : { 0.0, 0.75 })
+  {
+    ParametersType displacement(displacementFieldTransform->GetNumberOfParameters());
+    for (unsigned int i = 0; i < displacement.GetSize(); ++i)
+    {
+      displacement[i] = x * std::sin(0.1 * i);
+    }
+    displacements.push_back(displacement);
+  }
+  pass &= TestClone(demonsMetric.GetPointer(), displacements);
+
+  // The optimizers find the same solutions, evaluating their candidates in turn
+  // and concurrently.
+  for (const bool concurrently : { false, true })
+  {
+    std::cout << "EvaluateCandidatesConcurrently: " << concurrently << std::endl;
+    const auto metric = MakeMetric<MeanSquaresMetricType>(fixedImage, movingImage);
+    metric->Initialize();
+
+    using ExhaustiveOptimizerType = itk::ExhaustiveOptimizerv4<double>;
+    auto exhaustiveOptimizer = ExhaustiveOptimizerType::New();
+    exhaustiveOptimizer->SetMetric(metric);
+    exhaustiveOptimizer->SetNumberOfSteps(ExhaustiveOptimizerType::StepsType(Dimension, 4));
+    exhaustiveOptimizer->SetStepLength(0.5);
+    exhaustiveOptimizer->SetScales(ExhaustiveOptimizerType::ScalesType(Dimension, 1.0));
+    exhaustiveOptimizer->SetNumberOfWorkUnits(3);
+    exhaustiveOptimizer->SetEvaluateCandidatesConcurrently(concurrently);
+    ITK_TRY_EXPECT_NO_EXCEPTION(exhaustiveOptimizer->StartOptimization());
+    std::cout << "  Exhaustive: " << exhaustiveOptimizer->GetMinimumMetricValuePosition() << " "
+              << exhaustiveOptimizer->GetMinimumMetricValue() << " after "
+              << exhaustiveOptimizer->GetCurrentIteration() << " iterations" << std::endl;
+    ITK_TEST_EXPECT_EQUAL(exhaustiveOptimizer->GetCurrentIteration(), 81);
+    ITK_TEST_EXPECT_TRUE(itk::Math::Absolute(exhaustiveOptimizer->GetMinimumMetricValuePosition()[0] - 2.0) < 1e-9);
+    ITK_TEST_EXPECT_TRUE(itk::Math::Absolute(exhaustiveOptimizer->GetMinimumMetricValuePosition()[1] + 1.0) < 1e-9);
+
+    using MultiStartOptimizerType = itk::MultiStartOptimizerv4;
+    auto multiStartOptimizer = MultiStartOptimizerType::New();
+    multiStartOptimizer->SetMetric(metric);
+    MultiStartOptimizerType::ParametersListType startPoints;
+    for (int i = -3; i <= 3; ++i)
+    {
+      ParametersType startPoint(Dimension);
+      startPoint[0] = i;
+      startPoint[1] = -0.5 * i;
+      startPoints.push_back(startPoint);
+    }
+    multiStartOptimizer->SetParametersList(startPoints);
+    multiStartOptimizer->SetNumberOfWorkUnits(3);
+    multiStartOptimizer->SetEvaluateCandidatesConcurrently(concurrently);
+    ITK_TRY_EXPECT_NO_EXCEPTION(multiStartOptimizer->StartOptimization());
+    std::cout << "  MultiStart: " << multiStartOptimizer->GetBestParameters() << std::endl;
+    ITK_TEST_EXPECT_EQUAL(multiStartOptimizer->GetBestParameters(), startPoints[5]);
+  }
+
+  if (!pass)
+  {
+    std::cerr << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,343 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkBSplineTransform.h"
+#include "itkCorrelationImageToImageMetricv4.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkJointHistogramMutualInformationImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegistrationParameterScalesFromIndexShift.h"
+#include "itkRegistrationParameterScalesFromJacobian.h"
+#include "itkRegistrationParameterScalesFromPhysicalShift.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+/* Verify that the metrics and the scales estimators compute the same
+ * derivatives and scales from the sparse Jacobian of a BSplineTransform as
+ * from its full Jacobian. */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<double, Dimension>;
+using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+
+/** A BSplineTransform which lets the metrics use its full Jacobian. */
+class DenseJacobianBSplineTransform : public BSplineTransformType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DenseJacobianBSplineTransform);
+
+  using Self = DenseJacobianBSplineTransform;
+  using Superclass = BSplineTransformType;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(DenseJacobianBSplineTransform);
+
+  bool
+  HasSparseJacobianWithRespectToParameters() const override
+  {
+    return false;
+  }
+
+protected:
+  DenseJacobianBSplineTransform() = default;
+  ~DenseJacobianBSplineTransform() override = default;
+};
+
+/** Exposes the shifts of the parameters computed by a shift scales estimator,
+ * one parameter at a time, or from the sparse Jacobians. */
+template <typename TEstimator>
+class ShiftScalesEstimatorTester : public TEstimator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ShiftScalesEstimatorTester);
+
+  using Self = ShiftScalesEstimatorTester;
+  using Superclass = TEstimator;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(ShiftScalesEstimatorTester);
+
+  using typename Superclass::ScalesType;
+  using typename Superclass::ParametersType;
+
+  ScalesType
+  ComputeShiftsOfParameters(const bool fromSparseJacobians)
+  {
+    this->CheckAndSetInputs();
+    this->SetScalesSamplingStrategy();
+    this->SampleVirtualDomain();
+
+    const itk::SizeValueType numberOfParameters = this->GetNumberOfLocalParameters();
+    ScalesType               shifts(numberOfParameters);
+    if (fromSparseJacobians)
+    {
+      this->ComputeMaximumShiftsFromSparseJacobians(shifts);
+      return shifts;
+    }
+    ParametersType deltaParameters(numberOfParameters);
+    for (itk::SizeValueType i = 0; i < numberOfParameters; ++i)
+    {
+      deltaParameters.Fill(0.0);
+      deltaParameters[i] = this->GetSmallParameterVariation();
+      shifts[i] = this->ComputeMaximumVoxelShift(deltaParameters);
+    }
+    return shifts;
+  }
+
+protected:
+  ShiftScalesEstimatorTester() = default;
+  ~ShiftScalesEstimatorTester() override = default;
+};
+
+ImageType::Pointer
+MakeImage(const double centerX, const double centerY)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(32));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double dx = it.GetIndex()[0] - centerX;
+    const double dy = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(dx * dx + 0.5 * dy * dy) / 60.0) + 0.1 * it.GetIndex()[0]);
+  }
+  return image;
+}
+
+template <typename TTransform>
+typename TTransform::Pointer
+MakeBSplineTransform(const ImageType * image)
+{
+  auto transform = TTransform::New();
+  transform->SetTransformDomainOrigin(image->GetOrigin());
+  transform->SetTransformDomainDirection(image->GetDirection());
+  transform->SetTransformDomainPhysicalDimensions(itk::MakeVector(31.0, 31.0));
+  transform->SetTransformDomainMeshSize(itk::MakeSize(4, 5));
+
+  typename TTransform::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int p = 0; p < parameters.size(); ++p)
+  {
+    parameters[p] = 0.3 * std::sin(0.7 * p);
+  }
+  transform->SetParameters(parameters);
+  return transform;
+}
+
+bool
+AreNear(const itk::Array<double> & sparseValues, const itk::Array<double> & denseValues, const std::string & name)
+{
+  if (sparseValues.size() != denseValues.size())
+  {
+    std::cerr << name << ": expected " << denseValues.size() << " values, got " << sparseValues.size() << std::endl;
+    return false;
+  }
+  const double tolerance = 1e-9 * std::max(1.0, denseValues.inf_norm());
+  for (unsigned int p = 0; p < denseValues.size(); ++p)
+  {
+    if (std::abs(sparseValues[p] - denseValues[p]) > tolerance)
+    {
+      std::cerr << name << ": value " << p << " is " << sparseValues[p] << " with the sparse Jacobian, and "
+                << denseValues[p] << " with the dense Jacobian." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TMetric>
+bool
+TestMetric(TMetric * sparseMetric, TMetric * denseMetric, const std::string & name)
+{
+  const ImageType::Pointer fixedImage = MakeImage(15.0, 16.0);
+  const ImageType::Pointer movingImage = MakeImage(16.5, 15.0);
+
+  typename TMetric::MeasureType    values[2];
+  typename TMetric::DerivativeType derivatives[2];
+  TMetric * const                  metrics[2] = { sparseMetric, denseMetric };
+  for (unsigned int m = 0; m < 2; ++m)
+  {
+    metrics[m]->SetFixedImage(fixedImage);
+    metrics[m]->SetMovingImage(movingImage);
+    if (m == 0)
+    {
+      metrics[m]->SetMovingTransform(MakeBSplineTransform<BSplineTransformType>(fixedImage));
+    }
+    else
+    {
+      metrics[m]->SetMovingTransform(MakeBSplineTransform<DenseJacobianBSplineTransform>(fixedImage));
+    }
+    metrics[m]->Initialize();
+    metrics[m]->GetValueAndDerivative(values[m], derivatives[m]);
+  }
+
+  bool testPassed = true;
+  if (std::abs(values[0] - values[1]) > 1e-12 * std::max(1.0, std::abs(values[1])))
+  {
+    std::cerr << name << ": the value is " << values[0] << " with the sparse Jacobian, and " << values[1]
+              << " with the dense Jacobian." << std::endl;
+    testPassed = false;
+  }
+  if (derivatives[1].inf_norm() == 0.0)
+  {
+    std::cerr << name << ": the derivative is zero." << std::endl;
+    testPassed = false;
+  }
+  testPassed &= AreNear(derivatives[0], derivatives[1], name + " derivative");
+  return testPassed;
+}
+
+template <typename TEstimator>
+bool
+TestShiftScalesEstimator(const std::string & name)
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+
+  const ImageType::Pointer fixedImage = MakeImage(15.0, 16.0);
+  const ImageType::Pointer movingImage = MakeImage(16.5, 15.0);
+  movingImage->SetSpacing(itk::MakeVector(1.2, 0.8));
+  ImageType::DirectionType direction;
+  direction(0, 0) = std::cos(0.3);
+  direction(0, 1) = -std::sin(0.3);
+  direction(1, 0) = std::sin(0.3);
+  direction(1, 1) = std::cos(0.3);
+  movingImage->SetDirection(direction);
+
+  auto metric = MetricType::New();
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetMovingTransform(MakeBSplineTransform<BSplineTransformType>(fixedImage));
+  metric->Initialize();
+
+  auto estimator = ShiftScalesEstimatorTester<TEstimator>::New();
+  estimator->SetMetric(metric);
+  estimator->SetCentralRegionRadius(3);
+
+  const auto shifts = estimator->ComputeShiftsOfParameters(false);
+  const auto sparseShifts = estimator->ComputeShiftsOfParameters(true);
+  if (shifts.inf_norm() == 0.0)
+  {
+    std::cerr << name << ": the shifts are zero." << std::endl;
+    return false;
+  }
+  return AreNear(sparseShifts, shifts, name + " shifts");
+}
+
+bool
+TestJacobianScalesEstimator()
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+  using EstimatorType = itk::RegistrationParameterScalesFromJacobian<MetricType>;
+
+  const ImageType::Pointer fixedImage = MakeImage(15.0, 16.0);
+  const ImageType::Pointer movingImage = MakeImage(16.5, 15.0);
+
+  EstimatorType::ScalesType scales[2];
+  EstimatorType::FloatType  stepScales[2];
+  for (unsigned int m = 0; m < 2; ++m)
+  {
+    auto metric = MetricType::New();
+    metric->SetFixedImage(fixedImage);
+    metric->SetMovingImage(movingImage);
+    if (m == 0)
+    {
+      metric->SetMovingTransform(MakeBSplineTransform<BSplineTransformType>(fixedImage));
+    }
+    else
+    {
+      metric->SetMovingTransform(MakeBSplineTransform<DenseJacobianBSplineTransform>(fixedImage));
+    }
+    metric->Initialize();
+
+    auto estimator = EstimatorType::New();
+    estimator->SetMetric(metric);
+    estimator->EstimateScales(scales[m]);
+
+    EstimatorType::ParametersType step(metric->GetNumberOfParameters());
+    for (unsigned int p = 0; p < step.size(); ++p)
+    {
+      step[p] = std::cos(1.3 * p);
+    }
+    stepScales[m] = estimator->EstimateStepScale(step);
+  }
+
+  bool testPassed = AreNear(scales[0], scales[1], "Jacobian scales");
+  if (std::abs(stepScales[0] - stepScales[1]) > 1e-9 * stepScales[1])
+  {
+    std::cerr << "Jacobian step scale: " << stepScales[0] << " with the sparse Jacobian, and " << stepScales[1]
+              << " with the dense Jacobian." << std::endl;
+    testPassed = false;
+  }
+  return testPassed;
+}
+} // namespace
+
+int
+itkImageToImageMetricv4SparseJacobianTest(int, char *[])
+{
+  bool testPassed = true;
+
+  {
+    using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+    testPassed &= TestMetric<MetricType>(MetricType::New(), MetricType::New(), "MeanSquares");
+  }
+  {
+    using MetricType = itk::CorrelationImageToImageMetricv4<ImageType, ImageType>;
+    testPassed &= TestMetric<MetricType>(MetricType::New(), MetricType::New(), "Correlation");
+  }
+  {
+    using MetricType = itk::JointHistogramMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+    testPassed &= TestMetric<MetricType>(MetricType::New(), MetricType::New(), "JointHistogramMutualInformation");
+  }
+  {
+    using MetricType = itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>;
+    testPassed &= TestMetric<MetricType>(MetricType::New(), MetricType::New(), "ANTSNeighborhoodCorrelation");
+  }
+  for (const bool useExplicitPDFDerivatives : { true, false })
+  {
+    using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+    auto sparseMetric = MetricType::New();
+    auto denseMetric = MetricType::New();
+    sparseMetric->SetUseExplicitPDFDerivatives(useExplicitPDFDerivatives);
+    denseMetric->SetUseExplicitPDFDerivatives(useExplicitPDFDerivatives);
+    testPassed &= TestMetric<MetricType>(sparseMetric, denseMetric, "MattesMutualInformation");
+  }
+
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+  testPassed &=
+    TestShiftScalesEstimator<itk::RegistrationParameterScalesFromPhysicalShift<MetricType>>("PhysicalShift");
+  testPassed &= TestShiftScalesEstimator<itk::RegistrationParameterScalesFromIndexShift<MetricType>>("IndexShift");
+  testPassed &= TestJacobianScalesEstimator();
+
+  if (!testPassed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -223,6 +223,44 @@ itkJensenHavrdaCharvatTsallisPointSetMetricTestRun()
     moving_str2 << "0 0 0 0" << std::endl;
   }
 
+  // The density function of the metric is kept from one initialization to the next. Setting the moved points of a
+  // density function, which refits its locator, gives the same densities as a new density function of these points.
+  using DensityFunctionType =
+    typename itk::JensenHavrdaCharvatTsallisPointSetToPointSetMetricv4<PointSetType>::DensityFunctionType;
+  const auto makeDensityFunction = [] {
+    auto densityFunction = DensityFunctionType::New();
+    densityFunction->SetKernelSigma(10.0);
+    densityFunction->SetRegularizationSigma(1.0);
+    densityFunction->SetNormalize(true);
+    densityFunction->SetUseAnisotropicCovariances(true);
+    densityFunction->SetCovarianceKNeighborhood(covarianceKNeighborhood);
+    densityFunction->SetEvaluationKNeighborhood(10);
+    return densityFunction;
+  };
+  auto movedPoints = PointSetType::New();
+  for (unsigned long id = 0; id < movingPoints->GetNumberOfPoints(); ++id)
+  {
+    PointType point = movingPoints->GetPoint(id);
+    point[0] += 0.3 * point[1];
+    movedPoints->SetPoint(id, point);
+  }
+  const auto refitDensityFunction = makeDensityFunction();
+  refitDensityFunction->SetInputPointSet(movingPoints);
+  refitDensityFunction->SetInputPointSet(movedPoints);
+  const auto newDensityFunction = makeDensityFunction();
+  newDensityFunction->SetInputPointSet(movedPoints);
+  for (unsigned long id = 0; id < fixedPoints->GetNumberOfPoints(); ++id)
+  {
+    const PointType point = fixedPoints->GetPoint(id);
+    if (refitDensityFunction->Evaluate(point) != newDensityFunction->Evaluate(point))
+    {
+      std::cerr << "density at " << point << " of the refit density function: " << refitDensityFunction->Evaluate(point)
+                << " differs from the one of a new density function: " << newDensityFunction->Evaluate(point)
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
 
@@ -341,6 +341,33 @@ TestMattesMetricWithAffineTransform(TInterpolator * const interpolator, const bo
   metric->Initialize();
   metric->GetValueAndDerivative(metricValueWithDerivative, derivative);
 
+  // Without the joint PDF derivatives, the points are visited twice, for the same value and derivative.
+  ITK_TEST_SET_GET_BOOLEAN(metric, UseExplicitPDFDerivatives, false);
+  typename MetricType::MeasureType    implicitMetricValue;
+  typename MetricType::DerivativeType implicitDerivative;
+  metric->GetValueAndDerivative(implicitMetricValue, implicitDerivative);
+  if (metric->GetJointPDFDerivatives().IsNotNull())
+  {
+    std::cout << "[FAILED] the joint PDF derivatives are allocated without UseExplicitPDFDerivatives." << std::endl;
+    testFailed = true;
+  }
+  if (!itk::Math::FloatAlmostEqual(implicitMetricValue, metricValueWithDerivative, 8))
+  {
+    std::cout << "[FAILED] the value without UseExplicitPDFDerivatives differs: " << implicitMetricValue
+              << " != " << metricValueWithDerivative << std::endl;
+    testFailed = true;
+  }
+  for (unsigned int i = 0; i < numberOfParameters; ++i)
+  {
+    if (itk::Math::Absolute(implicitDerivative[i] - derivative[i]) > 1e-10 * (1.0 + derivative.inf_norm()))
+    {
+      std::cout << "[FAILED] the derivative without UseExplicitPDFDerivatives differs at " << i << ": "
+                << implicitDerivative[i] << " != " << derivative[i] << std::endl;
+      testFailed = true;
+    }
+  }
+  metric->UseExplicitPDFDerivativesOn();
+
   ParametersType parameters1Plus(numberOfParameters);
   ParametersType parameters2Plus(numberOfParameters);
   ParametersType parameters1Minus(numberOfParameters);
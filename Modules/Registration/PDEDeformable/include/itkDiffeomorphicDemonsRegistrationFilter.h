@@ -188,30 +188,43 @@ private:
   DownCastDifferenceFunctionType() const;
 
   /** Exp and composition type alias */
-  using MultiplyByConstantType =
-    MultiplyImageFilter<DisplacementFieldType, itk::Image<TimeStepType, ImageDimension>, DisplacementFieldType>;
-
   using FieldExponentiatorType = ExponentialDisplacementFieldImageFilter<DisplacementFieldType, DisplacementFieldType>;
 
-  using VectorWarperType = WarpVectorImageFilter<DisplacementFieldType, DisplacementFieldType, DisplacementFieldType>;
-
   using FieldInterpolatorType =
     VectorLinearInterpolateNearestNeighborExtrapolateImageFunction<DisplacementFieldType, double>;
 
-  using AdderType = AddImageFilter<DisplacementFieldType, DisplacementFieldType, DisplacementFieldType>;
-
-  using MultiplyByConstantPointer = typename MultiplyByConstantType::Pointer;
   using FieldExponentiatorPointer = typename FieldExponentiatorType::Pointer;
-  using VectorWarperPointer = typename VectorWarperType::Pointer;
   using FieldInterpolatorPointer = typename FieldInterpolatorType::Pointer;
   using FieldInterpolatorOutputType = typename FieldInterpolatorType::OutputType;
-  using AdderPointer = typename AdderType::Pointer;
 
-  MultiplyByConstantPointer m_Multiplier{};
+  /** Compute, in a single pass, the composition of \c field with the
+   * displacement d: composed(x) = field(x + d(x)) + d(x), where the field is
+   * interpolated linearly, and is zero outside of its buffer, as
+   * WarpVectorImageFilter followed by AddImageFilter compute it. When
+   * \c squareDisplacement is true, d is the square of \c displacement,
+   * d(x) = displacement(x + displacement(x)) + displacement(x), which is the
+   * last step of the scaling and squaring of ExponentialDisplacementFieldImageFilter. */
+  void
+  ComposeFields(const DisplacementFieldType * field,
+                const DisplacementFieldType * displacement,
+                bool                          squareDisplacement,
+                DisplacementFieldType *       composed);
+
+  /** Multiply the field by the factor, in place. */
+  void
+  ScaleField(DisplacementFieldType * field, TimeStepType factor);
+
+  /** Allocate the field like the output, unless it already is. */
+  void
+  AllocateLikeOutput(DisplacementFieldPointer & field);
+
   FieldExponentiatorPointer m_Exponentiator{};
-  VectorWarperPointer       m_Warper{};
-  AdderPointer              m_Adder{};
   bool                      m_UseFirstOrderExp{ false };
+
+  /** The buffers of the squarings of the exponential, and of the composition,
+   * kept from one iteration to the next. */
+  DisplacementFieldPointer m_SquaredUpdateBuffer{};
+  DisplacementFieldPointer m_ComposedFieldBuffer{};
 };
 } // end namespace itk
 
@@ -19,6 +19,8 @@
 #define itkDiffeomorphicDemonsRegistrationFilter_hxx
 
 #include "itkSmoothingRecursiveGaussianImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
 
 namespace itk
 {
@@ -26,17 +28,10 @@ namespace itk
 template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
 DiffeomorphicDemonsRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::
   DiffeomorphicDemonsRegistrationFilter()
-  : m_Multiplier(MultiplyByConstantType::New())
-  , m_Exponentiator(FieldExponentiatorType::New())
-  , m_Warper(VectorWarperType::New())
-  , m_Adder(AdderType::New())
+  : m_Exponentiator(FieldExponentiatorType::New())
 {
   auto drfp = DemonsRegistrationFunctionType::New();
   this->SetDifferenceFunction(drfp);
-  m_Multiplier->InPlaceOn();
-  const FieldInterpolatorPointer VectorInterpolator = FieldInterpolatorType::New();
-  m_Warper->SetInterpolator(VectorInterpolator);
-  m_Adder->InPlaceOn();
 }
 
 template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
@@ -182,96 +177,111 @@ void
 DiffeomorphicDemonsRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::ApplyUpdate(
   const TimeStepType & dt)
 {
-  // If we smooth the update buffer before applying it, then the are
-  // approximating a viscous problem as opposed to an elastic problem
-  if (this->GetSmoothUpdateField())
-  {
-    this->SmoothUpdateField();
-  }
-
   // Use time step if necessary. In many cases
   // the time step is one so this will be skipped
+  TimeStepType timeStep = 1.0;
   if (itk::Math::Absolute(dt - 1.0) > 1.0e-4)
   {
     itkDebugMacro("Using timestep: " << dt);
-    m_Multiplier->SetInput2(dt);
-    m_Multiplier->SetInput(this->GetUpdateBuffer());
-    m_Multiplier->GraftOutput(this->GetUpdateBuffer());
-    // in place update
-    m_Multiplier->Update();
-    // graft output back to this->GetUpdateBuffer()
-    this->GetUpdateBuffer()->Graft(m_Multiplier->GetOutput());
+    timeStep = dt;
+  }
+
+  // The number of squarings of the exponential, when it is imposed by the
+  // maximum update step length: max(norm(Phi))/2^N <= 0.25*pixelspacing
+  const double imposedMaxUpStep = this->GetMaximumUpdateStepLength();
+  const bool   squareUpdate = !this->m_UseFirstOrderExp && imposedMaxUpStep > 0.0;
+  unsigned int numiter = 0;
+  if (squareUpdate)
+  {
+    const double numiterfloat = 2.0 + std::log(imposedMaxUpStep) / itk::Math::ln2;
+    if (numiterfloat > 0.0)
+    {
+      numiter = Math::Ceil<unsigned int>(numiterfloat);
+    }
+  }
+
+  // The first order approximation of the exponential, u * dt / 2^N, is
+  // computed by the last pass of the smoothing of the update field, unless a
+  // subclass may have overridden the smoothing.
+  const TimeStepType updateFactor = timeStep / static_cast<TimeStepType>(1u << numiter);
+
+  // If we smooth the update buffer before applying it, then the are
+  // approximating a viscous problem as opposed to an elastic problem
+  if (this->GetSmoothUpdateField() && this->template CanFuseUpdateFieldSmoothing<Self>())
+  {
+    this->SmoothFieldInPlace(this->GetUpdateBuffer(), this->GetUpdateFieldStandardDeviations(), nullptr, updateFactor);
+  }
+  else
+  {
+    if (this->GetSmoothUpdateField())
+    {
+      this->SmoothUpdateField();
+    }
+    if (updateFactor != 1.0)
+    {
+      this->ScaleField(this->GetUpdateBuffer(), updateFactor);
+    }
   }
 
+  this->AllocateLikeOutput(m_ComposedFieldBuffer);
+
   if (this->m_UseFirstOrderExp)
   {
     // use s <- s o (Id +u)
 
     // skip exponential and compose the vector fields
-    m_Warper->SetOutputOrigin(this->GetUpdateBuffer()->GetOrigin());
-    m_Warper->SetOutputSpacing(this->GetUpdateBuffer()->GetSpacing());
-    m_Warper->SetOutputDirection(this->GetUpdateBuffer()->GetDirection());
-    m_Warper->SetInput(this->GetOutput());
-    m_Warper->SetDisplacementField(this->GetUpdateBuffer());
-
-    m_Adder->SetInput1(m_Warper->GetOutput());
-    m_Adder->SetInput2(this->GetUpdateBuffer());
-
-    m_Adder->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+    this->ComposeFields(this->GetOutput(), this->GetUpdateBuffer(), false, m_ComposedFieldBuffer);
   }
-  else
+  else if (squareUpdate)
   {
     // use s <- s o exp(u)
 
-    // compute the exponential
-    m_Exponentiator->SetInput(this->GetUpdateBuffer());
-
-    const double imposedMaxUpStep = this->GetMaximumUpdateStepLength();
-    if (imposedMaxUpStep > 0.0)
+    // compute the exponential by scaling and squaring, as
+    // ExponentialDisplacementFieldImageFilter does, and compose the vector
+    // fields in the pass of the last squaring
+    DisplacementFieldPointer squared = this->GetUpdateBuffer();
+    if (numiter > 1)
     {
-      // max(norm(Phi))/2^N <= 0.25*pixelspacing
-      const double numiterfloat = 2.0 + std::log(imposedMaxUpStep) / itk::Math::ln2;
-      unsigned int numiter = 0;
-      if (numiterfloat > 0.0)
+      this->AllocateLikeOutput(m_SquaredUpdateBuffer);
+      DisplacementFieldPointer nextSquared = m_SquaredUpdateBuffer;
+      for (unsigned int i = 0; i + 1 < numiter; ++i)
       {
-        numiter = Math::Ceil<unsigned int>(numiterfloat);
+        this->ComposeFields(squared, squared, false, nextSquared);
+        std::swap(squared, nextSquared);
       }
-
-      m_Exponentiator->AutomaticNumberOfIterationsOff();
-      m_Exponentiator->SetMaximumNumberOfIterations(numiter);
-    }
-    else
-    {
-      m_Exponentiator->AutomaticNumberOfIterationsOn();
-      // just set a high value so that automatic number of step
-      // is not thresholded
-      m_Exponentiator->SetMaximumNumberOfIterations(2000u);
     }
+    this->ComposeFields(this->GetOutput(), squared, numiter > 0, m_ComposedFieldBuffer);
+  }
+  else
+  {
+    // use s <- s o exp(u)
 
+    // compute the exponential with an automatic number of squarings
+    m_Exponentiator->SetInput(this->GetUpdateBuffer());
+    m_Exponentiator->AutomaticNumberOfIterationsOn();
+    // just set a high value so that automatic number of step
+    // is not thresholded
+    m_Exponentiator->SetMaximumNumberOfIterations(2000u);
     m_Exponentiator->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
-
     m_Exponentiator->Update();
 
     // compose the vector fields
-    m_Warper->SetOutputOrigin(this->GetUpdateBuffer()->GetOrigin());
-    m_Warper->SetOutputSpacing(this->GetUpdateBuffer()->GetSpacing());
-    m_Warper->SetOutputDirection(this->GetUpdateBuffer()->GetDirection());
-    m_Warper->SetInput(this->GetOutput());
-    m_Warper->SetDisplacementField(m_Exponentiator->GetOutput());
-
-    m_Warper->Update();
-
-    m_Adder->SetInput1(m_Warper->GetOutput());
-    m_Adder->SetInput2(m_Exponentiator->GetOutput());
-
-    m_Adder->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+    this->ComposeFields(this->GetOutput(), m_Exponentiator->GetOutput(), false, m_ComposedFieldBuffer);
   }
 
-  // Triggers update
-  m_Adder->Update();
-
-  // Region passing stuff
-  this->GraftOutput(m_Adder->GetOutput());
+  // The composed field becomes the output. The previous output buffer is
+  // kept for the next composition, unless it is shared with another image.
+  const typename DisplacementFieldType::PixelContainerPointer previousBuffer = this->GetOutput()->GetPixelContainer();
+  this->GraftOutput(m_ComposedFieldBuffer);
+  this->GetOutput()->Modified();
+  if (previousBuffer->GetReferenceCount() == 1)
+  {
+    m_ComposedFieldBuffer->SetPixelContainer(previousBuffer);
+  }
+  else
+  {
+    m_ComposedFieldBuffer = nullptr;
+  }
 
   DemonsRegistrationFunctionType * drfp = this->DownCastDifferenceFunctionType();
 
@@ -284,6 +294,112 @@ DiffeomorphicDemonsRegistrationFilter<TFixedImage, TMovingImage, TDisplacementFi
   }
 }
 
+template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
+void
+DiffeomorphicDemonsRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::ComposeFields(
+  const DisplacementFieldType * field,
+  const DisplacementFieldType * displacement,
+  bool                          squareDisplacement,
+  DisplacementFieldType *       composed)
+{
+  using PixelType = typename DisplacementFieldType::PixelType;
+  using ValueType = typename PixelType::ValueType;
+  using PointType = typename DisplacementFieldType::PointType;
+
+  const FieldInterpolatorPointer fieldInterpolator = FieldInterpolatorType::New();
+  fieldInterpolator->SetInputImage(field);
+  const FieldInterpolatorPointer displacementInterpolator = FieldInterpolatorType::New();
+  displacementInterpolator->SetInputImage(displacement);
+
+  // The field warped at a point, zero outside of its buffer, as the edge
+  // padding value of WarpVectorImageFilter.
+  const auto warp = [](const FieldInterpolatorType & interpolator, const PointType & point) {
+    PixelType warped{};
+    if (interpolator.IsInsideBuffer(point))
+    {
+      const FieldInterpolatorOutputType interpolatedValue = interpolator.Evaluate(point);
+      for (unsigned int k = 0; k < PixelType::Dimension; ++k)
+      {
+        warped[k] = static_cast<ValueType>(interpolatedValue[k]);
+      }
+    }
+    return warped;
+  };
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    composed->GetBufferedRegion(),
+    [&](const typename DisplacementFieldType::RegionType & region) {
+      ImageRegionConstIteratorWithIndex<DisplacementFieldType> displacementIt(displacement, region);
+      ImageRegionIterator<DisplacementFieldType>               composedIt(composed, region);
+      for (; !composedIt.IsAtEnd(); ++displacementIt, ++composedIt)
+      {
+        PointType origin;
+        composed->TransformIndexToPhysicalPoint(displacementIt.GetIndex(), origin);
+
+        PixelType d = displacementIt.Get();
+        if (squareDisplacement)
+        {
+          PointType point = origin;
+          for (unsigned int j = 0; j < ImageDimension; ++j)
+          {
+            point[j] += d[j];
+          }
+          d += warp(*displacementInterpolator, point);
+        }
+
+        PointType point = origin;
+        for (unsigned int j = 0; j < ImageDimension; ++j)
+        {
+          point[j] += d[j];
+        }
+        composedIt.Set(warp(*fieldInterpolator, point) + d);
+      }
+    },
+    nullptr);
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
+void
+DiffeomorphicDemonsRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::ScaleField(
+  DisplacementFieldType * field,
+  TimeStepType            factor)
+{
+  using PixelType = typename DisplacementFieldType::PixelType;
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    field->GetBufferedRegion(),
+    [field, factor](const typename DisplacementFieldType::RegionType & region) {
+      for (ImageRegionIterator<DisplacementFieldType> it(field, region); !it.IsAtEnd(); ++it)
+      {
+        it.Set(static_cast<PixelType>(it.Get() * factor));
+      }
+    },
+    nullptr);
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
+void
+DiffeomorphicDemonsRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::AllocateLikeOutput(
+  DisplacementFieldPointer & field)
+{
+  const DisplacementFieldType * output = this->GetOutput();
+  if (!field || field->GetBufferedRegion() != output->GetBufferedRegion())
+  {
+    field = DisplacementFieldType::New();
+    field->CopyInformation(output);
+    field->SetRequestedRegion(output->GetRequestedRegion());
+    field->SetBufferedRegion(output->GetBufferedRegion());
+    field->Allocate();
+  }
+  else
+  {
+    field->CopyInformation(output);
+    field->SetRequestedRegion(output->GetRequestedRegion());
+  }
+}
+
 template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
 void
 DiffeomorphicDemonsRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::PrintSelf(std::ostream & os,
@@ -180,34 +180,43 @@ FastSymmetricForcesDemonsRegistrationFilter<TFixedImage, TMovingImage, TDisplace
   const TimeStepType & dt)
 {
   // If we smooth the update buffer before applying it, then the are
-  // approximating a viscous problem as opposed to an elastic problem
-  if (this->GetSmoothUpdateField())
+  // approximating a viscous problem as opposed to an elastic problem.
+  // Unless a subclass may have overridden the smoothing, the last smoothing
+  // pass also applies the update.
+  if (this->GetSmoothUpdateField() && this->template CanFuseUpdateFieldSmoothing<Self>())
   {
-    this->SmoothUpdateField();
+    this->SmoothAndApplyUpdate(itk::Math::Absolute(dt - 1.0) > 1.0e-4 ? dt : 1.0);
   }
-
-  // use time step if necessary
-  if (itk::Math::Absolute(dt - 1.0) > 1.0e-4)
+  else
   {
-    itkDebugMacro("Using timestep: " << dt);
-    m_Multiplier->SetInput2(dt);
-    m_Multiplier->SetInput(this->GetUpdateBuffer());
-    m_Multiplier->GraftOutput(this->GetUpdateBuffer());
-    // in place update
-    m_Multiplier->Update();
-    // graft output back to this->GetUpdateBuffer()
-    this->GetUpdateBuffer()->Graft(m_Multiplier->GetOutput());
+    if (this->GetSmoothUpdateField())
+    {
+      this->SmoothUpdateField();
+    }
+
+    // use time step if necessary
+    if (itk::Math::Absolute(dt - 1.0) > 1.0e-4)
+    {
+      itkDebugMacro("Using timestep: " << dt);
+      m_Multiplier->SetInput2(dt);
+      m_Multiplier->SetInput(this->GetUpdateBuffer());
+      m_Multiplier->GraftOutput(this->GetUpdateBuffer());
+      // in place update
+      m_Multiplier->Update();
+      // graft output back to this->GetUpdateBuffer()
+      this->GetUpdateBuffer()->Graft(m_Multiplier->GetOutput());
+    }
+
+    m_Adder->SetInput1(this->GetOutput());
+    m_Adder->SetInput2(this->GetUpdateBuffer());
+
+    m_Adder->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+    m_Adder->Update();
+
+    // Region passing stuff
+    this->GraftOutput(m_Adder->GetOutput());
   }
 
-  m_Adder->SetInput1(this->GetOutput());
-  m_Adder->SetInput2(this->GetUpdateBuffer());
-
-  m_Adder->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
-  m_Adder->Update();
-
-  // Region passing stuff
-  this->GraftOutput(m_Adder->GetOutput());
-
   DemonsRegistrationFunctionType * drfp = this->DownCastDifferenceFunctionType();
 
   this->SetRMSChange(drfp->GetRMSChange());
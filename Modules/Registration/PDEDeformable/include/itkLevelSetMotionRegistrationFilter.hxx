@@ -223,13 +223,21 @@ void
 LevelSetMotionRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::ApplyUpdate(const TimeStepType & dt)
 {
   // If we smooth the update buffer before applying it, then the are
-  // approximating a viscous problem as opposed to an elastic problem
-  if (this->GetSmoothUpdateField())
+  // approximating a viscous problem as opposed to an elastic problem.
+  // Unless a subclass may have overridden the smoothing, the last smoothing
+  // pass also applies the update.
+  if (this->GetSmoothUpdateField() && this->template CanFuseUpdateFieldSmoothing<Self>())
   {
-    this->SmoothUpdateField();
+    this->SmoothAndApplyUpdate(dt);
+  }
+  else
+  {
+    if (this->GetSmoothUpdateField())
+    {
+      this->SmoothUpdateField();
+    }
+    this->Superclass::ApplyUpdate(dt);
   }
-
-  this->Superclass::ApplyUpdate(dt);
 
   auto * drfp = dynamic_cast<LevelSetMotionFunctionType *>(this->GetDifferenceFunction().GetPointer());
 
@@ -21,6 +21,8 @@
 #include "itkDenseFiniteDifferenceImageFilter.h"
 #include "itkPDEDeformableRegistrationFunction.h"
 
+#include <typeinfo>
+
 namespace itk
 {
 /**
@@ -54,10 +56,12 @@ namespace itk
  * of smoothing is governed by a set of user defined standard deviations
  * (one for each dimension).
  *
- * In terms of memory, this filter keeps two internal buffers: one for storing
- * the intermediate updates to the field and one for double-buffering when
- * smoothing the displacement field. Both buffers are the same type and size as the
- * output displacement field.
+ * In terms of memory, this filter keeps one internal buffer, for storing the
+ * intermediate updates to the field, of the same type and size as the output
+ * displacement field. The displacement and update fields are smoothed in
+ * place: the lines of the field along each dimension are convolved
+ * concurrently, each in a line buffer. When the update field is smoothed, its
+ * last smoothing pass also adds it to the displacement field.
  *
  * This class make use of the finite difference solver hierarchy. Update
  * for each iteration is computed using a PDEDeformableRegistrationFunction.
@@ -104,6 +108,7 @@ public:
 
   /** Types inherited from the superclass */
   using typename Superclass::OutputImageType;
+  using typename Superclass::TimeStepType;
 
   /** FiniteDifferenceFunction type. */
   using typename Superclass::FiniteDifferenceFunctionType;
@@ -250,16 +255,43 @@ protected:
 
   /** Utility to smooth the UpdateBuffer using a separable Gaussian kernel.
    * The amount of smoothing can be specified by setting the
-   * UpdateFieldStandardDeviations. */
+   * UpdateFieldStandardDeviations.
+   *
+   * The filters which fuse this smoothing with their next pass over the
+   * update field, see CanFuseUpdateFieldSmoothing(), still call it when a
+   * subclass may have overridden it. */
   virtual void
   SmoothUpdateField();
 
-  /** Release the memory of the internal buffers.
+  /** Smooth the field in place with a separable Gaussian kernel whose
+   * standard deviations are in pixel coordinates, one dimension after the
+   * other. The kernels are the GaussianOperator of MaximumError and
+   * MaximumKernelWidth, with zero-flux Neumann boundary conditions.
    *
-   * Called after the solution has been generated.
-   */
+   * When \c updatedField is given, the last pass also adds the smoothed field,
+   * times \c timeStep, to \c updatedField. Otherwise the last pass multiplies
+   * the smoothed field by \c timeStep. */
   void
-  PostProcessOutput() override;
+  SmoothFieldInPlace(DisplacementFieldType *        field,
+                     const StandardDeviationsType & standardDeviations,
+                     DisplacementFieldType *        updatedField = nullptr,
+                     TimeStepType                   timeStep = 1.0);
+
+  /** Smooth the UpdateBuffer, as SmoothUpdateField() does, and add it times
+   * the time step to the displacement field in the same pass. */
+  void
+  SmoothAndApplyUpdate(const TimeStepType & dt);
+
+  /** Whether this filter is exactly a \c TFilter, a filter which does not
+   * override SmoothUpdateField(), so that it may smooth the update field with
+   * SmoothFieldInPlace() fused with its next pass over the field. A subclass
+   * of \c TFilter may override SmoothUpdateField(), which is then called. */
+  template <typename TFilter>
+  bool
+  CanFuseUpdateFieldSmoothing() const
+  {
+    return typeid(*this) == typeid(TFilter);
+  }
 
   /** Initialize flags.
    *
@@ -293,10 +325,6 @@ private:
   bool m_SmoothDisplacementField{};
   bool m_SmoothUpdateField{};
 
-  /** Temporary displacement field use for smoothing the
-   * the displacement field. */
-  DisplacementFieldPointer m_TempField{};
-
 private:
   /** Maximum error for Gaussian operator approximation. */
   double m_MaximumError{};
@@ -20,13 +20,16 @@
 
 
 #include "itkImageRegionIterator.h"
+#include "itkImageLinearIteratorWithIndex.h"
 #include "itkDataObject.h"
 
 #include "itkGaussianOperator.h"
-#include "itkVectorNeighborhoodOperatorImageFilter.h"
 
 #include "itkMath.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace itk
 {
 
@@ -51,7 +54,6 @@ PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::
     m_UpdateFieldStandardDeviations[j] = 1.0;
   }
 
-  m_TempField = DisplacementFieldType::New();
   m_MaximumError = 0.1;
   m_MaximumKernelWidth = 30;
   m_StopRegistrationFlag = false;
@@ -116,8 +118,6 @@ PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::
   itkPrintSelfBooleanMacro(SmoothDisplacementField);
   itkPrintSelfBooleanMacro(SmoothUpdateField);
 
-  itkPrintSelfObjectMacro(TempField);
-
   os << indent << "MaximumError: " << m_MaximumError << std::endl;
   os << indent << "MaximumKernelWidth: " << m_MaximumKernelWidth << std::endl;
   itkPrintSelfBooleanMacro(StopRegistrationFlag);
@@ -239,125 +239,137 @@ PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::
 
 template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
 void
-PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::PostProcessOutput()
+PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::Initialize()
 {
-  this->Superclass::PostProcessOutput();
-  m_TempField->Initialize();
+  this->Superclass::Initialize();
+  m_StopRegistrationFlag = false;
 }
 
 template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
 void
-PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::Initialize()
+PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::SmoothDisplacementField()
 {
-  this->Superclass::Initialize();
-  m_StopRegistrationFlag = false;
+  this->SmoothFieldInPlace(this->GetOutput(), m_StandardDeviations);
+
+  // The smoothing changes the output buffer through iterators, which do not
+  // increment its timestamp.
+  this->GetOutput()->Modified();
 }
 
 template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
 void
-PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::SmoothDisplacementField()
+PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::SmoothUpdateField()
 {
-  const DisplacementFieldPointer field = this->GetOutput();
+  // The update buffer will be overwritten with new data.
+  this->SmoothFieldInPlace(this->GetUpdateBuffer(), this->GetUpdateFieldStandardDeviations());
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
+void
+PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::SmoothAndApplyUpdate(
+  const TimeStepType & dt)
+{
+  this->SmoothFieldInPlace(this->GetUpdateBuffer(), this->GetUpdateFieldStandardDeviations(), this->GetOutput(), dt);
 
-  // copy field to TempField
-  m_TempField->SetOrigin(field->GetOrigin());
-  m_TempField->SetSpacing(field->GetSpacing());
-  m_TempField->SetDirection(field->GetDirection());
-  m_TempField->SetLargestPossibleRegion(field->GetLargestPossibleRegion());
-  m_TempField->SetRequestedRegion(field->GetRequestedRegion());
-  m_TempField->SetBufferedRegion(field->GetBufferedRegion());
-  m_TempField->Allocate();
+  // Explicitly call Modified on GetOutput here, as
+  // DenseFiniteDifferenceImageFilter::ApplyUpdate() does.
+  this->GetOutput()->Modified();
+}
 
+template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
+void
+PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::SmoothFieldInPlace(
+  DisplacementFieldType *        field,
+  const StandardDeviationsType & standardDeviations,
+  DisplacementFieldType *        updatedField,
+  TimeStepType                   timeStep)
+{
   using VectorType = typename DisplacementFieldType::PixelType;
   using ScalarType = typename VectorType::ValueType;
   using OperatorType = GaussianOperator<ScalarType, ImageDimension>;
-  using SmootherType = VectorNeighborhoodOperatorImageFilter<DisplacementFieldType, DisplacementFieldType>;
+  using RegionType = typename DisplacementFieldType::RegionType;
+  using IteratorType = ImageLinearIteratorWithIndex<DisplacementFieldType>;
 
-  OperatorType oper;
-  auto         smoother = SmootherType::New();
-
-  using PixelContainerPointer = typename DisplacementFieldType::PixelContainerPointer;
-  PixelContainerPointer swapPtr;
+  const RegionType region = field->GetBufferedRegion();
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
 
-  // graft the output field onto the mini-pipeline
-  smoother->GraftOutput(m_TempField);
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   for (unsigned int j = 0; j < ImageDimension; ++j)
   {
     // smooth along this dimension
+    OperatorType oper;
     oper.SetDirection(j);
-    const double variance = itk::Math::sqr(m_StandardDeviations[j]);
+    const double variance = itk::Math::sqr(standardDeviations[j]);
     oper.SetVariance(variance);
     oper.SetMaximumError(m_MaximumError);
     oper.SetMaximumKernelWidth(m_MaximumKernelWidth);
     oper.CreateDirectional();
 
-    // todo: make sure we only smooth within the buffered region
-    smoother->SetOperator(oper);
-    smoother->SetInput(field);
-    smoother->Update();
-
-    if (j + 1 < ImageDimension)
-    {
-      // swap the containers
-      swapPtr = smoother->GetOutput()->GetPixelContainer();
-      smoother->GraftOutput(field);
-      field->SetPixelContainer(swapPtr);
-      smoother->Modified();
-    }
+    const std::vector<ScalarType> coefficients(oper.Begin(), oper.End());
+    const SizeValueType           radius = oper.GetRadius(j);
+    const SizeValueType           lineLength = region.GetSize(j);
+    const bool                    applyUpdate = (updatedField != nullptr && j + 1 == ImageDimension);
+    const bool                    scale = (updatedField == nullptr && j + 1 == ImageDimension && timeStep != 1.0);
+
+    // The lines along this dimension are independent: each work unit smooths
+    // whole lines, in a line buffer, and writes them back in place.
+    this->GetMultiThreader()->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+      j,
+      region,
+      [&](const RegionType & lambdaRegion) {
+        IteratorType it(field, lambdaRegion);
+        IteratorType updatedIt(applyUpdate ? updatedField : field, lambdaRegion);
+        it.SetDirection(j);
+        updatedIt.SetDirection(j);
+
+        std::vector<VectorType> line(lineLength + 2 * radius);
+        for (; !it.IsAtEnd(); it.NextLine(), updatedIt.NextLine())
+        {
+          // Extend the line with its end values, as the zero flux Neumann
+          // boundary condition does.
+          for (auto lineIt = line.begin() + radius; !it.IsAtEndOfLine(); ++it, ++lineIt)
+          {
+            *lineIt = it.Get();
+          }
+          std::fill(line.begin(), line.begin() + radius, line[radius]);
+          std::fill(line.end() - radius, line.end(), line[radius + lineLength - 1]);
+
+          // The inner product of VectorNeighborhoodOperatorImageFilter.
+          it.GoToBeginOfLine();
+          for (SizeValueType i = 0; i < lineLength; ++i, ++it)
+          {
+            VectorType sum{};
+            for (SizeValueType k = 0; k < coefficients.size(); ++k)
+            {
+              const VectorType & neighborPixel = line[i + k];
+              for (unsigned int c = 0; c < VectorType::Dimension; ++c)
+              {
+                sum[c] += coefficients[k] * neighborPixel[c];
+              }
+            }
+            if (applyUpdate)
+            {
+              it.Set(sum);
+              updatedIt.Value() += static_cast<VectorType>(sum * timeStep);
+              ++updatedIt;
+            }
+            else if (scale)
+            {
+              it.Set(static_cast<VectorType>(sum * timeStep));
+            }
+            else
+            {
+              it.Set(sum);
+            }
+          }
+        }
+      },
+      nullptr);
   }
-
-  // graft the output back to this filter
-  m_TempField->SetPixelContainer(field->GetPixelContainer());
-  this->GraftOutput(smoother->GetOutput());
-}
-
-template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
-void
-PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::SmoothUpdateField()
-{
-  // The update buffer will be overwritten with new data.
-  const DisplacementFieldPointer field = this->GetUpdateBuffer();
-
-  using VectorType = typename DisplacementFieldType::PixelType;
-  using ScalarType = typename VectorType::ValueType;
-  using OperatorType = GaussianOperator<ScalarType, ImageDimension>;
-  using SmootherType = VectorNeighborhoodOperatorImageFilter<DisplacementFieldType, DisplacementFieldType>;
-
-  OperatorType                   opers[ImageDimension];
-  typename SmootherType::Pointer smoothers[ImageDimension];
-
-  for (unsigned int j = 0; j < ImageDimension; ++j)
-  {
-    // smooth along this dimension
-    opers[j].SetDirection(j);
-    const double variance = itk::Math::sqr(this->GetUpdateFieldStandardDeviations()[j]);
-    // double variance = itk::Math::sqr( 1.0 );
-    opers[j].SetVariance(variance);
-    opers[j].SetMaximumError(this->GetMaximumError());
-    opers[j].SetMaximumKernelWidth(this->GetMaximumKernelWidth());
-    opers[j].CreateDirectional();
-
-    smoothers[j] = SmootherType::New();
-    smoothers[j]->SetOperator(opers[j]);
-    smoothers[j]->ReleaseDataFlagOn();
-
-    if (j > 0)
-    {
-      smoothers[j]->SetInput(smoothers[j - 1]->GetOutput());
-    }
-  }
-  smoothers[0]->SetInput(field);
-  smoothers[ImageDimension - 1]->GetOutput()->SetRequestedRegion(field->GetBufferedRegion());
-
-  smoothers[ImageDimension - 1]->Update();
-
-  // field to contain the final smoothed data, do the equivalent of a graft
-  field->SetPixelContainer(smoothers[ImageDimension - 1]->GetOutput()->GetPixelContainer());
-  field->SetRequestedRegion(smoothers[ImageDimension - 1]->GetOutput()->GetRequestedRegion());
-  field->SetBufferedRegion(smoothers[ImageDimension - 1]->GetOutput()->GetBufferedRegion());
-  field->SetLargestPossibleRegion(smoothers[ImageDimension - 1]->GetOutput()->GetLargestPossibleRegion());
-  field->CopyInformation(smoothers[ImageDimension - 1]->GetOutput());
 }
 } // end namespace itk
 
@@ -0,0 +1,262 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDemonsRegistrationFilter.h"
+#include "itkDiffeomorphicDemonsRegistrationFilter.h"
+#include "itkFastSymmetricForcesDemonsRegistrationFilter.h"
+#include "itkLevelSetMotionRegistrationFilter.h"
+#include "itkSymmetricForcesDemonsRegistrationFilter.h"
+#include "itkGaussianOperator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkVectorNeighborhoodOperatorImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+/* Verify that the in place smoothing of the displacement and update fields of
+ * PDEDeformableRegistrationFilter computes the same fields as the pipeline of
+ * VectorNeighborhoodOperatorImageFilter, and that the last smoothing pass
+ * applies the update as DenseFiniteDifferenceImageFilter::ApplyUpdate() does.
+ * The registration filters which fuse the smoothing of the update field still
+ * call SmoothUpdateField() when a subclass overrides it. */
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<float, Dimension>;
+using VectorType = itk::Vector<float, Dimension>;
+using FieldType = itk::Image<VectorType, Dimension>;
+
+// Expose the smoothing of the filter.
+class SmoothingFilter : public itk::DemonsRegistrationFilter<ImageType, ImageType, FieldType>
+{
+public:
+  using Self = SmoothingFilter;
+  using Superclass = itk::DemonsRegistrationFilter<ImageType, ImageType, FieldType>;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+
+  using Superclass::SmoothFieldInPlace;
+};
+
+// Count the smoothings of the update field, which a subclass may change by overriding SmoothUpdateField().
+template <typename TFilter>
+class CountingFilter : public TFilter
+{
+public:
+  using Self = CountingFilter;
+  using Superclass = TFilter;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+
+  unsigned int m_NumberOfUpdateSmoothings{ 0 };
+
+protected:
+  void
+  SmoothUpdateField() override
+  {
+    ++m_NumberOfUpdateSmoothings;
+    Superclass::SmoothUpdateField();
+  }
+};
+
+FieldType::Pointer
+MakeField(const FieldType::RegionType & region, const double phase)
+{
+  auto field = FieldType::New();
+  field->SetRegions(region);
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<FieldType> it(field, region); !it.IsAtEnd(); ++it)
+  {
+    const FieldType::IndexType index = it.GetIndex();
+    VectorType                 vector;
+    for (unsigned int c = 0; c < Dimension; ++c)
+    {
+      vector[c] = std::sin(0.3 * index[0] + 0.7 * c + phase) * std::cos(0.2 * index[1] - 0.4 * index[2]) + 0.05 * c;
+    }
+    it.Set(vector);
+  }
+  return field;
+}
+
+// Smooth the field with the pipeline of VectorNeighborhoodOperatorImageFilter.
+FieldType::Pointer
+SmoothField(FieldType * field, const SmoothingFilter::StandardDeviationsType & standardDeviations)
+{
+  using SmootherType = itk::VectorNeighborhoodOperatorImageFilter<FieldType, FieldType>;
+
+  FieldType::Pointer smoothed = field;
+  for (unsigned int j = 0; j < Dimension; ++j)
+  {
+    itk::GaussianOperator<float, Dimension> oper;
+    oper.SetDirection(j);
+    oper.SetVariance(standardDeviations[j] * standardDeviations[j]);
+    oper.SetMaximumError(0.1);
+    oper.SetMaximumKernelWidth(30);
+    oper.CreateDirectional();
+
+    auto smoother = SmootherType::New();
+    smoother->SetOperator(oper);
+    smoother->SetInput(smoothed);
+    smoother->Update();
+    smoothed = smoother->GetOutput();
+    smoothed->DisconnectPipeline();
+  }
+  return smoothed;
+}
+
+bool
+AreEqual(FieldType * field, FieldType * expectedField)
+{
+  itk::ImageRegionConstIterator<FieldType> it(field, field->GetBufferedRegion());
+  itk::ImageRegionConstIterator<FieldType> expectedIt(expectedField, field->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it, ++expectedIt)
+  {
+    for (unsigned int c = 0; c < Dimension; ++c)
+    {
+      if (std::abs(it.Get()[c] - expectedIt.Get()[c]) > 1e-6)
+      {
+        std::cerr << "Expected " << expectedIt.Get() << " at " << it.GetIndex() << ", but got " << it.Get()
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+ImageType::Pointer
+MakeImage(const double shift)
+{
+  auto image = ImageType::New();
+  image->SetRegions(itk::MakeSize(16, 16, 8));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(std::sin(0.4 * (it.GetIndex()[0] - shift)) + std::cos(0.3 * it.GetIndex()[1]));
+  }
+  return image;
+}
+
+// A subclass which overrides SmoothUpdateField() has it called at each iteration, and by calling the one of the
+// filter, registers the images as the filter does, which fuses the smoothing with the next pass over the update.
+template <typename TFilter>
+bool
+CheckUpdateFieldSmoothingOverride()
+{
+  const auto fixedImage = MakeImage(0.0);
+  const auto movingImage = MakeImage(1.0);
+  const auto filter = TFilter::New();
+  const auto countingFilter = CountingFilter<TFilter>::New();
+  for (TFilter * f : { filter.GetPointer(), static_cast<TFilter *>(countingFilter.GetPointer()) })
+  {
+    f->SetFixedImage(fixedImage);
+    f->SetMovingImage(movingImage);
+    f->SetNumberOfIterations(3);
+    f->SmoothUpdateFieldOn();
+    f->SetUpdateFieldStandardDeviations(1.5);
+    f->Update();
+  }
+  std::cout << filter->GetNameOfClass() << ": " << countingFilter->m_NumberOfUpdateSmoothings << " smoothings of "
+            << countingFilter->GetElapsedIterations() << " iterations" << std::endl;
+  return countingFilter->m_NumberOfUpdateSmoothings == countingFilter->GetElapsedIterations() &&
+         countingFilter->m_NumberOfUpdateSmoothings > 0 &&
+         AreEqual(countingFilter->GetOutput(), filter->GetOutput());
+}
+} // namespace
+
+int
+itkPDEDeformableRegistrationFilterSmoothingTest(int, char *[])
+{
+  FieldType::RegionType region;
+  region.SetIndex(itk::MakeIndex(-2, 3, 1));
+  region.SetSize(itk::MakeSize(23, 17, 9));
+
+  auto filter = SmoothingFilter::New();
+  filter->SetNumberOfWorkUnits(4);
+
+  bool pass = true;
+
+  // Standard deviations with kernels larger than the field, and without smoothing along an axis.
+  const SmoothingFilter::StandardDeviationsType standardDeviations = itk::MakeFilled<
+    SmoothingFilter::StandardDeviationsType>(1.5);
+  SmoothingFilter::StandardDeviationsType anisotropicStandardDeviations;
+  anisotropicStandardDeviations[0] = 0.5;
+  anisotropicStandardDeviations[1] = 3.0;
+  anisotropicStandardDeviations[2] = 0.0;
+
+  for (const auto & sigmas : { standardDeviations, anisotropicStandardDeviations })
+  {
+    std::cout << "StandardDeviations: " << sigmas << std::endl;
+
+    const FieldType::Pointer field = MakeField(region, 0.0);
+    const FieldType::Pointer expectedField = SmoothField(field, sigmas);
+    filter->SmoothFieldInPlace(field, sigmas);
+    pass &= AreEqual(field, expectedField);
+
+    // Smooth the update and apply it to the displacement field.
+    const FieldType::Pointer update = MakeField(region, 1.0);
+    const FieldType::Pointer displacement = MakeField(region, 2.0);
+    const FieldType::Pointer expectedDisplacement = MakeField(region, 2.0);
+    const FieldType::Pointer expectedUpdate = SmoothField(update, sigmas);
+    constexpr double         timeStep = 0.75;
+    itk::ImageRegionIterator<FieldType> displacementIt(expectedDisplacement, region);
+    itk::ImageRegionConstIterator<FieldType> updateIt(expectedUpdate, region);
+    for (; !displacementIt.IsAtEnd(); ++displacementIt, ++updateIt)
+    {
+      displacementIt.Value() += static_cast<VectorType>(updateIt.Get() * timeStep);
+    }
+
+    filter->SmoothFieldInPlace(update, sigmas, displacement, timeStep);
+    pass &= AreEqual(update, expectedUpdate);
+    pass &= AreEqual(displacement, expectedDisplacement);
+  }
+
+  // The last smoothing pass may also scale the field.
+  {
+    const FieldType::Pointer field = MakeField(region, 3.0);
+    const FieldType::Pointer expectedField = SmoothField(field, standardDeviations);
+    constexpr double         factor = 0.125;
+    for (itk::ImageRegionIterator<FieldType> it(expectedField, region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(static_cast<VectorType>(it.Get() * factor));
+    }
+    filter->SmoothFieldInPlace(field, standardDeviations, nullptr, factor);
+    pass &= AreEqual(field, expectedField);
+  }
+
+  using DemonsFilterType = itk::DemonsRegistrationFilter<ImageType, ImageType, FieldType>;
+  using SymmetricForcesFilterType = itk::SymmetricForcesDemonsRegistrationFilter<ImageType, ImageType, FieldType>;
+  using LevelSetMotionFilterType = itk::LevelSetMotionRegistrationFilter<ImageType, ImageType, FieldType>;
+  using FastSymmetricForcesFilterType =
+    itk::FastSymmetricForcesDemonsRegistrationFilter<ImageType, ImageType, FieldType>;
+  using DiffeomorphicFilterType = itk::DiffeomorphicDemonsRegistrationFilter<ImageType, ImageType, FieldType>;
+  pass &= CheckUpdateFieldSmoothingOverride<DemonsFilterType>();
+  pass &= CheckUpdateFieldSmoothingOverride<SymmetricForcesFilterType>();
+  pass &= CheckUpdateFieldSmoothingOverride<LevelSetMotionFilterType>();
+  pass &= CheckUpdateFieldSmoothingOverride<FastSymmetricForcesFilterType>();
+  pass &= CheckUpdateFieldSmoothingOverride<DiffeomorphicFilterType>();
+
+  if (!pass)
+  {
+    std::cerr << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
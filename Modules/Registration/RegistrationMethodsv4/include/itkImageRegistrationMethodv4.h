@@ -28,6 +28,7 @@
 #include "itkImageToImageMetricv4.h"
 #include "itkPointSetToPointSetMetricWithIndexv4.h"
 #include "itkShrinkImageFilter.h"
+#include "itkSmoothedImageCache.h"
 #include "itkIdentityTransform.h"
 #include "itkTransformParametersAdaptorBase.h"
 #include "ITKRegistrationMethodsv4Export.h"
@@ -47,12 +48,22 @@ public:
    * \class MetricSamplingStrategy
    * \ingroup ITKRegistrationMethodsv4
    * \brief enum type for metric sampling strategy
+   *
+   * NONE uses every point of the virtual domain. REGULAR takes every n-th
+   * voxel, and RANDOM voxels drawn uniformly. STRATIFIED divides the
+   * virtual domain into cells of 1 / percentage voxels, and draws one point
+   * uniformly within each cell, which covers the domain as evenly as
+   * REGULAR without aliasing with the image structures. GRADIENT_IMPORTANCE
+   * draws voxels with a probability proportional to the gradient magnitude
+   * of the fixed image, where the metric derivative is large.
    */
   enum class MetricSamplingStrategy : uint8_t
   {
     NONE,
     REGULAR,
-    RANDOM
+    RANDOM,
+    STRATIFIED,
+    GRADIENT_IMPORTANCE
   };
 };
 // Define how to print enumeration
@@ -197,6 +208,8 @@ public:
   using ShrinkFactorsArrayType = Array<SizeValueType>;
 
   using SmoothingSigmasArrayType = Array<RealType>;
+  using FixedImageSmoothingCacheType = SmoothedImageCache<FixedImageType>;
+  using MovingImageSmoothingCacheType = SmoothedImageCache<MovingImageType>;
   using MetricSamplingPercentageArrayType = Array<RealType>;
 
   /** Transform adaptor type alias */
@@ -352,6 +365,31 @@ public:
   itkGetConstMacro(MetricSamplingPercentagePerLevel, MetricSamplingPercentageArrayType);
   /** @ITKEndGrouping */
 
+  /** Set/Get whether the sampling percentage of each level is adapted to
+   * the variance of the metric. Before optimizing a level, the metric is
+   * evaluated on a few independent sample sets of the percentage of the
+   * level. As the standard error of the metric value decreases with the
+   * square root of the number of samples, the percentage is then scaled so
+   * that the relative standard error of the metric value is
+   * MetricSamplingRelativeStandardError, between a tenth of the percentage
+   * of the level and 1. Off by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseAdaptiveMetricSamplingPercentage, bool);
+  itkGetConstMacro(UseAdaptiveMetricSamplingPercentage, bool);
+  itkBooleanMacro(UseAdaptiveMetricSamplingPercentage);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the relative standard error of the metric value targeted by
+   * the adaptive sampling percentage. Defaults to 0.01. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(MetricSamplingRelativeStandardError, RealType, NumericTraits<RealType>::epsilon(), 1.0);
+  itkGetConstMacro(MetricSamplingRelativeStandardError, RealType);
+  /** @ITKEndGrouping */
+
+  /** Get the sampling percentage used at the current level, which differs
+   * from the one of the level when it is adaptive. */
+  itkGetConstMacro(CurrentMetricSamplingPercentage, RealType);
+
   /** Set/Get the initial fixed transform. */
   itkSetGetDecoratedObjectInputMacro(FixedInitialTransform, InitialTransformType);
 
@@ -460,6 +498,34 @@ public:
   itkBooleanMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits);
   /** @ITKEndGrouping */
 
+  /**
+   * Set/Get the caches of the smoothed fixed and moving images. By default,
+   * the images are smoothed at the beginning of each level. Given a cache,
+   * an image is smoothed once per level, and its smoothed images are reused
+   * by the next runs of the registration. Several registration methods may
+   * share a cache, e.g. the fixed image cache of the registrations of a
+   * cohort to an atlas, which then smooth the atlas once for the whole cohort.
+   */
+  /** @ITKStartGrouping */
+  itkSetObjectMacro(FixedImageSmoothingCache, FixedImageSmoothingCacheType);
+  itkGetModifiableObjectMacro(FixedImageSmoothingCache, FixedImageSmoothingCacheType);
+  itkSetObjectMacro(MovingImageSmoothingCache, MovingImageSmoothingCacheType);
+  itkGetModifiableObjectMacro(MovingImageSmoothingCache, MovingImageSmoothingCacheType);
+  /** @ITKEndGrouping */
+
+  /**
+   * Set/Get whether to smooth the images of all the levels on background
+   * tasks at the beginning of the registration, so that the smoothed images
+   * of the next levels are ready when the optimization of the current level
+   * ends. The smoothed images are kept in the smoothing caches, which the
+   * registration creates when they are not set. Default is false.
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(PrecomputeSmoothedImages, bool);
+  itkGetConstMacro(PrecomputeSmoothedImages, bool);
+  itkBooleanMacro(PrecomputeSmoothedImages);
+  /** @ITKEndGrouping */
+
   /** Make a DataObject of the correct type to be used as the specified output. */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
   using Superclass::MakeOutput;
@@ -560,10 +626,27 @@ protected:
   virtual VirtualImageBaseConstPointer
   GetCurrentLevelVirtualDomainImage();
 
+  /** Smooth the image of the level, taking it from the cache when the cache
+   * is not null. */
+  template <typename TImage>
+  typename TImage::ConstPointer
+  SmoothImage(const TImage * image, const SizeValueType level, SmoothedImageCache<TImage> * cache) const;
+
+  /** Sigmas of the smoothing of the image at the level, in physical units. */
+  template <typename TImage>
+  typename SmoothedImageCache<TImage>::SigmaArrayType
+  GetSmoothingSigmaArray(const TImage * image, const SizeValueType level) const;
+
   /** Set the metric sample points. */
   virtual void
   SetMetricSamplePoints();
 
+  /** Draw sample points in the requested region of the virtual domain of the
+   * image metric \c metric, within its fixed mask, with the current sampling
+   * strategy. */
+  virtual typename MetricSamplePointSetType::Pointer
+  SampleVirtualDomain(const ImageMetricType * metric, const RealType samplingPercentage);
+
   SizeValueType m_CurrentLevel{};
   SizeValueType m_NumberOfLevels{ 0 };
   SizeValueType m_CurrentIteration{};
@@ -588,11 +671,19 @@ protected:
   MetricPointer                                       m_Metric{};
   MetricSamplingStrategyEnum                          m_MetricSamplingStrategy{};
   MetricSamplingPercentageArrayType                   m_MetricSamplingPercentagePerLevel{};
+  bool                                                m_UseAdaptiveMetricSamplingPercentage{ false };
+  RealType                                            m_MetricSamplingRelativeStandardError{ 0.01 };
+  RealType                                            m_CurrentMetricSamplingPercentage{ 1.0 };
+  std::vector<float>                                  m_GradientImportanceWeights{};
+  SizeValueType                                       m_NumberOfGradientImportanceWeightedVoxels{};
   SizeValueType                                       m_NumberOfMetrics{};
   int                                                 m_FirstImageMetricIndex{};
   std::vector<ShrinkFactorsPerDimensionContainerType> m_ShrinkFactorsPerLevel{};
   SmoothingSigmasArrayType                            m_SmoothingSigmasPerLevel{};
   bool                                                m_SmoothingSigmasAreSpecifiedInPhysicalUnits{};
+  typename FixedImageSmoothingCacheType::Pointer      m_FixedImageSmoothingCache{};
+  typename MovingImageSmoothingCacheType::Pointer     m_MovingImageSmoothingCache{};
+  bool                                                m_PrecomputeSmoothedImages{ false };
 
   bool m_ReseedIterator{};
   int  m_RandomSeed{};
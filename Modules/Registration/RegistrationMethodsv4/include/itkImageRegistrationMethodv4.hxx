@@ -20,16 +20,23 @@
 
 
 #include "itkSmoothingRecursiveGaussianImageFilter.h"
+#include "itkCentralDifferenceImageFunction.h"
 #include "itkGradientDescentOptimizerv4.h"
 #include "itkImageRandomConstIteratorWithIndex.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageToImageMetricv4.h"
+#include "itkIndexRange.h"
 #include "itkIterationReporter.h"
 #include "itkMattesMutualInformationImageToImageMetricv4.h"
 #include "itkMersenneTwisterRandomVariateGenerator.h"
 #include "itkRegistrationParameterScalesFromPhysicalShift.h"
 #include "itkPrintHelper.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <type_traits>
+
 namespace itk
 {
 
@@ -567,6 +574,46 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   // Although this isn't necessary, we want to leave the option for
   // changing the point sets per level.
 
+  const auto isImageMetric = [this, &multiMetric](const SizeValueType n) {
+    return this->m_Metric->GetMetricCategory() == ObjectToObjectMetricBaseTemplateEnums::MetricCategory::IMAGE_METRIC ||
+           (this->m_Metric->GetMetricCategory() ==
+              ObjectToObjectMetricBaseTemplateEnums::MetricCategory::MULTI_METRIC &&
+            multiMetric->GetMetricQueue()[n]->GetMetricCategory() ==
+              ObjectToObjectMetricBaseTemplateEnums::MetricCategory::IMAGE_METRIC);
+  };
+
+  // Start smoothing the images of all the levels, while the first levels optimize.
+
+  if (level == 0 && this->m_PrecomputeSmoothedImages)
+  {
+    if (this->m_FixedImageSmoothingCache.IsNull())
+    {
+      this->m_FixedImageSmoothingCache = FixedImageSmoothingCacheType::New();
+    }
+    if (this->m_MovingImageSmoothingCache.IsNull())
+    {
+      this->m_MovingImageSmoothingCache = MovingImageSmoothingCacheType::New();
+    }
+
+    for (SizeValueType l = 0; l < this->m_NumberOfLevels; ++l)
+    {
+      if (this->m_SmoothingSigmasPerLevel[l] <= 0)
+      {
+        continue;
+      }
+      for (SizeValueType n = 0; n < this->m_NumberOfMetrics; ++n)
+      {
+        if (isImageMetric(n))
+        {
+          this->m_FixedImageSmoothingCache->Prefetch(this->GetFixedImage(n),
+                                                     this->GetSmoothingSigmaArray(this->GetFixedImage(n), l));
+          this->m_MovingImageSmoothingCache->Prefetch(this->GetMovingImage(n),
+                                                      this->GetSmoothingSigmaArray(this->GetMovingImage(n), l));
+        }
+      }
+    }
+  }
+
   this->m_FixedSmoothImages.clear();
   this->m_FixedSmoothImages.resize(this->m_NumberOfMetrics);
   this->m_MovingSmoothImages.clear();
@@ -583,58 +630,12 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
     this->m_FixedPointSets[n] = nullptr;
     this->m_MovingPointSets[n] = nullptr;
 
-    if (this->m_Metric->GetMetricCategory() == ObjectToObjectMetricBaseTemplateEnums::MetricCategory::IMAGE_METRIC ||
-        (this->m_Metric->GetMetricCategory() == ObjectToObjectMetricBaseTemplateEnums::MetricCategory::MULTI_METRIC &&
-         multiMetric->GetMetricQueue()[n]->GetMetricCategory() ==
-           ObjectToObjectMetricBaseTemplateEnums::MetricCategory::IMAGE_METRIC))
+    if (isImageMetric(n))
     {
-      if (this->m_SmoothingSigmasPerLevel[level] > 0)
-      {
-        using FixedImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<FixedImageType, FixedImageType>;
-        auto fixedImageSmoothingFilter = FixedImageSmoothingFilterType::New();
-        typename FixedImageSmoothingFilterType::SigmaArrayType fixedImageSigmaArray(
-          this->m_SmoothingSigmasPerLevel[level]);
-
-        if (!this->m_SmoothingSigmasAreSpecifiedInPhysicalUnits)
-        {
-          auto & fixedSpacing = this->GetFixedImage(n)->GetSpacing();
-          for (unsigned int i = 0; i < fixedImageSigmaArray.Size(); ++i)
-          {
-            fixedImageSigmaArray[i] *= fixedSpacing[i];
-          }
-        }
-        fixedImageSmoothingFilter->SetSigmaArray(fixedImageSigmaArray);
-        fixedImageSmoothingFilter->SetInput(this->GetFixedImage(n));
-
-        this->m_FixedSmoothImages[n] = fixedImageSmoothingFilter->GetOutput();
-        fixedImageSmoothingFilter->Update();
-        fixedImageSmoothingFilter->GetOutput()->DisconnectPipeline();
-
-        using MovingImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<MovingImageType, MovingImageType>;
-        auto movingImageSmoothingFilter = MovingImageSmoothingFilterType::New();
-        typename MovingImageSmoothingFilterType::SigmaArrayType movingImageSigmaArray(
-          this->m_SmoothingSigmasPerLevel[level]);
-
-        if (!this->m_SmoothingSigmasAreSpecifiedInPhysicalUnits)
-        {
-          auto & movingSpacing = this->GetMovingImage(n)->GetSpacing();
-          for (unsigned int i = 0; i < movingImageSigmaArray.Size(); ++i)
-          {
-            movingImageSigmaArray[i] *= movingSpacing[i];
-          }
-        }
-        movingImageSmoothingFilter->SetSigmaArray(movingImageSigmaArray);
-        movingImageSmoothingFilter->SetInput(this->GetMovingImage(n));
-
-        this->m_MovingSmoothImages[n] = movingImageSmoothingFilter->GetOutput();
-        movingImageSmoothingFilter->Update();
-        movingImageSmoothingFilter->GetOutput()->DisconnectPipeline();
-      }
-      else
-      {
-        this->m_MovingSmoothImages[n] = this->GetMovingImage(n);
-        this->m_FixedSmoothImages[n] = this->GetFixedImage(n);
-      }
+      this->m_FixedSmoothImages[n] =
+        this->SmoothImage(this->GetFixedImage(n), level, this->m_FixedImageSmoothingCache.GetPointer());
+      this->m_MovingSmoothImages[n] =
+        this->SmoothImage(this->GetMovingImage(n), level, this->m_MovingImageSmoothingCache.GetPointer());
 
       // Update the image metric
 
@@ -865,162 +866,325 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
 }
 
 template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
-void
-ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::SetMetricSamplePoints()
+template <typename TImage>
+typename TImage::ConstPointer
+ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::SmoothImage(
+  const TImage *               image,
+  const SizeValueType          level,
+  SmoothedImageCache<TImage> * cache) const
 {
-  using VirtualDomainImageType = typename ImageMetricType::VirtualImageType;
-  using VirtualDomainRegionType = typename VirtualDomainImageType::RegionType;
+  if (this->m_SmoothingSigmasPerLevel[level] <= 0)
+  {
+    return image;
+  }
 
-  const VirtualDomainImageType * virtualImage = nullptr;
-  const FixedImageMaskType *     fixedMaskImage = nullptr;
+  const typename SmoothedImageCache<TImage>::SigmaArrayType sigmas = this->GetSmoothingSigmaArray(image, level);
+  if (cache != nullptr)
+  {
+    return cache->GetSmoothedImage(image, sigmas);
+  }
+  return SmoothedImageCache<TImage>::ComputeSmoothedImage(image, sigmas);
+}
 
-  SizeValueType numberOfLocalMetrics = 1;
+template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
+template <typename TImage>
+typename SmoothedImageCache<TImage>::SigmaArrayType
+ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::GetSmoothingSigmaArray(
+  const TImage *      image,
+  const SizeValueType level) const
+{
+  typename SmoothedImageCache<TImage>::SigmaArrayType sigmas(this->m_SmoothingSigmasPerLevel[level]);
+
+  if (!this->m_SmoothingSigmasAreSpecifiedInPhysicalUnits)
+  {
+    const auto & spacing = image->GetSpacing();
+    for (unsigned int i = 0; i < sigmas.Size(); ++i)
+    {
+      sigmas[i] *= spacing[i];
+    }
+  }
+  return sigmas;
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
+void
+ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::SetMetricSamplePoints()
+{
+  std::vector<ImageMetricType *> imageMetrics;
 
   const typename MultiMetricType::Pointer multiMetric = dynamic_cast<MultiMetricType *>(this->m_Metric.GetPointer());
   if (multiMetric)
   {
-    numberOfLocalMetrics = multiMetric->GetNumberOfMetrics();
-    if (numberOfLocalMetrics < 1)
+    if (multiMetric->GetNumberOfMetrics() < 1)
     {
       itkExceptionStringMacro("Input multi metric should have at least one metric component.");
     }
-    else
+    for (SizeValueType n = 0; n < multiMetric->GetNumberOfMetrics(); ++n)
     {
-      const typename ImageMetricType::Pointer firstMetric =
-        dynamic_cast<ImageMetricType *>(multiMetric->GetMetricQueue()[0].GetPointer());
-      if (firstMetric.IsNotNull())
-      {
-        virtualImage = firstMetric->GetVirtualImage();
-        fixedMaskImage = firstMetric->GetFixedImageMask();
-      }
-      else
-      {
-        itkExceptionStringMacro("Invalid metric conversion.");
-      }
+      imageMetrics.push_back(dynamic_cast<ImageMetricType *>(multiMetric->GetMetricQueue()[n].GetPointer()));
     }
   }
   else
   {
-    const typename ImageMetricType::Pointer singleMetric = dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer());
-    if (singleMetric.IsNotNull())
+    imageMetrics.push_back(dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer()));
+  }
+  for (const ImageMetricType * imageMetric : imageMetrics)
+  {
+    if (imageMetric == nullptr)
     {
-      virtualImage = singleMetric->GetVirtualImage();
-      fixedMaskImage = singleMetric->GetFixedImageMask();
+      itkExceptionStringMacro("Invalid metric conversion.");
     }
-    else
+  }
+
+  // The points of every metric are sampled within the virtual domain and the fixed mask of the first metric.
+  const auto setSamplePoints = [this, &imageMetrics](const RealType samplingPercentage) {
+    for (ImageMetricType * imageMetric : imageMetrics)
     {
-      itkExceptionStringMacro("Invalid metric conversion.");
+      imageMetric->SetVirtualSampledPointSet(this->SampleVirtualDomain(imageMetrics.front(), samplingPercentage));
+      imageMetric->UseSampledPointSetOn();
+      imageMetric->UseVirtualSampledPointSetOn();
     }
+  };
+
+  // The gradient importance weights of the previous level are not valid anymore.
+  m_GradientImportanceWeights.clear();
+  m_GradientImportanceWeights.shrink_to_fit();
+
+  const RealType levelSamplingPercentage = this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel];
+  this->m_CurrentMetricSamplingPercentage = levelSamplingPercentage;
+
+  if (this->m_UseAdaptiveMetricSamplingPercentage)
+  {
+    // Estimate the standard error of the metric value from its values over independent sample sets.
+    constexpr unsigned int numberOfSampleSets = 4;
+    std::vector<RealType>  values;
+    for (unsigned int i = 0; i < numberOfSampleSets; ++i)
+    {
+      setSamplePoints(levelSamplingPercentage);
+      this->m_Metric->Initialize();
+      values.push_back(this->m_Metric->GetValue());
+    }
+    const RealType mean = std::accumulate(values.cbegin(), values.cend(), RealType{}) / numberOfSampleSets;
+    RealType       variance{};
+    for (const RealType value : values)
+    {
+      variance += (value - mean) * (value - mean);
+    }
+    variance /= numberOfSampleSets - 1;
+
+    if (std::abs(mean) > NumericTraits<RealType>::epsilon())
+    {
+      // The standard error decreases with the square root of the number of samples.
+      const RealType relativeStandardError = std::sqrt(variance) / std::abs(mean);
+      const RealType ratio = relativeStandardError / this->m_MetricSamplingRelativeStandardError;
+      this->m_CurrentMetricSamplingPercentage =
+        std::clamp(levelSamplingPercentage * ratio * ratio, 0.1 * levelSamplingPercentage, RealType{ 1.0 });
+    }
+    itkDebugMacro("Adapted the metric sampling percentage of level " << this->m_CurrentLevel << " from "
+                                                                     << levelSamplingPercentage << " to "
+                                                                     << this->m_CurrentMetricSamplingPercentage);
   }
 
+  setSamplePoints(this->m_CurrentMetricSamplingPercentage);
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
+auto
+ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::SampleVirtualDomain(
+  const ImageMetricType * metric,
+  const RealType          samplingPercentage) -> typename MetricSamplePointSetType::Pointer
+{
+  using VirtualDomainImageType = typename ImageMetricType::VirtualImageType;
+  using VirtualDomainRegionType = typename VirtualDomainImageType::RegionType;
+  using SamplePointType = typename MetricSamplePointSetType::PointType;
+
+  const VirtualDomainImageType * const virtualImage = metric->GetVirtualImage();
+  const FixedImageMaskType * const     fixedMaskImage = metric->GetFixedImageMask();
+
   const VirtualDomainRegionType &                    virtualDomainRegion = virtualImage->GetRequestedRegion();
   const typename VirtualDomainImageType::SpacingType oneThirdVirtualSpacing = virtualImage->GetSpacing() / 3.0;
 
-  for (SizeValueType n = 0; n < numberOfLocalMetrics; ++n)
+  auto samplePointSet = MetricSamplePointSetType::New();
+
+  using RandomizerType = Statistics::MersenneTwisterRandomVariateGenerator;
+  auto randomizer = RandomizerType::New();
+  if (m_ReseedIterator)
+  {
+    randomizer->SetSeed();
+  }
+  else
   {
-    auto samplePointSet = MetricSamplePointSetType::New();
+    randomizer->SetSeed(m_CurrentRandomSeed++);
+  }
 
-    using SamplePointType = typename MetricSamplePointSetType::PointType;
+  unsigned long index = 0;
 
-    using RandomizerType = Statistics::MersenneTwisterRandomVariateGenerator;
-    auto randomizer = RandomizerType::New();
-    if (m_ReseedIterator)
+  // Add the point, randomly perturbed within a voxel (approximately), if it is inside the fixed mask.
+  const auto addPerturbedPoint = [&](SamplePointType point) {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
     {
-      randomizer->SetSeed();
+      point[d] += randomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
     }
-    else
+    if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
     {
-      randomizer->SetSeed(m_CurrentRandomSeed++);
+      samplePointSet->SetPoint(index, point);
+      ++index;
     }
+  };
 
-
-    unsigned long index = 0;
-
-    switch (this->m_MetricSamplingStrategy)
+  switch (this->m_MetricSamplingStrategy)
+  {
+    case MetricSamplingStrategyEnum::REGULAR:
+    {
+      const auto    sampleCount = static_cast<unsigned long>(std::ceil(1.0 / samplingPercentage));
+      unsigned long count =
+        sampleCount; // Start at sampleCount to keep behavior backwards identical, using first element.
+      for (ImageRegionConstIteratorWithIndex It(virtualImage, virtualDomainRegion); !It.IsAtEnd(); ++It)
+      {
+        if (count == sampleCount)
+        {
+          count = 0; // Reset counter
+          SamplePointType point;
+          virtualImage->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+          addPerturbedPoint(point);
+        }
+        ++count;
+      }
+      break;
+    }
+    case MetricSamplingStrategyEnum::RANDOM:
+    {
+      const unsigned long totalVirtualDomainVoxels = virtualDomainRegion.GetNumberOfPixels();
+      const auto          sampleCount =
+        static_cast<unsigned long>(static_cast<float>(totalVirtualDomainVoxels) * samplingPercentage);
+      ImageRandomConstIteratorWithIndex ItR(virtualImage, virtualDomainRegion);
+      if (m_ReseedIterator)
+      {
+        ItR.ReinitializeSeed();
+      }
+      else
+      {
+        ItR.ReinitializeSeed(m_CurrentRandomSeed++);
+      }
+      ItR.SetNumberOfSamples(sampleCount);
+      for (ItR.GoToBegin(); !ItR.IsAtEnd(); ++ItR)
+      {
+        SamplePointType point;
+        virtualImage->TransformIndexToPhysicalPoint(ItR.GetIndex(), point);
+        addPerturbedPoint(point);
+      }
+      break;
+    }
+    case MetricSamplingStrategyEnum::STRATIFIED:
     {
-      case MetricSamplingStrategyEnum::REGULAR:
+      // One point drawn uniformly within every cell of cellSize^ImageDimension voxels.
+      const double                cellSize = std::pow(1.0 / samplingPercentage, 1.0 / ImageDimension);
+      ImageRegion<ImageDimension> cellRegion;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
       {
-        const auto sampleCount =
-          static_cast<unsigned long>(std::ceil(1.0 / this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]));
-        unsigned long count =
-          sampleCount; // Start at sampleCount to keep behavior backwards identical, using first element.
-        for (ImageRegionConstIteratorWithIndex It(virtualImage, virtualDomainRegion); !It.IsAtEnd(); ++It)
+        cellRegion.SetSize(d, static_cast<SizeValueType>(std::ceil(virtualDomainRegion.GetSize(d) / cellSize)));
+      }
+      for (const auto & cellIndex : ImageRegionIndexRange<ImageDimension>(cellRegion))
+      {
+        ContinuousIndex<double, ImageDimension> continuousIndex;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
         {
-          if (count == sampleCount)
+          const double lower = cellIndex[d] * cellSize;
+          const double upper = std::min(lower + cellSize, static_cast<double>(virtualDomainRegion.GetSize(d)));
+          continuousIndex[d] =
+            virtualDomainRegion.GetIndex(d) - 0.5 + lower + randomizer->GetVariateWithOpenUpperRange(upper - lower);
+        }
+        SamplePointType point;
+        virtualImage->TransformContinuousIndexToPhysicalPoint(continuousIndex, point);
+        if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
+        {
+          samplePointSet->SetPoint(index, point);
+          ++index;
+        }
+      }
+      break;
+    }
+    case MetricSamplingStrategyEnum::GRADIENT_IMPORTANCE:
+    {
+      if constexpr (std::is_arithmetic_v<typename FixedImageType::PixelType>)
+      {
+        // Weight every voxel by the gradient magnitude of the fixed image at its center. A tenth of the mean
+        // weight is added to the weight of every voxel, so that the flat regions keep some samples. The
+        // weights only depend on the level, so they are computed at the first sampling of the level.
+        if (m_GradientImportanceWeights.empty())
+        {
+          using GradientCalculatorType = CentralDifferenceImageFunction<FixedImageType, RealType>;
+          auto gradientCalculator = GradientCalculatorType::New();
+          gradientCalculator->SetInputImage(metric->GetFixedImage());
+          const auto * const fixedTransform = metric->GetFixedTransform();
+
+          m_GradientImportanceWeights.reserve(virtualDomainRegion.GetNumberOfPixels());
+          double totalGradientWeight = 0.0;
+          m_NumberOfGradientImportanceWeightedVoxels = 0;
+          for (ImageRegionConstIteratorWithIndex It(virtualImage, virtualDomainRegion); !It.IsAtEnd(); ++It)
           {
-            count = 0; // Reset counter
             SamplePointType point;
             virtualImage->TransformIndexToPhysicalPoint(It.GetIndex(), point);
-
-            // randomly perturb the point within a voxel (approximately)
-            for (SizeValueType d = 0; d < ImageDimension; ++d)
+            const auto fixedPoint = fixedTransform->TransformPoint(point);
+            if ((!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point)) &&
+                gradientCalculator->IsInsideBuffer(fixedPoint))
             {
-              point[d] += randomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
+              const auto weight = static_cast<float>(gradientCalculator->Evaluate(fixedPoint).GetNorm());
+              m_GradientImportanceWeights.push_back(weight);
+              totalGradientWeight += weight;
+              ++m_NumberOfGradientImportanceWeightedVoxels;
             }
-            if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
+            else
             {
-              samplePointSet->SetPoint(index, point);
-              ++index;
+              m_GradientImportanceWeights.push_back(-1.0f);
             }
           }
-          ++count;
-        }
-        break;
-      }
-      case MetricSamplingStrategyEnum::RANDOM:
-      {
-        const unsigned long totalVirtualDomainVoxels = virtualDomainRegion.GetNumberOfPixels();
-        const auto          sampleCount =
-          static_cast<unsigned long>(static_cast<float>(totalVirtualDomainVoxels) *
-                                     this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]);
-        ImageRandomConstIteratorWithIndex ItR(virtualImage, virtualDomainRegion);
-        if (m_ReseedIterator)
-        {
-          ItR.ReinitializeSeed();
+          const auto minimumWeight = static_cast<float>(
+            0.1 * totalGradientWeight / std::max(m_NumberOfGradientImportanceWeightedVoxels, SizeValueType{ 1 }));
+          for (float & weight : m_GradientImportanceWeights)
+          {
+            weight = (weight < 0.0f) ? 0.0f : weight + minimumWeight;
+          }
         }
-        else
+        const std::vector<float> & weights = m_GradientImportanceWeights;
+        const double totalWeight = std::accumulate(weights.cbegin(), weights.cend(), 0.0);
+
+        // Systematic sampling: voxels are drawn with a probability proportional to their weight, at regular
+        // steps of the cumulated weight, starting at a random offset.
+        const auto sampleCount = static_cast<unsigned long>(
+          static_cast<float>(m_NumberOfGradientImportanceWeightedVoxels) * samplingPercentage);
+        if (sampleCount == 0 || totalWeight <= 0.0)
         {
-          ItR.ReinitializeSeed(m_CurrentRandomSeed++);
+          break;
         }
-        ItR.SetNumberOfSamples(sampleCount);
-        for (ItR.GoToBegin(); !ItR.IsAtEnd(); ++ItR)
+        const double step = totalWeight / sampleCount;
+        double       nextSampleWeight = randomizer->GetVariateWithOpenUpperRange(step);
+        double       cumulatedWeight = 0.0;
+        auto         weightIt = weights.cbegin();
+        for (ImageRegionConstIteratorWithIndex It(virtualImage, virtualDomainRegion); !It.IsAtEnd(); ++It, ++weightIt)
         {
-          SamplePointType point;
-          virtualImage->TransformIndexToPhysicalPoint(ItR.GetIndex(), point);
-
-          // randomly perturb the point within a voxel (approximately)
-          for (unsigned int d = 0; d < ImageDimension; ++d)
-          {
-            point[d] += randomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
-          }
-          if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
+          cumulatedWeight += *weightIt;
+          for (; nextSampleWeight < cumulatedWeight; nextSampleWeight += step)
           {
-            samplePointSet->SetPoint(index, point);
-            ++index;
+            SamplePointType point;
+            virtualImage->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+            addPerturbedPoint(point);
           }
         }
-        break;
       }
-      default:
+      else
       {
-        itkExceptionStringMacro("Invalid sampling strategy requested.");
+        itkExceptionStringMacro("GRADIENT_IMPORTANCE sampling requires a fixed image of scalar pixels.");
       }
+      break;
     }
-
-    if (multiMetric)
-    {
-      dynamic_cast<ImageMetricType *>(multiMetric->GetMetricQueue()[n].GetPointer())
-        ->SetVirtualSampledPointSet(samplePointSet);
-      dynamic_cast<ImageMetricType *>(multiMetric->GetMetricQueue()[n].GetPointer())->UseSampledPointSetOn();
-      dynamic_cast<ImageMetricType *>(multiMetric->GetMetricQueue()[n].GetPointer())->UseVirtualSampledPointSetOn();
-    }
-    else
+    default:
     {
-      dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer())->SetVirtualSampledPointSet(samplePointSet);
-      dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer())->UseSampledPointSetOn();
-      dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer())->UseVirtualSampledPointSetOn();
+      itkExceptionStringMacro("Invalid sampling strategy requested.");
     }
   }
+
+  return samplePointSet;
 }
 
 template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
@@ -1144,11 +1308,17 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
 
   os << indent << "MetricSamplingStrategy: " << m_MetricSamplingStrategy << std::endl;
   os << indent << "MetricSamplingPercentagePerLevel: " << m_MetricSamplingPercentagePerLevel << std::endl;
+  itkPrintSelfBooleanMacro(UseAdaptiveMetricSamplingPercentage);
+  os << indent << "MetricSamplingRelativeStandardError: " << m_MetricSamplingRelativeStandardError << std::endl;
+  os << indent << "CurrentMetricSamplingPercentage: " << m_CurrentMetricSamplingPercentage << std::endl;
   print_helper::PrintNumericTrait(os, indent, "NumberOfMetrics", m_NumberOfMetrics);
   os << indent << "FirstImageMetricIndex: " << m_FirstImageMetricIndex << std::endl;
   os << indent << "ShrinkFactorsPerLevel: " << m_ShrinkFactorsPerLevel << std::endl;
   os << indent << "SmoothingSigmasPerLevel: " << m_SmoothingSigmasPerLevel << std::endl;
   itkPrintSelfBooleanMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits);
+  itkPrintSelfObjectMacro(FixedImageSmoothingCache);
+  itkPrintSelfObjectMacro(MovingImageSmoothingCache);
+  itkPrintSelfBooleanMacro(PrecomputeSmoothedImages);
 
   itkPrintSelfBooleanMacro(ReseedIterator);
   os << indent << "RandomSeed: " << m_RandomSeed << std::endl;
@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSmoothedImageCache_h
+#define itkSmoothedImageCache_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class SmoothedImageCache
+ * \brief Computes and keeps the Gaussian smoothed images of the levels of a registration.
+ *
+ * ImageRegistrationMethodv4 smooths the fixed and the moving images at the
+ * beginning of each level, before the optimizer can start. Given a cache,
+ * the method takes the smoothed images from it instead. An image is smoothed
+ * once per sigma array, and the result is reused for as long as the cache
+ * lives and the image is not modified. Sharing the fixed image cache between
+ * the registration methods of a batch, e.g. when registering many moving
+ * images to one atlas, the smoothed images of the atlas are computed once for
+ * the whole batch.
+ *
+ * Prefetch() starts smoothing an image on a background task, so the
+ * smoothed images of the next levels are computed while the optimizer
+ * iterates on the current one. GetSmoothedImage() waits for the task.
+ *
+ * An entry is keyed on the image, its modification time and the sigma array,
+ * in physical units. The cache holds a reference to the images, which are
+ * only released by Clear() or by the destruction of the cache. All the
+ * methods may be called concurrently.
+ *
+ * \sa ImageRegistrationMethodv4
+ *
+ * \ingroup ITKRegistrationMethodsv4
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT SmoothedImageCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SmoothedImageCache);
+
+  /** Standard class type aliases. */
+  using Self = SmoothedImageCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(SmoothedImageCache);
+
+  using ImageType = TImage;
+  using ImageConstPointer = typename ImageType::ConstPointer;
+
+  using SmoothingFilterType = SmoothingRecursiveGaussianImageFilter<ImageType, ImageType>;
+  using SigmaArrayType = typename SmoothingFilterType::SigmaArrayType;
+
+  /** Return the image smoothed with the sigmas, in physical units. The
+   * smoothed image is computed in the calling thread, unless it is cached or
+   * prefetched. */
+  ImageConstPointer
+  GetSmoothedImage(const ImageType * image, const SigmaArrayType & sigmas);
+
+  /** Smooth the image, without caching it. The cache calls it from the
+   * thread which first requests the smoothed image, or from a prefetch task.
+   * A graft of the image is smoothed, so the pipeline of the image is not
+   * updated: the image must be up to date, as the inputs of a filter are
+   * when its GenerateData() runs. */
+  static ImageConstPointer
+  ComputeSmoothedImage(ImageConstPointer image, SigmaArrayType sigmas);
+
+  /** Start smoothing the image on a background task, unless its smoothed
+   * image is already cached. */
+  void
+  Prefetch(const ImageType * image, const SigmaArrayType & sigmas);
+
+  /** Release the cached images, waiting for the prefetch tasks. */
+  void
+  Clear();
+
+  /** Number of cached smoothed images, including the ones being computed. */
+  SizeValueType
+  GetNumberOfCachedImages() const;
+
+  /** Number of smoothed images computed, or being computed, since the creation
+   * of the cache. */
+  SizeValueType
+  GetNumberOfComputedImages() const;
+
+protected:
+  SmoothedImageCache() = default;
+  ~SmoothedImageCache() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  struct Entry
+  {
+    ImageConstPointer                     m_Image;
+    ModifiedTimeType                      m_ImageModifiedTime;
+    SigmaArrayType                        m_Sigmas;
+    std::shared_future<ImageConstPointer> m_SmoothedImage;
+  };
+
+  /** Find the entry of the image and sigmas, adding it when it is missing.
+   * The smoothed image of an entry whose image was modified is moved to
+   * \c staleSmoothedImage, to be released by the caller once the mutex is
+   * unlocked, as its release waits for its prefetch task.
+   * Must be called with the mutex locked. */
+  std::shared_future<ImageConstPointer>
+  FindOrAddEntry(const ImageType *                       image,
+                 const SigmaArrayType &                  sigmas,
+                 std::launch                             policy,
+                 std::shared_future<ImageConstPointer> & staleSmoothedImage);
+
+  mutable std::mutex m_Mutex{};
+  std::vector<Entry> m_Entries{};
+  SizeValueType      m_NumberOfComputedImages{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSmoothedImageCache.hxx"
+#endif
+
+#endif
@@ -0,0 +1,181 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSmoothedImageCache_hxx
+#define itkSmoothedImageCache_hxx
+
+#include <algorithm>
+#include <utility>
+
+namespace itk
+{
+
+template <typename TImage>
+auto
+SmoothedImageCache<TImage>::GetSmoothedImage(const ImageType * image, const SigmaArrayType & sigmas)
+  -> ImageConstPointer
+{
+  if (image == nullptr)
+  {
+    itkExceptionMacro("The image to smooth is null.");
+  }
+
+  std::shared_future<ImageConstPointer> smoothedImage;
+  std::shared_future<ImageConstPointer> staleSmoothedImage;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    smoothedImage = this->FindOrAddEntry(image, sigmas, std::launch::deferred, staleSmoothedImage);
+  }
+  // The stale smoothed image may still be computed by a prefetch task: wait for it outside of the lock.
+  staleSmoothedImage = {};
+
+  try
+  {
+    return smoothedImage.get();
+  }
+  catch (...)
+  {
+    // Do not keep the failure: the next request smooths the image again.
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries.erase(std::remove_if(m_Entries.begin(),
+                                   m_Entries.end(),
+                                   [image, &sigmas](const Entry & entry) {
+                                     return entry.m_Image.GetPointer() == image && entry.m_Sigmas == sigmas;
+                                   }),
+                    m_Entries.end());
+    throw;
+  }
+}
+
+
+template <typename TImage>
+void
+SmoothedImageCache<TImage>::Prefetch(const ImageType * image, const SigmaArrayType & sigmas)
+{
+  if (image == nullptr)
+  {
+    itkExceptionMacro("The image to smooth is null.");
+  }
+
+  // Declared before the lock, so that a stale prefetch task is waited for after the unlock.
+  std::shared_future<ImageConstPointer> staleSmoothedImage;
+  const std::lock_guard<std::mutex>     lock(m_Mutex);
+  this->FindOrAddEntry(image, sigmas, std::launch::async, staleSmoothedImage);
+}
+
+
+template <typename TImage>
+void
+SmoothedImageCache<TImage>::Clear()
+{
+  std::vector<Entry> entries;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    entries.swap(m_Entries);
+  }
+  // The destruction of the entries waits for their prefetch tasks, outside of the lock.
+  entries.clear();
+}
+
+
+template <typename TImage>
+SizeValueType
+SmoothedImageCache<TImage>::GetNumberOfCachedImages() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<SizeValueType>(m_Entries.size());
+}
+
+
+template <typename TImage>
+SizeValueType
+SmoothedImageCache<TImage>::GetNumberOfComputedImages() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfComputedImages;
+}
+
+
+template <typename TImage>
+auto
+SmoothedImageCache<TImage>::FindOrAddEntry(const ImageType *                       image,
+                                           const SigmaArrayType &                  sigmas,
+                                           const std::launch                       policy,
+                                           std::shared_future<ImageConstPointer> & staleSmoothedImage)
+  -> std::shared_future<ImageConstPointer>
+{
+  const ModifiedTimeType modifiedTime = image->GetMTime();
+
+  for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+  {
+    if (it->m_Image.GetPointer() == image && it->m_Sigmas == sigmas)
+    {
+      if (it->m_ImageModifiedTime == modifiedTime)
+      {
+        return it->m_SmoothedImage;
+      }
+      // The image was modified since it was smoothed.
+      staleSmoothedImage = std::move(it->m_SmoothedImage);
+      m_Entries.erase(it);
+      break;
+    }
+  }
+
+  Entry entry;
+  entry.m_Image = image;
+  entry.m_ImageModifiedTime = modifiedTime;
+  entry.m_Sigmas = sigmas;
+  entry.m_SmoothedImage = std::async(policy, &Self::ComputeSmoothedImage, entry.m_Image, sigmas).share();
+  m_Entries.push_back(entry);
+  ++m_NumberOfComputedImages;
+  return entry.m_SmoothedImage;
+}
+
+
+template <typename TImage>
+auto
+SmoothedImageCache<TImage>::ComputeSmoothedImage(ImageConstPointer image, SigmaArrayType sigmas) -> ImageConstPointer
+{
+  // The pipeline updates the requested region of its input, and the image may be
+  // the input of other pipelines, in other threads: smooth a graft of the image.
+  const auto input = ImageType::New();
+  input->Graft(image);
+
+  auto smoothingFilter = SmoothingFilterType::New();
+  smoothingFilter->SetSigmaArray(sigmas);
+  smoothingFilter->SetInput(input);
+  smoothingFilter->Update();
+
+  typename ImageType::Pointer smoothedImage = smoothingFilter->GetOutput();
+  smoothedImage->DisconnectPipeline();
+  return smoothedImage;
+}
+
+
+template <typename TImage>
+void
+SmoothedImageCache<TImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfCachedImages: " << this->GetNumberOfCachedImages() << std::endl;
+  os << indent << "NumberOfComputedImages: " << this->GetNumberOfComputedImages() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Reports the time to convergence and the accuracy of the translation registration of two images, which differ by a
+// known translation, for each metric sampling strategy.
+
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageFileReader.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegularStepGradientDescentOptimizerv4.h"
+#include "itkTimeProbe.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <iomanip>
+#include <utility>
+
+int
+itkImageRegistrationSamplingBenchmark(int argc, char * argv[])
+{
+  if (argc < 6)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv)
+              << " fixedImage movingImage translationX translationY samplingPercentage [numberOfRuns]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using ImageType = itk::Image<float, Dimension>;
+  using TransformType = itk::TranslationTransform<double, Dimension>;
+  using RegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TransformType>;
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+  using StrategyEnum = itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy;
+
+  ImageType::Pointer fixedImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(fixedImage = itk::ReadImage<ImageType>(argv[1]));
+  ImageType::Pointer movingImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(movingImage = itk::ReadImage<ImageType>(argv[2]));
+  const double       expectedTranslation[Dimension] = { std::stod(argv[3]), std::stod(argv[4]) };
+  const double       samplingPercentage = std::stod(argv[5]);
+  const unsigned int numberOfRuns = (argc > 6) ? std::stoi(argv[6]) : 3;
+
+  std::cout << std::setw(20) << "Strategy" << std::setw(10) << "Adaptive" << std::setw(10) << "Points"
+            << std::setw(12) << "Iterations" << std::setw(12) << "Time (s)" << std::setw(12) << "Error (mm)"
+            << std::endl;
+
+  int result = EXIT_SUCCESS;
+
+  const std::pair<StrategyEnum, const char *> strategies[] = {
+    { StrategyEnum::NONE, "NONE" },
+    { StrategyEnum::REGULAR, "REGULAR" },
+    { StrategyEnum::RANDOM, "RANDOM" },
+    { StrategyEnum::STRATIFIED, "STRATIFIED" },
+    { StrategyEnum::GRADIENT_IMPORTANCE, "GRADIENT_IMPORTANCE" },
+  };
+  for (const auto & [strategy, strategyName] : strategies)
+  {
+    for (const bool adaptive : { false, true })
+    {
+      if (adaptive && strategy == StrategyEnum::NONE)
+      {
+        continue;
+      }
+
+      itk::TimeProbe     probe;
+      itk::SizeValueType numberOfPoints = 0;
+      itk::SizeValueType numberOfIterations = 0;
+      double             error = 0.0;
+      for (unsigned int run = 0; run < numberOfRuns; ++run)
+      {
+        auto metric = MetricType::New();
+        auto optimizer = itk::RegularStepGradientDescentOptimizerv4<double>::New();
+        optimizer->SetLearningRate(4.0);
+        optimizer->SetMinimumStepLength(0.001);
+        optimizer->SetRelaxationFactor(0.5);
+        optimizer->SetNumberOfIterations(200);
+
+        auto registration = RegistrationType::New();
+        registration->SetFixedImage(fixedImage);
+        registration->SetMovingImage(movingImage);
+        registration->SetMetric(metric);
+        registration->SetOptimizer(optimizer);
+        registration->SetNumberOfLevels(1);
+        RegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel(1);
+        shrinkFactorsPerLevel[0] = 1;
+        registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
+        RegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel(1);
+        smoothingSigmasPerLevel[0] = 0.0;
+        registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+        registration->SetMetricSamplingStrategy(strategy);
+        registration->SetMetricSamplingPercentage(samplingPercentage);
+        registration->MetricSamplingReinitializeSeed(121212 + run);
+        registration->SetUseAdaptiveMetricSamplingPercentage(adaptive);
+
+        probe.Start();
+        ITK_TRY_EXPECT_NO_EXCEPTION(registration->Update());
+        probe.Stop();
+
+        const TransformType::ParametersType translation = registration->GetOutput()->Get()->GetParameters();
+        error += std::hypot(translation[0] - expectedTranslation[0], translation[1] - expectedTranslation[1]);
+        numberOfIterations += optimizer->GetCurrentIteration();
+        numberOfPoints = (strategy == StrategyEnum::NONE)
+                           ? fixedImage->GetBufferedRegion().GetNumberOfPixels()
+                           : metric->GetVirtualSampledPointSet()->GetNumberOfPoints();
+      }
+      error /= numberOfRuns;
+
+      std::cout << std::setw(20) << strategyName << std::setw(10) << adaptive << std::setw(10) << numberOfPoints
+                << std::setw(12) << numberOfIterations / numberOfRuns << std::setw(12) << std::fixed
+                << std::setprecision(4) << probe.GetMean() << std::setw(12) << error << std::endl;
+
+      // Every strategy recovers the translation within a twentieth of a pixel.
+      if (error > 0.05)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "The translation error of " << strategyName << " sampling is " << error << " mm." << std::endl;
+        result = EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
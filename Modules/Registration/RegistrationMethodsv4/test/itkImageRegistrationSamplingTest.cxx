@@ -17,19 +17,47 @@
  *=========================================================================*/
 
 #include "itkImageRegistrationMethodv4.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegistrationParameterScalesFromPhysicalShift.h"
+#include "itkTranslationTransform.h"
 #include "itkTestingMacros.h"
 
+#include <cmath>
+
+namespace
+{
+using PixelType = double;
+using ImageType = itk::Image<PixelType, 2>;
+
+// A Gaussian blob centered at the given point.
+ImageType::Pointer
+MakeBlobImage(const double centerX, const double centerY)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(64));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double dx = it.GetIndex()[0] - centerX;
+    const double dy = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(dx * dx + dy * dy) / 128.0));
+  }
+  return image;
+}
+} // namespace
+
 /*
  * Test the SetMetricSamplingPercentage and SetMetricSamplingPercentagePerLevel.
  * We only need to explicitly run the SetMetricSamplingPercentage method because it
  * invokes the SetMetricSamplingPercentagePerLevel method.
+ * Then register two translated images with every sampling strategy.
  */
 int
 itkImageRegistrationSamplingTest(int, char *[])
 {
-  using PixelType = double;
-  using FixedImageType = itk::Image<PixelType, 2>;
-  using MovingImageType = itk::Image<PixelType, 2>;
+  using FixedImageType = ImageType;
+  using MovingImageType = ImageType;
 
   using RegistrationType = itk::ImageRegistrationMethodv4<FixedImageType, MovingImageType>;
   auto registrationMethod = RegistrationType::New();
@@ -45,6 +73,75 @@ itkImageRegistrationSamplingTest(int, char *[])
   }
 
 
+  using TransformType = itk::TranslationTransform<double, 2>;
+  using TranslationRegistrationType = itk::ImageRegistrationMethodv4<FixedImageType, MovingImageType, TransformType>;
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<FixedImageType, MovingImageType>;
+  using StrategyEnum = itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy;
+
+  const auto fixedImage = MakeBlobImage(32.0, 32.0);
+  const auto movingImage = MakeBlobImage(34.0, 31.0);
+
+  for (const StrategyEnum strategy :
+       { StrategyEnum::REGULAR, StrategyEnum::RANDOM, StrategyEnum::STRATIFIED, StrategyEnum::GRADIENT_IMPORTANCE })
+  {
+    for (const bool adaptive : { false, true })
+    {
+      std::cout << "Strategy: " << strategy << ", adaptive: " << adaptive << std::endl;
+
+      auto metric = MetricType::New();
+      auto scalesEstimator = itk::RegistrationParameterScalesFromPhysicalShift<MetricType>::New();
+      scalesEstimator->SetMetric(metric);
+      auto optimizer = itk::GradientDescentOptimizerv4::New();
+      optimizer->SetScalesEstimator(scalesEstimator);
+      optimizer->SetMaximumStepSizeInPhysicalUnits(0.5);
+      optimizer->SetNumberOfIterations(100);
+
+      auto registration = TranslationRegistrationType::New();
+      registration->SetFixedImage(fixedImage);
+      registration->SetMovingImage(movingImage);
+      registration->SetMetric(metric);
+      registration->SetOptimizer(optimizer);
+      registration->SetNumberOfLevels(1);
+      TranslationRegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel(1);
+      shrinkFactorsPerLevel[0] = 1;
+      registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
+      TranslationRegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel(1);
+      smoothingSigmasPerLevel[0] = 0.0;
+      registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+      registration->SetMetricSamplingStrategy(strategy);
+      registration->SetMetricSamplingPercentage(0.1);
+      registration->MetricSamplingReinitializeSeed(121212);
+      ITK_TEST_SET_GET_BOOLEAN(registration, UseAdaptiveMetricSamplingPercentage, adaptive);
+      registration->SetMetricSamplingRelativeStandardError(0.05);
+      ITK_TEST_SET_GET_VALUE(0.05, registration->GetMetricSamplingRelativeStandardError());
+
+      ITK_TRY_EXPECT_NO_EXCEPTION(registration->Update());
+
+      const double percentage = registration->GetCurrentMetricSamplingPercentage();
+      if (adaptive)
+      {
+        ITK_TEST_EXPECT_TRUE(percentage >= 0.01 && percentage <= 1.0);
+      }
+      else
+      {
+        ITK_TEST_EXPECT_EQUAL(percentage, 0.1);
+      }
+
+      // About the sampling percentage of the voxels, except for the points perturbed out of the image.
+      const double numberOfPoints = metric->GetVirtualSampledPointSet()->GetNumberOfPoints();
+      const double expectedNumberOfPoints = percentage * fixedImage->GetBufferedRegion().GetNumberOfPixels();
+      std::cout << "  Number of sample points: " << numberOfPoints << std::endl;
+      ITK_TEST_EXPECT_TRUE(numberOfPoints > 0.9 * expectedNumberOfPoints);
+      ITK_TEST_EXPECT_TRUE(numberOfPoints < 1.1 * expectedNumberOfPoints + 16);
+
+      const TransformType::ParametersType translation = registration->GetOutput()->Get()->GetParameters();
+      std::cout << "  Translation: " << translation << std::endl;
+      ITK_TEST_EXPECT_TRUE(std::abs(translation[0] - 2.0) < 0.1);
+      ITK_TEST_EXPECT_TRUE(std::abs(translation[1] + 1.0) < 0.1);
+    }
+  }
+
+
   std::cout << "Test finished." << std::endl;
   return EXIT_SUCCESS;
 }
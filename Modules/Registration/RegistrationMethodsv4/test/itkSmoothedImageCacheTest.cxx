@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSmoothedImageCache.h"
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegistrationParameterScalesFromPhysicalShift.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+namespace
+{
+using PixelType = double;
+using ImageType = itk::Image<PixelType, 2>;
+
+// A Gaussian blob centered at the given point.
+ImageType::Pointer
+MakeBlobImage(const double centerX, const double centerY)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(64));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double dx = it.GetIndex()[0] - centerX;
+    const double dy = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(dx * dx + dy * dy) / 128.0));
+  }
+  return image;
+}
+
+bool
+ImagesAreEqual(const ImageType * image1, const ImageType * image2)
+{
+  itk::ImageRegionConstIterator<ImageType> it2(image2, image1->GetBufferedRegion());
+  for (itk::ImageRegionConstIterator<ImageType> it1(image1, image1->GetBufferedRegion()); !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+using TransformType = itk::TranslationTransform<double, 2>;
+using RegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TransformType>;
+
+RegistrationType::Pointer
+MakeRegistration(const ImageType * fixedImage, const ImageType * movingImage)
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+
+  auto metric = MetricType::New();
+  auto scalesEstimator = itk::RegistrationParameterScalesFromPhysicalShift<MetricType>::New();
+  scalesEstimator->SetMetric(metric);
+  auto optimizer = itk::GradientDescentOptimizerv4::New();
+  optimizer->SetScalesEstimator(scalesEstimator);
+  optimizer->SetMaximumStepSizeInPhysicalUnits(0.5);
+  optimizer->SetNumberOfIterations(50);
+  optimizer->DoEstimateLearningRateOnceOff();
+  optimizer->DoEstimateLearningRateAtEachIterationOn();
+
+  auto registration = RegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(metric);
+  registration->SetOptimizer(optimizer);
+  registration->SetNumberOfLevels(3);
+  RegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel(3);
+  shrinkFactorsPerLevel[0] = 4;
+  shrinkFactorsPerLevel[1] = 2;
+  shrinkFactorsPerLevel[2] = 1;
+  registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
+  RegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel(3);
+  smoothingSigmasPerLevel[0] = 2.0;
+  smoothingSigmasPerLevel[1] = 1.0;
+  smoothingSigmasPerLevel[2] = 0.0;
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+  registration->SmoothingSigmasAreSpecifiedInPhysicalUnitsOff();
+  return registration;
+}
+} // namespace
+
+/*
+ * Test the SmoothedImageCache, and the registration of several moving images
+ * to a fixed image, sharing the cache of the smoothed fixed images.
+ */
+int
+itkSmoothedImageCacheTest(int, char *[])
+{
+  using CacheType = itk::SmoothedImageCache<ImageType>;
+
+  auto cache = CacheType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(cache, SmoothedImageCache, Object);
+
+  const auto image = MakeBlobImage(30.0, 33.0);
+
+  CacheType::SigmaArrayType sigmas;
+  sigmas.Fill(1.5);
+  const CacheType::SigmaArrayType otherSigmas(3.0);
+
+  ITK_TRY_EXPECT_EXCEPTION(cache->GetSmoothedImage(nullptr, sigmas));
+  ITK_TRY_EXPECT_EXCEPTION(cache->Prefetch(nullptr, sigmas));
+
+  const CacheType::ImageConstPointer expected = CacheType::ComputeSmoothedImage(image, sigmas);
+  ITK_TEST_EXPECT_TRUE(!ImagesAreEqual(expected, image));
+
+  const CacheType::ImageConstPointer smoothed = cache->GetSmoothedImage(image, sigmas);
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual(expected, smoothed));
+  ITK_TEST_EXPECT_EQUAL(cache->GetSmoothedImage(image, sigmas), smoothed);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 1);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfComputedImages(), 1);
+
+  // A prefetched image is computed once, on a background task.
+  cache->Prefetch(image, otherSigmas);
+  cache->Prefetch(image, otherSigmas);
+  const CacheType::ImageConstPointer prefetched = cache->GetSmoothedImage(image, otherSigmas);
+  ITK_TEST_EXPECT_TRUE(ImagesAreEqual(CacheType::ComputeSmoothedImage(image, otherSigmas), prefetched));
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 2);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfComputedImages(), 2);
+
+  // A modified image is smoothed again.
+  image->Modified();
+  ITK_TEST_EXPECT_TRUE(cache->GetSmoothedImage(image, sigmas) != smoothed);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 2);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfComputedImages(), 3);
+
+  cache->Clear();
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 0);
+
+
+  // Register a cohort of moving images to a fixed image, without and with caches.
+
+  const auto fixedImage = MakeBlobImage(32.0, 32.0);
+  const auto movingImages = { MakeBlobImage(34.0, 31.0), MakeBlobImage(31.0, 33.5), MakeBlobImage(33.0, 32.0) };
+
+  auto fixedImageCache = RegistrationType::FixedImageSmoothingCacheType::New();
+
+  for (const auto & movingImage : movingImages)
+  {
+    auto referenceRegistration = MakeRegistration(fixedImage, movingImage);
+    ITK_TEST_EXPECT_TRUE(referenceRegistration->GetFixedImageSmoothingCache() == nullptr);
+    ITK_TEST_EXPECT_TRUE(!referenceRegistration->GetPrecomputeSmoothedImages());
+    ITK_TRY_EXPECT_NO_EXCEPTION(referenceRegistration->Update());
+
+    auto registration = MakeRegistration(fixedImage, movingImage);
+    registration->SetFixedImageSmoothingCache(fixedImageCache);
+    ITK_TEST_SET_GET_VALUE(fixedImageCache, registration->GetFixedImageSmoothingCache());
+    ITK_TEST_SET_GET_BOOLEAN(registration, PrecomputeSmoothedImages, true);
+    ITK_TRY_EXPECT_NO_EXCEPTION(registration->Update());
+
+    // The registration created its moving image cache, with the two smoothed levels.
+    ITK_TEST_EXPECT_TRUE(registration->GetMovingImageSmoothingCache() != nullptr);
+    ITK_TEST_EXPECT_EQUAL(registration->GetMovingImageSmoothingCache()->GetNumberOfComputedImages(), 2);
+
+    const TransformType::ParametersType expectedTranslation =
+      referenceRegistration->GetOutput()->Get()->GetParameters();
+    const TransformType::ParametersType translation = registration->GetOutput()->Get()->GetParameters();
+    std::cout << "Translation: " << translation << std::endl;
+    ITK_TEST_EXPECT_EQUAL(translation, expectedTranslation);
+  }
+
+  // The smoothed fixed images of the two smoothed levels are shared by the cohort.
+  ITK_TEST_EXPECT_EQUAL(fixedImageCache->GetNumberOfComputedImages(), 2);
+
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
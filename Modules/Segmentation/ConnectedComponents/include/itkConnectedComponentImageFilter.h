@@ -39,7 +39,12 @@ namespace itk
  * label.
  *
  * By default, connectivity is defined as face-connected (e.g. 4-connected on a 2D image).
- * Use SetFullyConnected(true) to change to fully-connected (e.g. 8-connected on a 2D image).
+ * Use SetFullyConnected(true) to change to fully-connected (e.g. 8-connected on a 2D image,
+ * 26-connected on a 3D image).
+ *
+ * The runs are encoded, their equivalences merged and the output written by several
+ * threads. The equivalences are merged in a lock-free union-find structure, whose sets
+ * are then numbered and flattened concurrently as well.
  *
  * After the filter is executed, ObjectCount holds the number of connected components.
  *
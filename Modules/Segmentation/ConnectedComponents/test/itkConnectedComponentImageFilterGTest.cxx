@@ -25,6 +25,9 @@ using itk::print_helper::operator<<;
 #include "itkConnectedComponentImageFilter.h"
 
 #include <bitset>
+#include <cstdlib>
+#include <random>
+#include <vector>
 
 namespace
 {
@@ -84,3 +87,116 @@ TEST(ConnectedComponentImageFilter, Checkerboard3D)
   ++it;
   EXPECT_TRUE(it.IsAtEnd());
 }
+
+
+namespace
+{
+// Label the objects of the mask by flood filling them in raster order, with
+// consecutive labels skipping the background value.
+template <typename TMaskImage, typename TLabelImage>
+typename TLabelImage::Pointer
+ComputeReferenceLabels(const TMaskImage * mask, bool fullyConnected, typename TLabelImage::PixelType backgroundValue)
+{
+  using LabelPixelType = typename TLabelImage::PixelType;
+  const auto region = mask->GetBufferedRegion();
+
+  auto labels = TLabelImage::New();
+  labels->SetRegions(region);
+  labels->Allocate();
+  labels->FillBuffer(backgroundValue);
+  std::vector<bool> visited(region.GetNumberOfPixels(), false);
+
+  LabelPixelType label = 0;
+  for (itk::SizeValueType i = 0; i < region.GetNumberOfPixels(); ++i)
+  {
+    if (visited[i] || mask->GetBufferPointer()[i] == 0)
+    {
+      continue;
+    }
+    if (label == backgroundValue)
+    {
+      ++label;
+    }
+    std::vector<itk::SizeValueType> front{ i };
+    visited[i] = true;
+    while (!front.empty())
+    {
+      const itk::SizeValueType current = front.back();
+      front.pop_back();
+      labels->GetBufferPointer()[current] = label;
+      const auto index = mask->ComputeIndex(current);
+      for (int z = -1; z <= 1; ++z)
+      {
+        for (int y = -1; y <= 1; ++y)
+        {
+          for (int x = -1; x <= 1; ++x)
+          {
+            const int distance = std::abs(x) + std::abs(y) + std::abs(z);
+            if (distance == 0 || (!fullyConnected && distance > 1))
+            {
+              continue;
+            }
+            const auto neighbor = index + itk::Offset<3>{ { x, y, z } };
+            if (region.IsInside(neighbor))
+            {
+              const itk::SizeValueType n = mask->ComputeOffset(neighbor);
+              if (!visited[n] && mask->GetBufferPointer()[n] != 0)
+              {
+                visited[n] = true;
+                front.push_back(n);
+              }
+            }
+          }
+        }
+      }
+    }
+    ++label;
+  }
+  return labels;
+}
+} // namespace
+
+
+TEST(ConnectedComponentImageFilter, MatchesFloodFillOfRandomMasks)
+{
+  using MaskImageType = itk::Image<unsigned char, 3>;
+  using LabelImageType = itk::Image<unsigned int, 3>;
+
+  std::mt19937 randomNumberGenerator(5);
+  for (const double density : { 0.05, 0.3, 0.6 })
+  {
+    auto mask = MaskImageType::New();
+    mask->SetRegions(itk::MakeSize(31u, 17u, 23u));
+    mask->Allocate();
+    std::bernoulli_distribution distribution(density);
+    for (itk::SizeValueType i = 0; i < mask->GetBufferedRegion().GetNumberOfPixels(); ++i)
+    {
+      mask->GetBufferPointer()[i] = distribution(randomNumberGenerator);
+    }
+
+    for (const bool fullyConnected : { false, true })
+    {
+      for (const unsigned int backgroundValue : { 0u, 3u })
+      {
+        auto connected = itk::ConnectedComponentImageFilter<MaskImageType, LabelImageType>::New();
+        connected->SetInput(mask);
+        connected->SetFullyConnected(fullyConnected);
+        connected->SetBackgroundValue(backgroundValue);
+        // Many work units, so that equivalences are merged concurrently.
+        connected->SetNumberOfWorkUnits(16);
+        connected->Update();
+
+        const auto expectedLabels =
+          ComputeReferenceLabels<MaskImageType, LabelImageType>(mask, fullyConnected, backgroundValue);
+        const LabelImageType * labels = connected->GetOutput();
+        itk::SizeValueType     numberOfMismatches = 0;
+        for (itk::SizeValueType i = 0; i < mask->GetBufferedRegion().GetNumberOfPixels(); ++i)
+        {
+          numberOfMismatches += labels->GetBufferPointer()[i] != expectedLabels->GetBufferPointer()[i];
+        }
+        EXPECT_EQ(numberOfMismatches, 0u) << "density " << density << ", fully connected " << fullyConnected
+                                          << ", background " << backgroundValue;
+      }
+    }
+  }
+}
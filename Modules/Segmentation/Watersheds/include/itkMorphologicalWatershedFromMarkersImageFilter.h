@@ -19,6 +19,13 @@
 #define itkMorphologicalWatershedFromMarkersImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include "itkTotalProgressReporter.h"
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -64,6 +71,11 @@ namespace itk
  * The morphological watershed transform algorithm is described in
  * \cite soille2004c.
  *
+ * The pixels are flooded by increasing values from a hierarchical queue of
+ * pixel offsets. For 8 and 16 bit integer input images, the hierarchical
+ * queue is an array of buckets, one per pixel value, otherwise a map from the
+ * pixel values to their queues.
+ *
  * This code was contributed in the Insight Journal paper:
  * "The watershed transform in ITK - discussion and new developments"
  * by Beare R., Lehmann G.
@@ -162,6 +174,41 @@ public:
   itkGetConstReferenceMacro(MarkWatershedLine, bool);
   itkBooleanMacro(MarkWatershedLine);
   /** @ITKEndGrouping */
+
+  /**
+   * Set/Get whether the image is flooded in tiles, concurrently. Default is
+   * false.
+   *
+   * The requested region is split into at most one tile per work unit, and
+   * each tile is flooded from its own markers, as if it was a whole image. The
+   * pixels which are left unlabeled, because no marker of their tile
+   * reaches them, are then flooded from the labels of the neighboring
+   * tiles, sequentially. Basins do not compete across the tile borders, so
+   * the result differs from the one of the sequential flooding where a
+   * basin crosses a tile border:
+   *  - a basin flooded from the markers of a tile takes the pixels of that
+   *    tile which a marker of another tile would have reached first, and
+   *    two basins may meet at a tile border instead of at the crest
+   *    between them;
+   *  - with MarkWatershedLine, the watershed lines within the tiles are
+   *    those of the sequential flooding of the tile. Where two labels meet
+   *    at a tile border, the pixel of the higher input value of the two,
+   *    or the later one in memory if their values are equal, becomes a
+   *    watershed pixel, unless it is a marker pixel, so that different
+   *    labels are still separated by watershed lines. These lines follow the tile border rather than the
+   *    crest of the input image.
+   * The result does not depend on the order in which the tiles are
+   * flooded, but on the number of work units. With a single work unit, it
+   * is that of the sequential flooding. It is closest to it when every
+   * basin has a marker in each tile it covers, e.g. with a marker per
+   * cell nucleus; a tile without markers is flooded entirely from its
+   * neighbors.
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseTiledFlooding, bool);
+  itkGetConstReferenceMacro(UseTiledFlooding, bool);
+  itkBooleanMacro(UseTiledFlooding);
+  /** @ITKEndGrouping */
 protected:
   MorphologicalWatershedFromMarkersImageFilter();
   ~MorphologicalWatershedFromMarkersImageFilter() override = default;
@@ -180,14 +227,173 @@ protected:
   void
   EnlargeOutputRequestedRegion(DataObject * itkNotUsed(output)) override;
 
-  /** The filter is single threaded. */
+  /** The filter is single threaded, unless UseTiledFlooding is on. */
   void
   GenerateData() override;
 
 private:
+  /** Flood the requested region of the output image from the markers, as a
+   * whole. */
+  void
+  Flood(const InputImageType *  inputImage,
+        const LabelImageType *  markerImage,
+        LabelImageType *        outputImage,
+        TotalProgressReporter & progress) const;
+
+  /** Flood the output image in tiles, concurrently, see SetUseTiledFlooding(). */
+  void
+  FloodTiles(const InputImageType * inputImage, const LabelImageType * markerImage, LabelImageType * outputImage);
+
+  /** The hierarchical queue of the flooding, with a FIFO queue of pixel
+   * offsets for each pixel value. The queue of the lowest value is flooded
+   * first, as the current level. Pixels of lower or equal values, found while
+   * flooding it, are pushed to the current level. */
+  class MapHierarchicalQueue
+  {
+  public:
+    bool
+    IsEmpty() const
+    {
+      return m_Queues.empty();
+    }
+
+    void
+    Push(InputImagePixelType value, OffsetValueType offset)
+    {
+      m_Queues[value].push(offset);
+    }
+
+    /** Make the queue of the lowest value the current level, and return its
+     * value. */
+    InputImagePixelType
+    BeginLevel()
+    {
+      const auto                lowest = m_Queues.begin();
+      const InputImagePixelType value = lowest->first;
+      m_Level = std::move(lowest->second);
+      m_Queues.erase(lowest);
+      return value;
+    }
+
+    bool
+    IsLevelEmpty() const
+    {
+      return m_Level.empty();
+    }
+
+    OffsetValueType
+    PopFromLevel()
+    {
+      const OffsetValueType offset = m_Level.front();
+      m_Level.pop();
+      return offset;
+    }
+
+    void
+    PushToLevel(OffsetValueType offset)
+    {
+      m_Level.push(offset);
+    }
+
+  private:
+    std::map<InputImagePixelType, std::queue<OffsetValueType>> m_Queues{};
+    std::queue<OffsetValueType>                                m_Level{};
+  };
+
+  /** The hierarchical queue of the flooding of integer pixels of at most 16
+   * bits, an array of buckets indexed by the pixel value, searched upward
+   * from the current level. */
+  class BucketHierarchicalQueue
+  {
+  public:
+    BucketHierarchicalQueue()
+      : m_Buckets(SizeValueType{ 1 } << (8 * sizeof(InputImagePixelType)))
+    {}
+
+    bool
+    IsEmpty() const
+    {
+      return m_NumberOfPendingOffsets == 0;
+    }
+
+    void
+    Push(InputImagePixelType value, OffsetValueType offset)
+    {
+      const SizeValueType bucket = ToBucket(value);
+      m_Buckets[bucket].push_back(offset);
+      m_LowestBucket = std::min(m_LowestBucket, bucket);
+      ++m_NumberOfPendingOffsets;
+    }
+
+    /** Make the lowest non-empty bucket the current level, and return its
+     * value. */
+    InputImagePixelType
+    BeginLevel()
+    {
+      // Release the memory of the previous level, if any, which has been
+      // flooded entirely.
+      if (m_LevelPosition > 0)
+      {
+        std::vector<OffsetValueType>().swap(m_Buckets[m_LevelBucket]);
+      }
+      while (m_Buckets[m_LowestBucket].empty())
+      {
+        ++m_LowestBucket;
+      }
+      m_LevelBucket = m_LowestBucket;
+      m_LevelPosition = 0;
+      m_NumberOfPendingOffsets -= m_Buckets[m_LevelBucket].size();
+      // The values pushed from now on are larger than the current level.
+      ++m_LowestBucket;
+      return static_cast<InputImagePixelType>(static_cast<OffsetValueType>(m_LevelBucket) + LowestValue);
+    }
+
+    bool
+    IsLevelEmpty() const
+    {
+      return m_LevelPosition == m_Buckets[m_LevelBucket].size();
+    }
+
+    OffsetValueType
+    PopFromLevel()
+    {
+      return m_Buckets[m_LevelBucket][m_LevelPosition++];
+    }
+
+    void
+    PushToLevel(OffsetValueType offset)
+    {
+      m_Buckets[m_LevelBucket].push_back(offset);
+    }
+
+  private:
+    static constexpr OffsetValueType LowestValue = NumericTraits<InputImagePixelType>::NonpositiveMin();
+
+    static SizeValueType
+    ToBucket(InputImagePixelType value)
+    {
+      return static_cast<SizeValueType>(static_cast<OffsetValueType>(value) - LowestValue);
+    }
+
+    std::vector<std::vector<OffsetValueType>> m_Buckets;
+    SizeValueType                             m_LowestBucket{ NumericTraits<SizeValueType>::max() };
+    SizeValueType                             m_LevelBucket{ 0 };
+    SizeValueType                             m_LevelPosition{ 0 };
+    SizeValueType                             m_NumberOfPendingOffsets{ 0 };
+  };
+
+  static constexpr bool UseBucketHierarchicalQueue = std::is_integral_v<InputImagePixelType> &&
+                                                     !std::is_same_v<InputImagePixelType, bool> &&
+                                                     sizeof(InputImagePixelType) <= 2;
+
+  using HierarchicalQueueType =
+    std::conditional_t<UseBucketHierarchicalQueue, BucketHierarchicalQueue, MapHierarchicalQueue>;
+
   bool m_FullyConnected{ false };
 
   bool m_MarkWatershedLine{ true };
+
+  bool m_UseTiledFlooding{ false };
 }; // end of class
 } // end namespace itk
 
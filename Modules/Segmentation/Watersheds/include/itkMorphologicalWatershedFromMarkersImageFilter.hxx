@@ -19,9 +19,10 @@
 #define itkMorphologicalWatershedFromMarkersImageFilter_hxx
 
 #include <algorithm>
-#include <queue>
-#include <list>
-#include "itkProgressReporter.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionSplitterMultidimensional.h"
+#include "itkMath.h"
 #include "itkImageRegionIterator.h"
 #include "itkConstShapedNeighborhoodIterator.h"
 #include "itkConstantBoundaryCondition.h"
@@ -75,6 +76,163 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::EnlargeO
 template <typename TInputImage, typename TLabelImage>
 void
 MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const LabelImageType * markerImage = this->GetMarkerImage();
+  const InputImageType * inputImage = this->GetInput();
+  LabelImageType *       outputImage = this->GetOutput();
+
+  // mask and marker must have the same size
+  if (markerImage->GetRequestedRegion().GetSize() != inputImage->GetRequestedRegion().GetSize())
+  {
+    itkExceptionStringMacro("Marker and input must have the same size.");
+  }
+
+  if (m_UseTiledFlooding)
+  {
+    this->FloodTiles(inputImage, markerImage, outputImage);
+  }
+  else
+  {
+    // Set up the progress reporter
+    // we can't found the exact number of pixel to process in the 2nd pass, so
+    // we use the maximum number possible.
+    TotalProgressReporter progress(this, markerImage->GetRequestedRegion().GetNumberOfPixels() * 2);
+    this->Flood(inputImage, markerImage, outputImage, progress);
+  }
+}
+
+
+template <typename TInputImage, typename TLabelImage>
+void
+MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::FloodTiles(const InputImageType * inputImage,
+                                                                                   const LabelImageType * markerImage,
+                                                                                   LabelImageType *       outputImage)
+{
+  static const LabelImagePixelType bgLabel{};
+  static const LabelImagePixelType wsLabel{};
+
+  const LabelImageRegionType region = outputImage->GetRequestedRegion();
+  const auto                 splitter = ImageRegionSplitterMultidimensional::New();
+  const unsigned int         numberOfTiles = splitter->GetNumberOfSplits(region, this->GetNumberOfWorkUnits());
+  if (numberOfTiles < 2)
+  {
+    TotalProgressReporter progress(this, region.GetNumberOfPixels() * 2);
+    this->Flood(inputImage, markerImage, outputImage, progress);
+    return;
+  }
+
+  // Each tile is flooded twice at most: by itself, and from its neighbors.
+  const SizeValueType               totalNumberOfPixels = region.GetNumberOfPixels() * 4;
+  std::vector<LabelImageRegionType> tiles(numberOfTiles, region);
+  for (unsigned int i = 0; i < numberOfTiles; ++i)
+  {
+    splitter->GetSplit(i, numberOfTiles, tiles[i]);
+  }
+
+  // Flood each tile from its own markers, as a whole image.
+  auto tiledImage = LabelImageType::New();
+  tiledImage->CopyInformation(outputImage);
+  tiledImage->SetRegions(region);
+  tiledImage->Allocate();
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfTiles,
+    [this, &tiles, inputImage, markerImage, &tiledImage, totalNumberOfPixels](const SizeValueType i) {
+      const LabelImageRegionType & tile = tiles[i];
+      auto                         tileInput = InputImageType::New();
+      tileInput->SetRegions(tile);
+      tileInput->Allocate();
+      ImageAlgorithm::Copy(inputImage, tileInput.GetPointer(), tile, tile);
+      auto tileMarker = LabelImageType::New();
+      tileMarker->SetRegions(tile);
+      tileMarker->Allocate();
+      ImageAlgorithm::Copy(markerImage, tileMarker.GetPointer(), tile, tile);
+      auto tileOutput = LabelImageType::New();
+      tileOutput->SetRegions(tile);
+      tileOutput->Allocate();
+
+      TotalProgressReporter progress(this, totalNumberOfPixels);
+      this->Flood(tileInput, tileMarker, tileOutput, progress);
+      ImageAlgorithm::Copy(tileOutput.GetPointer(), tiledImage.GetPointer(), tile, tile);
+    },
+    nullptr);
+
+  if (m_MarkWatershedLine)
+  {
+    // The labels of two tiles may meet at their border. Of two adjacent pixels of different labels, the one of
+    // higher value, or the later one, becomes a watershed pixel, unless it is a marker pixel.
+    constexpr auto                                  radius = Size<ImageDimension>::Filled(1);
+    ConstShapedNeighborhoodIterator<LabelImageType> neighborhoodIt(radius, tiledImage, region);
+    setConnectivity(&neighborhoodIt, m_FullyConnected);
+    std::vector<typename LabelImageType::OffsetType> neighborOffsets;
+    for (auto nIt = neighborhoodIt.Begin(); nIt != neighborhoodIt.End(); ++nIt)
+    {
+      neighborOffsets.push_back(nIt.GetNeighborhoodOffset());
+    }
+
+    for (const LabelImageRegionType & tile : tiles)
+    {
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        if (tile.GetIndex(d) == region.GetIndex(d))
+        {
+          continue;
+        }
+        // The first pixels of the tile along d, next to those of the preceding tile.
+        LabelImageRegionType face = tile;
+        face.SetSize(d, 1);
+        for (ImageRegionConstIteratorWithIndex<LabelImageType> faceIt(tiledImage, face); !faceIt.IsAtEnd(); ++faceIt)
+        {
+          const IndexType index = faceIt.GetIndex();
+          for (const auto & neighborOffset : neighborOffsets)
+          {
+            const IndexType neighbor = index + neighborOffset;
+            if (!region.IsInside(neighbor))
+            {
+              continue;
+            }
+            const LabelImagePixelType label = tiledImage->GetPixel(index);
+            const LabelImagePixelType neighborLabel = tiledImage->GetPixel(neighbor);
+            if (label == wsLabel || neighborLabel == wsLabel || label == neighborLabel)
+            {
+              continue;
+            }
+            const bool isMarker = markerImage->GetPixel(index) != bgLabel;
+            const bool isNeighborMarker = markerImage->GetPixel(neighbor) != bgLabel;
+            if (isMarker && isNeighborMarker)
+            {
+              continue;
+            }
+            bool neighborBecomesWatershed = isMarker;
+            if (!isMarker && !isNeighborMarker)
+            {
+              const InputImagePixelType value = inputImage->GetPixel(index);
+              const InputImagePixelType neighborValue = inputImage->GetPixel(neighbor);
+              neighborBecomesWatershed =
+                value < neighborValue || (Math::ExactlyEquals(value, neighborValue) &&
+                                          tiledImage->ComputeOffset(neighbor) > tiledImage->ComputeOffset(index));
+            }
+            tiledImage->SetPixel(neighborBecomesWatershed ? neighbor : index, wsLabel);
+          }
+        }
+      }
+    }
+  }
+
+  // Flood the pixels which are left unlabeled from the labels of the tiles. The labeled pixels are kept as they are.
+  TotalProgressReporter progress(this, totalNumberOfPixels);
+  this->Flood(inputImage, tiledImage, outputImage, progress);
+}
+
+
+template <typename TInputImage, typename TLabelImage>
+void
+MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Flood(const InputImageType *  inputImage,
+                                                                              const LabelImageType *  markerImage,
+                                                                              LabelImageType *        outputImage,
+                                                                              TotalProgressReporter & progress) const
 {
   // there is 2 possible cases: with or without watershed lines.
   // the algorithm with watershed lines is from Meyer
@@ -83,8 +241,7 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
 
   //---------------------------------------------------------------------------
   // declare the vars common to the 2 algorithms: constants, iterators,
-  // hierarchical queue, progress reporter, and status image
-  // also allocate output images and verify preconditions
+  // hierarchical queue, and status image
   //---------------------------------------------------------------------------
 
   // the label used to find background in the marker image
@@ -92,27 +249,8 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
   // the label used to mark the watershed line in the output image
   static const LabelImagePixelType wsLabel{};
 
-  this->AllocateOutputs();
-
-  const LabelImageType * markerImage = this->GetMarkerImage();
-  const InputImageType * inputImage = this->GetInput();
-  LabelImageType *       outputImage = this->GetOutput();
-
-  // Set up the progress reporter
-  // we can't found the exact number of pixel to process in the 2nd pass, so we
-  // use the maximum number possible.
-  ProgressReporter progress(this, 0, markerImage->GetRequestedRegion().GetNumberOfPixels() * 2);
-
-  // mask and marker must have the same size
-  if (markerImage->GetRequestedRegion().GetSize() != inputImage->GetRequestedRegion().GetSize())
-  {
-    itkExceptionStringMacro("Marker and input must have the same size.");
-  }
-
   // FAH (in french: File d'Attente Hierarchique)
-  using QueueType = std::queue<IndexType>;
-  using MapType = std::map<InputImagePixelType, QueueType>;
-  MapType fah;
+  HierarchicalQueueType fah;
 
   // the radius which will be used for all the shaped iterators
   constexpr auto radius = Size<ImageDimension>::Filled(1);
@@ -210,7 +348,7 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
           {
             // this neighbor is a background pixel and is not already
             // processed; add its index to fah
-            fah[niIt.Get()].push(markerIt.GetIndex() + nmIt.GetNeighborhoodOffset());
+            fah.Push(niIt.Get(), outputImage->ComputeOffset(markerIt.GetIndex() + nmIt.GetNeighborhoodOffset()));
             // mark it as already in the fah to avoid adding it several times
             nsIt.Set(true);
           }
@@ -240,18 +378,14 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     inputIt.GoToBegin();
 
     // and start flooding
-    while (!fah.empty())
+    while (!fah.IsEmpty())
     {
-      // store the current vars
-      const InputImagePixelType currentValue = fah.begin()->first;
-      QueueType                 currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase(fah.begin());
+      // flood the lowest level of the fah
+      const InputImagePixelType currentValue = fah.BeginLevel();
 
-      while (!currentQueue.empty())
+      while (!fah.IsLevelEmpty())
       {
-        const IndexType idx = currentQueue.front();
-        currentQueue.pop();
+        const IndexType idx = outputImage->ComputeIndex(fah.PopFromLevel());
 
         // move the iterators to the right place
         const OffsetType shift = idx - outputIt.GetIndex();
@@ -288,13 +422,15 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
             {
               // the pixel is not yet processed. add it to the fah
               const InputImagePixelType GrayVal = niIt.Get();
+              const OffsetValueType     offset =
+                outputImage->ComputeOffset(inputIt.GetIndex() + niIt.GetNeighborhoodOffset());
               if (GrayVal <= currentValue)
               {
-                currentQueue.push(inputIt.GetIndex() + niIt.GetNeighborhoodOffset());
+                fah.PushToLevel(offset);
               }
               else
               {
-                fah[GrayVal].push(inputIt.GetIndex() + niIt.GetNeighborhoodOffset());
+                fah.Push(GrayVal, offset);
               }
               // mark it as already in the fah
               nsIt.Set(true);
@@ -348,7 +484,7 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
         if (haveBgNeighbor)
         {
           // there is a background pixel in the neighborhood; add to fah
-          fah[inputIt.GetCenterPixel()].push(markerIt.GetIndex());
+          fah.Push(inputIt.GetCenterPixel(), outputImage->ComputeOffset(markerIt.GetIndex()));
         }
         else
         {
@@ -371,18 +507,14 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     inputIt.GoToBegin();
 
     // and start flooding
-    while (!fah.empty())
+    while (!fah.IsEmpty())
     {
-      // store the current vars
-      const InputImagePixelType currentValue = fah.begin()->first;
-      QueueType                 currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase(fah.begin());
+      // flood the lowest level of the fah
+      const InputImagePixelType currentValue = fah.BeginLevel();
 
-      while (!currentQueue.empty())
+      while (!fah.IsLevelEmpty())
       {
-        const IndexType idx = currentQueue.front();
-        currentQueue.pop();
+        const IndexType idx = outputImage->ComputeIndex(fah.PopFromLevel());
 
         // move the iterators to the right place
         const OffsetType shift = idx - outputIt.GetIndex();
@@ -400,13 +532,15 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
             // current label
             noIt.Set(currentMarker);
             const InputImagePixelType GrayVal = niIt.Get();
+            const OffsetValueType     offset =
+              outputImage->ComputeOffset(inputIt.GetIndex() + noIt.GetNeighborhoodOffset());
             if (GrayVal <= currentValue)
             {
-              currentQueue.push(inputIt.GetIndex() + noIt.GetNeighborhoodOffset());
+              fah.PushToLevel(offset);
             }
             else
             {
-              fah[GrayVal].push(inputIt.GetIndex() + noIt.GetNeighborhoodOffset());
+              fah.Push(GrayVal, offset);
             }
             progress.CompletedPixel();
           }
@@ -426,6 +560,7 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::PrintSel
 
   itkPrintSelfBooleanMacro(FullyConnected);
   os << indent << "MarkWatershedLine: " << m_MarkWatershedLine << std::endl;
+  itkPrintSelfBooleanMacro(UseTiledFlooding);
 }
 
 } // end namespace itk
@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMorphologicalWatershedFromMarkersImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using LabelImageType = itk::Image<unsigned short, Dimension>;
+
+// Flood the same relief, shifted by an offset, stored with the pixel type.
+// The flooding only depends on the order of the pixel values, so the labels
+// must not depend on the pixel type, whether its hierarchical queue is made
+// of buckets or of a map.
+template <typename TPixel>
+LabelImageType::Pointer
+ComputeWatershed(const LabelImageType * relief,
+                 const LabelImageType * markers,
+                 double                 valueOffset,
+                 bool                   markWatershedLine,
+                 bool                   fullyConnected)
+{
+  using ImageType = itk::Image<TPixel, Dimension>;
+  auto image = ImageType::New();
+  image->SetRegions(relief->GetLargestPossibleRegion());
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<TPixel>(relief->GetPixel(it.GetIndex()) + valueOffset));
+  }
+
+  using FilterType = itk::MorphologicalWatershedFromMarkersImageFilter<ImageType, LabelImageType>;
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetMarkerImage(markers);
+  filter->SetMarkWatershedLine(markWatershedLine);
+  filter->SetFullyConnected(fullyConnected);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+bool
+HaveSameLabels(const LabelImageType * labels, const LabelImageType * expectedLabels, const char * pixelTypeName)
+{
+  for (itk::ImageRegionIteratorWithIndex<const LabelImageType> it(labels, labels->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    if (it.Get() != expectedLabels->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in the labels of the " << pixelTypeName << " image at index " << it.GetIndex() << std::endl;
+      std::cerr << "Expected value " << expectedLabels->GetPixel(it.GetIndex()) << std::endl;
+      std::cerr << " differs from " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkMorphologicalWatershedFromMarkersImageFilterPixelTypesTest(int, char *[])
+{
+  // A noisy relief of values from 0 to 255, with plateaus, and a few markers.
+  auto relief = LabelImageType::New();
+  relief->SetRegions(itk::MakeSize(24, 21, 17));
+  relief->Allocate();
+  std::mt19937                           randomNumberGenerator(7);
+  std::uniform_real_distribution<double> noise(0.0, 40.0);
+  for (itk::ImageRegionIteratorWithIndex<LabelImageType> it(relief, relief->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const auto & index = it.GetIndex();
+    const double value =
+      100.0 + 60.0 * std::sin(0.5 * index[0]) * std::cos(0.4 * index[1]) + 30.0 * std::sin(0.3 * index[2]);
+    it.Set(static_cast<unsigned short>(std::floor((value + noise(randomNumberGenerator)) / 8.0) * 8.0));
+  }
+
+  auto markers = LabelImageType::New();
+  markers->SetRegions(relief->GetLargestPossibleRegion());
+  markers->AllocateInitialized();
+  for (unsigned short label = 1; label <= 12; ++label)
+  {
+    markers->SetPixel({ { static_cast<itk::IndexValueType>(randomNumberGenerator() % 24),
+                          static_cast<itk::IndexValueType>(randomNumberGenerator() % 21),
+                          static_cast<itk::IndexValueType>(randomNumberGenerator() % 17) } },
+                      label);
+  }
+
+  for (const bool markWatershedLine : { true, false })
+  {
+    for (const bool fullyConnected : { false, true })
+    {
+      const LabelImageType::Pointer expectedLabels =
+        ComputeWatershed<double>(relief, markers, 0.0, markWatershedLine, fullyConnected);
+
+      ITK_TEST_EXPECT_TRUE(HaveSameLabels(
+        ComputeWatershed<unsigned char>(relief, markers, 0.0, markWatershedLine, fullyConnected),
+        expectedLabels,
+        "unsigned char"));
+      ITK_TEST_EXPECT_TRUE(HaveSameLabels(
+        ComputeWatershed<short>(relief, markers, -128.0, markWatershedLine, fullyConnected), expectedLabels, "short"));
+      ITK_TEST_EXPECT_TRUE(HaveSameLabels(
+        ComputeWatershed<unsigned short>(relief, markers, 1000.0, markWatershedLine, fullyConnected),
+        expectedLabels,
+        "unsigned short"));
+      ITK_TEST_EXPECT_TRUE(HaveSameLabels(
+        ComputeWatershed<int>(relief, markers, -100000.0, markWatershedLine, fullyConnected), expectedLabels, "int"));
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -65,6 +65,8 @@ itkMorphologicalWatershedFromMarkersImageFilterTest(int argc, char * argv[])
   const bool fullyConnected = std::stoi(argv[5]);
   ITK_TEST_SET_GET_BOOLEAN(filter, FullyConnected, fullyConnected);
 
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseTiledFlooding, false);
+
 
   filter->SetInput(reader->GetOutput());
 
@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMorphologicalWatershedFromMarkersImageFilter.h"
+#include "itkConnectedComponentAlgorithm.h"
+#include "itkConstShapedNeighborhoodIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <random>
+#include <set>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<unsigned short, Dimension>;
+using LabelImageType = itk::Image<unsigned char, Dimension>;
+
+LabelImageType::Pointer
+ComputeWatershed(const ImageType *      relief,
+                 const LabelImageType * markers,
+                 bool                   markWatershedLine,
+                 bool                   fullyConnected,
+                 bool                   useTiledFlooding,
+                 unsigned int           numberOfWorkUnits)
+{
+  using FilterType = itk::MorphologicalWatershedFromMarkersImageFilter<ImageType, LabelImageType>;
+  auto filter = FilterType::New();
+  filter->SetInput(relief);
+  filter->SetMarkerImage(markers);
+  filter->SetMarkWatershedLine(markWatershedLine);
+  filter->SetFullyConnected(fullyConnected);
+  filter->SetUseTiledFlooding(useTiledFlooding);
+  filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+unsigned int
+CountDifferences(const LabelImageType * labels, const LabelImageType * expectedLabels)
+{
+  unsigned int numberOfDifferences = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<LabelImageType> it(labels, labels->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    if (it.Get() != expectedLabels->GetPixel(it.GetIndex()))
+    {
+      ++numberOfDifferences;
+    }
+  }
+  return numberOfDifferences;
+}
+
+// Checks the properties of the labels which do not depend on the tiling: the markers keep their labels, all pixels are
+// labeled with the label of a marker, or are watershed pixels with MarkWatershedLine, and, with MarkWatershedLine,
+// pixels of different labels are not adjacent, unless both are marker pixels.
+bool
+HasValidLabels(const LabelImageType * labels,
+               const LabelImageType * markers,
+               bool                   markWatershedLine,
+               bool                   fullyConnected)
+{
+  std::set<LabelImageType::PixelType> markerLabels;
+  for (itk::ImageRegionConstIterator<LabelImageType> it(markers, markers->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    markerLabels.insert(it.Get());
+  }
+
+  using IteratorType = itk::ConstShapedNeighborhoodIterator<LabelImageType>;
+  IteratorType it(itk::Size<Dimension>::Filled(1), labels, labels->GetLargestPossibleRegion());
+  setConnectivity(&it, fullyConnected);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const LabelImageType::IndexType index = it.GetIndex();
+    const LabelImageType::PixelType label = it.GetCenterPixel();
+    const LabelImageType::PixelType marker = markers->GetPixel(index);
+    if ((marker != 0 && label != marker) || markerLabels.count(label) == 0 || (!markWatershedLine && label == 0))
+    {
+      std::cerr << "Invalid label " << +label << " at " << index << std::endl;
+      return false;
+    }
+    if (!markWatershedLine || label == 0)
+    {
+      continue;
+    }
+    for (auto nIt = it.Begin(); nIt != it.End(); ++nIt)
+    {
+      const LabelImageType::IndexType neighbor = index + nIt.GetNeighborhoodOffset();
+      if (labels->GetLargestPossibleRegion().IsInside(neighbor) && nIt.Get() != 0 && nIt.Get() != label &&
+          (marker == 0 || markers->GetPixel(neighbor) == 0))
+      {
+        std::cerr << "The labels " << +label << " at " << index << " and " << +nIt.Get() << " at " << neighbor
+                  << " are not separated by a watershed line" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkMorphologicalWatershedFromMarkersImageFilterTiledTest(int, char *[])
+{
+  // A noisy relief with plateaus, and markers, two of which are adjacent.
+  auto relief = ImageType::New();
+  relief->SetRegions(itk::MakeSize(40, 33, 27));
+  relief->Allocate();
+  std::mt19937                           randomNumberGenerator(11);
+  std::uniform_real_distribution<double> noise(0.0, 40.0);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(relief, relief->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    const double value =
+      100.0 + 60.0 * std::sin(0.3 * index[0]) * std::cos(0.25 * index[1]) + 30.0 * std::sin(0.2 * index[2]);
+    it.Set(static_cast<unsigned short>(std::floor((value + noise(randomNumberGenerator)) / 8.0) * 8.0));
+  }
+
+  auto markers = LabelImageType::New();
+  markers->SetRegions(relief->GetLargestPossibleRegion());
+  markers->AllocateInitialized();
+  for (unsigned char label = 1; label <= 20; ++label)
+  {
+    markers->SetPixel({ { static_cast<itk::IndexValueType>(randomNumberGenerator() % 40),
+                          static_cast<itk::IndexValueType>(randomNumberGenerator() % 33),
+                          static_cast<itk::IndexValueType>(randomNumberGenerator() % 27) } },
+                      label);
+  }
+  markers->SetPixel({ { 20, 16, 13 } }, 21);
+  markers->SetPixel({ { 20, 16, 14 } }, 22);
+
+  for (const bool markWatershedLine : { true, false })
+  {
+    for (const bool fullyConnected : { false, true })
+    {
+      const LabelImageType::Pointer expectedLabels =
+        ComputeWatershed(relief, markers, markWatershedLine, fullyConnected, false, 1);
+
+      // A single tile is flooded sequentially.
+      ITK_TEST_EXPECT_EQUAL(
+        CountDifferences(ComputeWatershed(relief, markers, markWatershedLine, fullyConnected, true, 1), expectedLabels),
+        0u);
+
+      for (const unsigned int numberOfWorkUnits : { 2u, 3u, 8u, 27u })
+      {
+        const LabelImageType::Pointer labels =
+          ComputeWatershed(relief, markers, markWatershedLine, fullyConnected, true, numberOfWorkUnits);
+        ITK_TEST_EXPECT_TRUE(HasValidLabels(labels, markers, markWatershedLine, fullyConnected));
+
+        // The labels do not depend on the order in which the tiles are flooded.
+        ITK_TEST_EXPECT_EQUAL(
+          CountDifferences(
+            ComputeWatershed(relief, markers, markWatershedLine, fullyConnected, true, numberOfWorkUnits), labels),
+          0u);
+
+        std::cout << "MarkWatershedLine: " << markWatershedLine << ", FullyConnected: " << fullyConnected << ", "
+                  << numberOfWorkUnits << " work units: " << CountDifferences(labels, expectedLabels)
+                  << " pixels differ from the sequential flooding." << std::endl;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
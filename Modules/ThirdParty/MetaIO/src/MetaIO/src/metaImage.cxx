@@ -1675,17 +1675,13 @@ MetaImage::WriteStream(METAIO_STREAM::ofstream * _stream, bool _writeElements, c
 
     if (_constElementData == nullptr)
     {
-      compressedElementData = MET_PerformCompression(static_cast<const unsigned char *>(m_ElementData),
-                                                     m_Quantity * elementNumberOfBytes,
-                                                     &m_CompressedDataSize,
-                                                     m_CompressionLevel);
+      compressedElementData = M_PerformCompression(
+        static_cast<const unsigned char *>(m_ElementData), m_Quantity * elementNumberOfBytes, &m_CompressedDataSize);
     }
     else
     {
-      compressedElementData = MET_PerformCompression(static_cast<const unsigned char *>(_constElementData),
-                                                     m_Quantity * elementNumberOfBytes,
-                                                     &m_CompressedDataSize,
-                                                     m_CompressionLevel);
+      compressedElementData = M_PerformCompression(
+        static_cast<const unsigned char *>(_constElementData), m_Quantity * elementNumberOfBytes, &m_CompressedDataSize);
     }
   }
 
@@ -1725,6 +1721,14 @@ MetaImage::WriteStream(METAIO_STREAM::ofstream * _stream, bool _writeElements, c
   return writeResult;
 }
 
+unsigned char *
+MetaImage::M_PerformCompression(const unsigned char * _source,
+                                std::streamoff        _sourceSize,
+                                std::streamoff *      _compressedDataSize)
+{
+  return MET_PerformCompression(_source, _sourceSize, _compressedDataSize, m_CompressionLevel);
+}
+
 
 /** Write a portion of an image */
 bool
@@ -491,6 +491,13 @@ protected:
   bool
   M_WriteElementData(METAIO_STREAM::ofstream * _fstream, const void * _data, std::streamoff _dataQuantity);
 
+  // Compresses the element data written by WriteStream() into a buffer
+  // allocated with new[]. The default uses MET_PerformCompression(). A
+  // derived class may compress differently, e.g. in parallel, as long as
+  // the result is a single zlib stream.
+  virtual unsigned char *
+  M_PerformCompression(const unsigned char * _source, std::streamoff _sourceSize, std::streamoff * _compressedDataSize);
+
   static bool
   M_FileExists(const char * filename) ;
 